@@ -12,7 +12,7 @@ echo test data path: %test_data_folder%
 echo:
 
 echo --- building all testing executables ------------------------------------------
-call build rdi_from_pdb rdi_dump raddbg radlink tester
+call build rdi_from_pdb rdi_dump raddbg radlink radbin tester
 echo:
 
 echo --- running tests -------------------------------------------------------------
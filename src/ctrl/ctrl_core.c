@@ -1583,6 +1583,7 @@ ctrl_init(void)
   ctrl_state->ctrl_thread_entity_ctx_rw_mutex = rw_mutex_alloc();
   ctrl_state->ctrl_thread_entity_store = ctrl_entity_ctx_rw_store_alloc();
   ctrl_state->ctrl_thread_eval_cache = e_cache_alloc();
+  ctrl_state->ctrl_thread_cond_eval_cache = e_cache_alloc();
   ctrl_state->ctrl_thread_msg_process_arena = arena_alloc();
   ctrl_state->dmn_event_arena = arena_alloc();
   ctrl_state->user_entry_point_arena = arena_alloc();
@@ -3336,15 +3337,13 @@ ctrl_call_stack_from_unwind(Arena *arena, CTRL_Entity *process, CTRL_Unwind *bas
       U64 rip_voff = ctrl_voff_from_vaddr(module, rip_vaddr);
       DI_Key dbgi_key = ctrl_dbgi_key_from_module(module);
       RDI_Parsed *rdi = di_rdi_from_key(di_scope, &dbgi_key, 1, 0);
-      RDI_Scope *scope = rdi_scope_from_voff(rdi, rip_voff);
+      DI_ScopeLookup scope_lookup = di_scope_lookup_from_rdi_voff(rdi, rip_voff);
       
       // rjf: build inline frames (minus parent & inline depth)
       FrameNode *first_inline_frame = 0;
       FrameNode *last_inline_frame = 0;
       U64 inline_frame_count = 0;
-      for(RDI_Scope *s = scope;
-          s->inline_site_idx != 0;
-          s = rdi_element_from_name_idx(rdi, Scopes, s->parent_scope_idx))
+      for(U64 inline_idx = 0; inline_idx < scope_lookup.inline_depth; inline_idx += 1)
       {
         FrameNode *dst_inline = push_array(scratch.arena, FrameNode, 1);
         if(first_inline_frame == 0)
@@ -3797,6 +3796,7 @@ ctrl_thread__entry_point(void *p)
         MemoryZeroStruct(&ctrl_state->msg_user_bp_touched_files);
         MemoryZeroStruct(&ctrl_state->msg_user_bp_touched_symbols);
         MemoryCopyArray(ctrl_state->exception_code_filters, msg->exception_code_filters);
+        ctrl_state->in_target_conditions = !!(msg->run_flags & CTRL_RunFlag_InTargetConditions);
         
         //- rjf: gather all touched symbols by user breakpoints
         {
@@ -3960,6 +3960,223 @@ ctrl_thread__entry_point(void *p)
 
 //- rjf: breakpoint resolution
 
+internal B32
+ctrl_thread__append_dmn_condition_bytecode(Arena *arena, String8List *out, String8 bytecode, CTRL_Entity *process, CTRL_Entity *module, RDI_Parsed *rdi, U64 voff, B32 allow_frame_off)
+{
+  B32 result = 1;
+  U8 *ptr = bytecode.str;
+  U8 *opl = bytecode.str + bytecode.size;
+  for(;ptr < opl && result;)
+  {
+    // decode op
+    U8 op = ptr[0];
+    U64 decode_size = 0;
+    if(op < RDI_EvalOp_COUNT)
+    {
+      decode_size = RDI_DECODEN_FROM_CTRLBITS(rdi_eval_op_ctrlbits_table[op]);
+    }
+    else if(op == E_IRExtKind_SetSpace)
+    {
+      decode_size = sizeof(E_Space);
+    }
+    else
+    {
+      result = 0;
+      break;
+    }
+    if(ptr + 1 + decode_size > opl)
+    {
+      result = 0;
+      break;
+    }
+    U8 *imm_ptr = ptr + 1;
+    U64 imm = 0;
+    MemoryCopy(&imm, imm_ptr, Min(decode_size, sizeof(imm)));
+    String8 op_bytecode = str8(ptr, 1 + decode_size);
+    ptr += 1 + decode_size;
+    
+    // lower op
+    switch(op)
+    {
+      // everything else is evaluated as-is - the demon decides which ops
+      // it is able to evaluate inside the target
+      default:
+      {
+        str8_list_push(arena, out, op_bytecode);
+      }break;
+      
+      // stop
+      case RDI_EvalOp_Stop:
+      {
+        ptr = opl;
+      }break;
+      
+      // ops which depend on state the target does not have, or on jump
+      // offsets which lowering does not preserve
+      case RDI_EvalOp_Cond:
+      case RDI_EvalOp_Skip:
+      case RDI_EvalOp_RegReadDyn:
+      case RDI_EvalOp_TLSOff:
+      case RDI_EvalOp_ObjectOff:
+      case RDI_EvalOp_CFA:
+      case RDI_EvalOp_ConstString:
+      case RDI_EvalOp_CallSiteValue:
+      case RDI_EvalOp_PartialValue:
+      case RDI_EvalOp_PartialValueBit:
+      {
+        result = 0;
+      }break;
+      
+      // space selection - only reads of the breakpoint's own process are
+      // possible from inside of it
+      case E_IRExtKind_SetSpace:
+      {
+        E_Space space = {0};
+        MemoryCopy(&space, imm_ptr, sizeof(space));
+        if(space.kind != CTRL_EvalSpaceKind_Entity || space.u64_0 != (U64)process)
+        {
+          result = 0;
+        }
+      }break;
+      
+      // module offsets -> absolute addresses
+      case RDI_EvalOp_ModuleOff:
+      {
+        U64 vaddr = module->vaddr_range.min + imm;
+        U8 *lowered = push_array(arena, U8, 1 + sizeof(vaddr));
+        lowered[0] = RDI_EvalOp_ConstU64;
+        MemoryCopy(lowered + 1, &vaddr, sizeof(vaddr));
+        str8_list_push(arena, out, str8(lowered, 1 + sizeof(vaddr)));
+      }break;
+      
+      // frame offsets -> procedure's frame base bytecode + offset
+      case RDI_EvalOp_FrameOff:
+      {
+        String8 frame_base_bytecode = {0};
+        RDI_Procedure *proc = rdi_procedure_from_voff(rdi, voff);
+        for(U64 loc_block_idx = proc->frame_base_location_first; loc_block_idx < proc->frame_base_location_opl; loc_block_idx += 1)
+        {
+          RDI_LocationBlock *block = rdi_element_from_name_idx(rdi, LocationBlocks, loc_block_idx);
+          if(block->scope_off_first <= voff && voff < block->scope_off_opl)
+          {
+            U64 all_location_data_size = 0;
+            U8 *all_location_data = rdi_table_from_name(rdi, LocationData, &all_location_data_size);
+            if(block->location_data_off + sizeof(RDI_LocationKind) <= all_location_data_size)
+            {
+              RDI_LocationKind loc_kind = *(RDI_LocationKind *)(all_location_data + block->location_data_off);
+              if(loc_kind == RDI_LocationKind_ValBytecodeStream || loc_kind == RDI_LocationKind_AddrBytecodeStream)
+              {
+                U8 *bytecode_ptr = all_location_data + block->location_data_off + sizeof(RDI_LocationKind);
+                U8 *bytecode_opl = all_location_data + all_location_data_size;
+                frame_base_bytecode = str8(bytecode_ptr, rdi_size_from_bytecode_stream(bytecode_ptr, bytecode_opl));
+              }
+            }
+            break;
+          }
+        }
+        if(!allow_frame_off || frame_base_bytecode.size == 0 ||
+           !ctrl_thread__append_dmn_condition_bytecode(arena, out, frame_base_bytecode, process, module, rdi, voff, 0))
+        {
+          result = 0;
+        }
+        else
+        {
+          U8 *lowered = push_array(arena, U8, 1 + sizeof(imm) + 2);
+          lowered[0] = RDI_EvalOp_ConstU64;
+          MemoryCopy(lowered + 1, &imm, sizeof(imm));
+          lowered[1 + sizeof(imm) + 0] = RDI_EvalOp_Add;
+          lowered[1 + sizeof(imm) + 1] = RDI_EvalTypeGroup_U;
+          str8_list_push(arena, out, str8(lowered, 1 + sizeof(imm) + 2));
+        }
+      }break;
+    }
+  }
+  return result;
+}
+
+internal String8
+ctrl_thread__dmn_condition_from_user_bp(Arena *arena, CTRL_EvalScope *eval_scope, CTRL_Entity *process, U64 vaddr, CTRL_UserBreakpoint *bp)
+{
+  String8 result = {0};
+  
+  //- in-target evaluation is opt-in (CTRL_RunFlag_InTargetConditions) - without
+  // it, conditions are left to the ctrl thread, which evaluates them on every hit
+  CTRL_Entity *module = &ctrl_entity_nil;
+  RDI_Parsed *rdi = &rdi_parsed_nil;
+  if(ctrl_state->in_target_conditions && bp->condition.size != 0 && bp->flags == 0)
+  {
+    module = ctrl_module_from_process_vaddr(process, vaddr);
+    DI_Key dbgi_key = ctrl_dbgi_key_from_module(module);
+    rdi = di_rdi_from_key(eval_scope->di_scope, &dbgi_key, 1, 0);
+  }
+  if(module != &ctrl_entity_nil && rdi != &rdi_parsed_nil)
+  {
+    Temp scratch = scratch_begin(&arena, 1);
+    U64 voff = ctrl_voff_from_vaddr(module, vaddr);
+    
+    //- save the currently-selected evaluation contexts - compilation
+    // happens in the context of the breakpoint's address, not the thread's
+    E_Cache *cache_restore = e_cache;
+    E_BaseCtx *base_ctx_restore = e_base_ctx;
+    E_IRCtx *ir_ctx_restore = e_ir_ctx;
+    E_InterpretCtx *interpret_ctx_restore = e_interpret_ctx;
+    
+    //- build & select evaluation contexts at the breakpoint's address
+    E_Module *eval_module = push_array(scratch.arena, E_Module, 1);
+    eval_module->arch        = process->arch;
+    eval_module->rdi         = rdi;
+    eval_module->vaddr_range = module->vaddr_range;
+    eval_module->space       = e_space_make(CTRL_EvalSpaceKind_Entity);
+    eval_module->space.u64_0 = (U64)process;
+    E_BaseCtx *base_ctx = push_array(scratch.arena, E_BaseCtx, 1);
+    base_ctx->thread_ip_vaddr = vaddr;
+    base_ctx->thread_ip_voff  = voff;
+    base_ctx->thread_arch     = process->arch;
+    base_ctx->modules         = eval_module;
+    base_ctx->modules_count   = 1;
+    base_ctx->primary_module  = eval_module;
+    base_ctx->space_read      = ctrl_eval_space_read;
+    E_IRCtx *ir_ctx = push_array(scratch.arena, E_IRCtx, 1);
+    ir_ctx->regs_map      = ctrl_string2reg_from_arch(process->arch);
+    ir_ctx->reg_alias_map = ctrl_string2alias_from_arch(process->arch);
+    ir_ctx->locals_map    = e_push_locals_map_from_rdi_voff(scratch.arena, rdi, voff);
+    ir_ctx->member_map    = e_push_member_map_from_rdi_voff(scratch.arena, rdi, voff);
+    E_InterpretCtx *interpret_ctx = push_array(scratch.arena, E_InterpretCtx, 1);
+    interpret_ctx->space_read     = ctrl_eval_space_read;
+    interpret_ctx->primary_space  = eval_module->space;
+    interpret_ctx->reg_arch       = process->arch;
+    interpret_ctx->module_base    = push_array(scratch.arena, U64, 1);
+    interpret_ctx->module_base[0] = module->vaddr_range.min;
+    interpret_ctx->frame_base     = push_array(scratch.arena, U64, 1);
+    interpret_ctx->tls_base       = push_array(scratch.arena, U64, 1);
+    e_select_cache(ctrl_state->ctrl_thread_cond_eval_cache);
+    e_select_base_ctx(base_ctx);
+    e_select_ir_ctx(ir_ctx);
+    e_select_interpret_ctx(interpret_ctx, rdi, voff);
+    
+    //- compile condition, lower to target-evaluable bytecode
+    {
+      E_IRTreeAndType irtree = e_irtree_from_string(bp->condition);
+      String8 bytecode = e_bytecode_from_string(bp->condition);
+      String8List lowered = {0};
+      if(irtree.msgs.max_kind == E_MsgKind_Null && bytecode.size != 0 &&
+         ctrl_thread__append_dmn_condition_bytecode(scratch.arena, &lowered, bytecode, process, module, rdi, voff, 1))
+      {
+        result = str8_list_join(arena, &lowered, 0);
+      }
+    }
+    
+    //- restore evaluation contexts
+    e_cache = cache_restore;
+    e_base_ctx = base_ctx_restore;
+    e_ir_ctx = ir_ctx_restore;
+    e_interpret_ctx = interpret_ctx_restore;
+    
+    scratch_end(scratch);
+  }
+  return result;
+}
+
 internal void
 ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_EvalScope *eval_scope, CTRL_Handle process, CTRL_Handle module, CTRL_UserBreakpointList *user_bps, DMN_TrapChunkList *traps_out)
 {
@@ -3968,6 +4185,7 @@ ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_EvalScope *
   Temp scratch = scratch_begin(&arena, 1);
   DI_Scope *di_scope = eval_scope->di_scope;
   CTRL_EntityCtx *entity_ctx = &ctrl_state->ctrl_thread_entity_store->ctx;
+  CTRL_Entity *process_entity = ctrl_entity_from_handle(entity_ctx, process);
   CTRL_Entity *module_entity = ctrl_entity_from_handle(entity_ctx, module);
   CTRL_Entity *debug_info_path_entity = ctrl_entity_child_from_kind(module_entity, CTRL_EntityKind_DebugInfoPath);
   DI_Key dbgi_key = {debug_info_path_entity->string, debug_info_path_entity->timestamp};
@@ -4027,6 +4245,7 @@ ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_EvalScope *
           {
             U64 vaddr = voffs[i] + base_vaddr;
             DMN_Trap trap = {process.dmn_handle, vaddr, (U64)bp};
+            trap.condition = ctrl_thread__dmn_condition_from_user_bp(arena, eval_scope, process_entity, vaddr, bp);
             dmn_trap_chunk_list_push(arena, traps_out, 256, &trap);
           }
         }
@@ -4042,6 +4261,7 @@ ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_EvalScope *
           DMN_Trap trap = {process.dmn_handle, value.u64, (U64)bp};
           trap.flags = ctrl_dmn_trap_flags_from_user_breakpoint_flags(bp->flags);
           trap.size = bp->size;
+          trap.condition = ctrl_thread__dmn_condition_from_user_bp(arena, eval_scope, process_entity, value.u64, bp);
           dmn_trap_chunk_list_push(arena, traps_out, 256, &trap);
         }
       }break;
@@ -4054,6 +4274,8 @@ ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_EvalScope *
 internal void
 ctrl_thread__append_resolved_process_user_bp_traps(Arena *arena, CTRL_EvalScope *eval_scope, CTRL_Handle process, CTRL_UserBreakpointList *user_bps, DMN_TrapChunkList *traps_out)
 {
+  CTRL_EntityCtx *entity_ctx = &ctrl_state->ctrl_thread_entity_store->ctx;
+  CTRL_Entity *process_entity = ctrl_entity_from_handle(entity_ctx, process);
   for(CTRL_UserBreakpointNode *n = user_bps->first; n != 0; n = n->next)
   {
     CTRL_UserBreakpoint *bp = &n->v;
@@ -4066,6 +4288,7 @@ ctrl_thread__append_resolved_process_user_bp_traps(Arena *arena, CTRL_EvalScope
         DMN_Trap trap = {process.dmn_handle, value.u64, (U64)bp};
         trap.flags = ctrl_dmn_trap_flags_from_user_breakpoint_flags(bp->flags);
         trap.size = bp->size;
+        trap.condition = ctrl_thread__dmn_condition_from_user_bp(arena, eval_scope, process_entity, value.u64, bp);
         dmn_trap_chunk_list_push(arena, traps_out, 256, &trap);
       }
     }
@@ -6752,6 +6975,25 @@ ctrl_thread__run(DMN_CtrlCtx *ctrl_ctx, CTRL_Msg *msg)
     }
   }
   
+  //////////////////////////////
+  //- warm scope lookup cache for the stop location (all frontend
+  // call stack / locals queries for this stop will begin here)
+  //
+  if(stop_event != 0)
+  {
+    DI_Scope *di_scope = di_scope_open();
+    CTRL_Entity *process = ctrl_entity_from_handle(entity_ctx, ctrl_handle_make(CTRL_MachineID_Local, stop_event->process));
+    CTRL_Entity *module = ctrl_module_from_process_vaddr(process, stop_event->instruction_pointer);
+    DI_Key dbgi_key = ctrl_dbgi_key_from_module(module);
+    RDI_Parsed *rdi = di_rdi_from_key(di_scope, &dbgi_key, 1, 0);
+    if(rdi != &rdi_parsed_nil)
+    {
+      U64 rip_voff = ctrl_voff_from_vaddr(module, stop_event->instruction_pointer);
+      di_scope_lookup_from_rdi_voff(rdi, rip_voff);
+    }
+    di_scope_close(di_scope);
+  }
+  
   //////////////////////////////
   //- rjf: record stop
   //
@@ -384,7 +384,8 @@ CTRL_MsgKind;
 typedef U32 CTRL_RunFlags;
 enum
 {
-  CTRL_RunFlag_StopOnEntryPoint = (1<<0),
+  CTRL_RunFlag_StopOnEntryPoint    = (1<<0),
+  CTRL_RunFlag_InTargetConditions = (1<<1), // let the demon evaluate simple conditions inside the target
 };
 
 typedef struct CTRL_Msg CTRL_Msg;
@@ -891,6 +892,7 @@ struct CTRL_State
   RWMutex ctrl_thread_entity_ctx_rw_mutex;
   CTRL_EntityCtxRWStore *ctrl_thread_entity_store;
   E_Cache *ctrl_thread_eval_cache;
+  E_Cache *ctrl_thread_cond_eval_cache;
   Arena *ctrl_thread_msg_process_arena;
   Arena *dmn_event_arena;
   DMN_EventNode *first_dmn_event_node;
@@ -899,6 +901,7 @@ struct CTRL_State
   Arena *user_entry_point_arena;
   String8List user_entry_points;
   U64 exception_code_filters[(CTRL_ExceptionCodeKind_COUNT+63)/64];
+  B32 in_target_conditions;
   U64 process_counter;
   Arena *dbg_dir_arena;
   CTRL_DbgDirNode *dbg_dir_root;
@@ -1195,6 +1198,8 @@ internal CTRL_EventList ctrl_c2u_pop_events(Arena *arena);
 internal void ctrl_thread__entry_point(void *p);
 
 //- rjf: breakpoint resolution
+internal B32 ctrl_thread__append_dmn_condition_bytecode(Arena *arena, String8List *out, String8 bytecode, CTRL_Entity *process, CTRL_Entity *module, RDI_Parsed *rdi, U64 voff, B32 allow_frame_off);
+internal String8 ctrl_thread__dmn_condition_from_user_bp(Arena *arena, CTRL_EvalScope *eval_scope, CTRL_Entity *process, U64 vaddr, CTRL_UserBreakpoint *bp);
 internal void ctrl_thread__append_resolved_module_user_bp_traps(Arena *arena, CTRL_EvalScope *eval_scope, CTRL_Handle process, CTRL_Handle module, CTRL_UserBreakpointList *user_bps, DMN_TrapChunkList *traps_out);
 internal void ctrl_thread__append_resolved_process_user_bp_traps(Arena *arena, CTRL_EvalScope *eval_scope, CTRL_Handle process, CTRL_UserBreakpointList *user_bps, DMN_TrapChunkList *traps_out);
 internal void ctrl_thread__append_program_defined_bp_traps(Arena *arena, CTRL_Entity *bp, DMN_TrapChunkList *traps_out);
@@ -749,11 +749,12 @@ d_lines_from_dbgi_key_voff(Arena *arena, DI_Key *dbgi_key, U64 voff)
     RDI_LineTable *unit_line_table = rdi_line_table_from_unit(rdi, unit);
     rdi_parsed_from_line_table(rdi, unit_line_table, &start_line_table.parsed_line_table);
     LineTableNode *top_line_table = 0;
-    RDI_Scope *scope = rdi_scope_from_voff(rdi, voff);
+    DI_ScopeLookup scope_lookup = di_scope_lookup_from_rdi_voff(rdi, voff);
     {
-      for(RDI_Scope *s = scope;
-          s->inline_site_idx != 0;
-          s = rdi_element_from_name_idx(rdi, Scopes, s->parent_scope_idx))
+      RDI_Scope *s = scope_lookup.scope;
+      for(U64 inline_idx = 0;
+          inline_idx < scope_lookup.inline_depth;
+          inline_idx += 1, s = rdi_element_from_name_idx(rdi, Scopes, s->parent_scope_idx))
       {
         RDI_InlineSite *inline_site = rdi_element_from_name_idx(rdi, InlineSites, s->inline_site_idx);
         if(inline_site->line_table_idx != 0)
@@ -1446,7 +1447,7 @@ d_init(void)
 }
 
 internal D_EventList
-d_tick(Arena *arena, D_TargetArray *targets, D_BreakpointArray *breakpoints, D_PathMapArray *path_maps, U64 exception_code_filters[(CTRL_ExceptionCodeKind_COUNT+63)/64])
+d_tick(Arena *arena, D_TargetArray *targets, D_BreakpointArray *breakpoints, D_PathMapArray *path_maps, U64 exception_code_filters[(CTRL_ExceptionCodeKind_COUNT+63)/64], CTRL_RunFlags settings_run_flags)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(&arena, 1);
@@ -2099,7 +2100,7 @@ d_tick(Arena *arena, D_TargetArray *targets, D_BreakpointArray *breakpoints, D_P
         {
           CTRL_Entity *process = ctrl_entity_ancestor_from_kind(run_thread, CTRL_EntityKind_Process);
           msg->kind = (run_kind == D_RunKind_Run || run_kind == D_RunKind_Step) ? CTRL_MsgKind_Run : CTRL_MsgKind_SingleStep;
-          msg->run_flags  = run_flags;
+          msg->run_flags  = run_flags|settings_run_flags;
           msg->entity     = run_thread->handle;
           msg->parent     = process->handle;
           MemoryCopyArray(msg->exception_code_filters, exception_code_filters);
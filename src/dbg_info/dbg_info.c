@@ -560,6 +560,8 @@ di_close(DI_Key *key)
             {
               arena_release(node->arena);
             }
+            di_scope_cache_release(node->scope_cache);
+            node->scope_cache = 0;
             DLLRemove(slot->first, slot->last, node);
             SLLStackPush(stripe->free_node, node);
             break;
@@ -649,6 +651,103 @@ di_rdi_from_key(DI_Scope *scope, DI_Key *key, B32 high_priority, U64 endt_us)
   return result;
 }
 
+////////////////////////////////
+//~ Scope Lookup Cache
+
+//- cache allocation
+
+internal DI_ScopeCache *
+di_scope_cache_alloc(RDI_Parsed *rdi)
+{
+  Arena *arena = arena_alloc();
+  DI_ScopeCache *cache = push_array(arena, DI_ScopeCache, 1);
+  cache->arena = arena;
+  U64 scopes_count = 0;
+  rdi_table_from_name(rdi, Scopes, &scopes_count);
+  cache->entries_count = u64_up_to_pow2(Clamp(256, scopes_count/4, 16384));
+  cache->entries = push_array(arena, DI_ScopeCacheEntry, cache->entries_count);
+  return cache;
+}
+
+internal void
+di_scope_cache_release(DI_ScopeCache *cache)
+{
+  if(cache != 0)
+  {
+    arena_release(cache->arena);
+  }
+}
+
+//- lookups
+
+internal DI_ScopeLookup
+di_scope_lookup_from_rdi_voff(RDI_Parsed *rdi, U64 voff)
+{
+  DI_ScopeLookup result = {0};
+  DI_ScopeCache *cache = 0;
+  if(rdi != &rdi_parsed_nil)
+  {
+    DI_Node *node = CastFromMember(DI_Node, rdi, rdi);
+    cache = node->scope_cache;
+  }
+  
+  //- voff -> cache entry
+  DI_ScopeCacheEntry *entry = 0;
+  if(cache != 0)
+  {
+    U64 hash = u64_hash_from_str8(str8_struct(&voff));
+    entry = &cache->entries[hash&(cache->entries_count-1)];
+  }
+  
+  //- try cached result (seqlock read - retry-free; a torn read is a miss)
+  B32 hit = 0;
+  if(entry != 0)
+  {
+    U64 seq_before = ins_atomic_u64_eval(&entry->seq);
+    U64 voff_plus_one = ins_atomic_u64_eval(&entry->voff_plus_one);
+    U64 packed = ins_atomic_u64_eval(&entry->scope_idx_and_inline_depth);
+    U64 seq_after = ins_atomic_u64_eval(&entry->seq);
+    U32 scope_idx = (U32)packed;
+    U32 inline_depth = (U32)(packed >> 32);
+    if(seq_before == seq_after && !(seq_before & 1) && voff_plus_one == voff+1)
+    {
+      hit = 1;
+      result.scope = rdi_element_from_name_idx(rdi, Scopes, scope_idx);
+      result.procedure = rdi_procedure_from_scope(rdi, result.scope);
+      result.inline_depth = inline_depth;
+    }
+  }
+  
+  //- miss -> compute via scope vmap & walk up inline sites
+  if(!hit)
+  {
+    U32 scope_idx = rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_ScopeVMap, voff);
+    result.scope = rdi_element_from_name_idx(rdi, Scopes, scope_idx);
+    result.procedure = rdi_procedure_from_scope(rdi, result.scope);
+    for(RDI_Scope *s = result.scope;
+        s->inline_site_idx != 0;
+        s = rdi_element_from_name_idx(rdi, Scopes, s->parent_scope_idx))
+    {
+      result.inline_depth += 1;
+    }
+    if(cache != 0)
+    {
+      // fill entry, unless another writer holds it. the interlocked
+      // stores are full barriers, so readers never see new data with an
+      // old even `seq`.
+      U64 seq = ins_atomic_u64_eval(&entry->seq);
+      if(!(seq & 1) && ins_atomic_u64_eval_cond_assign(&entry->seq, seq+1, seq) == seq)
+      {
+        ins_atomic_u64_eval_assign(&entry->voff_plus_one, voff+1);
+        ins_atomic_u64_eval_assign(&entry->scope_idx_and_inline_depth, (U64)scope_idx | ((U64)result.inline_depth << 32));
+        ins_atomic_u64_eval_assign(&entry->seq, seq+2);
+      }
+    }
+  }
+  
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Search Cache Lookups
 
@@ -1108,6 +1207,11 @@ ASYNC_WORK_DEF(di_parse_work)
     }
   }
   
+  ////////////////////////////
+  //- build scope lookup cache
+  //
+  DI_ScopeCache *scope_cache = di_scope_cache_alloc(&rdi_parsed);
+  
   ////////////////////////////
   //- rjf: commit parsed info to cache
   //
@@ -1123,6 +1227,7 @@ ASYNC_WORK_DEF(di_parse_work)
       node->file_props = file_props;
       node->arena = rdi_parsed_arena;
       node->rdi = rdi_parsed;
+      node->scope_cache = scope_cache;
       node->parse_done = 1;
     }
     else
@@ -1131,6 +1236,7 @@ ASYNC_WORK_DEF(di_parse_work)
       {
         arena_release(rdi_parsed_arena);
       }
+      di_scope_cache_release(scope_cache);
       os_file_map_view_close(file_map, file_base, r1u64(0, file_props.size));
       os_file_map_close(file_map);
       os_file_close(file);
@@ -71,6 +71,35 @@ struct DI_EventList
   U64 count;
 };
 
+////////////////////////////////
+//~ Scope Lookup Cache Types
+
+typedef struct DI_ScopeCacheEntry DI_ScopeCacheEntry;
+struct DI_ScopeCacheEntry
+{
+  // NOTE: seqlock; `seq` is odd while an entry is being written. all fields
+  // are accessed with ins_atomic_* only, so reads are ordered against `seq`.
+  U64 seq;
+  U64 voff_plus_one;
+  U64 scope_idx_and_inline_depth; // scope_idx | inline_depth<<32
+};
+
+typedef struct DI_ScopeCache DI_ScopeCache;
+struct DI_ScopeCache
+{
+  Arena *arena;
+  U64 entries_count;
+  DI_ScopeCacheEntry *entries;
+};
+
+typedef struct DI_ScopeLookup DI_ScopeLookup;
+struct DI_ScopeLookup
+{
+  RDI_Scope *scope;
+  RDI_Procedure *procedure;
+  U64 inline_depth;
+};
+
 ////////////////////////////////
 //~ rjf: Debug Info Cache Types
 
@@ -106,6 +135,9 @@ struct DI_Node
   Arena *arena;
   RDI_Parsed rdi;
   B32 parse_done;
+  
+  // voff -> scope lookup acceleration
+  DI_ScopeCache *scope_cache;
 };
 
 typedef struct DI_Slot DI_Slot;
@@ -450,6 +482,16 @@ internal void di_close(DI_Key *key);
 
 internal RDI_Parsed *di_rdi_from_key(DI_Scope *scope, DI_Key *key, B32 high_priority, U64 endt_us);
 
+////////////////////////////////
+//~ Scope Lookup Cache
+
+//- cache allocation
+internal DI_ScopeCache *di_scope_cache_alloc(RDI_Parsed *rdi);
+internal void di_scope_cache_release(DI_ScopeCache *cache);
+
+//- lookups (`rdi` must be obtained via `di_rdi_from_key`)
+internal DI_ScopeLookup di_scope_lookup_from_rdi_voff(RDI_Parsed *rdi, U64 voff);
+
 ////////////////////////////////
 //~ rjf: Search Cache Lookups
 
@@ -116,6 +116,12 @@ struct DMN_Trap
   U64 id;
   DMN_TrapFlags flags;
   U32 size;
+  
+  // optional condition (RDI_EvalOp bytecode) for software traps. backends
+  // may evaluate simple conditions inside the target, and only stop when it is
+  // nonzero - they are free to ignore it and always stop, so the condition must
+  // still be checked by the usage code when the trap is hit.
+  String8 condition;
 };
 
 typedef struct DMN_TrapChunkNode DMN_TrapChunkNode;
@@ -437,6 +437,76 @@ dmn_lnx_module_info_list_from_process(Arena *arena, DMN_LNX_Entity *process)
   return list;
 }
 
+//- pid * vaddr => containing mapping
+
+internal DMN_LNX_Mapping
+dmn_lnx_mapping_from_vaddr(pid_t pid, U64 vaddr)
+{
+  Temp scratch = scratch_begin(0, 0);
+  DMN_LNX_Mapping result = {0};
+  
+  // read maps (procfs reports zero sizes, so read until eof)
+  String8List chunks = {0};
+  String8 maps_path = push_str8f(scratch.arena, "/proc/%d/maps", pid);
+  int maps_fd = open((char*)maps_path.str, O_RDONLY);
+  if(maps_fd >= 0)
+  {
+    for(;;)
+    {
+      U64 chunk_size = KB(16);
+      U8 *chunk = push_array_no_zero(scratch.arena, U8, chunk_size);
+      ssize_t read_size = read(maps_fd, chunk, chunk_size);
+      if(read_size <= 0)
+      {
+        break;
+      }
+      str8_list_push(scratch.arena, &chunks, str8(chunk, (U64)read_size));
+    }
+    close(maps_fd);
+  }
+  String8 maps = str8_list_join(scratch.arena, &chunks, 0);
+  
+  // find mapping - lines look like "start-end perms offset dev inode path"
+  U8 line_splits[] = {'\n'};
+  String8List lines = str8_split(scratch.arena, maps, line_splits, ArrayCount(line_splits), 0);
+  for(String8Node *n = lines.first; n != 0; n = n->next)
+  {
+    U8 field_splits[] = {' ', '-'};
+    String8List fields = str8_split(scratch.arena, n->string, field_splits, ArrayCount(field_splits), 0);
+    if(fields.node_count >= 3)
+    {
+      U64 min = u64_from_str8(fields.first->string, 16);
+      U64 max = u64_from_str8(fields.first->next->string, 16);
+      if(min <= vaddr && vaddr < max)
+      {
+        result.vaddr_range = r1u64(min, max);
+        String8 perms = fields.first->next->next->string;
+        if(perms.size >= 3)
+        {
+          if(perms.str[0] == 'r') { result.prot |= PROT_READ; }
+          if(perms.str[1] == 'w') { result.prot |= PROT_WRITE; }
+          if(perms.str[2] == 'x') { result.prot |= PROT_EXEC; }
+        }
+        String8 path = fields.last->string;
+        result.is_kernel_named = (str8_match(str8_prefix(path, 1), str8_lit("["), 0) && !str8_match(path, str8_lit("[heap]"), 0));
+        break;
+      }
+    }
+  }
+  
+  scratch_end(scratch);
+  return result;
+}
+
+//- pid * vaddr => protection flags of the containing mapping
+
+internal int
+dmn_lnx_prot_from_vaddr(pid_t pid, U64 vaddr)
+{
+  DMN_LNX_Mapping mapping = dmn_lnx_mapping_from_vaddr(pid, vaddr);
+  return mapping.prot;
+}
+
 ////////////////////////////////
 //~ rjf: Entity Functions
 
@@ -479,6 +549,13 @@ dmn_lnx_entity_release(DMN_LNX_Entity *entity)
     DMN_LNX_EntityNode *first_task = &start_task;
     for(DMN_LNX_EntityNode *t = first_task; t != 0; t = t->next)
     {
+      if(t->v->cond_arena != 0)
+      {
+        arena_release(t->v->cond_arena);
+        t->v->cond_arena = 0;
+        t->v->first_cond_region = 0;
+        t->v->first_cond_trampoline = 0;
+      }
       SLLStackPush(dmn_lnx_state->free_entity, t->v);
       for(DMN_LNX_Entity *child = t->v->first; child != &dmn_lnx_nil_entity; child = child->next)
       {
@@ -723,7 +800,7 @@ dmn_lnx_thread_read_reg_block(DMN_LNX_Entity *thread, void *reg_block)
           {
             U64 offset = OffsetOf(DMN_LNX_UserX64, u_debugreg[i]);
             errno = 0;
-            int peek_result = ptrace(PTRACE_PEEKUSER, tid, PtrFromInt(offset), 0);
+            long peek_result = ptrace(PTRACE_PEEKUSER, tid, PtrFromInt(offset), 0);
             if(errno == 0)
             {
               dr_d->u64 = (U64)peek_result;
@@ -865,29 +942,1015 @@ dmn_lnx_thread_write_reg_block(DMN_LNX_Entity *thread, void *reg_block)
         // rjf: good finish requires xsave or fxsave
         did_fpr = (xsave_result != -1 || fxsave_result != -1);
       }
-      
-      //- rjf: write debug registers
-      B32 did_dbg = 0;
-      if(did_fpr)
+      
+      //- rjf: write debug registers
+      B32 did_dbg = 0;
+      if(did_fpr)
+      {
+        did_dbg = 1;
+        REGS_Reg64 *dr_s = &src->dr0;
+        for(U32 i = 0; i < 8; i += 1, dr_s += 1)
+        {
+          if(i != 4 && i != 5)
+          {
+            U64 offset = OffsetOf(DMN_LNX_UserX64, u_debugreg[i]);
+            int poke_result = ptrace(PTRACE_POKEUSER, tid, PtrFromInt(offset), dr_s->u64);
+            if(poke_result == -1)
+            {
+              did_dbg = 0;
+            }
+          }
+        }
+      }
+      
+      result = (did_dbg);
+    }break;
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Thread Control Helpers
+
+//- threads that were sent a SIGSTOP at the end of the last run may not
+// have reported it yet, in which case they cannot be ptrace'd - reap the stop
+// early, and stash any other event so the next wait still observes it
+internal void
+dmn_lnx_thread_settle_stop(DMN_LNX_Entity *thread)
+{
+  if(thread->expecting_dummy_sigstop && !thread->has_pending_wait_status)
+  {
+    int status = 0;
+    pid_t wait_id = waitpid((pid_t)thread->id, &status, __WALL);
+    if(wait_id == (pid_t)thread->id)
+    {
+      if(WIFSTOPPED(status) && WSTOPSIG(status) == SIGSTOP)
+      {
+        thread->expecting_dummy_sigstop = 0;
+      }
+      else
+      {
+        thread->has_pending_wait_status = 1;
+        thread->pending_wait_status = status;
+      }
+    }
+  }
+}
+
+internal DMN_LNX_Entity *
+dmn_lnx_stopped_thread_from_process(DMN_LNX_Entity *process)
+{
+  DMN_LNX_Entity *result = &dmn_lnx_nil_entity;
+  for(DMN_LNX_Entity *child = process->first; child != &dmn_lnx_nil_entity; child = child->next)
+  {
+    if(child->kind != DMN_LNX_EntityKind_Thread) {continue;}
+    dmn_lnx_thread_settle_stop(child);
+    if(!child->expecting_dummy_sigstop)
+    {
+      result = child;
+      break;
+    }
+  }
+  return result;
+}
+
+internal B32
+dmn_lnx_thread_single_step(DMN_LNX_Entity *thread)
+{
+  B32 result = 0;
+  pid_t tid = (pid_t)thread->id;
+  if(ptrace(PTRACE_SINGLESTEP, tid, 0, 0) != -1)
+  {
+    int status = 0;
+    pid_t wait_id = waitpid(tid, &status, __WALL);
+    if(wait_id == tid && WIFSTOPPED(status))
+    {
+      result = (WSTOPSIG(status) == SIGTRAP);
+      if(!result)
+      {
+        thread->has_pending_wait_status = 1;
+        thread->pending_wait_status = status;
+      }
+    }
+  }
+  return result;
+}
+
+//- runs a system call inside the target, on a stopped thread, by
+// temporarily planting a `syscall` instruction at its instruction pointer
+internal B32
+dmn_lnx_thread_inject_syscall(DMN_LNX_Entity *thread, U64 syscall_num, U64 *args, U64 args_count, U64 *result_out)
+{
+  B32 result = 0;
+  if(thread->arch == Arch_x64 && args_count <= 6)
+  {
+    DMN_LNX_Entity *process = thread->parent;
+    pid_t tid = (pid_t)thread->id;
+    DMN_LNX_UserRegsX64 regs_og = {0};
+    if(ptrace(PTRACE_GETREGS, tid, 0, &regs_og) != -1)
+    {
+      U8 code_og[2] = {0};
+      U8 code_syscall[2] = {0x0f, 0x05};
+      Rng1U64 code_range = r1u64(regs_og.rip, regs_og.rip+sizeof(code_og));
+      if(dmn_lnx_read(process->fd, code_range, code_og) == sizeof(code_og) &&
+         dmn_lnx_write(process->fd, code_range, code_syscall))
+      {
+        DMN_LNX_UserRegsX64 regs = regs_og;
+        U64 *arg_regs[] = {&regs.rdi, &regs.rsi, &regs.rdx, &regs.r10, &regs.r8, &regs.r9};
+        regs.rax      = syscall_num;
+        regs.orig_rax = (U64)-1;
+        for(U64 idx = 0; idx < args_count; idx += 1)
+        {
+          *arg_regs[idx] = args[idx];
+        }
+        if(ptrace(PTRACE_SETREGS, tid, 0, &regs) != -1 && dmn_lnx_thread_single_step(thread))
+        {
+          DMN_LNX_UserRegsX64 regs_after = {0};
+          if(ptrace(PTRACE_GETREGS, tid, 0, &regs_after) != -1)
+          {
+            if(result_out != 0)
+            {
+              *result_out = regs_after.rax;
+            }
+            result = 1;
+          }
+        }
+        dmn_lnx_write(process->fd, code_range, code_og);
+        ptrace(PTRACE_SETREGS, tid, 0, &regs_og);
+      }
+    }
+  }
+  return result;
+}
+
+internal B32
+dmn_lnx_thread_inject_mprotect(DMN_LNX_Entity *thread, U64 vaddr, U64 size, int prot)
+{
+  U64 args[] = {vaddr, size, (U64)prot};
+  U64 syscall_result = (U64)-1;
+  B32 result = (dmn_lnx_thread_inject_syscall(thread, DMN_LNX_X64_SYSCALL_MPROTECT, args, ArrayCount(args), &syscall_result) &&
+                syscall_result == 0);
+  return result;
+}
+
+////////////////////////////////
+//~ Data Breakpoint Functions
+
+internal U64
+dmn_lnx_dr7_from_traps(DMN_Trap **traps, U64 traps_count)
+{
+  U64 dr7 = 0;
+  for(U64 slot_idx = 0; slot_idx < traps_count && slot_idx < DMN_LNX_HW_WATCH_SLOT_COUNT; slot_idx += 1)
+  {
+    DMN_Trap *trap = traps[slot_idx];
+    if(trap == 0) {continue;}
+    
+    // local enable
+    dr7 |= (1ull << (slot_idx*2));
+    
+    // condition (R/W) bits - 00 execute, 01 write, 11 read/write
+    U64 rw = 0;
+    if(trap->flags & DMN_TrapFlag_BreakOnRead)       { rw = 3; }
+    else if(trap->flags & DMN_TrapFlag_BreakOnWrite) { rw = 1; }
+    
+    // length bits - 00 1 byte, 01 2 bytes, 11 4 bytes, 10 8 bytes; must be 00 for execute
+    U64 len = 0;
+    if(rw != 0) switch(trap->size)
+    {
+      default:{}break;
+      case 2:{len = 1;}break;
+      case 4:{len = 3;}break;
+      case 8:{len = 2;}break;
+    }
+    
+    dr7 |= (rw  << (16 + slot_idx*4));
+    dr7 |= (len << (18 + slot_idx*4));
+  }
+  return dr7;
+}
+
+internal void
+dmn_lnx_thread_sync_debug_regs(DMN_LNX_Entity *thread, U64 *dr_vaddr, U64 dr7)
+{
+  B32 is_synced = (thread->dr_is_synced && thread->dr7 == dr7);
+  for(U64 slot_idx = 0; is_synced && slot_idx < DMN_LNX_HW_WATCH_SLOT_COUNT; slot_idx += 1)
+  {
+    is_synced = (thread->dr_vaddr[slot_idx] == dr_vaddr[slot_idx]);
+  }
+  if(!is_synced && thread->arch == Arch_x64)
+  {
+    dmn_lnx_thread_settle_stop(thread);
+    pid_t tid = (pid_t)thread->id;
+    
+    // the kernel validates each debug register write against dr7, so
+    // disable all slots first, then write addresses, then enable
+    B32 good = 1;
+    U64 dr7_offset = OffsetOf(DMN_LNX_UserX64, u_debugreg[7]);
+    good = good && (ptrace(PTRACE_POKEUSER, tid, PtrFromInt(dr7_offset), 0) != -1);
+    for(U64 slot_idx = 0; good && slot_idx < DMN_LNX_HW_WATCH_SLOT_COUNT; slot_idx += 1)
+    {
+      U64 offset = OffsetOf(DMN_LNX_UserX64, u_debugreg[slot_idx]);
+      good = good && (ptrace(PTRACE_POKEUSER, tid, PtrFromInt(offset), dr_vaddr[slot_idx]) != -1);
+    }
+    good = good && (ptrace(PTRACE_POKEUSER, tid, PtrFromInt(dr7_offset), dr7) != -1);
+    
+    // record state - if the write failed, retry on the next run
+    thread->dr_is_synced = good;
+    thread->dr7 = dr7;
+    MemoryCopy(thread->dr_vaddr, dr_vaddr, sizeof(thread->dr_vaddr));
+  }
+}
+
+internal DMN_LNX_WatchTask *
+dmn_lnx_watch_task_from_process(DMN_LNX_WatchTask *first_task, DMN_LNX_Entity *process)
+{
+  DMN_LNX_WatchTask *result = 0;
+  for(DMN_LNX_WatchTask *t = first_task; t != 0; t = t->next)
+  {
+    if(t->process == process)
+    {
+      result = t;
+      break;
+    }
+  }
+  return result;
+}
+
+internal B32
+dmn_lnx_page_is_guardable(DMN_LNX_Mapping *mapping, U64 page, Rng1U64 *unguardable_ranges, U64 unguardable_range_count)
+{
+  B32 result = (mapping->vaddr_range.min <= page && page < mapping->vaddr_range.max &&
+                !(mapping->prot & PROT_EXEC) &&
+                !mapping->is_kernel_named);
+  for(U64 range_idx = 0; result && range_idx < unguardable_range_count; range_idx += 1)
+  {
+    result = !contains_1u64(unguardable_ranges[range_idx], page);
+  }
+  return result;
+}
+
+internal void
+dmn_lnx_watch_task_apply_page_guards(DMN_LNX_WatchTask *task, B32 apply)
+{
+  if(task->first_guard != 0)
+  {
+    DMN_LNX_Entity *thread = dmn_lnx_stopped_thread_from_process(task->process);
+    U64 page_size = os_get_system_info()->page_size;
+    for(DMN_LNX_PageGuard *g = task->first_guard; g != 0; g = g->next)
+    {
+      dmn_lnx_thread_inject_mprotect(thread, g->vaddr, page_size, apply ? g->prot_guard : g->prot_og);
+    }
+  }
+}
+
+internal DMN_Trap *
+dmn_lnx_page_guard_trap_from_vaddr(DMN_LNX_WatchTask *task, U64 vaddr, DMN_LNX_PageGuard **guard_out)
+{
+  DMN_Trap *result = 0;
+  
+  // find guard
+  U64 page_size = os_get_system_info()->page_size;
+  DMN_LNX_PageGuard *guard = 0;
+  for(DMN_LNX_PageGuard *g = task->first_guard; g != 0; g = g->next)
+  {
+    if(g->vaddr <= vaddr && vaddr < g->vaddr + page_size)
+    {
+      guard = g;
+      break;
+    }
+  }
+  
+  // find trap
+  // NOTE: the faulting address is the first byte of the access, and the
+  // access kind is not reported - so this is exact for accesses starting inside
+  // the watched range, and reads hit write-only watches which share a page with
+  // read watches.
+  if(guard != 0)
+  {
+    for(DMN_TrapChunkNode *n = task->sw_traps.first; n != 0 && result == 0; n = n->next)
+    {
+      for(U64 n_idx = 0; n_idx < n->count; n_idx += 1)
+      {
+        DMN_Trap *trap = &n->v[n_idx];
+        if(trap->vaddr <= vaddr && vaddr < trap->vaddr + Max(trap->size, 1))
+        {
+          result = trap;
+          break;
+        }
+      }
+    }
+  }
+  
+  if(guard_out != 0)
+  {
+    *guard_out = guard;
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Conditional Breakpoint Functions
+
+//- x64 code building
+
+internal void
+dmn_lnx_x64_code_push(DMN_LNX_X64Code *code, void *bytes, U64 size)
+{
+  if(code->size + size <= code->cap)
+  {
+    MemoryCopy(code->v + code->size, bytes, size);
+    code->size += size;
+  }
+  else
+  {
+    code->overflowed = 1;
+  }
+}
+
+internal void
+dmn_lnx_x64_code_patch_rel32(DMN_LNX_X64Code *code, U64 rel32_off, U64 dst_off)
+{
+  if(rel32_off + sizeof(S32) <= code->size)
+  {
+    S32 rel32 = (S32)((S64)dst_off - (S64)(rel32_off + sizeof(S32)));
+    MemoryCopy(code->v + rel32_off, &rel32, sizeof(rel32));
+  }
+}
+
+//- trampoline pieces
+
+internal void
+dmn_lnx_x64_code_push_state_save(DMN_LNX_X64Code *code)
+{
+  // step over the red zone, save flags & all general purpose registers
+  // but rsp, in encoding order - rbx then points at the saved registers
+  dmn_lnx_x64_code_pushb(code, 0x48, 0x8D, 0x64, 0x24, 0x80);  // lea rsp, [rsp-128]
+  dmn_lnx_x64_code_pushb(code, 0x9C);                          // pushfq
+  for(U8 regnum = 0; regnum < 16; regnum += 1)
+  {
+    if(regnum == 4) {continue;}
+    if(regnum < 8) { dmn_lnx_x64_code_pushb(code, 0x50 + regnum); }             // push r
+    else           { dmn_lnx_x64_code_pushb(code, 0x41, 0x50 + (regnum - 8)); } // push r8-r15
+  }
+  dmn_lnx_x64_code_pushb(code, 0x48, 0x89, 0xE3);              // mov rbx, rsp
+}
+
+internal void
+dmn_lnx_x64_code_push_state_restore(DMN_LNX_X64Code *code)
+{
+  for(U8 regnum = 16; regnum > 0; regnum -= 1)
+  {
+    if(regnum-1 == 4) {continue;}
+    if(regnum-1 < 8) { dmn_lnx_x64_code_pushb(code, 0x58 + (regnum-1)); }             // pop r
+    else             { dmn_lnx_x64_code_pushb(code, 0x41, 0x58 + (regnum-1 - 8)); }   // pop r8-r15
+  }
+  dmn_lnx_x64_code_pushb(code, 0x9D);                                      // popfq
+  dmn_lnx_x64_code_pushb(code, 0x48, 0x8D, 0xA4, 0x24, 0x80, 0x00, 0x00, 0x00); // lea rsp, [rsp+128]
+}
+
+internal B32
+dmn_lnx_x64_code_push_condition(DMN_LNX_X64Code *code, DMN_LNX_Entity *process, U64 site_vaddr, String8 condition, U64 *hit_patch_offs, U64 *hit_patch_count_out)
+{
+  B32 result = 1;
+  DMN_LNX_CondValue stack[DMN_LNX_COND_STACK_MAX] = {0};
+  U64 stack_count = 0;
+  U64 hit_patch_count = 0;
+  U8 *ptr = condition.str;
+  U8 *opl = condition.str + condition.size;
+  for(U64 op_count = 0; ptr < opl && result; op_count += 1)
+  {
+    //- decode
+    U8 op = ptr[0];
+    if(op >= RDI_EvalOp_COUNT || op_count >= DMN_LNX_COND_OP_MAX)
+    {
+      result = 0;
+      break;
+    }
+    U16 ctrlbits = rdi_eval_op_ctrlbits_table[op];
+    U64 decode_size = RDI_DECODEN_FROM_CTRLBITS(ctrlbits);
+    U64 pop_count = RDI_POPN_FROM_CTRLBITS(ctrlbits);
+    U64 push_count = RDI_PUSHN_FROM_CTRLBITS(ctrlbits);
+    if(ptr + 1 + decode_size > opl || decode_size > sizeof(U64) ||
+       pop_count > stack_count || stack_count - pop_count + push_count > DMN_LNX_COND_STACK_MAX)
+    {
+      result = 0;
+      break;
+    }
+    U64 imm = 0;
+    MemoryCopy(&imm, ptr + 1, decode_size);
+    ptr += 1 + decode_size;
+    B32 imm_is_int_group = (imm == RDI_EvalTypeGroup_U || imm == RDI_EvalTypeGroup_S);
+    
+    //- pop operands - rax <- first operand, rcx <- second operand
+    stack_count -= pop_count;
+    DMN_LNX_CondValue *svals = stack + stack_count;
+    if(pop_count == 2)
+    {
+      dmn_lnx_x64_code_pushb(code, 0x59);                 // pop rcx
+      dmn_lnx_x64_code_pushb(code, 0x58);                 // pop rax
+    }
+    else if(pop_count == 1)
+    {
+      dmn_lnx_x64_code_pushb(code, 0x58);                 // pop rax
+    }
+    
+    //- op => code, mirroring e_interpret's semantics for 64-bit values
+    DMN_LNX_CondValue nval = {DMN_LNX_CondValueKind_Other};
+    switch(op)
+    {
+      default:
+      {
+        result = 0;
+      }break;
+      
+      case RDI_EvalOp_Stop:
+      {
+        ptr = opl;
+      }break;
+      
+      case RDI_EvalOp_Noop:
+      {
+      }break;
+      
+      case RDI_EvalOp_ConstU8:
+      case RDI_EvalOp_ConstU16:
+      case RDI_EvalOp_ConstU32:
+      case RDI_EvalOp_ConstU64:
+      {
+        nval.kind = DMN_LNX_CondValueKind_Const;
+        nval.u64  = imm;
+        dmn_lnx_x64_code_pushb(code, 0x48, 0xB8);           // mov rax, imm64
+        dmn_lnx_x64_code_push_struct(code, &imm);
+      }break;
+      
+      case RDI_EvalOp_RegRead:
+      {
+        U8 rdi_reg_code = (imm&0x0000FF)>>0;
+        U8 byte_size    = (imm&0x00FF00)>>8;
+        U8 byte_off     = (imm&0xFF0000)>>16;
+        if(byte_size == 0 || byte_off + byte_size > 8)
+        {
+          result = 0;
+          break;
+        }
+        
+        // saved general purpose registers; rdi codes for rax-r15 follow encoding order
+        if(RDI_RegCodeX64_rax <= rdi_reg_code && rdi_reg_code <= RDI_RegCodeX64_r15 && rdi_reg_code != RDI_RegCodeX64_rsp)
+        {
+          U32 regnum = rdi_reg_code - RDI_RegCodeX64_rax;
+          U32 push_idx = (regnum < 4 ? regnum : regnum - 1);
+          U32 disp = 8*(14 - push_idx);
+          dmn_lnx_x64_code_pushb(code, 0x48, 0x8B, 0x83);   // mov rax, [rbx+disp32]
+          dmn_lnx_x64_code_push_struct(code, &disp);
+        }
+        
+        // stack pointer, as of the trap address
+        else if(rdi_reg_code == RDI_RegCodeX64_rsp)
+        {
+          U32 disp = 8*16 + DMN_LNX_X64_RED_ZONE_SIZE;
+          dmn_lnx_x64_code_pushb(code, 0x48, 0x8D, 0x83);   // lea rax, [rbx+disp32]
+          dmn_lnx_x64_code_push_struct(code, &disp);
+          nval.kind = DMN_LNX_CondValueKind_Frame;
+          nval.u64  = 0;
+        }
+        
+        // flags
+        else if(rdi_reg_code == RDI_RegCodeX64_rflags)
+        {
+          U32 disp = 8*15;
+          dmn_lnx_x64_code_pushb(code, 0x48, 0x8B, 0x83);   // mov rax, [rbx+disp32]
+          dmn_lnx_x64_code_push_struct(code, &disp);
+        }
+        
+        // instruction pointer => always the trap address
+        else if(rdi_reg_code == RDI_RegCodeX64_rip)
+        {
+          dmn_lnx_x64_code_pushb(code, 0x48, 0xB8);         // mov rax, imm64
+          dmn_lnx_x64_code_push_struct(code, &site_vaddr);
+          nval.kind = DMN_LNX_CondValueKind_Const;
+          nval.u64  = site_vaddr;
+        }
+        else
+        {
+          result = 0;
+          break;
+        }
+        
+        // sub-register reads
+        if(byte_off != 0 || byte_size != 8)
+        {
+          U64 mask = max_U64 >> (64 - 8*byte_size);
+          if(byte_off != 0)
+          {
+            dmn_lnx_x64_code_pushb(code, 0x48, 0xC1, 0xE8, 8*byte_off); // shr rax, imm8
+          }
+          dmn_lnx_x64_code_pushb(code, 0x48, 0xB9);           // mov rcx, imm64
+          dmn_lnx_x64_code_push_struct(code, &mask);
+          dmn_lnx_x64_code_pushb(code, 0x48, 0x21, 0xC8);     // and rax, rcx
+          nval.kind = (nval.kind == DMN_LNX_CondValueKind_Const ? nval.kind : DMN_LNX_CondValueKind_Other);
+          nval.u64  = (nval.u64 >> (8*byte_off)) & mask;
+        }
+      }break;
+      
+      case RDI_EvalOp_MemRead:
+      {
+        // only read addresses which cannot fault - small offsets from the
+        // stack pointer. constant addresses are not read, as their mappings
+        // may change after the trampoline is emitted. rbp is not trusted as a
+        // frame base, it is not set up before the prologue and is a general
+        // purpose register in code without frame pointers.
+        U64 size = imm;
+        B32 addr_is_safe = 0;
+        if(svals[0].kind == DMN_LNX_CondValueKind_Frame && 0 < size && size <= 8)
+        {
+          S64 off = (S64)svals[0].u64;
+          addr_is_safe = (-DMN_LNX_X64_RED_ZONE_SIZE <= off && off + (S64)size <= DMN_LNX_COND_FRAME_READ_MAX);
+        }
+        if(!addr_is_safe)
+        {
+          result = 0;
+          break;
+        }
+        switch(size)
+        {
+          default:{result = 0;}break;
+          case 1:{dmn_lnx_x64_code_pushb(code, 0x0F, 0xB6, 0x00);}break; // movzx eax, byte [rax]
+          case 2:{dmn_lnx_x64_code_pushb(code, 0x0F, 0xB7, 0x00);}break; // movzx eax, word [rax]
+          case 4:{dmn_lnx_x64_code_pushb(code, 0x8B, 0x00);}break;       // mov eax, [rax]
+          case 8:{dmn_lnx_x64_code_pushb(code, 0x48, 0x8B, 0x00);}break; // mov rax, [rax]
+        }
+      }break;
+      
+      case RDI_EvalOp_Add:
+      case RDI_EvalOp_Sub:
+      {
+        if(!imm_is_int_group)
+        {
+          result = 0;
+          break;
+        }
+        B32 is_add = (op == RDI_EvalOp_Add);
+        dmn_lnx_x64_code_pushb(code, 0x48, is_add ? 0x01 : 0x29, 0xC8); // add/sub rax, rcx
+        DMN_LNX_CondValueKind lhs = svals[0].kind;
+        DMN_LNX_CondValueKind rhs = svals[1].kind;
+        if(lhs == DMN_LNX_CondValueKind_Const && rhs == DMN_LNX_CondValueKind_Const)
+        {
+          nval.kind = DMN_LNX_CondValueKind_Const;
+          nval.u64  = is_add ? svals[0].u64 + svals[1].u64 : svals[0].u64 - svals[1].u64;
+        }
+        else if((lhs == DMN_LNX_CondValueKind_Frame && rhs == DMN_LNX_CondValueKind_Const) ||
+                (lhs == DMN_LNX_CondValueKind_Const && rhs == DMN_LNX_CondValueKind_Frame && is_add))
+        {
+          nval.kind = DMN_LNX_CondValueKind_Frame;
+          nval.u64  = is_add ? svals[0].u64 + svals[1].u64 : svals[0].u64 - svals[1].u64;
+        }
+      }break;
+      
+      case RDI_EvalOp_Mul:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x0F, 0xAF, 0xC1);   // imul rax, rcx
+      }break;
+      
+      case RDI_EvalOp_Div:
+      {
+        // division by zero is an evaluation error, which stops - operands are
+        // still on the stack at that point, the hit path resets it
+        if(!imm_is_int_group || hit_patch_count >= DMN_LNX_COND_OP_MAX) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x85, 0xC9);         // test rcx, rcx
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0x84, 0, 0, 0, 0);   // jz hit
+        hit_patch_offs[hit_patch_count] = code->size - 4;
+        hit_patch_count += 1;
+        dmn_lnx_x64_code_pushb(code, 0x31, 0xD2);               // xor edx, edx
+        dmn_lnx_x64_code_pushb(code, 0x48, 0xF7, 0xF1);         // div rcx
+      }break;
+      
+      case RDI_EvalOp_Mod:
+      {
+        // modulo by zero produces zero
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x85, 0xC9);         // test rcx, rcx
+        dmn_lnx_x64_code_pushb(code, 0x74, 0x0A);               // jz zero
+        dmn_lnx_x64_code_pushb(code, 0x31, 0xD2);               // xor edx, edx
+        dmn_lnx_x64_code_pushb(code, 0x48, 0xF7, 0xF1);         // div rcx
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x89, 0xD0);         // mov rax, rdx
+        dmn_lnx_x64_code_pushb(code, 0xEB, 0x02);               // jmp done
+        dmn_lnx_x64_code_pushb(code, 0x31, 0xC0);               // zero: xor eax, eax
+      }break;
+      
+      case RDI_EvalOp_LShift:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0xD3, 0xE0);         // shl rax, cl
+      }break;
+      
+      case RDI_EvalOp_RShift:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0xD3, imm == RDI_EvalTypeGroup_S ? 0xF8 : 0xE8); // sar/shr rax, cl
+      }break;
+      
+      case RDI_EvalOp_BitAnd:
+      case RDI_EvalOp_BitOr:
+      case RDI_EvalOp_BitXor:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        U8 opcode = (op == RDI_EvalOp_BitAnd ? 0x21 : op == RDI_EvalOp_BitOr ? 0x09 : 0x31);
+        dmn_lnx_x64_code_pushb(code, 0x48, opcode, 0xC8);       // and/or/xor rax, rcx
+      }break;
+      
+      case RDI_EvalOp_BitNot:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0xF7, 0xD0);         // not rax
+      }break;
+      
+      case RDI_EvalOp_Neg:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0xF7, 0xD8);         // neg rax
+      }break;
+      
+      case RDI_EvalOp_Abs:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x85, 0xC0);         // test rax, rax
+        dmn_lnx_x64_code_pushb(code, 0x79, 0x03);               // jns done
+        dmn_lnx_x64_code_pushb(code, 0x48, 0xF7, 0xD8);         // neg rax
+      }break;
+      
+      case RDI_EvalOp_LogAnd:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x85, 0xC0);         // test rax, rax
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0x95, 0xC0);         // setnz al
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x85, 0xC9);         // test rcx, rcx
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0x95, 0xC1);         // setnz cl
+        dmn_lnx_x64_code_pushb(code, 0x20, 0xC8);               // and al, cl
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0xB6, 0xC0);         // movzx eax, al
+      }break;
+      
+      case RDI_EvalOp_LogOr:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x09, 0xC8);         // or rax, rcx
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0x95, 0xC0);         // setnz al
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0xB6, 0xC0);         // movzx eax, al
+      }break;
+      
+      case RDI_EvalOp_LogNot:
+      {
+        if(!imm_is_int_group) { result = 0; break; }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x85, 0xC0);         // test rax, rax
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0x94, 0xC0);         // sete al
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0xB6, 0xC0);         // movzx eax, al
+      }break;
+      
+      case RDI_EvalOp_EqEq:
+      case RDI_EvalOp_NtEq:
+      case RDI_EvalOp_LsEq:
+      case RDI_EvalOp_GrEq:
+      case RDI_EvalOp_Less:
+      case RDI_EvalOp_Grtr:
+      {
+        // equality compares raw bits; ordering needs an integer type group
+        U8 setcc = 0;
+        B32 is_signed = (imm == RDI_EvalTypeGroup_S);
+        switch(op)
+        {
+          case RDI_EvalOp_EqEq:{setcc = 0x94;}break;
+          case RDI_EvalOp_NtEq:{setcc = 0x95;}break;
+          case RDI_EvalOp_LsEq:{setcc = is_signed ? 0x9E : 0x96;}break;
+          case RDI_EvalOp_GrEq:{setcc = is_signed ? 0x9D : 0x93;}break;
+          case RDI_EvalOp_Less:{setcc = is_signed ? 0x9C : 0x92;}break;
+          case RDI_EvalOp_Grtr:{setcc = is_signed ? 0x9F : 0x97;}break;
+        }
+        if(op != RDI_EvalOp_EqEq && op != RDI_EvalOp_NtEq && !imm_is_int_group)
+        {
+          result = 0;
+          break;
+        }
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x39, 0xC8);         // cmp rax, rcx
+        dmn_lnx_x64_code_pushb(code, 0x0F, setcc, 0xC0);        // setcc al
+        dmn_lnx_x64_code_pushb(code, 0x0F, 0xB6, 0xC0);         // movzx eax, al
+      }break;
+      
+      case RDI_EvalOp_Trunc:
+      {
+        if(imm == 0 || imm >= 64)
+        {
+          dmn_lnx_x64_code_pushb(code, 0x31, 0xC0);             // xor eax, eax
+        }
+        else
+        {
+          U64 mask = max_U64 >> (64 - imm);
+          dmn_lnx_x64_code_pushb(code, 0x48, 0xB9);             // mov rcx, imm64
+          dmn_lnx_x64_code_push_struct(code, &mask);
+          dmn_lnx_x64_code_pushb(code, 0x48, 0x21, 0xC8);       // and rax, rcx
+        }
+      }break;
+      
+      case RDI_EvalOp_TruncSigned:
+      {
+        if(imm == 0)
+        {
+          dmn_lnx_x64_code_pushb(code, 0x31, 0xC0);             // xor eax, eax
+        }
+        else if(imm < 32)
+        {
+          dmn_lnx_x64_code_pushb(code, 0x48, 0xC1, 0xE0, (U8)(64 - imm)); // shl rax, imm8
+          dmn_lnx_x64_code_pushb(code, 0x48, 0xC1, 0xF8, (U8)(64 - imm)); // sar rax, imm8
+        }
+        else
+        {
+          result = 0;
+        }
+      }break;
+      
+      case RDI_EvalOp_Pop:
+      {
+      }break;
+    }
+    
+    //- push result
+    if(result && push_count == 1)
+    {
+      dmn_lnx_x64_code_pushb(code, 0x50);                       // push rax
+      stack[stack_count] = nval;
+      stack_count += 1;
+    }
+  }
+  if(stack_count != 1)
+  {
+    result = 0;
+  }
+  *hit_patch_count_out = hit_patch_count;
+  return result;
+}
+
+internal B32
+dmn_lnx_x64_code_push_relocated_inst(DMN_LNX_X64Code *code, U64 code_vaddr, U64 site_vaddr, String8 site_code, U64 *inst_size_out)
+{
+  B32 result = 0;
+  ZydisDecoder decoder = {0};
+  ZydisDecodedInstruction inst = {0};
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT] = {0};
+  if(ZYAN_SUCCESS(ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64)) &&
+     ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, site_code.str, site_code.size, &inst, operands)) &&
+     inst.length >= DMN_LNX_X64_JMP_REL32_SIZE)
+  {
+    U64 inst_vaddr = code_vaddr + code->size;
+    U64 next_vaddr = site_vaddr + inst.length;
+    S64 retarget = (S64)(site_vaddr - inst_vaddr);
+    B32 has_rip_relative_mem = 0;
+    for(U64 idx = 0; idx < inst.operand_count; idx += 1)
+    {
+      if(operands[idx].type == ZYDIS_OPERAND_TYPE_MEMORY && operands[idx].mem.base == ZYDIS_REGISTER_RIP)
+      {
+        has_rip_relative_mem = 1;
+      }
+    }
+    B32 has_relative_imm = (inst.raw.imm[0].is_relative || inst.raw.imm[1].is_relative);
+    
+    //- calls push their own address - only relative calls are emulated
+    // (pushing the original return address), everything else would return
+    // into the trampoline
+    if(inst.mnemonic == ZYDIS_MNEMONIC_CALL)
+    {
+      if(has_relative_imm && inst.raw.imm[0].size == 32)
+      {
+        U64 dst_vaddr = next_vaddr + inst.raw.imm[0].value.s;
+        U32 ret_lo = (U32)(next_vaddr >>  0);
+        U32 ret_hi = (U32)(next_vaddr >> 32);
+        dmn_lnx_x64_code_pushb(code, 0x48, 0x8D, 0x64, 0x24, 0xF8);  // lea rsp, [rsp-8]
+        dmn_lnx_x64_code_pushb(code, 0xC7, 0x04, 0x24);              // mov dword [rsp], imm32
+        dmn_lnx_x64_code_push_struct(code, &ret_lo);
+        dmn_lnx_x64_code_pushb(code, 0xC7, 0x44, 0x24, 0x04);        // mov dword [rsp+4], imm32
+        dmn_lnx_x64_code_push_struct(code, &ret_hi);
+        S64 rel = (S64)(dst_vaddr - (code_vaddr + code->size + DMN_LNX_X64_JMP_REL32_SIZE));
+        if(min_S32 <= rel && rel <= max_S32)
+        {
+          S32 rel32 = (S32)rel;
+          dmn_lnx_x64_code_pushb(code, 0xE9);                        // jmp rel32
+          dmn_lnx_x64_code_push_struct(code, &rel32);
+          result = 1;
+        }
+      }
+    }
+    
+    //- position-independent => copy as-is
+    else if(!(inst.attributes & ZYDIS_ATTRIB_IS_RELATIVE))
+    {
+      dmn_lnx_x64_code_push(code, site_code.str, inst.length);
+      result = 1;
+    }
+    
+    //- rip-relative memory operand, or relative jump => copy, and
+    // retarget the 32-bit displacement / immediate
+    else if((has_rip_relative_mem && !has_relative_imm && inst.raw.disp.size == 32) ||
+            (has_relative_imm && !has_rip_relative_mem && inst.raw.imm[0].is_relative && inst.raw.imm[0].size == 32))
+    {
+      U64 fixup_off = has_rip_relative_mem ? inst.raw.disp.offset : inst.raw.imm[0].offset;
+      S64 fixup     = (has_rip_relative_mem ? inst.raw.disp.value : inst.raw.imm[0].value.s) + retarget;
+      if(min_S32 <= fixup && fixup <= max_S32 && fixup_off + sizeof(S32) <= inst.length)
+      {
+        S32 fixup32 = (S32)fixup;
+        U64 inst_off = code->size;
+        dmn_lnx_x64_code_push(code, site_code.str, inst.length);
+        if(!code->overflowed)
+        {
+          MemoryCopy(code->v + inst_off + fixup_off, &fixup32, sizeof(fixup32));
+        }
+        result = 1;
+      }
+    }
+    
+    if(inst_size_out != 0)
+    {
+      *inst_size_out = inst.length;
+    }
+  }
+  return result;
+}
+
+internal B32
+dmn_lnx_x64_code_push_cond_trampoline(DMN_LNX_X64Code *code, DMN_LNX_Entity *process, U64 code_vaddr, U64 site_vaddr, String8 site_code, String8 condition, U64 *hit_off_out, U64 *inst_size_out)
+{
+  //- save state, evaluate condition
+  U64 hit_patch_offs[DMN_LNX_COND_OP_MAX] = {0};
+  U64 hit_patch_count = 0;
+  dmn_lnx_x64_code_push_state_save(code);
+  B32 condition_is_good = dmn_lnx_x64_code_push_condition(code, process, site_vaddr, condition, hit_patch_offs, &hit_patch_count);
+  dmn_lnx_x64_code_pushb(code, 0x58);                         // pop rax
+  dmn_lnx_x64_code_pushb(code, 0x48, 0x85, 0xC0);             // test rax, rax
+  dmn_lnx_x64_code_pushb(code, 0x0F, 0x84, 0, 0, 0, 0);       // jz no_hit
+  U64 no_hit_patch_off = code->size - 4;
+  
+  //- condition holds => restore state & stop. the thread is moved back
+  // to the trap address by the demon, but falls through to the relocated
+  // instruction if it is resumed here.
+  U64 hit_off = code->size;
+  dmn_lnx_x64_code_pushb(code, 0x48, 0x89, 0xDC);             // mov rsp, rbx
+  dmn_lnx_x64_code_push_state_restore(code);
+  U64 int3_off = code->size;
+  dmn_lnx_x64_code_pushb(code, 0xCC);                         // int3
+  dmn_lnx_x64_code_pushb(code, 0xE9, 0, 0, 0, 0);             // jmp inst
+  U64 inst_patch_off = code->size - 4;
+  
+  //- condition does not hold => restore state
+  U64 no_hit_off = code->size;
+  dmn_lnx_x64_code_push_state_restore(code);
+  
+  //- run relocated instruction, jump back
+  U64 inst_off = code->size;
+  U64 inst_size = 0;
+  B32 inst_is_good = dmn_lnx_x64_code_push_relocated_inst(code, code_vaddr, site_vaddr, site_code, &inst_size);
+  S64 ret_rel = (S64)((site_vaddr + inst_size) - (code_vaddr + code->size + DMN_LNX_X64_JMP_REL32_SIZE));
+  S32 ret_rel32 = (S32)ret_rel;
+  dmn_lnx_x64_code_pushb(code, 0xE9);                         // jmp site+inst_size
+  dmn_lnx_x64_code_push_struct(code, &ret_rel32);
+  
+  //- patch jumps
+  dmn_lnx_x64_code_patch_rel32(code, no_hit_patch_off, no_hit_off);
+  dmn_lnx_x64_code_patch_rel32(code, inst_patch_off, inst_off);
+  for(U64 idx = 0; idx < hit_patch_count; idx += 1)
+  {
+    dmn_lnx_x64_code_patch_rel32(code, hit_patch_offs[idx], hit_off);
+  }
+  
+  B32 result = (condition_is_good && inst_is_good && !code->overflowed &&
+                min_S32 <= ret_rel && ret_rel <= max_S32);
+  *hit_off_out = int3_off;
+  *inst_size_out = inst_size;
+  return result;
+}
+
+//- trampolines
+
+internal U64
+dmn_lnx_cond_region_alloc(DMN_LNX_Entity *process, U64 site_vaddr, U64 size)
+{
+  U64 result = 0;
+  U64 reach = (U64)max_S32 - DMN_LNX_COND_REGION_SIZE;
+  size = AlignPow2(size, 16);
+  
+  //- find existing region within jump range of the site
+  for(DMN_LNX_CondRegion *region = process->first_cond_region; region != 0; region = region->next)
+  {
+    U64 distance = (region->vaddr < site_vaddr ? site_vaddr - region->vaddr : region->vaddr - site_vaddr);
+    if(distance < reach && region->pos + size <= region->size)
+    {
+      result = region->vaddr + region->pos;
+      region->pos += size;
+      break;
+    }
+  }
+  
+  //- none => map a new region inside the target, trying addresses below the
+  // site (where there is usually free space below images), then anywhere
+  if(result == 0 && size <= DMN_LNX_COND_REGION_SIZE)
+  {
+    DMN_LNX_Entity *thread = dmn_lnx_stopped_thread_from_process(process);
+    U64 hint_offs[] = {MB(16), MB(256), GB(1), 0};
+    for EachElement(idx, hint_offs)
+    {
+      U64 hint = 0;
+      if(hint_offs[idx] != 0)
+      {
+        if(site_vaddr < hint_offs[idx] + DMN_LNX_COND_REGION_SIZE) { continue; }
+        hint = AlignDownPow2(site_vaddr - hint_offs[idx], DMN_LNX_COND_REGION_SIZE);
+      }
+      U64 mmap_args[] = {hint, DMN_LNX_COND_REGION_SIZE, PROT_READ|PROT_EXEC, MAP_PRIVATE|MAP_ANONYMOUS, (U64)-1, 0};
+      U64 vaddr = 0;
+      if(thread == &dmn_lnx_nil_entity ||
+         !dmn_lnx_thread_inject_syscall(thread, DMN_LNX_X64_SYSCALL_MMAP, mmap_args, ArrayCount(mmap_args), &vaddr) ||
+         vaddr >= (U64)-4096)
+      {
+        break;
+      }
+      U64 distance = (vaddr < site_vaddr ? site_vaddr - vaddr : vaddr - site_vaddr);
+      if(distance < reach)
+      {
+        DMN_LNX_CondRegion *region = push_array(process->cond_arena, DMN_LNX_CondRegion, 1);
+        SLLStackPush(process->first_cond_region, region);
+        region->vaddr   = vaddr;
+        region->size    = DMN_LNX_COND_REGION_SIZE;
+        region->pos     = size;
+        result = vaddr;
+        break;
+      }
+      U64 munmap_args[] = {vaddr, DMN_LNX_COND_REGION_SIZE};
+      dmn_lnx_thread_inject_syscall(thread, DMN_LNX_X64_SYSCALL_MUNMAP, munmap_args, ArrayCount(munmap_args), 0);
+    }
+  }
+  return result;
+}
+
+internal DMN_LNX_CondTrampoline *
+dmn_lnx_cond_trampoline_from_trap(DMN_Trap *trap)
+{
+  DMN_LNX_CondTrampoline *result = 0;
+  DMN_LNX_Entity *process = dmn_lnx_entity_from_handle(trap->process);
+  if(trap->flags == 0 && trap->condition.size != 0 &&
+     process->kind == DMN_LNX_EntityKind_Process && process->arch == Arch_x64)
+  {
+    //- read original code at the trap address
+    U8 site_code[16] = {0};
+    U64 site_code_size = dmn_lnx_read(process->fd, r1u64(trap->vaddr, trap->vaddr + sizeof(site_code)), site_code);
+    U64 condition_hash = u64_hash_from_str8(trap->condition);
+    
+    //- find existing trampoline
+    for(DMN_LNX_CondTrampoline *t = process->first_cond_trampoline; t != 0; t = t->next)
+    {
+      if(t->site_vaddr == trap->vaddr &&
+         t->condition_hash == condition_hash &&
+         str8_match(t->condition, trap->condition, 0) &&
+         t->site_code_size <= site_code_size &&
+         MemoryMatch(t->site_code, site_code, t->site_code_size))
+      {
+        result = t;
+        break;
+      }
+    }
+    
+    //- none => build one. code is generated once to size it, then again at
+    // its final address. failures are cached too, so they are only tried once.
+    if(result == 0 && site_code_size != 0)
+    {
+      Temp scratch = scratch_begin(0, 0);
+      if(process->cond_arena == 0)
       {
-        did_dbg = 1;
-        REGS_Reg64 *dr_s = &src->dr0;
-        for(U32 i = 0; i < 8; i += 1, dr_s += 1)
+        process->cond_arena = arena_alloc();
+      }
+      result = push_array(process->cond_arena, DMN_LNX_CondTrampoline, 1);
+      SLLStackPush(process->first_cond_trampoline, result);
+      result->site_vaddr     = trap->vaddr;
+      result->condition_hash = condition_hash;
+      result->condition      = push_str8_copy(process->cond_arena, trap->condition);
+      result->site_code_size = site_code_size;
+      MemoryCopyArray(result->site_code, site_code);
+      DMN_LNX_X64Code code = {push_array_no_zero(scratch.arena, U8, DMN_LNX_COND_TRAMPOLINE_MAX_SIZE), 0, DMN_LNX_COND_TRAMPOLINE_MAX_SIZE};
+      U64 hit_off = 0;
+      U64 inst_size = 0;
+      if(dmn_lnx_x64_code_push_cond_trampoline(&code, process, trap->vaddr, trap->vaddr, str8(site_code, site_code_size), trap->condition, &hit_off, &inst_size))
+      {
+        result->site_code_size = inst_size;
+        U64 code_vaddr = dmn_lnx_cond_region_alloc(process, trap->vaddr, code.size);
+        if(code_vaddr != 0)
         {
-          if(i != 4 && i != 5)
+          MemoryZeroStruct(&code);
+          code.v   = push_array_no_zero(scratch.arena, U8, DMN_LNX_COND_TRAMPOLINE_MAX_SIZE);
+          code.cap = DMN_LNX_COND_TRAMPOLINE_MAX_SIZE;
+          if(dmn_lnx_x64_code_push_cond_trampoline(&code, process, code_vaddr, trap->vaddr, str8(site_code, site_code_size), trap->condition, &hit_off, &inst_size) &&
+             dmn_lnx_write(process->fd, r1u64(code_vaddr, code_vaddr + code.size), code.v))
           {
-            U64 offset = OffsetOf(DMN_LNX_UserX64, u_debugreg[i]);
-            int poke_result = ptrace(PTRACE_POKEUSER, tid, PtrFromInt(offset), dr_s->u64);
-            if(poke_result == -1)
-            {
-              did_dbg = 0;
-            }
+            result->code_vaddr = code_vaddr;
+            result->hit_vaddr  = code_vaddr + hit_off;
           }
         }
       }
-      
-      result = (did_dbg);
-    }break;
+      scratch_end(scratch);
+    }
   }
   return result;
 }
@@ -1224,10 +2287,25 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
     //
     B32 need_wait_on_events = (evts.count == 0);
     
+    ////////////////////////////
+    //- step the thread which hit a page-guard watchpoint over its
+    // faulting instruction, before guards go back up
+    //
+    if(need_wait_on_events)
+    {
+      DMN_LNX_Entity *step_thread = dmn_lnx_entity_from_handle(dmn_lnx_state->page_guard_step_thread);
+      if(step_thread != &dmn_lnx_nil_entity)
+      {
+        dmn_lnx_thread_single_step(step_thread);
+      }
+      MemoryZeroStruct(&dmn_lnx_state->page_guard_step_thread);
+    }
+    
     ////////////////////////////
     //- rjf: write all traps into memory
     //
     U8 *trap_swap_bytes = push_array_no_zero(scratch.arena, U8, ctrls->traps.trap_count);
+    DMN_LNX_CondTrampoline **trap_trampolines = push_array(scratch.arena, DMN_LNX_CondTrampoline *, ctrls->traps.trap_count);
     ProfScope("write all traps into memory")
     {
       U64 trap_idx = 0;
@@ -1236,6 +2314,43 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
         for(U64 n_idx = 0; n_idx < n->count; n_idx += 1, trap_idx += 1)
         {
           DMN_Trap *trap = n->v+n_idx;
+          
+          // conditional traps which are alone at their instruction => try
+          // to jump to a trampoline which evaluates the condition in-process
+          DMN_LNX_CondTrampoline *tramp = 0;
+          if(need_wait_on_events && trap->flags == 0 && trap->condition.size != 0)
+          {
+            tramp = dmn_lnx_cond_trampoline_from_trap(trap);
+            for(DMN_TrapChunkNode *n2 = ctrls->traps.first; n2 != 0 && tramp != 0; n2 = n2->next)
+            {
+              for(U64 n2_idx = 0; n2_idx < n2->count; n2_idx += 1)
+              {
+                DMN_Trap *trap2 = n2->v+n2_idx;
+                if(trap2 != trap && trap2->flags == 0 && dmn_handle_match(trap2->process, trap->process) &&
+                   trap->vaddr <= trap2->vaddr && trap2->vaddr < trap->vaddr + tramp->site_code_size)
+                {
+                  tramp = 0;
+                  break;
+                }
+              }
+            }
+            if(tramp != 0 && tramp->code_vaddr != 0)
+            {
+              U8 jmp[DMN_LNX_X64_JMP_REL32_SIZE] = {0xE9};
+              S32 rel32 = (S32)((S64)tramp->code_vaddr - (S64)(trap->vaddr + DMN_LNX_X64_JMP_REL32_SIZE));
+              MemoryCopy(jmp+1, &rel32, sizeof(rel32));
+              if(dmn_process_write(trap->process, r1u64(trap->vaddr, trap->vaddr+sizeof(jmp)), jmp))
+              {
+                // snapshot - the process, and its trampolines, may be released during the run
+                trap_trampolines[trap_idx] = push_array(scratch.arena, DMN_LNX_CondTrampoline, 1);
+                MemoryCopyStruct(trap_trampolines[trap_idx], tramp);
+                trap_swap_bytes[trap_idx] = 0xCC;
+                continue;
+              }
+            }
+          }
+          
+          // rjf: all others => int3
           if(trap->flags == 0)
           {
             trap_swap_bytes[trap_idx] = 0xCC;
@@ -1247,6 +2362,259 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
       }
     }
     
+    ////////////////////////////
+    //- gather all flagged traps, bucketed by process
+    //
+    DMN_LNX_WatchTask *first_watch_task = 0;
+    DMN_LNX_WatchTask *last_watch_task = 0;
+    if(need_wait_on_events) ProfScope("gather all flagged traps, bucketed by process")
+    {
+      for(DMN_TrapChunkNode *n = ctrls->traps.first; n != 0; n = n->next)
+      {
+        for(U64 n_idx = 0; n_idx < n->count; n_idx += 1)
+        {
+          DMN_Trap *trap = n->v+n_idx;
+          DMN_LNX_Entity *process = dmn_lnx_entity_from_handle(trap->process);
+          if(trap->flags == 0 || process->kind != DMN_LNX_EntityKind_Process || process->arch != Arch_x64)
+          {
+            continue;
+          }
+          DMN_LNX_WatchTask *task = dmn_lnx_watch_task_from_process(first_watch_task, process);
+          if(task == 0)
+          {
+            task = push_array(scratch.arena, DMN_LNX_WatchTask, 1);
+            SLLQueuePush(first_watch_task, last_watch_task, task);
+            task->process = process;
+          }
+          B32 already_in_task = 0;
+          for(DMN_TrapChunkNode *task_n = task->traps.first; task_n != 0 && !already_in_task; task_n = task_n->next)
+          {
+            for(U64 task_n_idx = 0; task_n_idx < task_n->count; task_n_idx += 1)
+            {
+              if(task_n->v[task_n_idx].id == trap->id)
+              {
+                already_in_task = 1;
+                break;
+              }
+            }
+          }
+          if(!already_in_task)
+          {
+            dmn_trap_chunk_list_push(scratch.arena, &task->traps, 8, trap);
+          }
+        }
+      }
+    }
+    
+    ////////////////////////////
+    //- assign flagged traps to debug register slots, fall back to page guards
+    //
+    if(need_wait_on_events) ProfScope("assign flagged traps to debug register slots, fall back to page guards")
+    {
+      U64 page_size = os_get_system_info()->page_size;
+      for(DMN_LNX_Entity *process = dmn_lnx_state->entities_base->first;
+          process != &dmn_lnx_nil_entity;
+          process = process->next)
+      {
+        if(process->kind != DMN_LNX_EntityKind_Process) {continue;}
+        DMN_LNX_WatchTask *task = dmn_lnx_watch_task_from_process(first_watch_task, process);
+        if(task == 0)
+        {
+          MemoryZeroArray(process->dr_trap_ids);
+          continue;
+        }
+        
+        //- gather traps which fit a debug register
+        U64 hw_candidate_count = 0;
+        DMN_Trap **hw_candidates = push_array(scratch.arena, DMN_Trap *, task->traps.trap_count);
+        for(DMN_TrapChunkNode *n = task->traps.first; n != 0; n = n->next)
+        {
+          for(U64 n_idx = 0; n_idx < n->count; n_idx += 1)
+          {
+            DMN_Trap *trap = n->v+n_idx;
+            B32 is_hw_compatible = (trap->flags == DMN_TrapFlag_BreakOnExecute ||
+                                    ((trap->size == 1 || trap->size == 2 || trap->size == 4 || trap->size == 8) &&
+                                     trap->vaddr % trap->size == 0));
+            if(is_hw_compatible)
+            {
+              hw_candidates[hw_candidate_count] = trap;
+              hw_candidate_count += 1;
+            }
+            else
+            {
+              dmn_trap_chunk_list_push(scratch.arena, &task->sw_traps, 8, trap);
+            }
+          }
+        }
+        
+        //- keep traps in the slots they occupied during the last run, so
+        // threads don't need to be re-synced, then fill free slots in order
+        for EachIndex(slot_idx, DMN_LNX_HW_WATCH_SLOT_COUNT)
+        {
+          for EachIndex(candidate_idx, hw_candidate_count)
+          {
+            if(hw_candidates[candidate_idx] != 0 && hw_candidates[candidate_idx]->id == process->dr_trap_ids[slot_idx])
+            {
+              task->hw_traps[slot_idx] = hw_candidates[candidate_idx];
+              hw_candidates[candidate_idx] = 0;
+              break;
+            }
+          }
+        }
+        for EachIndex(candidate_idx, hw_candidate_count)
+        {
+          DMN_Trap *trap = hw_candidates[candidate_idx];
+          if(trap == 0) {continue;}
+          B32 is_assigned = 0;
+          for EachIndex(slot_idx, DMN_LNX_HW_WATCH_SLOT_COUNT)
+          {
+            if(task->hw_traps[slot_idx] == 0)
+            {
+              task->hw_traps[slot_idx] = trap;
+              is_assigned = 1;
+              break;
+            }
+          }
+          if(!is_assigned)
+          {
+            dmn_trap_chunk_list_push(scratch.arena, &task->sw_traps, 8, trap);
+          }
+        }
+        
+        //- build debug register state
+        for EachIndex(slot_idx, DMN_LNX_HW_WATCH_SLOT_COUNT)
+        {
+          DMN_Trap *trap = task->hw_traps[slot_idx];
+          process->dr_trap_ids[slot_idx] = trap ? trap->id : 0;
+          task->dr_vaddr[slot_idx]       = trap ? trap->vaddr : 0;
+        }
+        task->dr7 = dmn_lnx_dr7_from_traps(task->hw_traps, DMN_LNX_HW_WATCH_SLOT_COUNT);
+        
+        //- gather what must never be guarded - the page under each thread's
+        // rip (syscalls are injected there, including the one which lowers
+        // guards) and the mapping holding each thread's stack
+        U64 unguardable_range_count = 0;
+        Rng1U64 *unguardable_ranges = 0;
+        B32 can_guard = 1;
+        if(task->sw_traps.trap_count != 0)
+        {
+          U64 thread_count = 0;
+          for(DMN_LNX_Entity *child = process->first; child != &dmn_lnx_nil_entity; child = child->next)
+          {
+            thread_count += (child->kind == DMN_LNX_EntityKind_Thread);
+          }
+          unguardable_ranges = push_array(scratch.arena, Rng1U64, thread_count*2);
+          for(DMN_LNX_Entity *child = process->first; child != &dmn_lnx_nil_entity; child = child->next)
+          {
+            if(child->kind != DMN_LNX_EntityKind_Thread) {continue;}
+            dmn_lnx_thread_settle_stop(child);
+            DMN_LNX_UserRegsX64 regs = {0};
+            if(ptrace(PTRACE_GETREGS, (pid_t)child->id, 0, &regs) == -1)
+            {
+              can_guard = 0;
+              break;
+            }
+            U64 ip_page = AlignDownPow2(regs.rip, page_size);
+            U64 sp_page = AlignDownPow2(regs.rsp, page_size);
+            DMN_LNX_Mapping stack = dmn_lnx_mapping_from_vaddr((pid_t)process->id, regs.rsp);
+            unguardable_ranges[unguardable_range_count+0] = r1u64(ip_page, ip_page + page_size);
+            unguardable_ranges[unguardable_range_count+1] = (stack.vaddr_range.max != 0 ? stack.vaddr_range : r1u64(sp_page, sp_page + page_size));
+            unguardable_range_count += 2;
+          }
+        }
+        
+        //- build page guards for the leftovers, when all of a trap's pages
+        // can be guarded - otherwise the trap is not set
+        DMN_TrapChunkList guarded_traps = {0};
+        DMN_TrapChunkList unwatched_traps = {0};
+        U64 fallback_trap_ids_hash = 0;
+        for(DMN_TrapChunkNode *n = task->sw_traps.first; n != 0; n = n->next)
+        {
+          for(U64 n_idx = 0; n_idx < n->count; n_idx += 1)
+          {
+            DMN_Trap *trap = n->v+n_idx;
+            U64 page_first = AlignDownPow2(trap->vaddr, page_size);
+            U64 page_opl   = AlignPow2(trap->vaddr + Max(trap->size, 1), page_size);
+            B32 is_guardable = can_guard;
+            for(U64 page = page_first; is_guardable && page < page_opl; page += page_size)
+            {
+              DMN_LNX_Mapping mapping = dmn_lnx_mapping_from_vaddr((pid_t)process->id, page);
+              is_guardable = dmn_lnx_page_is_guardable(&mapping, page, unguardable_ranges, unguardable_range_count);
+            }
+            if(!is_guardable)
+            {
+              dmn_trap_chunk_list_push(scratch.arena, &unwatched_traps, 8, trap);
+              fallback_trap_ids_hash = u64_hash_from_seed_str8(fallback_trap_ids_hash, str8_struct(&trap->id));
+              continue;
+            }
+            dmn_trap_chunk_list_push(scratch.arena, &guarded_traps, 8, trap);
+            fallback_trap_ids_hash = u64_hash_from_seed_str8(fallback_trap_ids_hash ^ 1, str8_struct(&trap->id));
+            for(U64 page = page_first; page < page_opl; page += page_size)
+            {
+              DMN_LNX_PageGuard *guard = 0;
+              for(DMN_LNX_PageGuard *g = task->first_guard; g != 0; g = g->next)
+              {
+                if(g->vaddr == page)
+                {
+                  guard = g;
+                  break;
+                }
+              }
+              if(guard == 0)
+              {
+                guard = push_array(scratch.arena, DMN_LNX_PageGuard, 1);
+                SLLQueuePush(task->first_guard, task->last_guard, guard);
+                guard->vaddr      = page;
+                guard->prot_og    = dmn_lnx_prot_from_vaddr((pid_t)process->id, page);
+                guard->prot_guard = guard->prot_og;
+              }
+              if(trap->flags & (DMN_TrapFlag_BreakOnRead|DMN_TrapFlag_BreakOnExecute))
+              {
+                guard->prot_guard = PROT_NONE;
+              }
+              else
+              {
+                guard->prot_guard &= ~PROT_WRITE;
+              }
+            }
+          }
+        }
+        task->sw_traps = guarded_traps;
+        
+        //- report how traps outside the debug registers are handled, once per change
+        if(fallback_trap_ids_hash != process->fallback_trap_ids_hash)
+        {
+          process->fallback_trap_ids_hash = fallback_trap_ids_hash;
+          DMN_TrapChunkList *lists[] = {&guarded_traps, &unwatched_traps};
+          for EachElement(list_idx, lists)
+          {
+            for(DMN_TrapChunkNode *n = lists[list_idx]->first; n != 0; n = n->next)
+            {
+              for(U64 n_idx = 0; n_idx < n->count; n_idx += 1)
+              {
+                DMN_Trap *trap = n->v+n_idx;
+                DMN_Event *e = dmn_event_list_push(arena, &evts);
+                e->kind    = DMN_EventKind_DebugString;
+                e->process = dmn_lnx_handle_from_entity(process);
+                e->thread  = dmn_lnx_handle_from_entity(dmn_lnx_stopped_thread_from_process(process));
+                if(list_idx == 0)
+                {
+                  e->string = push_str8f(arena, "Data breakpoint at 0x%llx (%llu bytes) did not fit a debug register and is watched by page protection - syscalls accessing its pages fail with EFAULT while it is set.\n", trap->vaddr, (U64)trap->size);
+                }
+                else
+                {
+                  e->string = push_str8f(arena, "Data breakpoint at 0x%llx (%llu bytes) was not set: it did not fit a debug register, and it lies on code, stack, or kernel-managed pages, which cannot be guarded.\n", trap->vaddr, (U64)trap->size);
+                }
+              }
+            }
+          }
+        }
+        
+        //- raise page guards for the duration of the run
+        dmn_lnx_watch_task_apply_page_guards(task, 1);
+      }
+    }
+    
     ////////////////////////////
     //- rjf: gather all threads which we should run
     //
@@ -1340,7 +2708,19 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
     DMN_LNX_EntityNode *last_ran_thread = 0;
     for(DMN_LNX_EntityNode *n = first_run_thread; n != 0; n = n->next)
     {
-      ptrace(PTRACE_CONT, (pid_t)n->v->id, 0, 0);
+      // sync debug registers to the process' watchpoints - this is also
+      // how new threads inherit them, as debug registers are not copied by clone()
+      {
+        DMN_LNX_WatchTask *task = dmn_lnx_watch_task_from_process(first_watch_task, n->v->parent);
+        U64 dr_vaddr_zero[DMN_LNX_HW_WATCH_SLOT_COUNT] = {0};
+        dmn_lnx_thread_sync_debug_regs(n->v, task ? task->dr_vaddr : dr_vaddr_zero, task ? task->dr7 : 0);
+      }
+      
+      // threads with a stashed event are already stopped at it - keep them there
+      if(!n->v->has_pending_wait_status)
+      {
+        ptrace(n->v == single_step_thread ? PTRACE_SINGLESTEP : PTRACE_CONT, (pid_t)n->v->id, 0, 0);
+      }
       DMN_LNX_EntityNode *n2 = push_array_no_zero(scratch.arena, DMN_LNX_EntityNode, 1);
       SLLQueuePush(first_ran_thread, last_ran_thread, n2);
       n2->v = n->v;
@@ -1352,9 +2732,24 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
     pid_t final_wait_pid = 0;
     if(need_wait_on_events) for(B32 done = 0; !done;)
     {
-      //- rjf: wait for next event
+      //- wait for next event - take stashed events first
       int status = 0;
-      pid_t wait_id = waitpid(-1, &status, __WALL);
+      pid_t wait_id = 0;
+      for EachIndex(idx, dmn_lnx_state->entities_count)
+      {
+        DMN_LNX_Entity *entity = &dmn_lnx_state->entities_base[idx];
+        if(entity->kind == DMN_LNX_EntityKind_Thread && entity->has_pending_wait_status)
+        {
+          entity->has_pending_wait_status = 0;
+          status = entity->pending_wait_status;
+          wait_id = (pid_t)entity->id;
+          break;
+        }
+      }
+      if(wait_id == 0)
+      {
+        wait_id = waitpid(-1, &status, __WALL);
+      }
       final_wait_pid = wait_id;
       done = 1;
       
@@ -1394,6 +2789,19 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
       DMN_LNX_Entity *process = thread->parent;
       B32 thread_is_process_root = (thread->id == process->id);
       
+      //- stop of an unknown thread => initial stop of a clone()'d thread,
+      // reported before its parent's PTRACE_EVENT_CLONE
+      if(thread == &dmn_lnx_nil_entity && wifstopped)
+      {
+        if(dmn_lnx_state->early_stop_tid_count < DMN_LNX_EARLY_STOP_TID_MAX)
+        {
+          dmn_lnx_state->early_stop_tids[dmn_lnx_state->early_stop_tid_count] = wait_id;
+          dmn_lnx_state->early_stop_tid_count += 1;
+        }
+        done = 0;
+        continue;
+      }
+      
       //- rjf: unpack thread's registers
       U64 rip = 0;
       void *regs_block = 0;
@@ -1430,7 +2838,33 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
       //- rjf: SIGTRAP:PTRACE_EVENT_CLONE
       else if(wifstopped && wstopsig == SIGTRAP && ptrace_event_code == PTRACE_EVENT_CLONE)
       {
-        // TODO(rjf)
+        unsigned long new_tid = 0;
+        if(ptrace(PTRACE_GETEVENTMSG, wait_id, 0, &new_tid) != -1 && new_tid != 0)
+        {
+          DMN_LNX_Entity *new_thread = dmn_lnx_entity_alloc(process, DMN_LNX_EntityKind_Thread);
+          new_thread->id   = new_tid;
+          new_thread->arch = process->arch;
+          
+          // new threads start with a SIGSTOP - swallow it, unless it was already observed
+          new_thread->expecting_dummy_sigstop = 1;
+          for(U64 idx = 0; idx < dmn_lnx_state->early_stop_tid_count; idx += 1)
+          {
+            if(dmn_lnx_state->early_stop_tids[idx] == (pid_t)new_tid)
+            {
+              dmn_lnx_state->early_stop_tid_count -= 1;
+              dmn_lnx_state->early_stop_tids[idx] = dmn_lnx_state->early_stop_tids[dmn_lnx_state->early_stop_tid_count];
+              new_thread->expecting_dummy_sigstop = 0;
+              break;
+            }
+          }
+          
+          DMN_Event *e = dmn_event_list_push(arena, &evts);
+          e->kind    = DMN_EventKind_CreateThread;
+          e->process = dmn_lnx_handle_from_entity(process);
+          e->thread  = dmn_lnx_handle_from_entity(new_thread);
+          e->arch    = new_thread->arch;
+          e->code    = new_thread->id;
+        }
       }
       
       //- rjf: SIGTRAP:PTRACE_EVENT_FORK, or SIGTRAP:PTRACE_EVENT_VFORK
@@ -1450,15 +2884,73 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
           e_kind = DMN_EventKind_SingleStep;
         }
         
-        // rjf: this matches a specified trap => breakpoint
+        // debug status register flags an enabled slot => data breakpoint
+        B32 is_data_breakpoint = 0;
+        U64 data_breakpoint_vaddr = 0;
+        U64 data_breakpoint_id = 0;
+        if(thread->arch == Arch_x64 && regs_block != 0)
+        {
+          REGS_RegBlockX64 *regs = (REGS_RegBlockX64 *)regs_block;
+          for EachIndex(slot_idx, DMN_LNX_HW_WATCH_SLOT_COUNT)
+          {
+            B32 slot_is_enabled = !!(regs->dr7.u64 & (1ull << (slot_idx*2)));
+            B32 slot_is_hit     = !!(regs->dr6.u64 & (1ull << slot_idx));
+            if(slot_is_enabled && slot_is_hit)
+            {
+              DMN_LNX_WatchTask *task = dmn_lnx_watch_task_from_process(first_watch_task, process);
+              DMN_Trap *trap = task ? task->hw_traps[slot_idx] : 0;
+              is_data_breakpoint    = 1;
+              data_breakpoint_vaddr = (&regs->dr0)[slot_idx].u64;
+              data_breakpoint_id    = trap ? trap->id : 0;
+              e_kind = DMN_EventKind_Breakpoint;
+              break;
+            }
+          }
+          
+          // dr6 is sticky - clear it, so the next stop isn't misreported
+          if(regs->dr6.u64 & 0xF)
+          {
+            ptrace(PTRACE_POKEUSER, wait_id, PtrFromInt(OffsetOf(DMN_LNX_UserX64, u_debugreg[6])), 0);
+          }
+        }
+        
+        // this matches a specified trap => breakpoint. int3 reports the
+        // address after itself - either right after the trap address, or after
+        // the int3 in a conditional trap's trampoline, once its condition holds.
+        DMN_Trap *hit_trap = 0;
+        if(!is_data_breakpoint && thread->arch == Arch_x64)
         {
-          // TODO(rjf)
+          DMN_Handle process_handle = dmn_lnx_handle_from_entity(process);
+          U64 trap_idx = 0;
+          for(DMN_TrapChunkNode *n = ctrls->traps.first; n != 0 && hit_trap == 0; n = n->next)
+          {
+            for(U64 n_idx = 0; n_idx < n->count; n_idx += 1, trap_idx += 1)
+            {
+              DMN_Trap *trap = n->v+n_idx;
+              DMN_LNX_CondTrampoline *tramp = trap_trampolines[trap_idx];
+              if(trap->flags == 0 && dmn_handle_match(trap->process, process_handle) &&
+                 ((tramp == 0 && trap_swap_bytes[trap_idx] != 0xCC && rip == trap->vaddr+1) ||
+                  (tramp != 0 && rip == tramp->hit_vaddr+1)))
+              {
+                hit_trap = trap;
+                e_kind = DMN_EventKind_Breakpoint;
+                break;
+              }
+            }
+          }
         }
         
-        // rjf: after breakpoint -> rollback
-        if(e_kind == DMN_EventKind_Breakpoint)
+        // after breakpoint -> rollback to the trap address (data breakpoints
+        // trap after the access, nothing to roll back)
+        if(hit_trap != 0)
         {
-          // TODO(rjf)
+          DMN_LNX_UserRegsX64 regs = {0};
+          if(ptrace(PTRACE_GETREGS, wait_id, 0, &regs) != -1)
+          {
+            regs.rip = hit_trap->vaddr;
+            ptrace(PTRACE_SETREGS, wait_id, 0, &regs);
+          }
+          rip = hit_trap->vaddr;
         }
         
         // rjf: push event
@@ -1467,6 +2959,15 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
         e->process             = dmn_lnx_handle_from_entity(process);
         e->thread              = dmn_lnx_handle_from_entity(thread);
         e->instruction_pointer = rip;
+        if(is_data_breakpoint)
+        {
+          e->address   = data_breakpoint_vaddr;
+          e->user_data = data_breakpoint_id;
+        }
+        else if(hit_trap != 0)
+        {
+          e->user_data = hit_trap->id;
+        }
       }
       
       //- rjf: WSTOPSIG(status) is SIGSTOP
@@ -1506,17 +3007,64 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
       //- rjf: WSTOPSIG(status) is an unrecoverable exception (unless user does something to fix state first)
       else if(wifstopped)
       {
+        // SIGSEGV inside a guarded page => page-guard watchpoint
+        B32 is_page_guard_fault = 0;
+        DMN_LNX_WatchTask *watch_task = dmn_lnx_watch_task_from_process(first_watch_task, process);
+        if(wstopsig == SIGSEGV && watch_task != 0 && watch_task->first_guard != 0)
+        {
+          siginfo_t siginfo = {0};
+          if(ptrace(PTRACE_GETSIGINFO, wait_id, 0, &siginfo) != -1)
+          {
+            DMN_LNX_PageGuard *guard = 0;
+            DMN_Trap *trap = dmn_lnx_page_guard_trap_from_vaddr(watch_task, (U64)siginfo.si_addr, &guard);
+            
+            // watched bytes => breakpoint; the access has not happened yet, so
+            // the thread steps over it with guards lifted before it next runs
+            if(trap != 0)
+            {
+              is_page_guard_fault = 1;
+              DMN_Event *e = dmn_event_list_push(arena, &evts);
+              e->kind                = DMN_EventKind_Breakpoint;
+              e->process             = dmn_lnx_handle_from_entity(process);
+              e->thread              = dmn_lnx_handle_from_entity(thread);
+              e->instruction_pointer = rip;
+              e->address             = trap->vaddr;
+              e->user_data           = trap->id;
+              dmn_lnx_state->page_guard_step_thread = dmn_lnx_handle_from_entity(thread);
+            }
+            
+            // unwatched bytes on a guarded page => lift the guard for one
+            // instruction, then keep going without reporting anything
+            else if(guard != 0)
+            {
+              is_page_guard_fault = 1;
+              U64 page_size = os_get_system_info()->page_size;
+              dmn_lnx_thread_inject_mprotect(thread, guard->vaddr, page_size, guard->prot_og);
+              dmn_lnx_thread_single_step(thread);
+              dmn_lnx_thread_inject_mprotect(thread, guard->vaddr, page_size, guard->prot_guard);
+              if(!thread->has_pending_wait_status)
+              {
+                ptrace(PTRACE_CONT, wait_id, 0, 0);
+              }
+              done = 0;
+            }
+          }
+        }
+        
         // TODO(rjf): possible cases:
         // SIGABRT
         // SIGFPE
         // SIGSEGV
         // SIGILL
-        DMN_Event *e = dmn_event_list_push(arena, &evts);
-        e->kind                = DMN_EventKind_Exception;
-        e->process             = dmn_lnx_handle_from_entity(process);
-        e->thread              = dmn_lnx_handle_from_entity(thread);
-        e->instruction_pointer = rip;
-        e->signo               = wstopsig;
+        if(!is_page_guard_fault)
+        {
+          DMN_Event *e = dmn_event_list_push(arena, &evts);
+          e->kind                = DMN_EventKind_Exception;
+          e->process             = dmn_lnx_handle_from_entity(process);
+          e->thread              = dmn_lnx_handle_from_entity(thread);
+          e->instruction_pointer = rip;
+          e->signo               = wstopsig;
+        }
       }
       
       //- rjf: thread exit, thread is process' "root thread" -> eliminate this entire entity subtree
@@ -1584,6 +3132,21 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
       }
     }
     
+    ////////////////////////////
+    //- lower page guards
+    //
+    ProfScope("lower page guards")
+    {
+      for(DMN_LNX_WatchTask *task = first_watch_task; task != 0; task = task->next)
+      {
+        // skip processes which exited during the run
+        if(task->process->parent != &dmn_lnx_nil_entity)
+        {
+          dmn_lnx_watch_task_apply_page_guards(task, 0);
+        }
+      }
+    }
+    
     //////////////////////////
     //- rjf: restore original memory at trap locations
     //
@@ -1595,7 +3158,12 @@ dmn_ctrl_run(Arena *arena, DMN_CtrlCtx *ctx, DMN_RunCtrls *ctrls)
         for(U64 n_idx = 0; n_idx < n->count; n_idx += 1, trap_idx += 1)
         {
           DMN_Trap *trap = n->v+n_idx;
-          if(trap->flags == 0)
+          DMN_LNX_CondTrampoline *tramp = trap_trampolines[trap_idx];
+          if(tramp != 0)
+          {
+            dmn_process_write(trap->process, r1u64(trap->vaddr, trap->vaddr+DMN_LNX_X64_JMP_REL32_SIZE), tramp->site_code);
+          }
+          else if(trap->flags == 0)
           {
             U8 og_byte = trap_swap_bytes[trap_idx];
             if(og_byte != 0xCC)
@@ -1749,6 +3317,10 @@ dmn_thread_write_reg_block(DMN_Handle handle, void *reg_block)
   {
     DMN_LNX_Entity *thread = dmn_lnx_entity_from_handle(handle);
     result = dmn_lnx_thread_write_reg_block(thread, reg_block);
+    if(thread != &dmn_lnx_nil_entity)
+    {
+      thread->dr_is_synced = 0;
+    }
   }
   return result;
 }
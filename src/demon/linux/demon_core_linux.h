@@ -25,6 +25,26 @@ PTRACE_O_TRACEFORK|\
 PTRACE_O_TRACEVFORK|\
 PTRACE_O_TRACECLONE)
 
+////////////////////////////////
+//~ Data Breakpoint Constants
+
+#define DMN_LNX_HW_WATCH_SLOT_COUNT   4
+#define DMN_LNX_X64_SYSCALL_MPROTECT  10
+#define DMN_LNX_EARLY_STOP_TID_MAX    64
+
+////////////////////////////////
+//~ Conditional Breakpoint Constants
+
+#define DMN_LNX_X64_SYSCALL_MMAP          9
+#define DMN_LNX_X64_SYSCALL_MUNMAP        11
+#define DMN_LNX_X64_JMP_REL32_SIZE        5
+#define DMN_LNX_X64_RED_ZONE_SIZE         128
+#define DMN_LNX_COND_REGION_SIZE          KB(64)
+#define DMN_LNX_COND_TRAMPOLINE_MAX_SIZE  KB(2)
+#define DMN_LNX_COND_OP_MAX               128
+#define DMN_LNX_COND_STACK_MAX            16
+#define DMN_LNX_COND_FRAME_READ_MAX       KB(16)
+
 ////////////////////////////////
 //~ rjf: Register Layouts
 //
@@ -233,6 +253,14 @@ struct DMN_LNX_ModuleInfoList
   U64 count;
 };
 
+typedef struct DMN_LNX_Mapping DMN_LNX_Mapping;
+struct DMN_LNX_Mapping
+{
+  Rng1U64 vaddr_range;
+  int prot;
+  B32 is_kernel_named; // [stack], [vdso], [vvar], ... - everything bracketed but [heap]
+};
+
 ////////////////////////////////
 //~ rjf: Entity Types
 
@@ -247,6 +275,9 @@ typedef enum DMN_LNX_EntityKind
 }
 DMN_LNX_EntityKind;
 
+typedef struct DMN_LNX_CondRegion DMN_LNX_CondRegion;
+typedef struct DMN_LNX_CondTrampoline DMN_LNX_CondTrampoline;
+
 typedef struct DMN_LNX_Entity DMN_LNX_Entity;
 struct DMN_LNX_Entity
 {
@@ -261,6 +292,27 @@ struct DMN_LNX_Entity
   U64 id;
   int fd;
   B32 expecting_dummy_sigstop;
+  
+  // wait status reaped out-of-band (while settling a stop), consumed by the next wait
+  B32 has_pending_wait_status;
+  int pending_wait_status;
+  
+  // (threads) debug register state currently programmed into this thread
+  B32 dr_is_synced;
+  U64 dr_vaddr[DMN_LNX_HW_WATCH_SLOT_COUNT];
+  U64 dr7;
+  
+  // (processes) trap ids assigned to debug register slots during the last run
+  U64 dr_trap_ids[DMN_LNX_HW_WATCH_SLOT_COUNT];
+  
+  // (processes) hash of the trap ids which did not fit a debug register during
+  // the last run, so how they are handled is reported once rather than every run
+  U64 fallback_trap_ids_hash;
+  
+  // (processes) conditional breakpoint trampolines, persistent across runs
+  Arena *cond_arena;
+  DMN_LNX_CondRegion *first_cond_region;
+  DMN_LNX_CondTrampoline *first_cond_trampoline;
 };
 
 typedef struct DMN_LNX_EntityNode DMN_LNX_EntityNode;
@@ -270,6 +322,115 @@ struct DMN_LNX_EntityNode
   DMN_LNX_Entity *v;
 };
 
+////////////////////////////////
+//~ Data Breakpoint Types
+//
+// Flagged traps are assigned to DR0-DR3 per process, and every thread in the
+// process is synced to that assignment before it runs, so threads created by
+// clone() pick up active watchpoints on their first run. Traps which do not
+// fit in the debug registers (more than four, or unaligned / oddly sized)
+// fall back to guarding the containing pages with mprotect() for the duration
+// of the run, and the resulting SIGSEGVs are translated into breakpoints.
+//
+// A guard changes how the target behaves, not just what is caught: the kernel
+// does not fault on the target's behalf, so a syscall touching a guarded page
+// (e.g. read() into a watched buffer) fails with EFAULT. Code pages are never
+// guarded (syscalls are injected at a stopped thread's rip, and guards must be
+// lowered that way), and neither are thread stacks or kernel-named mappings.
+// Traps which would need such a page are not set. Both outcomes are reported to
+// the user as debug strings, so neither changes the target silently.
+
+typedef struct DMN_LNX_PageGuard DMN_LNX_PageGuard;
+struct DMN_LNX_PageGuard
+{
+  DMN_LNX_PageGuard *next;
+  U64 vaddr;
+  int prot_og;
+  int prot_guard;
+};
+
+typedef struct DMN_LNX_WatchTask DMN_LNX_WatchTask;
+struct DMN_LNX_WatchTask
+{
+  DMN_LNX_WatchTask *next;
+  DMN_LNX_Entity *process;
+  DMN_TrapChunkList traps;
+  DMN_Trap *hw_traps[DMN_LNX_HW_WATCH_SLOT_COUNT];
+  U64 dr_vaddr[DMN_LNX_HW_WATCH_SLOT_COUNT];
+  U64 dr7;
+  DMN_TrapChunkList sw_traps;
+  DMN_LNX_PageGuard *first_guard;
+  DMN_LNX_PageGuard *last_guard;
+};
+
+////////////////////////////////
+//~ Conditional Breakpoint Types
+//
+// Software traps which carry a condition are, when possible, not planted as
+// int3s on x64. Instead, a trampoline is emitted into memory mapped near the
+// trap address, which saves the thread's state, evaluates the condition inside
+// the target, and only executes an int3 when it holds - otherwise, it runs a
+// relocated copy of the instruction at the trap address and jumps back, so the
+// target never stops for false conditions. For the duration of each run, the
+// trap address is patched with a `jmp rel32` into the trampoline, the same way
+// int3 bytes are. Like gdb's fast tracepoints, this requires the instruction at
+// the trap address to be at least 5 bytes long.
+//
+// Only conditions which cannot fault are compiled - registers, constants, and
+// memory reads at small offsets from the stack pointer. Reads of constant
+// addresses (globals) are not, as the mapping backing them may be unmapped or
+// reprotected by the target between runs. Everything else falls back to an
+// int3.
+//
+// Trampolines are never rewritten once emitted, as a thread may be stopped
+// inside of one; they are keyed on address, condition text, and the original
+// code at the address. They, and the regions they are emitted into, are owned
+// by their process entity and released along with it.
+
+struct DMN_LNX_CondRegion
+{
+  DMN_LNX_CondRegion *next;
+  U64 vaddr;
+  U64 size;
+  U64 pos;
+};
+
+struct DMN_LNX_CondTrampoline
+{
+  DMN_LNX_CondTrampoline *next;
+  U64 site_vaddr;
+  U64 condition_hash;
+  String8 condition;
+  U8 site_code[16];
+  U64 site_code_size;
+  U64 code_vaddr; // 0 => condition/site could not be compiled, always use an int3
+  U64 hit_vaddr;  // address of the trampoline's int3
+};
+
+typedef enum DMN_LNX_CondValueKind
+{
+  DMN_LNX_CondValueKind_Const,
+  DMN_LNX_CondValueKind_Frame,
+  DMN_LNX_CondValueKind_Other,
+}
+DMN_LNX_CondValueKind;
+
+typedef struct DMN_LNX_CondValue DMN_LNX_CondValue;
+struct DMN_LNX_CondValue
+{
+  DMN_LNX_CondValueKind kind;
+  U64 u64; // Const => value, Frame => offset from the stack pointer at the trap address
+};
+
+typedef struct DMN_LNX_X64Code DMN_LNX_X64Code;
+struct DMN_LNX_X64Code
+{
+  U8 *v;
+  U64 size;
+  U64 cap;
+  B32 overflowed;
+};
+
 ////////////////////////////////
 //~ rjf: Main State Bundle
 
@@ -296,6 +457,15 @@ struct DMN_LNX_State
   B32 has_halt_injection;
   U64 halt_code;
   U64 halt_user_data;
+  
+  // page-guard watchpoints - thread which must step over its faulting
+  // instruction, with guards lifted, before the next run
+  DMN_Handle page_guard_step_thread;
+  
+  // initial stops of cloned threads, observed before their parent's
+  // PTRACE_EVENT_CLONE
+  U64 early_stop_tid_count;
+  pid_t early_stop_tids[DMN_LNX_EARLY_STOP_TID_MAX];
 };
 
 read_only global DMN_LNX_Entity dmn_lnx_nil_entity = {&dmn_lnx_nil_entity, &dmn_lnx_nil_entity, &dmn_lnx_nil_entity, &dmn_lnx_nil_entity, &dmn_lnx_nil_entity};
@@ -322,6 +492,8 @@ internal DMN_LNX_PhdrInfo dmn_lnx_phdr_info_from_memory(int memory_fd, B32 is_32
 
 //- rjf: process entity => info extraction
 internal DMN_LNX_ModuleInfoList dmn_lnx_module_info_list_from_process(Arena *arena, DMN_LNX_Entity *process);
+internal DMN_LNX_Mapping dmn_lnx_mapping_from_vaddr(pid_t pid, U64 vaddr);
+internal int dmn_lnx_prot_from_vaddr(pid_t pid, U64 vaddr);
 
 ////////////////////////////////
 //~ rjf: Entity Functions
@@ -334,4 +506,43 @@ internal DMN_LNX_Entity *dmn_lnx_thread_from_pid(pid_t pid);
 internal B32 dmn_lnx_thread_read_reg_block(DMN_LNX_Entity *thread, void *reg_block);
 internal B32 dmn_lnx_thread_write_reg_block(DMN_LNX_Entity *thread, void *reg_block);
 
+////////////////////////////////
+//~ Thread Control Helpers
+
+internal void dmn_lnx_thread_settle_stop(DMN_LNX_Entity *thread);
+internal DMN_LNX_Entity *dmn_lnx_stopped_thread_from_process(DMN_LNX_Entity *process);
+internal B32 dmn_lnx_thread_single_step(DMN_LNX_Entity *thread);
+internal B32 dmn_lnx_thread_inject_syscall(DMN_LNX_Entity *thread, U64 syscall_num, U64 *args, U64 args_count, U64 *result_out);
+internal B32 dmn_lnx_thread_inject_mprotect(DMN_LNX_Entity *thread, U64 vaddr, U64 size, int prot);
+
+////////////////////////////////
+//~ Data Breakpoint Functions
+
+internal U64 dmn_lnx_dr7_from_traps(DMN_Trap **traps, U64 traps_count);
+internal void dmn_lnx_thread_sync_debug_regs(DMN_LNX_Entity *thread, U64 *dr_vaddr, U64 dr7);
+internal DMN_LNX_WatchTask *dmn_lnx_watch_task_from_process(DMN_LNX_WatchTask *first_task, DMN_LNX_Entity *process);
+internal B32 dmn_lnx_page_is_guardable(DMN_LNX_Mapping *mapping, U64 page, Rng1U64 *unguardable_ranges, U64 unguardable_range_count);
+internal void dmn_lnx_watch_task_apply_page_guards(DMN_LNX_WatchTask *task, B32 apply);
+internal DMN_Trap *dmn_lnx_page_guard_trap_from_vaddr(DMN_LNX_WatchTask *task, U64 vaddr, DMN_LNX_PageGuard **guard_out);
+
+////////////////////////////////
+//~ Conditional Breakpoint Functions
+
+//- x64 code building
+internal void dmn_lnx_x64_code_push(DMN_LNX_X64Code *code, void *bytes, U64 size);
+#define dmn_lnx_x64_code_pushb(code, ...) do { U8 bytes__[] = {__VA_ARGS__}; dmn_lnx_x64_code_push((code), bytes__, sizeof(bytes__)); } while(0)
+#define dmn_lnx_x64_code_push_struct(code, ptr) dmn_lnx_x64_code_push((code), (ptr), sizeof(*(ptr)))
+internal void dmn_lnx_x64_code_patch_rel32(DMN_LNX_X64Code *code, U64 rel32_off, U64 dst_off);
+
+//- trampoline pieces
+internal void dmn_lnx_x64_code_push_state_save(DMN_LNX_X64Code *code);
+internal void dmn_lnx_x64_code_push_state_restore(DMN_LNX_X64Code *code);
+internal B32 dmn_lnx_x64_code_push_condition(DMN_LNX_X64Code *code, DMN_LNX_Entity *process, U64 site_vaddr, String8 condition, U64 *hit_patch_offs, U64 *hit_patch_count_out);
+internal B32 dmn_lnx_x64_code_push_relocated_inst(DMN_LNX_X64Code *code, U64 code_vaddr, U64 site_vaddr, String8 site_code, U64 *inst_size_out);
+internal B32 dmn_lnx_x64_code_push_cond_trampoline(DMN_LNX_X64Code *code, DMN_LNX_Entity *process, U64 code_vaddr, U64 site_vaddr, String8 site_code, String8 condition, U64 *hit_off_out, U64 *inst_size_out);
+
+//- trampolines
+internal U64 dmn_lnx_cond_region_alloc(DMN_LNX_Entity *process, U64 site_vaddr, U64 size);
+internal DMN_LNX_CondTrampoline *dmn_lnx_cond_trampoline_from_trap(DMN_Trap *trap);
+
 #endif // DEMON_CORE_LINUX_H
@@ -225,21 +225,30 @@ dasm_line_array_from_chunk_list(Arena *arena, DASM_LineChunkList *list)
 }
 
 internal U64
-dasm_line_array_idx_from_code_off__linear_scan(DASM_LineArray *array, U64 off)
+dasm_line_array_idx_from_code_off(DASM_LineArray *array, U64 off)
 {
+  // NOTE: lines are sorted by code offset, & decorative lines precede the
+  // instruction line at the same offset - so the last line at or before `off`
+  // is the instruction line containing `off`.
   U64 result = 0;
-  for(U64 idx = 0; idx < array->count; idx += 1)
+  U64 first = 0;
+  U64 opl = array->count;
+  for(;first < opl;)
   {
-    U64 next_off = (idx+1 < array->count ? array->v[idx+1].code_off : max_U64);
-    if(array->v[idx].code_off <= off && off < next_off)
+    U64 mid = first + (opl - first)/2;
+    if(array->v[mid].code_off <= off)
     {
-      result = idx;
-      if(!(array->v[idx].flags & DASM_LineFlag_Decorative))
-      {
-        break;
-      }
+      first = mid+1;
+    }
+    else
+    {
+      opl = mid;
     }
   }
+  if(first > 0)
+  {
+    result = first-1;
+  }
   return result;
 }
 
@@ -254,6 +263,158 @@ dasm_line_array_code_off_from_idx(DASM_LineArray *array, U64 idx)
   return off;
 }
 
+////////////////////////////////
+//~ Chunked Decoding Functions
+
+internal DASM_ChunkInst
+dasm_chunk_inst_from_data_off(Arena *arena, RDI_Parsed *rdi, DASM_Params *params, String8 data, U64 off)
+{
+  DASM_ChunkInst result = {0};
+  result.off = off;
+  result.inst = dasm_inst_from_code(arena, params->arch, params->vaddr+off, str8_skip(data, off), params->syntax);
+  if(result.inst.size != 0)
+  {
+    DASM_Inst *inst = &result.inst;
+    
+    //- voff -> line info
+    if(params->style_flags & (DASM_StyleFlag_SourceFilesNames|DASM_StyleFlag_SourceLines) &&
+       rdi != &rdi_parsed_nil)
+    {
+      U64 voff = (params->vaddr+off) - params->base_vaddr;
+      U32 unit_idx = rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_UnitVMap, voff);
+      RDI_Unit *unit = rdi_element_from_name_idx(rdi, Units, unit_idx);
+      RDI_LineTable *line_table = rdi_element_from_name_idx(rdi, LineTables, unit->line_table_idx);
+      RDI_ParsedLineTable unit_line_info = {0};
+      rdi_parsed_from_line_table(rdi, line_table, &unit_line_info);
+      U64 line_info_idx = rdi_line_info_idx_from_voff(&unit_line_info, voff);
+      if(line_info_idx < unit_line_info.count)
+      {
+        result.line_id  = ((U64)unit_idx << 32 | line_info_idx) + 1;
+        result.file_idx = unit_line_info.lines[line_info_idx].file_idx;
+        result.line_num = unit_line_info.lines[line_info_idx].line_num;
+      }
+    }
+    
+    //- build instruction text
+    String8 addr_part = {0};
+    if(params->style_flags & DASM_StyleFlag_Addresses)
+    {
+      addr_part = push_str8f(arena, "%s0x%016I64x  ", rdi != &rdi_parsed_nil ? "  " : "", params->vaddr+off);
+    }
+    String8 code_bytes_part = {0};
+    if(params->style_flags & DASM_StyleFlag_CodeBytes)
+    {
+      Temp scratch = scratch_begin(&arena, 1);
+      String8List code_bytes_strings = {0};
+      str8_list_push(scratch.arena, &code_bytes_strings, str8_lit("{"));
+      for(U64 byte_idx = 0; byte_idx < inst->size || byte_idx < 16; byte_idx += 1)
+      {
+        if(byte_idx < inst->size)
+        {
+          str8_list_pushf(scratch.arena, &code_bytes_strings, "%02x%s ", (U32)data.str[off+byte_idx], byte_idx == inst->size-1 ? "}" : "");
+        }
+        else if(byte_idx < 8)
+        {
+          str8_list_push(scratch.arena, &code_bytes_strings, str8_lit("   "));
+        }
+      }
+      str8_list_push(scratch.arena, &code_bytes_strings, str8_lit(" "));
+      code_bytes_part = str8_list_join(arena, &code_bytes_strings, 0);
+      scratch_end(scratch);
+    }
+    String8 symbol_part = {0};
+    if(inst->jump_dest_vaddr != 0 && rdi != &rdi_parsed_nil && params->style_flags & DASM_StyleFlag_SymbolNames)
+    {
+      RDI_U32 scope_idx = rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_ScopeVMap, inst->jump_dest_vaddr-params->base_vaddr);
+      if(scope_idx != 0)
+      {
+        RDI_Scope *scope = rdi_element_from_name_idx(rdi, Scopes, scope_idx);
+        RDI_U32 procedure_idx = scope->proc_idx;
+        RDI_Procedure *procedure = rdi_element_from_name_idx(rdi, Procedures, procedure_idx);
+        String8 procedure_name = {0};
+        procedure_name.str = rdi_string_from_idx(rdi, procedure->name_string_idx, &procedure_name.size);
+        if(procedure_name.size != 0)
+        {
+          symbol_part = push_str8f(arena, " (%S)", procedure_name);
+        }
+      }
+    }
+    result.string = push_str8f(arena, "%S%S%S%S", addr_part, code_bytes_part, inst->string, symbol_part);
+  }
+  return result;
+}
+
+internal U64
+dasm_sync_off_from_rdi_range(RDI_Parsed *rdi, DASM_Params *params, Rng1U64 range)
+{
+  U64 result = range.min;
+  if(rdi != &rdi_parsed_nil && params->vaddr+range.min >= params->base_vaddr)
+  {
+    //- find line table covering the start of the range
+    U64 voff = (params->vaddr+range.min) - params->base_vaddr;
+    U64 voff_opl = voff + dim_1u64(range);
+    U32 unit_idx = rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_UnitVMap, voff);
+    RDI_Unit *unit = rdi_element_from_name_idx(rdi, Units, unit_idx);
+    RDI_LineTable *line_table = rdi_element_from_name_idx(rdi, LineTables, unit->line_table_idx);
+    RDI_ParsedLineTable unit_line_info = {0};
+    rdi_parsed_from_line_table(rdi, line_table, &unit_line_info);
+    
+    //- find first line start at or after the start of the range
+    U64 first = 0;
+    U64 opl = unit_line_info.count;
+    for(;first < opl;)
+    {
+      U64 mid = first + (opl - first)/2;
+      if(unit_line_info.voffs[mid] < voff)
+      {
+        first = mid+1;
+      }
+      else
+      {
+        opl = mid;
+      }
+    }
+    if(first < unit_line_info.count && unit_line_info.voffs[first] < voff_opl)
+    {
+      result = range.min + (unit_line_info.voffs[first] - voff);
+    }
+  }
+  return result;
+}
+
+internal void
+dasm_chunk_decode(Arena *arena, RDI_Parsed *rdi, DASM_Params *params, String8 data, DASM_Chunk *chunk)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  DASM_ChunkInstList insts = {0};
+  U64 off = chunk->range.min;
+  for(;off < chunk->range.max;)
+  {
+    DASM_ChunkInst inst = dasm_chunk_inst_from_data_off(arena, rdi, params, data, off);
+    if(inst.inst.size == 0)
+    {
+      chunk->is_broken = 1;
+      break;
+    }
+    DASM_ChunkInstNode *n = push_array(scratch.arena, DASM_ChunkInstNode, 1);
+    n->v = inst;
+    SLLQueuePush(insts.first, insts.last, n);
+    insts.count += 1;
+    off += inst.inst.size;
+  }
+  chunk->end_off = off;
+  chunk->inst_count = insts.count;
+  chunk->insts = push_array_no_zero(arena, DASM_ChunkInst, insts.count);
+  {
+    U64 idx = 0;
+    for(DASM_ChunkInstNode *n = insts.first; n != 0; n = n->next, idx += 1)
+    {
+      chunk->insts[idx] = n->v;
+    }
+  }
+  scratch_end(scratch);
+}
+
 ////////////////////////////////
 //~ rjf: Artifact Cache Hooks / Lookups
 
@@ -264,11 +425,106 @@ struct DASM_Artifact
   DASM_Info info;
 };
 
+typedef struct DASM_ChunkArtifact DASM_ChunkArtifact;
+struct DASM_ChunkArtifact
+{
+  Arena *arena;
+  DASM_Chunk chunk;
+};
+
+internal AC_Artifact
+dasm_chunk_artifact_create(String8 key, U64 gen, U64 *requested_gen, B32 *retry_out)
+{
+  DASM_ChunkArtifact *artifact = 0;
+  {
+    DI_Scope *di_scope = di_scope_open();
+    
+    //- rjf: unpack key
+    DASM_Params params = {0};
+    U64 chunk_size = 0;
+    U64 key_read_off = 0;
+    key_read_off += str8_deserial_read_struct(key, key_read_off, &params);
+    key_read_off += str8_deserial_read_struct(key, key_read_off, &chunk_size);
+    params.dbgi_key.path.str = key.str + key_read_off;
+    key_read_off += params.dbgi_key.path.size;
+    String8 data = str8_skip(key, key_read_off);
+    
+    //- rjf: get dbg info
+    B32 stale = 0;
+    RDI_Parsed *rdi = &rdi_parsed_nil;
+    if(params.dbgi_key.path.size != 0)
+    {
+      rdi = di_rdi_from_key(di_scope, &params.dbgi_key, 1, 0);
+      stale = (stale || (rdi == &rdi_parsed_nil));
+    }
+    
+    //- decode from the chunk's first known instruction boundary
+    if(!stale)
+    {
+      Arena *arena = arena_alloc();
+      artifact = push_array(arena, DASM_ChunkArtifact, 1);
+      artifact->arena = arena;
+      artifact->chunk.range.min = dasm_sync_off_from_rdi_range(rdi, &params, r1u64(0, chunk_size));
+      artifact->chunk.range.max = chunk_size;
+      dasm_chunk_decode(arena, rdi, &params, data, &artifact->chunk);
+    }
+    
+    //- rjf: if stale, retry
+    if(stale)
+    {
+      retry_out[0] = 1;
+    }
+    
+    di_scope_close(di_scope);
+  }
+  AC_Artifact result = {0};
+  result.u64[0] = (U64)artifact;
+  return result;
+}
+
+internal void
+dasm_chunk_artifact_destroy(AC_Artifact artifact)
+{
+  DASM_ChunkArtifact *chunk_artifact = (DASM_ChunkArtifact *)artifact.u64[0];
+  if(chunk_artifact == 0) { return; }
+  arena_release(chunk_artifact->arena);
+}
+
+internal DASM_Chunk *
+dasm_chunk_from_params_data(Access *access, DASM_Params *params, U64 chunk_size, String8 data)
+{
+  DASM_Chunk *chunk = 0;
+  {
+    Temp scratch = scratch_begin(0, 0);
+    
+    // form key - the chunk's bytes are part of its key, so that any range
+    // containing the same code at the same address shares decoded chunks
+    DASM_Params key_params = *params;
+    key_params.dbgi_key.path.str = 0;
+    String8List key_parts = {0};
+    str8_list_push(scratch.arena, &key_parts, str8_struct(&key_params));
+    str8_list_push(scratch.arena, &key_parts, str8_struct(&chunk_size));
+    str8_list_push(scratch.arena, &key_parts, params->dbgi_key.path);
+    str8_list_push(scratch.arena, &key_parts, data);
+    String8 key = str8_list_join(scratch.arena, &key_parts, 0);
+    
+    // get chunk
+    AC_Artifact artifact = ac_artifact_from_key(access, key, dasm_chunk_artifact_create, dasm_chunk_artifact_destroy, 0);
+    DASM_ChunkArtifact *chunk_artifact = (DASM_ChunkArtifact *)artifact.u64[0];
+    if(chunk_artifact)
+    {
+      chunk = &chunk_artifact->chunk;
+    }
+    
+    scratch_end(scratch);
+  }
+  return chunk;
+}
+
 internal AC_Artifact
 dasm_artifact_create(String8 key, U64 gen, U64 *requested_gen, B32 *retry_out)
 {
   DASM_Artifact *artifact = 0;
-  if(lane_idx() == 0)
   {
     Temp scratch = scratch_begin(0, 0);
     Access *access = access_open();
@@ -292,153 +548,160 @@ dasm_artifact_create(String8 key, U64 gen, U64 *requested_gen, B32 *retry_out)
       stale = (stale || (rdi == &rdi_parsed_nil));
     }
     
-    //- rjf: data * arch * addr * dbg -> decode artifacts
-    DASM_LineChunkList line_list = {0};
-    String8List inst_strings = {0};
+    //- split data into chunks & look up each chunk's decoding. chunks which
+    // are not yet decoded are requested all at once (and decoded in parallel),
+    // and this artifact is retried until all of them are available.
+    U64 chunks_count = 0;
+    DASM_Chunk **chunks = 0;
     switch(params.arch)
     {
       default:{}break;
-      
-      //- rjf: x86/x64 decoding
       case Arch_x64:
       case Arch_x86:
       {
-        // rjf: disassemble
-        RDI_SourceFile *last_file = &rdi_nil_element_union.source_file;
-        RDI_Line *last_line = 0;
-        for(U64 off = 0; off < data.size;)
+        chunks_count = (data.size + DASM_CHUNK_SIZE - 1) / DASM_CHUNK_SIZE;
+        chunks = push_array(scratch.arena, DASM_Chunk *, chunks_count);
+      }break;
+    }
+    for EachIndex(idx, chunks_count)
+    {
+      U64 chunk_off = idx*DASM_CHUNK_SIZE;
+      U64 chunk_size = Min(DASM_CHUNK_SIZE, data.size - chunk_off);
+      DASM_Params chunk_params = params;
+      chunk_params.vaddr += chunk_off;
+      chunk_params.lead_in_size = 0;
+      String8 chunk_data = str8_substr(data, r1u64(chunk_off, chunk_off + chunk_size + DASM_CHUNK_INST_SIZE_MAX));
+      chunks[idx] = dasm_chunk_from_params_data(access, &chunk_params, chunk_size, chunk_data);
+      stale = (stale || chunks[idx] == 0);
+    }
+    
+    //- chunks -> serial instruction list. each chunk's decoding is used from
+    // the first instruction boundary it shares with the previous chunk's
+    // decoding; up to that point, instructions are decoded serially. with a
+    // lead-in, nothing is output until the first such boundary past it.
+    DASM_ChunkInstList insts = {0};
+    if(!stale)
+    {
+      U64 off = 0;
+      B32 done = 0;
+      B32 is_synced = (params.lead_in_size == 0);
+      for(U64 chunk_idx = 0; chunk_idx < chunks_count && !done; chunk_idx += 1)
+      {
+        DASM_Chunk *chunk = chunks[chunk_idx];
+        U64 chunk_off = chunk_idx*DASM_CHUNK_SIZE;
+        U64 inst_idx = 0;
+        for(;!done && off < chunk_off + chunk->range.max;)
         {
-          // rjf: disassemble one instruction
-          DASM_Inst inst = dasm_inst_from_code(scratch.arena, params.arch, params.vaddr+off, str8_skip(data, off), params.syntax);
-          if(inst.size == 0)
+          for(;inst_idx < chunk->inst_count && chunk_off + chunk->insts[inst_idx].off < off; inst_idx += 1){}
+          if(inst_idx < chunk->inst_count && chunk_off + chunk->insts[inst_idx].off == off)
           {
+            is_synced = (is_synced || chunk_off >= params.lead_in_size);
+            for(;is_synced && inst_idx < chunk->inst_count; inst_idx += 1)
+            {
+              DASM_ChunkInstNode *n = push_array(scratch.arena, DASM_ChunkInstNode, 1);
+              n->v = chunk->insts[inst_idx];
+              n->v.off += chunk_off;
+              SLLQueuePush(insts.first, insts.last, n);
+              insts.count += 1;
+            }
+            off = chunk_off + chunk->end_off;
+            done = chunk->is_broken;
             break;
           }
-          
-          // rjf: push strings derived from voff -> line info
-          if(params.style_flags & (DASM_StyleFlag_SourceFilesNames|DASM_StyleFlag_SourceLines) &&
-             rdi != &rdi_parsed_nil)
+          DASM_ChunkInst inst = dasm_chunk_inst_from_data_off(scratch.arena, rdi, &params, data, off);
+          if(inst.inst.size == 0)
           {
-            U64 voff = (params.vaddr+off) - params.base_vaddr;
-            U32 unit_idx = rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_UnitVMap, voff);
-            RDI_Unit *unit = rdi_element_from_name_idx(rdi, Units, unit_idx);
-            RDI_LineTable *line_table = rdi_element_from_name_idx(rdi, LineTables, unit->line_table_idx);
-            RDI_ParsedLineTable unit_line_info = {0};
-            rdi_parsed_from_line_table(rdi, line_table, &unit_line_info);
-            U64 line_info_idx = rdi_line_info_idx_from_voff(&unit_line_info, voff);
-            if(line_info_idx < unit_line_info.count)
-            {
-              RDI_Line *line = &unit_line_info.lines[line_info_idx];
-              RDI_SourceFile *file = rdi_element_from_name_idx(rdi, SourceFiles, line->file_idx);
-              String8 file_normalized_full_path = {0};
-              file_normalized_full_path.str = rdi_string_from_idx(rdi, file->normal_full_path_string_idx, &file_normalized_full_path.size);
-              if(file != last_file)
-              {
-                if(params.style_flags & DASM_StyleFlag_SourceFilesNames &&
-                   file->normal_full_path_string_idx != 0 && file_normalized_full_path.size != 0)
-                {
-                  String8 inst_string = push_str8f(scratch.arena, "> %S", file_normalized_full_path);
-                  DASM_Line inst = {u32_from_u64_saturate(off), DASM_LineFlag_Decorative, 0, r1u64(inst_strings.total_size + inst_strings.node_count,
-                                                                                                   inst_strings.total_size + inst_strings.node_count + inst_string.size)};
-                  dasm_line_chunk_list_push(scratch.arena, &line_list, 1024, &inst);
-                  str8_list_push(scratch.arena, &inst_strings, inst_string);
-                }
-                if(params.style_flags & DASM_StyleFlag_SourceFilesNames && file->normal_full_path_string_idx == 0)
-                {
-                  String8 inst_string = str8_lit(">");
-                  DASM_Line inst = {u32_from_u64_saturate(off), DASM_LineFlag_Decorative, 0, r1u64(inst_strings.total_size + inst_strings.node_count,
-                                                                                                   inst_strings.total_size + inst_strings.node_count + inst_string.size)};
-                  dasm_line_chunk_list_push(scratch.arena, &line_list, 1024, &inst);
-                  str8_list_push(scratch.arena, &inst_strings, inst_string);
-                }
-                last_file = file;
-              }
-              if(line && line != last_line && file->normal_full_path_string_idx != 0 &&
-                 params.style_flags & DASM_StyleFlag_SourceLines &&
-                 file_normalized_full_path.size != 0)
-              {
-                FileProperties props = os_properties_from_file_path(file_normalized_full_path);
-                if(props.modified != 0)
-                {
-                  // TODO(rjf): need redirection path - this may map to a different path on the local machine,
-                  // need frontend to communicate path remapping info to this layer
-                  C_Key key = fs_key_from_path_range(file_normalized_full_path, r1u64(0, max_U64), 0);
-                  TXT_LangKind lang_kind = txt_lang_kind_from_extension(file_normalized_full_path);
-                  U64 endt_us = max_U64;
-                  U128 hash = {0};
-                  TXT_TextInfo text_info = txt_text_info_from_key_lang(access, key, lang_kind, &hash);
-                  stale = (stale || u128_match(hash, u128_zero()));
-                  if(0 < line->line_num && line->line_num < text_info.lines_count)
-                  {
-                    String8 data = c_data_from_hash(access, hash);
-                    String8 line_text = str8_skip_chop_whitespace(str8_substr(data, text_info.lines_ranges[line->line_num-1]));
-                    if(line_text.size != 0)
-                    {
-                      String8 inst_string = push_str8f(scratch.arena, "> %S", line_text);
-                      DASM_Line inst = {u32_from_u64_saturate(off), DASM_LineFlag_Decorative, 0, r1u64(inst_strings.total_size + inst_strings.node_count,
-                                                                                                       inst_strings.total_size + inst_strings.node_count + inst_string.size)};
-                      dasm_line_chunk_list_push(scratch.arena, &line_list, 1024, &inst);
-                      str8_list_push(scratch.arena, &inst_strings, inst_string);
-                    }
-                  }
-                }
-                last_line = line;
-              }
-            }
+            done = 1;
+            break;
           }
-          
-          // rjf: push line
-          String8 addr_part = {0};
-          if(params.style_flags & DASM_StyleFlag_Addresses)
+          if(is_synced)
           {
-            addr_part = push_str8f(scratch.arena, "%s0x%016I64x  ", rdi != &rdi_parsed_nil ? "  " : "", params.vaddr+off);
+            DASM_ChunkInstNode *n = push_array(scratch.arena, DASM_ChunkInstNode, 1);
+            n->v = inst;
+            SLLQueuePush(insts.first, insts.last, n);
+            insts.count += 1;
           }
-          String8 code_bytes_part = {0};
-          if(params.style_flags & DASM_StyleFlag_CodeBytes)
+          off += inst.inst.size;
+        }
+      }
+    }
+    
+    //- instructions -> lines & strings, with source decorations
+    DASM_LineChunkList line_list = {0};
+    String8List inst_strings = {0};
+    {
+      RDI_SourceFile *last_file = &rdi_nil_element_union.source_file;
+      U64 last_line_id = 0;
+      for(DASM_ChunkInstNode *n = insts.first; n != 0; n = n->next)
+      {
+        DASM_ChunkInst *ci = &n->v;
+        U64 off = ci->off;
+        
+        // rjf: push strings derived from voff -> line info
+        if(ci->line_id != 0)
+        {
+          RDI_SourceFile *file = rdi_element_from_name_idx(rdi, SourceFiles, ci->file_idx);
+          String8 file_normalized_full_path = {0};
+          file_normalized_full_path.str = rdi_string_from_idx(rdi, file->normal_full_path_string_idx, &file_normalized_full_path.size);
+          if(file != last_file)
           {
-            String8List code_bytes_strings = {0};
-            str8_list_push(scratch.arena, &code_bytes_strings, str8_lit("{"));
-            for(U64 byte_idx = 0; byte_idx < inst.size || byte_idx < 16; byte_idx += 1)
+            if(params.style_flags & DASM_StyleFlag_SourceFilesNames &&
+               file->normal_full_path_string_idx != 0 && file_normalized_full_path.size != 0)
             {
-              if(byte_idx < inst.size)
-              {
-                str8_list_pushf(scratch.arena, &code_bytes_strings, "%02x%s ", (U32)data.str[off+byte_idx], byte_idx == inst.size-1 ? "}" : "");
-              }
-              else if(byte_idx < 8)
-              {
-                str8_list_push(scratch.arena, &code_bytes_strings, str8_lit("   "));
-              }
+              String8 inst_string = push_str8f(scratch.arena, "> %S", file_normalized_full_path);
+              DASM_Line inst = {u32_from_u64_saturate(off), DASM_LineFlag_Decorative, 0, r1u64(inst_strings.total_size + inst_strings.node_count,
+                                                                                               inst_strings.total_size + inst_strings.node_count + inst_string.size)};
+              dasm_line_chunk_list_push(scratch.arena, &line_list, 1024, &inst);
+              str8_list_push(scratch.arena, &inst_strings, inst_string);
             }
-            str8_list_push(scratch.arena, &code_bytes_strings, str8_lit(" "));
-            code_bytes_part = str8_list_join(scratch.arena, &code_bytes_strings, 0);
+            if(params.style_flags & DASM_StyleFlag_SourceFilesNames && file->normal_full_path_string_idx == 0)
+            {
+              String8 inst_string = str8_lit(">");
+              DASM_Line inst = {u32_from_u64_saturate(off), DASM_LineFlag_Decorative, 0, r1u64(inst_strings.total_size + inst_strings.node_count,
+                                                                                               inst_strings.total_size + inst_strings.node_count + inst_string.size)};
+              dasm_line_chunk_list_push(scratch.arena, &line_list, 1024, &inst);
+              str8_list_push(scratch.arena, &inst_strings, inst_string);
+            }
+            last_file = file;
           }
-          String8 symbol_part = {0};
-          if(inst.jump_dest_vaddr != 0 && rdi != &rdi_parsed_nil && params.style_flags & DASM_StyleFlag_SymbolNames)
+          if(ci->line_id != last_line_id && file->normal_full_path_string_idx != 0 &&
+             params.style_flags & DASM_StyleFlag_SourceLines &&
+             file_normalized_full_path.size != 0)
           {
-            RDI_U32 scope_idx = rdi_vmap_idx_from_section_kind_voff(rdi, RDI_SectionKind_ScopeVMap, inst.jump_dest_vaddr-params.base_vaddr);
-            if(scope_idx != 0)
+            FileProperties props = os_properties_from_file_path(file_normalized_full_path);
+            if(props.modified != 0)
             {
-              RDI_Scope *scope = rdi_element_from_name_idx(rdi, Scopes, scope_idx);
-              RDI_U32 procedure_idx = scope->proc_idx;
-              RDI_Procedure *procedure = rdi_element_from_name_idx(rdi, Procedures, procedure_idx);
-              String8 procedure_name = {0};
-              procedure_name.str = rdi_string_from_idx(rdi, procedure->name_string_idx, &procedure_name.size);
-              if(procedure_name.size != 0)
+              // TODO(rjf): need redirection path - this may map to a different path on the local machine,
+              // need frontend to communicate path remapping info to this layer
+              C_Key key = fs_key_from_path_range(file_normalized_full_path, r1u64(0, max_U64), 0);
+              TXT_LangKind lang_kind = txt_lang_kind_from_extension(file_normalized_full_path);
+              U128 hash = {0};
+              TXT_TextInfo text_info = txt_text_info_from_key_lang(access, key, lang_kind, &hash);
+              stale = (stale || u128_match(hash, u128_zero()));
+              if(0 < ci->line_num && ci->line_num < text_info.lines_count)
               {
-                symbol_part = push_str8f(scratch.arena, " (%S)", procedure_name);
+                String8 data = c_data_from_hash(access, hash);
+                String8 line_text = str8_skip_chop_whitespace(str8_substr(data, text_info.lines_ranges[ci->line_num-1]));
+                if(line_text.size != 0)
+                {
+                  String8 inst_string = push_str8f(scratch.arena, "> %S", line_text);
+                  DASM_Line inst = {u32_from_u64_saturate(off), DASM_LineFlag_Decorative, 0, r1u64(inst_strings.total_size + inst_strings.node_count,
+                                                                                                   inst_strings.total_size + inst_strings.node_count + inst_string.size)};
+                  dasm_line_chunk_list_push(scratch.arena, &line_list, 1024, &inst);
+                  str8_list_push(scratch.arena, &inst_strings, inst_string);
+                }
               }
             }
+            last_line_id = ci->line_id;
           }
-          String8 inst_string = push_str8f(scratch.arena, "%S%S%S%S", addr_part, code_bytes_part, inst.string, symbol_part);
-          DASM_Line line = {u32_from_u64_saturate(off), 0, inst.jump_dest_vaddr, r1u64(inst_strings.total_size + inst_strings.node_count,
-                                                                                       inst_strings.total_size + inst_strings.node_count + inst_string.size)};
-          dasm_line_chunk_list_push(scratch.arena, &line_list, 1024, &line);
-          str8_list_push(scratch.arena, &inst_strings, inst_string);
-          
-          // rjf: increment
-          off += inst.size;
         }
-      }break;
+        
+        // rjf: push line
+        DASM_Line line = {u32_from_u64_saturate(off), 0, ci->inst.jump_dest_vaddr, r1u64(inst_strings.total_size + inst_strings.node_count,
+                                                                                         inst_strings.total_size + inst_strings.node_count + ci->string.size)};
+        dasm_line_chunk_list_push(scratch.arena, &line_list, 1024, &line);
+        str8_list_push(scratch.arena, &inst_strings, ci->string);
+      }
     }
     
     //- rjf: artifacts -> value bundle
@@ -482,7 +745,6 @@ dasm_artifact_create(String8 key, U64 gen, U64 *requested_gen, B32 *retry_out)
     access_close(access);
     scratch_end(scratch);
   }
-  lane_sync_u64(&artifact, 0);
   AC_Artifact result = {0};
   result.u64[0] = (U64)artifact;
   return result;
@@ -512,7 +774,7 @@ dasm_info_from_hash_params(Access *access, U128 hash, DASM_Params *params)
     String8 key = str8_list_join(scratch.arena, &key_parts, 0);
     
     // rjf: get info
-    AC_Artifact artifact = ac_artifact_from_key(access, key, dasm_artifact_create, dasm_artifact_destroy, 0, .gen = fs_change_gen(), .flags = AC_Flag_Wide);
+    AC_Artifact artifact = ac_artifact_from_key(access, key, dasm_artifact_create, dasm_artifact_destroy, 0, .gen = fs_change_gen());
     DASM_Artifact *dasm_artifact = (DASM_Artifact *)artifact.u64[0];
     if(dasm_artifact)
     {
@@ -98,6 +98,7 @@ struct DASM_Params
   DASM_Syntax syntax;
   U64 base_vaddr;
   DI_Key dbgi_key;
+  U64 lead_in_size; // leading bytes only decoded to find an instruction boundary, not output
 };
 
 ////////////////////////////////
@@ -161,6 +162,66 @@ struct DASM_LineArray
   U64 count;
 };
 
+////////////////////////////////
+//~ Chunked Decoding Types
+
+// NOTE: ranges are split into chunks of DASM_CHUNK_SIZE bytes, each of which
+// is its own artifact - keyed by its address, bytes, & parameters - so chunks
+// are decoded in parallel, & are shared by any ranges containing them. Each
+// chunk starts decoding at the first line table entry inside of it, when debug
+// info is available, as those are known instruction boundaries. When a
+// chunk's decoding does not line up with where the previous chunk's decoding
+// ended, it is resynchronized by decoding serially from that point until the
+// two agree on an instruction boundary - so the output always matches a
+// serial decode of the whole range.
+
+#define DASM_CHUNK_SIZE KB(16)
+#define DASM_CHUNK_INST_SIZE_MAX 15
+
+// NOTE: views decode ranges larger than DASM_WINDOW_SIZE only a window at a
+// time, around the address they are looking at. A window which does not start
+// at the start of the range may not start at an instruction boundary, so one
+// more chunk before it is decoded as a lead-in, & output starts at the first
+// instruction where the lead-in's decoding agrees with the window's.
+
+#define DASM_WINDOW_SIZE (DASM_CHUNK_SIZE*16)
+
+typedef struct DASM_ChunkInst DASM_ChunkInst;
+struct DASM_ChunkInst
+{
+  U64 off;
+  DASM_Inst inst;
+  String8 string;
+  U64 line_id;
+  U32 file_idx;
+  U32 line_num;
+};
+
+typedef struct DASM_ChunkInstNode DASM_ChunkInstNode;
+struct DASM_ChunkInstNode
+{
+  DASM_ChunkInstNode *next;
+  DASM_ChunkInst v;
+};
+
+typedef struct DASM_ChunkInstList DASM_ChunkInstList;
+struct DASM_ChunkInstList
+{
+  DASM_ChunkInstNode *first;
+  DASM_ChunkInstNode *last;
+  U64 count;
+};
+
+typedef struct DASM_Chunk DASM_Chunk;
+struct DASM_Chunk
+{
+  Rng1U64 range;
+  DASM_ChunkInst *insts;
+  U64 inst_count;
+  U64 end_off;
+  B32 is_broken;
+};
+
 ////////////////////////////////
 //~ rjf: Value Bundle Type
 
@@ -191,12 +252,22 @@ internal B32 dasm_params_match(DASM_Params *a, DASM_Params *b);
 
 internal void dasm_line_chunk_list_push(Arena *arena, DASM_LineChunkList *list, U64 cap, DASM_Line *line);
 internal DASM_LineArray dasm_line_array_from_chunk_list(Arena *arena, DASM_LineChunkList *list);
-internal U64 dasm_line_array_idx_from_code_off__linear_scan(DASM_LineArray *array, U64 off);
+internal U64 dasm_line_array_idx_from_code_off(DASM_LineArray *array, U64 off);
 internal U64 dasm_line_array_code_off_from_idx(DASM_LineArray *array, U64 idx);
 
+////////////////////////////////
+//~ Chunked Decoding Functions
+
+internal DASM_ChunkInst dasm_chunk_inst_from_data_off(Arena *arena, RDI_Parsed *rdi, DASM_Params *params, String8 data, U64 off);
+internal U64 dasm_sync_off_from_rdi_range(RDI_Parsed *rdi, DASM_Params *params, Rng1U64 range);
+internal void dasm_chunk_decode(Arena *arena, RDI_Parsed *rdi, DASM_Params *params, String8 data, DASM_Chunk *chunk);
+
 ////////////////////////////////
 //~ rjf: Artifact Cache Hooks / Lookups
 
+internal AC_Artifact dasm_chunk_artifact_create(String8 key, U64 gen, U64 *requested_gen, B32 *retry_out);
+internal void dasm_chunk_artifact_destroy(AC_Artifact artifact);
+internal DASM_Chunk *dasm_chunk_from_params_data(Access *access, DASM_Params *params, U64 chunk_size, String8 data);
 internal AC_Artifact dasm_artifact_create(String8 key, U64 gen, U64 *requested_gen, B32 *retry_out);
 internal void dasm_artifact_destroy(AC_Artifact artifact);
 internal DASM_Info dasm_info_from_hash_params(Access *access, U128 hash, DASM_Params *params);
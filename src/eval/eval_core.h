@@ -73,6 +73,7 @@ enum
 {
   E_IRExtKind_Bytecode = RDI_EvalOp_COUNT,
   E_IRExtKind_SetSpace,
+  E_IRExtKind_BatchInput,
   E_IRExtKind_COUNT
 };
 
@@ -6,3 +6,4 @@
 #include "eval/eval_parse.c"
 #include "eval/eval_ir.c"
 #include "eval/eval_interpret.c"
+#include "eval/eval_jit.c"
@@ -9,5 +9,6 @@
 #include "eval/eval_parse.h"
 #include "eval/eval_ir.h"
 #include "eval/eval_interpret.h"
+#include "eval/eval_jit.h"
 
 #endif // EVAL_INC_H
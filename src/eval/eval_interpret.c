@@ -95,8 +95,498 @@ e_space_write(E_Space space, void *in, Rng1U64 range)
 ////////////////////////////////
 //~ rjf: Interpretation Functions
 
+internal E_InterpretationCode
+e_interpret_value_op(RDI_EvalOp op, E_Value imm, E_Value *svals, E_Value *nval)
+{
+  E_InterpretationCode result = E_InterpretationCode_Good;
+  switch(op)
+  {
+    default:{}break;
+    
+    case RDI_EvalOp_Abs:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->f32 = svals[0].f32;
+        if(svals[0].f32 < 0)
+        {
+          nval->f32 = -svals[0].f32;
+        }
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->f64 = svals[0].f64;
+        if(svals[0].f64 < 0)
+        {
+          nval->f64 = -svals[0].f64;
+        }
+      }
+      else
+      {
+        nval->s64 = svals[0].s64;
+        if(svals[0].s64 < 0)
+        {
+          nval->s64 = -svals[0].s64;
+        }
+      }
+    }break;
+    
+    case RDI_EvalOp_Neg:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->f32 = -svals[0].f32;
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->f64 = -svals[0].f64;
+      }
+      else
+      {
+        nval->u64 = (~svals[0].u64) + 1;
+      }
+    }break;
+    
+    case RDI_EvalOp_Add:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->f32 = svals[0].f32 + svals[1].f32;
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->f64 = svals[0].f64 + svals[1].f64;
+      }
+      else
+      {
+        nval->u64 = svals[0].u64 + svals[1].u64;
+      }
+    }break;
+    
+    case RDI_EvalOp_Sub:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->f32 = svals[0].f32 - svals[1].f32;
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->f64 = svals[0].f64 - svals[1].f64;
+      }
+      else
+      {
+        nval->u64 = svals[0].u64 - svals[1].u64;
+      }
+    }break;
+    
+    case RDI_EvalOp_Mul:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->f32 = svals[0].f32*svals[1].f32;
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->f64 = svals[0].f64*svals[1].f64;
+      }
+      else
+      {
+        nval->u64 = svals[0].u64*svals[1].u64;
+      }
+    }break;
+    
+    case RDI_EvalOp_Div:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        if(svals[1].f32 != 0.f)
+        {
+          nval->f32 = svals[0].f32/svals[1].f32;
+        }
+        else
+        {
+          result = E_InterpretationCode_DivideByZero;
+        }
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        if(svals[1].f64 != 0.)
+        {
+          nval->f64 = svals[0].f64/svals[1].f64;
+        }
+        else
+        {
+          result = E_InterpretationCode_DivideByZero;
+        }
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_U ||
+              imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        if(svals[1].u64 != 0)
+        {
+          nval->u64 = svals[0].u64/svals[1].u64;
+        }
+        else
+        {
+          result = E_InterpretationCode_DivideByZero;
+        }
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_Mod:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        if(svals[1].u64 != 0)
+        {
+          nval->u64 = svals[0].u64%svals[1].u64;
+        }
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_LShift:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = svals[0].u64 << svals[1].u64;
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_RShift:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U)
+      {
+        nval->u64 = svals[0].u64 >> svals[1].u64;
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = svals[0].s64 >> svals[1].u64;
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_BitAnd:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = svals[0].u64&svals[1].u64;
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_BitOr:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = svals[0].u64|svals[1].u64;
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_BitXor:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = svals[0].u64^svals[1].u64;
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_BitNot:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = ~svals[0].u64;
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_LogAnd:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = (svals[0].u64 && svals[1].u64);
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_LogOr:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = (svals[0].u64 || svals[1].u64);
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_LogNot:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_U ||
+         imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = (!svals[0].u64);
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_EqEq:
+    {
+      B32 match = MemoryMatchArray(svals[0].u512.u64, svals[1].u512.u64);
+      nval->u64 = !!match;
+    }break;
+    
+    case RDI_EvalOp_NtEq:
+    {
+      B32 match = MemoryMatchArray(svals[0].u512.u64, svals[1].u512.u64);
+      nval->u64 = !match;
+    }break;
+    
+    case RDI_EvalOp_LsEq:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->u64 = (svals[0].f32 <= svals[1].f32);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->u64 = (svals[0].f64 <= svals[1].f64);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_U)
+      {
+        nval->u64 = (svals[0].u64 <= svals[1].u64);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = (svals[0].s64 <= svals[1].s64);
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_GrEq:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->u64 = (svals[0].f32 >= svals[1].f32);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->u64 = (svals[0].f64 >= svals[1].f64);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_U)
+      {
+        nval->u64 = (svals[0].u64 >= svals[1].u64);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = (svals[0].s64 >= svals[1].s64);
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_Less:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->u64 = (svals[0].f32 < svals[1].f32);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->u64 = (svals[0].f64 < svals[1].f64);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_U)
+      {
+        nval->u64 = (svals[0].u64 < svals[1].u64);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = (svals[0].s64 < svals[1].s64);
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_Grtr:
+    {
+      if(imm.u64 == RDI_EvalTypeGroup_F32)
+      {
+        nval->u64 = (svals[0].f32 > svals[1].f32);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_F64)
+      {
+        nval->u64 = (svals[0].f64 > svals[1].f64);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_U)
+      {
+        nval->u64 = (svals[0].u64 > svals[1].u64);
+      }
+      else if(imm.u64 == RDI_EvalTypeGroup_S)
+      {
+        nval->u64 = (svals[0].s64 > svals[1].s64);
+      }
+      else
+      {
+        result = E_InterpretationCode_BadOpTypes;
+      }
+    }break;
+    
+    case RDI_EvalOp_Trunc:
+    {
+      if(0 < imm.u64)
+      {
+        U64 mask = 0;
+        if(imm.u64 < 64)
+        {
+          mask = max_U64 >> (64 - imm.u64);
+        }
+        nval->u64 = svals[0].u64&mask;
+      }
+    }break;
+    
+    case RDI_EvalOp_TruncSigned:
+    {
+      if(0 < imm.u64)
+      {
+        U64 mask = 0;
+        if(imm.u64 < 64)
+        {
+          mask = max_U64 >> (64 - imm.u64);
+        }
+        U64 high = 0;
+        if(svals[0].u64 & (1 << (imm.u64 - 1)))
+        {
+          high = ~mask;
+        }
+        nval->u64 = high|(svals[0].u64&mask);
+      }
+    }break;
+    
+    case RDI_EvalOp_Convert:
+    {
+      U32 in = imm.u64&0xFF;
+      U32 out = (imm.u64 >> 8)&0xFF;
+      if(in != out)
+      {
+        switch(in + out*RDI_EvalTypeGroup_COUNT)
+        {
+          case RDI_EvalTypeGroup_F32 + RDI_EvalTypeGroup_U*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->u64 = (U64)svals[0].f32;
+          }break;
+          case RDI_EvalTypeGroup_F64 + RDI_EvalTypeGroup_U*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->u64 = (U64)svals[0].f64;
+          }break;
+          
+          case RDI_EvalTypeGroup_F32 + RDI_EvalTypeGroup_S*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->s64 = (S64)svals[0].f32;
+          }break;
+          case RDI_EvalTypeGroup_F64 + RDI_EvalTypeGroup_S*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->s64 = (S64)svals[0].f64;
+          }break;
+          
+          case RDI_EvalTypeGroup_U + RDI_EvalTypeGroup_F32*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->f32 = (F32)svals[0].u64;
+          }break;
+          case RDI_EvalTypeGroup_S + RDI_EvalTypeGroup_F32*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->f32 = (F32)svals[0].s64;
+          }break;
+          case RDI_EvalTypeGroup_F64 + RDI_EvalTypeGroup_F32*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->f32 = (F32)svals[0].f64;
+          }break;
+          
+          case RDI_EvalTypeGroup_U + RDI_EvalTypeGroup_F64*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->f64 = (F64)svals[0].u64;
+          }break;
+          case RDI_EvalTypeGroup_S + RDI_EvalTypeGroup_F64*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->f64 = (F64)svals[0].s64;
+          }break;
+          case RDI_EvalTypeGroup_F32 + RDI_EvalTypeGroup_F64*RDI_EvalTypeGroup_COUNT:
+          {
+            nval->f64 = (F64)svals[0].f32;
+          }break;
+        }
+      }
+    }break;
+    
+    case RDI_EvalOp_ByteSwap:
+    {
+      U64 byte_size = imm.u64;
+      switch(byte_size)
+      {
+        default:
+        {
+          result = E_InterpretationCode_BadOp;
+        }break;
+        case 2:{nval->u16 = bswap_u16(svals[0].u16);}break;
+        case 4:{nval->u32 = bswap_u32(svals[0].u32);}break;
+        case 8:{nval->u64 = bswap_u64(svals[0].u64);}break;
+      }
+    }break;
+  }
+  return result;
+}
+
 internal E_Interpretation
-e_interpret(String8 bytecode)
+e_interpret__switch(String8 bytecode)
 {
   E_Interpretation result = {0};
   Temp scratch = scratch_begin(0, 0);
@@ -295,579 +785,563 @@ e_interpret(String8 bytecode)
         ptr += imm.u64;
       }break;
       
-      case RDI_EvalOp_Abs:
+      case RDI_EvalOp_Pick:
       {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          nval.f32 = svals[0].f32;
-          if(svals[0].f32 < 0)
-          {
-            nval.f32 = -svals[0].f32;
-          }
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
+        if(stack_count > imm.u64)
         {
-          nval.f64 = svals[0].f64;
-          if(svals[0].f64 < 0)
-          {
-            nval.f64 = -svals[0].f64;
-          }
+          nval = stack[stack_count - imm.u64 - 1];
         }
         else
         {
-          nval.s64 = svals[0].s64;
-          if(svals[0].s64 < 0)
-          {
-            nval.s64 = -svals[0].s64;
-          }
+          result.code = E_InterpretationCode_BadOp;
+          goto done;
         }
       }break;
       
-      case RDI_EvalOp_Neg:
+      case RDI_EvalOp_Pop:
       {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          nval.f32 = -svals[0].f32;
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
-        {
-          nval.f64 = -svals[0].f64;
-        }
-        else
-        {
-          nval.u64 = (~svals[0].u64) + 1;
-        }
-      }break;
-      
-      case RDI_EvalOp_Add:
-      {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          nval.f32 = svals[0].f32 + svals[1].f32;
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
-        {
-          nval.f64 = svals[0].f64 + svals[1].f64;
-        }
-        else
-        {
-          nval.u64 = svals[0].u64 + svals[1].u64;
-        }
-      }break;
-      
-      case RDI_EvalOp_Sub:
-      {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          nval.f32 = svals[0].f32 - svals[1].f32;
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
-        {
-          nval.f64 = svals[0].f64 - svals[1].f64;
-        }
-        else
-        {
-          nval.u64 = svals[0].u64 - svals[1].u64;
-        }
-      }break;
-      
-      case RDI_EvalOp_Mul:
-      {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          nval.f32 = svals[0].f32*svals[1].f32;
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
-        {
-          nval.f64 = svals[0].f64*svals[1].f64;
-        }
-        else
-        {
-          nval.u64 = svals[0].u64*svals[1].u64;
-        }
+        // do nothing - the pop is handled by the control bits
       }break;
       
-      case RDI_EvalOp_Div:
+      case RDI_EvalOp_Insert:
       {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          if(svals[1].f32 != 0.f)
-          {
-            nval.f32 = svals[0].f32/svals[1].f32;
-          }
-          else
-          {
-            result.code = E_InterpretationCode_DivideByZero;
-            goto done;
-          }
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
-        {
-          if(svals[1].f64 != 0.)
-          {
-            nval.f64 = svals[0].f64/svals[1].f64;
-          }
-          else
-          {
-            result.code = E_InterpretationCode_DivideByZero;
-            goto done;
-          }
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_U ||
-                imm.u64 == RDI_EvalTypeGroup_S)
+        if(stack_count > imm.u64)
         {
-          if(svals[1].u64 != 0)
-          {
-            nval.u64 = svals[0].u64/svals[1].u64;
-          }
-          else
+          if(imm.u64 > 0)
           {
-            result.code = E_InterpretationCode_DivideByZero;
-            goto done;
+            E_Value tval = stack[stack_count - 1];
+            E_Value *dst = stack + stack_count - 1 - imm.u64;
+            E_Value *shift = dst + 1;
+            MemoryCopy(shift, dst, imm.u64*sizeof(E_Value));
+            *dst = tval;
           }
         }
         else
         {
-          result.code = E_InterpretationCode_BadOpTypes;
+          result.code = E_InterpretationCode_BadOp;
           goto done;
         }
       }break;
       
-      case RDI_EvalOp_Mod:
+      case RDI_EvalOp_ValueRead:
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          if(svals[1].u64 != 0)
-          {
-            nval.u64 = svals[0].u64%svals[1].u64;
-          }
-        }
-        else
+        U64 bytes_to_read = imm.u64;
+        U64 offset = svals[0].u64;
+        if(offset + bytes_to_read <= sizeof(E_Value))
         {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
+          E_Value src_val = svals[1];
+          MemoryCopy(&nval.u512.u64[0], (U8 *)(&src_val.u512.u64[0]) + offset, bytes_to_read);
         }
       }break;
       
-      case RDI_EvalOp_LShift:
+      default:
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = svals[0].u64 << svals[1].u64;
-        }
-        else
+        result.code = e_interpret_value_op(op, imm, svals, &nval);
+        if(result.code != E_InterpretationCode_Good)
         {
-          result.code = E_InterpretationCode_BadOpTypes;
           goto done;
         }
       }break;
-      
-      case RDI_EvalOp_RShift:
+    }
+    
+    // rjf: push
+    {
+      U64 push_count = RDI_PUSHN_FROM_CTRLBITS(ctrlbits);
+      if(push_count == 1)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U)
-        {
-          nval.u64 = svals[0].u64 >> svals[1].u64;
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_S)
+        if(stack_count < stack_cap)
         {
-          nval.u64 = svals[0].s64 >> svals[1].u64;
+          stack[stack_count] = nval;
+          stack_count += 1;
         }
         else
         {
-          result.code = E_InterpretationCode_BadOpTypes;
+          result.code = E_InterpretationCode_InsufficientStackSpace;
           goto done;
         }
-      }break;
-      
-      case RDI_EvalOp_BitAnd:
+      }
+    }
+  }
+  done:;
+  
+  if(stack_count >= 1)
+  {
+    result.value = stack[0];
+  }
+  result.space = selected_space;
+  scratch_end(scratch);
+  return result;
+}
+
+internal E_Interpretation
+e_interpret(String8 bytecode)
+{
+  E_Interpretation result = {0};
+  E_JITFunction *jit_function = e_jit_function_from_bytecode(bytecode, E_JIT_HOT_HIT_COUNT);
+  if(jit_function != 0)
+  {
+    result = e_jit_interpret(jit_function);
+  }
+  else
+  {
+    result = e_interpret__switch(bytecode);
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Batch Interpretation Functions
+
+internal void
+e_interpret_batch_lane_fail(E_Interpretation *result, U64 *slots, U64 count, U64 lane_idx, U64 depth, E_Space space, E_InterpretationCode code)
+{
+  MemoryZeroStruct(result);
+  if(depth >= 1)
+  {
+    result->value.u64 = slots[lane_idx];
+  }
+  result->space = space;
+  result->code = code;
+}
+
+internal void
+e_interpret_batch_value_op(RDI_EvalOp op, E_Value imm, U64 *slots, U64 count, U64 depth, U64 pop_count, U64 push_count, E_Space space, E_Interpretation *results)
+{
+  U64 *s0 = slots + depth*count;
+  for EachIndex(lane_idx, count)
+  {
+    if(results[lane_idx].code == E_InterpretationCode_Good)
+    {
+      E_Value svals[2] = {0};
+      for EachIndex(pop_idx, pop_count)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = svals[0].u64&svals[1].u64;
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_BitOr:
+        svals[pop_idx].u64 = s0[pop_idx*count + lane_idx];
+      }
+      E_Value nval = {0};
+      E_InterpretationCode code = e_interpret_value_op(op, imm, svals, &nval);
+      if(code != E_InterpretationCode_Good)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = svals[0].u64|svals[1].u64;
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_BitXor:
+        e_interpret_batch_lane_fail(&results[lane_idx], slots, count, lane_idx, depth, space, code);
+      }
+      else if(push_count == 1)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = svals[0].u64^svals[1].u64;
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_BitNot:
+        s0[lane_idx] = nval.u64;
+      }
+    }
+  }
+}
+
+internal void
+e_interpret_batch(String8 bytecode, U64 count, U64 *inputs, E_Interpretation *results_out)
+{
+  Temp scratch = scratch_begin(0, 0);
+  MemoryZero(results_out, sizeof(results_out[0])*count);
+  
+  //- scan bytecode - find input placeholders, determine maximum stack
+  // depth, & determine whether all lanes can be run in lockstep
+  B32 is_lockstep = (bytecode.size != 0);
+  B32 is_stopped = 0;
+  U64 max_depth = 0;
+  U64 input_off_count = 0;
+  U64 *input_offs = push_array_no_zero(scratch.arena, U64, bytecode.size/9 + 1);
+  {
+    U64 depth = 0;
+    U8 *ptr = bytecode.str;
+    U8 *opl = bytecode.str + bytecode.size;
+    for(;ptr < opl;)
+    {
+      // rjf: consume next opcode
+      U8 op = *ptr;
+      U16 ctrlbits = 0;
+      if(op < RDI_EvalOp_COUNT)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = ~svals[0].u64;
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_LogAnd:
+        ctrlbits = rdi_eval_op_ctrlbits_table[op];
+      }
+      else if(op == E_IRExtKind_SetSpace)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = (svals[0].u64 && svals[1].u64);
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_LogOr:
+        ctrlbits = RDI_EVAL_CTRLBITS(32, 0, 0);
+      }
+      else if(op == E_IRExtKind_BatchInput)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = (svals[0].u64 || svals[1].u64);
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_LogNot:
+        ctrlbits = RDI_EVAL_CTRLBITS(8, 0, 1);
+        input_offs[input_off_count] = (U64)(ptr - bytecode.str);
+        input_off_count += 1;
+      }
+      else
       {
-        if(imm.u64 == RDI_EvalTypeGroup_U ||
-           imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = (!svals[0].u64);
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
+        is_lockstep = is_lockstep && is_stopped;
+        break;
+      }
+      ptr += 1;
       
-      case RDI_EvalOp_EqEq:
+      // rjf: decode
+      U64 decode_size = RDI_DECODEN_FROM_CTRLBITS(ctrlbits);
+      if(ptr + decode_size > opl)
       {
-        B32 result = MemoryMatchArray(svals[0].u512.u64, svals[1].u512.u64);
-        nval.u64 = !!result;
-      }break;
-      
-      case RDI_EvalOp_NtEq:
+        is_lockstep = is_lockstep && is_stopped;
+        break;
+      }
+      U64 imm = 0;
+      MemoryCopy(&imm, ptr, Min(decode_size, sizeof(imm)));
+      ptr += decode_size;
+      if(op == RDI_EvalOp_ConstString)
       {
-        B32 result = MemoryMatchArray(svals[0].u512.u64, svals[1].u512.u64);
-        nval.u64 = !result;
-      }break;
+        ptr += imm;
+      }
       
-      case RDI_EvalOp_LsEq:
+      // ops past a `Stop` are only reachable via jumps, which are not
+      // run in lockstep anyway - only their input placeholders matter
+      if(is_stopped)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          nval.u64 = (svals[0].f32 <= svals[1].f32);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
-        {
-          nval.u64 = (svals[0].f64 <= svals[1].f64);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_U)
-        {
-          nval.u64 = (svals[0].u64 <= svals[1].u64);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = (svals[0].s64 <= svals[1].s64);
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
+        continue;
+      }
       
-      case RDI_EvalOp_GrEq:
+      // track stack depth; reject anything which is not straight-line
+      // code over 64-bit values
+      U64 pop_count = RDI_POPN_FROM_CTRLBITS(ctrlbits);
+      U64 push_count = RDI_PUSHN_FROM_CTRLBITS(ctrlbits);
+      if(pop_count > depth || pop_count > 2)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          nval.u64 = (svals[0].f32 >= svals[1].f32);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
-        {
-          nval.u64 = (svals[0].f64 >= svals[1].f64);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_U)
-        {
-          nval.u64 = (svals[0].u64 >= svals[1].u64);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = (svals[0].s64 >= svals[1].s64);
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_Less:
+        is_lockstep = 0;
+        continue;
+      }
+      U64 d = depth - pop_count;
+      switch(op)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
-        {
-          nval.u64 = (svals[0].f32 < svals[1].f32);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
-        {
-          nval.u64 = (svals[0].f64 < svals[1].f64);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_U)
-        {
-          nval.u64 = (svals[0].u64 < svals[1].u64);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = (svals[0].s64 < svals[1].s64);
-        }
-        else
-        {
-          result.code = E_InterpretationCode_BadOpTypes;
-          goto done;
-        }
-      }break;
+        default:{}break;
+        case RDI_EvalOp_Stop:
+        {
+          is_stopped = 1;
+        }break;
+        case RDI_EvalOp_Cond:
+        case RDI_EvalOp_Skip:
+        case RDI_EvalOp_ConstU128:
+        case RDI_EvalOp_ConstString:
+        case RDI_EvalOp_ValueRead:
+        {
+          is_lockstep = 0;
+        }break;
+        case RDI_EvalOp_MemRead:
+        {
+          is_lockstep = is_lockstep && (imm <= sizeof(U64));
+        }break;
+        case RDI_EvalOp_RegRead:
+        {
+          is_lockstep = is_lockstep && (((imm&0x00FF00)>>8) <= sizeof(U64));
+        }break;
+        case RDI_EvalOp_RegReadDyn:
+        {
+          is_lockstep = is_lockstep && (bit_size_from_arch(e_interpret_ctx->reg_arch)/8 <= sizeof(U64));
+        }break;
+        case RDI_EvalOp_Pick:
+        case RDI_EvalOp_Insert:
+        {
+          is_lockstep = is_lockstep && (d > imm);
+        }break;
+      }
+      d += push_count;
+      if(d > E_INTERPRET_BATCH_STACK_CAP)
+      {
+        is_lockstep = 0;
+      }
+      depth = d;
+      max_depth = Max(max_depth, depth);
+    }
+  }
+  
+  //- not runnable in lockstep => run each lane through the interpreter,
+  // with the input ops patched into constants
+  if(!is_lockstep)
+  {
+    String8 lane_bytecode = push_str8_copy(scratch.arena, bytecode);
+    for EachIndex(idx, input_off_count)
+    {
+      lane_bytecode.str[input_offs[idx]] = RDI_EvalOp_ConstU64;
+    }
+    for EachIndex(lane_idx, count)
+    {
+      for EachIndex(idx, input_off_count)
+      {
+        MemoryCopy(lane_bytecode.str + input_offs[idx] + 1, &inputs[lane_idx], sizeof(U64));
+      }
+      results_out[lane_idx] = e_interpret__switch(lane_bytecode);
+    }
+  }
+  
+  //- run all lanes in lockstep. the stack is stored as one array of lane
+  // values per stack slot (slot `i`, lane `j` => `slots[i*count + j]`), with one
+  // extra slot used as temporary storage.
+  if(is_lockstep && count != 0)
+  {
+    U64 *slots = push_array(scratch.arena, U64, (max_depth+1)*count);
+    U64 *tslot = slots + max_depth*count;
+    U64 depth = 0;
+    E_Space selected_space = e_interpret_ctx->primary_space;
+    U8 *ptr = bytecode.str;
+    U8 *opl = bytecode.str + bytecode.size;
+    for(;ptr < opl;)
+    {
+      // consume next opcode & decode
+      RDI_EvalOp op = (RDI_EvalOp)*ptr;
+      U16 ctrlbits = (op < RDI_EvalOp_COUNT ? rdi_eval_op_ctrlbits_table[op] :
+                      op == E_IRExtKind_BatchInput ? RDI_EVAL_CTRLBITS(8, 0, 1) :
+                      RDI_EVAL_CTRLBITS(32, 0, 0));
+      U32 decode_size = RDI_DECODEN_FROM_CTRLBITS(ctrlbits);
+      E_Value imm = {0};
+      MemoryCopy(&imm, ptr + 1, decode_size);
+      ptr += 1 + decode_size;
       
-      case RDI_EvalOp_Grtr:
+      // pop - popped operands start at slot `d`, and a pushed result
+      // is stored to slot `d`
+      U64 pop_count = RDI_POPN_FROM_CTRLBITS(ctrlbits);
+      U64 push_count = RDI_PUSHN_FROM_CTRLBITS(ctrlbits);
+      U64 d = depth - pop_count;
+      U64 *s0 = slots + d*count;
+      U64 *s1 = s0 + count;
+      U64 *dst = s0;
+      
+      // interpret op across all lanes
+      switch(op)
       {
-        if(imm.u64 == RDI_EvalTypeGroup_F32)
+        case E_IRExtKind_SetSpace:
         {
-          nval.u64 = (svals[0].f32 > svals[1].f32);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_F64)
+          MemoryCopy(&selected_space, &imm, sizeof(selected_space));
+        }break;
+        
+        case E_IRExtKind_BatchInput:
         {
-          nval.u64 = (svals[0].f64 > svals[1].f64);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_U)
-        {
-          nval.u64 = (svals[0].u64 > svals[1].u64);
-        }
-        else if(imm.u64 == RDI_EvalTypeGroup_S)
-        {
-          nval.u64 = (svals[0].s64 > svals[1].s64);
-        }
-        else
+          MemoryCopy(dst, inputs, sizeof(dst[0])*count);
+        }break;
+        
+        case RDI_EvalOp_Stop:
         {
-          result.code = E_InterpretationCode_BadOpTypes;
           goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_Trunc:
-      {
-        if(0 < imm.u64)
-        {
-          U64 mask = 0;
-          if(imm.u64 < 64)
+        }break;
+        
+        case RDI_EvalOp_Noop:
+        case RDI_EvalOp_Pop:
+        {
+          // do nothing - the pop is handled by the control bits
+        }break;
+        
+        case RDI_EvalOp_MemRead:
+        {
+          // gather the addresses of all live lanes; if they are dense,
+          // read the whole span once & pull each lane's value out of that
+          U64 size = imm.u64;
+          U64 addr_min = max_U64;
+          U64 addr_max = 0;
+          U64 live_count = 0;
+          for EachIndex(lane_idx, count)
           {
-            mask = max_U64 >> (64 - imm.u64);
+            if(results_out[lane_idx].code == E_InterpretationCode_Good)
+            {
+              addr_min = Min(addr_min, s0[lane_idx]);
+              addr_max = Max(addr_max, s0[lane_idx]);
+              live_count += 1;
+            }
           }
-          nval.u64 = svals[0].u64&mask;
-        }
-      }break;
-      
-      case RDI_EvalOp_TruncSigned:
-      {
-        if(0 < imm.u64)
-        {
-          U64 mask = 0;
-          if(imm.u64 < 64)
+          Temp temp = temp_begin(scratch.arena);
+          U8 *span = 0;
+          if(live_count > 1 && size != 0 && addr_max <= max_U64 - size)
           {
-            mask = max_U64 >> (64 - imm.u64);
+            U64 span_size = addr_max - addr_min + size;
+            U64 span_size_max = Min(Max(live_count*size*8, KB(64)), E_INTERPRET_BATCH_MAX_GATHER_SIZE);
+            if(span_size <= span_size_max)
+            {
+              span = push_array_no_zero(temp.arena, U8, span_size);
+              if(!e_space_read(selected_space, span, r1u64(addr_min, addr_min + span_size)))
+              {
+                span = 0;
+              }
+            }
           }
-          U64 high = 0;
-          if(svals[0].u64 & (1 << (imm.u64 - 1)))
+          for EachIndex(lane_idx, count)
           {
-            high = ~mask;
+            if(results_out[lane_idx].code == E_InterpretationCode_Good)
+            {
+              U64 addr = s0[lane_idx];
+              U64 value = 0;
+              if(span != 0)
+              {
+                MemoryCopy(&value, span + (addr - addr_min), size);
+              }
+              else if(!e_space_read(selected_space, &value, r1u64(addr, addr+size)))
+              {
+                e_interpret_batch_lane_fail(&results_out[lane_idx], slots, count, lane_idx, d, selected_space, E_InterpretationCode_BadMemRead);
+                continue;
+              }
+              dst[lane_idx] = value;
+            }
           }
-          nval.u64 = high|(svals[0].u64&mask);
-        }
-      }break;
-      
-      case RDI_EvalOp_Convert:
-      {
-        U32 in = imm.u64&0xFF;
-        U32 out = (imm.u64 >> 8)&0xFF;
-        if(in != out)
+          temp_end(temp);
+          if(e_space_match(selected_space, e_interpret_ctx->reg_space))
+          {
+            selected_space = e_interpret_ctx->primary_space;
+          }
+        }break;
+        
+        case RDI_EvalOp_RegRead:
+        {
+          U8 rdi_reg_code     = (imm.u64&0x0000FF)>>0;
+          U8 byte_size        = (imm.u64&0x00FF00)>>8;
+          U8 byte_off         = (imm.u64&0xFF0000)>>16;
+          REGS_RegCode base_reg_code = regs_reg_code_from_arch_rdi_code(e_interpret_ctx->reg_arch, rdi_reg_code);
+          REGS_Rng rng = regs_reg_code_rng_table_from_arch(e_interpret_ctx->reg_arch)[base_reg_code];
+          U64 off = (U64)rng.byte_off + byte_off;
+          U64 size = (U64)byte_size;
+          U64 value = 0;
+          B32 good_read = e_space_read(e_interpret_ctx->reg_space, &value, r1u64(off, off+size));
+          for EachIndex(lane_idx, count)
+          {
+            if(results_out[lane_idx].code != E_InterpretationCode_Good) {}
+            else if(good_read) {dst[lane_idx] = value;}
+            else {e_interpret_batch_lane_fail(&results_out[lane_idx], slots, count, lane_idx, d, selected_space, E_InterpretationCode_BadRegRead);}
+          }
+        }break;
+        
+        case RDI_EvalOp_RegReadDyn:
         {
-          switch(in + out*RDI_EvalTypeGroup_COUNT)
+          U64 size = bit_size_from_arch(e_interpret_ctx->reg_arch)/8;
+          for EachIndex(lane_idx, count)
           {
-            case RDI_EvalTypeGroup_F32 + RDI_EvalTypeGroup_U*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.u64 = (U64)svals[0].f32;
-            }break;
-            case RDI_EvalTypeGroup_F64 + RDI_EvalTypeGroup_U*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.u64 = (U64)svals[0].f64;
-            }break;
-            
-            case RDI_EvalTypeGroup_F32 + RDI_EvalTypeGroup_S*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.s64 = (S64)svals[0].f32;
-            }break;
-            case RDI_EvalTypeGroup_F64 + RDI_EvalTypeGroup_S*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.s64 = (S64)svals[0].f64;
-            }break;
-            
-            case RDI_EvalTypeGroup_U + RDI_EvalTypeGroup_F32*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.f32 = (F32)svals[0].u64;
-            }break;
-            case RDI_EvalTypeGroup_S + RDI_EvalTypeGroup_F32*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.f32 = (F32)svals[0].s64;
-            }break;
-            case RDI_EvalTypeGroup_F64 + RDI_EvalTypeGroup_F32*RDI_EvalTypeGroup_COUNT:
+            if(results_out[lane_idx].code == E_InterpretationCode_Good)
             {
-              nval.f32 = (F32)svals[0].f64;
-            }break;
-            
-            case RDI_EvalTypeGroup_U + RDI_EvalTypeGroup_F64*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.f64 = (F64)svals[0].u64;
-            }break;
-            case RDI_EvalTypeGroup_S + RDI_EvalTypeGroup_F64*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.f64 = (F64)svals[0].s64;
-            }break;
-            case RDI_EvalTypeGroup_F32 + RDI_EvalTypeGroup_F64*RDI_EvalTypeGroup_COUNT:
-            {
-              nval.f64 = (F64)svals[0].f32;
-            }break;
+              U64 off = s0[lane_idx];
+              U64 value = 0;
+              if(e_space_read(e_interpret_ctx->reg_space, &value, r1u64(off, off+size)))
+              {
+                dst[lane_idx] = value;
+              }
+              else
+              {
+                e_interpret_batch_lane_fail(&results_out[lane_idx], slots, count, lane_idx, d, selected_space, E_InterpretationCode_BadRegRead);
+              }
+            }
+          }
+        }break;
+        
+        case RDI_EvalOp_FrameOff:
+        case RDI_EvalOp_ModuleOff:
+        case RDI_EvalOp_TLSOff:
+        {
+          U64 *base = 0;
+          E_InterpretationCode code = E_InterpretationCode_Good;
+          switch(op)
+          {
+            default:{}break;
+            case RDI_EvalOp_FrameOff: {base = e_interpret_ctx->frame_base;  code = E_InterpretationCode_BadFrameBase;}break;
+            case RDI_EvalOp_ModuleOff:{base = e_interpret_ctx->module_base; code = E_InterpretationCode_BadModuleBase;}break;
+            case RDI_EvalOp_TLSOff:   {base = e_interpret_ctx->tls_base;    code = E_InterpretationCode_BadTLSBase;}break;
+          }
+          for EachIndex(lane_idx, count)
+          {
+            if(results_out[lane_idx].code != E_InterpretationCode_Good) {}
+            else if(base != 0) {dst[lane_idx] = *base + imm.u64;}
+            else {e_interpret_batch_lane_fail(&results_out[lane_idx], slots, count, lane_idx, d, selected_space, code);}
+          }
+        }break;
+        
+        case RDI_EvalOp_ConstU8:
+        case RDI_EvalOp_ConstU16:
+        case RDI_EvalOp_ConstU32:
+        case RDI_EvalOp_ConstU64:
+        {
+          for EachIndex(lane_idx, count)
+          {
+            dst[lane_idx] = imm.u64;
+          }
+        }break;
+        
+        case RDI_EvalOp_Pick:
+        {
+          MemoryCopy(dst, slots + (d - imm.u64 - 1)*count, sizeof(dst[0])*count);
+        }break;
+        
+        case RDI_EvalOp_Insert:
+        if(imm.u64 > 0)
+        {
+          U64 *ins = slots + (d - 1 - imm.u64)*count;
+          MemoryCopy(tslot, slots + (d - 1)*count, sizeof(tslot[0])*count);
+          MemoryCopy(ins + count, ins, sizeof(ins[0])*count*imm.u64);
+          MemoryCopy(ins, tslot, sizeof(ins[0])*count);
+        }break;
+        
+        //- dedicated lane loops for the common integer ops
+        case RDI_EvalOp_Add:
+        case RDI_EvalOp_Sub:
+        case RDI_EvalOp_Mul:
+        if(imm.u64 != RDI_EvalTypeGroup_F32 && imm.u64 != RDI_EvalTypeGroup_F64)
+        {
+          switch(op)
+          {
+            default:{}break;
+            case RDI_EvalOp_Add:{for EachIndex(lane_idx, count) {dst[lane_idx] = s0[lane_idx] + s1[lane_idx];}}break;
+            case RDI_EvalOp_Sub:{for EachIndex(lane_idx, count) {dst[lane_idx] = s0[lane_idx] - s1[lane_idx];}}break;
+            case RDI_EvalOp_Mul:{for EachIndex(lane_idx, count) {dst[lane_idx] = s0[lane_idx] * s1[lane_idx];}}break;
           }
-        }
-      }break;
-      
-      case RDI_EvalOp_Pick:
-      {
-        if(stack_count > imm.u64)
-        {
-          nval = stack[stack_count - imm.u64 - 1];
         }
         else
         {
-          result.code = E_InterpretationCode_BadOp;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_Pop:
-      {
-        // do nothing - the pop is handled by the control bits
-      }break;
-      
-      case RDI_EvalOp_Insert:
-      {
-        if(stack_count > imm.u64)
+          e_interpret_batch_value_op(op, imm, slots, count, d, pop_count, push_count, selected_space, results_out);
+        }break;
+        
+        case RDI_EvalOp_BitAnd:
+        case RDI_EvalOp_BitOr:
+        case RDI_EvalOp_BitXor:
+        if(imm.u64 == RDI_EvalTypeGroup_U || imm.u64 == RDI_EvalTypeGroup_S)
         {
-          if(imm.u64 > 0)
+          switch(op)
           {
-            E_Value tval = stack[stack_count - 1];
-            E_Value *dst = stack + stack_count - 1 - imm.u64;
-            E_Value *shift = dst + 1;
-            MemoryCopy(shift, dst, imm.u64*sizeof(E_Value));
-            *dst = tval;
+            default:{}break;
+            case RDI_EvalOp_BitAnd:{for EachIndex(lane_idx, count) {dst[lane_idx] = s0[lane_idx] & s1[lane_idx];}}break;
+            case RDI_EvalOp_BitOr: {for EachIndex(lane_idx, count) {dst[lane_idx] = s0[lane_idx] | s1[lane_idx];}}break;
+            case RDI_EvalOp_BitXor:{for EachIndex(lane_idx, count) {dst[lane_idx] = s0[lane_idx] ^ s1[lane_idx];}}break;
           }
         }
         else
         {
-          result.code = E_InterpretationCode_BadOp;
-          goto done;
-        }
-      }break;
-      
-      case RDI_EvalOp_ValueRead:
-      {
-        U64 bytes_to_read = imm.u64;
-        U64 offset = svals[0].u64;
-        if(offset + bytes_to_read <= sizeof(E_Value))
-        {
-          E_Value src_val = svals[1];
-          MemoryCopy(&nval.u512.u64[0], (U8 *)(&src_val.u512.u64[0]) + offset, bytes_to_read);
-        }
-      }break;
-      
-      case RDI_EvalOp_ByteSwap:
-      {
-        U64 byte_size = imm.u64;
-        switch(byte_size)
+          e_interpret_batch_value_op(op, imm, slots, count, d, pop_count, push_count, selected_space, results_out);
+        }break;
+        
+        case RDI_EvalOp_Trunc:
         {
-          default:
+          U64 mask = 0;
+          if(0 < imm.u64 && imm.u64 < 64)
           {
-            result.code = E_InterpretationCode_BadOp;
-            goto done;
-          }break;
-          case 2:{nval.u16 = bswap_u16(svals[0].u16);}break;
-          case 4:{nval.u32 = bswap_u32(svals[0].u32);}break;
-          case 8:{nval.u64 = bswap_u64(svals[0].u64);}break;
-        }
-      }break;
+            mask = max_U64 >> (64 - imm.u64);
+          }
+          for EachIndex(lane_idx, count)
+          {
+            dst[lane_idx] = s0[lane_idx]&mask;
+          }
+        }break;
+        
+        //- everything else => scalar value op, per lane
+        default:
+        {
+          e_interpret_batch_value_op(op, imm, slots, count, d, pop_count, push_count, selected_space, results_out);
+        }break;
+      }
+      
+      // rjf: push
+      depth = d + push_count;
     }
+    done:;
     
-    // rjf: push
+    //- fill results of all lanes which did not fail
+    for EachIndex(lane_idx, count)
     {
-      U64 push_count = RDI_PUSHN_FROM_CTRLBITS(ctrlbits);
-      if(push_count == 1)
+      if(results_out[lane_idx].code == E_InterpretationCode_Good)
       {
-        if(stack_count < stack_cap)
-        {
-          stack[stack_count] = nval;
-          stack_count += 1;
-        }
-        else
+        if(depth >= 1)
         {
-          result.code = E_InterpretationCode_InsufficientStackSpace;
-          goto done;
+          results_out[lane_idx].value.u64 = slots[lane_idx];
         }
+        results_out[lane_idx].space = selected_space;
       }
     }
   }
-  done:;
   
-  if(stack_count >= 1)
-  {
-    result.value = stack[0];
-  }
-  result.space = selected_space;
   scratch_end(scratch);
-  return result;
 }
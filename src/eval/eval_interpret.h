@@ -22,6 +22,24 @@ struct E_InterpretCtx
   U64 *tls_base;
 };
 
+////////////////////////////////
+//~ Batch Interpretation Notes
+//
+// `e_interpret_batch` evaluates one bytecode program for many inputs at once
+// (e.g. one expression over every element of an array). The bytecode refers to
+// each lane's input via the `E_IRExtKind_BatchInput` op (see
+// `e_irtree_batch_input`), which is encoded with an 8-byte immediate, so that
+// it can be patched into a `ConstU64` of the input in place - the scalar
+// interpreter rejects it as a bad op. Straight-line bytecode which only produces 64-bit
+// values is run one op at a time across all lanes, with the stack stored as
+// one array of lane values per slot, and with each `MemRead` served by one
+// read of the span covered by all lanes when the lanes' addresses are dense.
+// Everything else is run lane-by-lane through the interpreter. Either way, the
+// result of each lane matches `e_interpret__switch` on that lane's input.
+
+#define E_INTERPRET_BATCH_STACK_CAP       128
+#define E_INTERPRET_BATCH_MAX_GATHER_SIZE MB(64)
+
 ////////////////////////////////
 //~ rjf: Globals
 
@@ -42,6 +60,15 @@ internal B32 e_space_write(E_Space space, void *in, Rng1U64 range);
 ////////////////////////////////
 //~ rjf: Interpretation Functions
 
+internal E_InterpretationCode e_interpret_value_op(RDI_EvalOp op, E_Value imm, E_Value *svals, E_Value *nval);
+internal E_Interpretation e_interpret__switch(String8 bytecode);
 internal E_Interpretation e_interpret(String8 bytecode);
 
+////////////////////////////////
+//~ Batch Interpretation Functions
+
+internal void e_interpret_batch_lane_fail(E_Interpretation *result, U64 *slots, U64 count, U64 lane_idx, U64 depth, E_Space space, E_InterpretationCode code);
+internal void e_interpret_batch_value_op(RDI_EvalOp op, E_Value imm, U64 *slots, U64 count, U64 depth, U64 pop_count, U64 push_count, E_Space space, E_Interpretation *results);
+internal void e_interpret_batch(String8 bytecode, U64 count, U64 *inputs, E_Interpretation *results_out);
+
 #endif // EVAL_INTERPRET_H
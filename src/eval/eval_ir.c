@@ -197,6 +197,15 @@ e_irtree_bytecode_no_copy(Arena *arena, String8 bytecode)
   return n;
 }
 
+internal E_IRNode *
+e_irtree_batch_input(Arena *arena)
+{
+  String8 bytecode = {push_array(arena, U8, 1 + sizeof(U64)), 1 + sizeof(U64)};
+  bytecode.str[0] = E_IRExtKind_BatchInput;
+  E_IRNode *n = e_irtree_bytecode_no_copy(arena, bytecode);
+  return n;
+}
+
 internal E_IRNode *
 e_irtree_string_literal(Arena *arena, String8 string)
 {
@@ -2535,6 +2544,481 @@ e_push_irtree_and_type_from_expr(Arena *arena, E_IRTreeAndType *root_parent, E_I
   return result;
 }
 
+//- irtree optimization
+
+internal E_IRNode *
+e_irnode_copy(Arena *arena, E_IRNode *src)
+{
+  E_IRNode *n = push_array_no_zero(arena, E_IRNode, 1);
+  MemoryCopyStruct(n, src);
+  n->next = &e_irnode_nil;
+  return n;
+}
+
+internal B32
+e_irnode_is_const(E_IRNode *n)
+{
+  E_Space zero_space = zero_struct;
+  B32 result = (RDI_EvalOp_ConstU8 <= n->op && n->op <= RDI_EvalOp_ConstU64 &&
+                n->first == &e_irnode_nil &&
+                MemoryMatchStruct(&n->space, &zero_space));
+  return result;
+}
+
+internal U64
+e_irnode_const_value(E_IRNode *n)
+{
+  // NOTE: constants are encoded at their op's width, so only the low bytes
+  // of the node's value ever make it into the bytecode.
+  U64 result = n->value.u64;
+  switch(n->op)
+  {
+    default:{}break;
+    case RDI_EvalOp_ConstU8: {result &= max_U8;}break;
+    case RDI_EvalOp_ConstU16:{result &= max_U16;}break;
+    case RDI_EvalOp_ConstU32:{result &= max_U32;}break;
+  }
+  return result;
+}
+
+internal B32
+e_irtree_match(E_IRNode *a, E_IRNode *b)
+{
+  B32 result = (a->op == b->op &&
+                MemoryMatchStruct(&a->value, &b->value) &&
+                MemoryMatchStruct(&a->space, &b->space) &&
+                str8_match(a->string, b->string, 0));
+  for(E_IRNode *a_child = a->first, *b_child = b->first; result; a_child = a_child->next, b_child = b_child->next)
+  {
+    if(a_child == &e_irnode_nil || b_child == &e_irnode_nil)
+    {
+      result = (a_child == b_child);
+      break;
+    }
+    result = e_irtree_match(a_child, b_child);
+  }
+  return result;
+}
+
+internal U64
+e_irtree_node_count(E_IRNode *root)
+{
+  U64 result = 1;
+  for(E_IRNode *child = root->first; child != &e_irnode_nil; child = child->next)
+  {
+    result += e_irtree_node_count(child);
+  }
+  return result;
+}
+
+internal U64
+e_irtree_mem_read_count(E_IRNode *root)
+{
+  // NOTE: only counts reads which are always evaluated along with `root` -
+  // this excludes the arms of conditionals (the condition is the only child
+  // which `Cond` pops).
+  U64 result = (root->op == RDI_EvalOp_MemRead);
+  if(root->op < RDI_EvalOp_COUNT)
+  {
+    U64 child_count = RDI_POPN_FROM_CTRLBITS(rdi_eval_op_ctrlbits_table[root->op]);
+    U64 idx = 0;
+    for(E_IRNode *child = root->first;
+        child != &e_irnode_nil && idx < child_count;
+        child = child->next, idx += 1)
+    {
+      result += e_irtree_mem_read_count(child);
+    }
+  }
+  return result;
+}
+
+internal B32
+e_irtree_space_is_uniform(E_IRNode *root, E_Space space)
+{
+  E_Space zero_space = zero_struct;
+  B32 result = (root->op < E_IRExtKind_COUNT &&
+                root->op != E_IRExtKind_SetSpace &&
+                (MemoryMatchStruct(&root->space, &zero_space) ||
+                 MemoryMatchStruct(&root->space, &space)));
+  for(E_IRNode *child = root->first; result && child != &e_irnode_nil; child = child->next)
+  {
+    result = e_irtree_space_is_uniform(child, space);
+  }
+  return result;
+}
+
+internal E_IRNode *
+e_irtree_fold_constants(Arena *arena, E_IRNode *root, U64 *fold_count_out)
+{
+  E_IRNode *result = root;
+  if(root->op < RDI_EvalOp_COUNT && root->first != &e_irnode_nil)
+  {
+    //- fold children; if any changed, rebuild this node (the input tree may
+    // be cached & shared, so it is never modified in place)
+    {
+      Temp scratch = scratch_begin(&arena, 1);
+      U64 child_count = 0;
+      for(E_IRNode *child = root->first; child != &e_irnode_nil; child = child->next)
+      {
+        child_count += 1;
+      }
+      E_IRNode **children = push_array(scratch.arena, E_IRNode *, child_count);
+      B32 children_changed = 0;
+      {
+        U64 idx = 0;
+        for(E_IRNode *child = root->first; child != &e_irnode_nil; child = child->next, idx += 1)
+        {
+          children[idx] = e_irtree_fold_constants(arena, child, fold_count_out);
+          children_changed = (children_changed || children[idx] != child);
+        }
+      }
+      if(children_changed)
+      {
+        result = e_irnode_copy(arena, root);
+        result->first = result->last = &e_irnode_nil;
+        for EachIndex(idx, child_count)
+        {
+          e_irnode_push_child(result, e_irnode_copy(arena, children[idx]));
+        }
+      }
+      scratch_end(scratch);
+    }
+    
+    //- fold this node, if its operands are all constant
+    U64 pop_count = RDI_POPN_FROM_CTRLBITS(rdi_eval_op_ctrlbits_table[result->op]);
+    E_IRNode *l = result->first;
+    E_IRNode *r = l->next;
+    U64 imm = result->value.u64;
+    B32 is_int = (imm == RDI_EvalTypeGroup_U || imm == RDI_EvalTypeGroup_S);
+    B32 is_folded = 0;
+    U64 v = 0;
+    if(pop_count == 1 && e_irnode_is_const(l))
+    {
+      U64 a = e_irnode_const_value(l);
+      switch(result->op)
+      {
+        default:{}break;
+        case RDI_EvalOp_Neg:   {is_folded = is_int; v = (~a) + 1;}break;
+        case RDI_EvalOp_BitNot:{is_folded = is_int; v = ~a;}break;
+        case RDI_EvalOp_LogNot:{is_folded = is_int; v = !a;}break;
+        case RDI_EvalOp_Trunc:
+        {
+          is_folded = 1;
+          if(0 < imm)
+          {
+            v = (imm < 64) ? (a & (max_U64 >> (64 - imm))) : 0;
+          }
+        }break;
+        case RDI_EvalOp_TruncSigned:
+        {
+          is_folded = (imm < 32);
+          if(0 < imm && imm < 32)
+          {
+            U64 mask = max_U64 >> (64 - imm);
+            v = ((a & (1ull << (imm - 1))) ? ~mask : 0) | (a & mask);
+          }
+        }break;
+      }
+    }
+    else if(pop_count == 2 && e_irnode_is_const(l) && e_irnode_is_const(r))
+    {
+      U64 a = e_irnode_const_value(l);
+      U64 b = e_irnode_const_value(r);
+      switch(result->op)
+      {
+        default:{}break;
+        case RDI_EvalOp_Add:   {is_folded = is_int; v = a + b;}break;
+        case RDI_EvalOp_Sub:   {is_folded = is_int; v = a - b;}break;
+        case RDI_EvalOp_Mul:   {is_folded = is_int; v = a * b;}break;
+        case RDI_EvalOp_Div:   {is_folded = is_int && b != 0; v = b ? a / b : 0;}break;
+        case RDI_EvalOp_Mod:   {is_folded = is_int; v = b ? a % b : 0;}break;
+        case RDI_EvalOp_LShift:{is_folded = is_int && b < 64; v = a << (b & 63);}break;
+        case RDI_EvalOp_RShift:{is_folded = is_int && b < 64; v = (imm == RDI_EvalTypeGroup_S) ? (U64)((S64)a >> (b & 63)) : (a >> (b & 63));}break;
+        case RDI_EvalOp_BitAnd:{is_folded = is_int; v = a & b;}break;
+        case RDI_EvalOp_BitOr: {is_folded = is_int; v = a | b;}break;
+        case RDI_EvalOp_BitXor:{is_folded = is_int; v = a ^ b;}break;
+        case RDI_EvalOp_LogAnd:{is_folded = is_int; v = (a && b);}break;
+        case RDI_EvalOp_LogOr: {is_folded = is_int; v = (a || b);}break;
+        case RDI_EvalOp_EqEq:  {is_folded = 1; v = (a == b);}break;
+        case RDI_EvalOp_NtEq:  {is_folded = 1; v = (a != b);}break;
+        case RDI_EvalOp_LsEq:  {is_folded = is_int; v = (imm == RDI_EvalTypeGroup_S) ? ((S64)a <= (S64)b) : (a <= b);}break;
+        case RDI_EvalOp_GrEq:  {is_folded = is_int; v = (imm == RDI_EvalTypeGroup_S) ? ((S64)a >= (S64)b) : (a >= b);}break;
+        case RDI_EvalOp_Less:  {is_folded = is_int; v = (imm == RDI_EvalTypeGroup_S) ? ((S64)a <  (S64)b) : (a <  b);}break;
+        case RDI_EvalOp_Grtr:  {is_folded = is_int; v = (imm == RDI_EvalTypeGroup_S) ? ((S64)a >  (S64)b) : (a >  b);}break;
+      }
+    }
+    
+    //- reassociate chained constant offsets - (x + c0) + c1 -> x + (c0 + c1)
+    else if(pop_count == 2 && result->op == RDI_EvalOp_Add && is_int && e_irnode_is_const(r) &&
+            l->op == RDI_EvalOp_Add && l->first->next == l->last && e_irnode_is_const(l->last) &&
+            (l->value.u64 == RDI_EvalTypeGroup_U || l->value.u64 == RDI_EvalTypeGroup_S))
+    {
+      E_Space zero_space = zero_struct;
+      if(MemoryMatchStruct(&l->space, &zero_space))
+      {
+        U64 off = e_irnode_const_value(l->last) + e_irnode_const_value(r);
+        E_IRNode *folded = e_irtree_binary_op(arena, RDI_EvalOp_Add, (RDI_EvalTypeGroup)imm, e_irnode_copy(arena, l->first), e_irtree_const_u(arena, off));
+        folded->space = result->space;
+        result = folded;
+        *fold_count_out += 1;
+      }
+    }
+    
+    //- replace folded node with constant
+    if(is_folded)
+    {
+      E_IRNode *folded = e_irtree_const_u(arena, v);
+      folded->space = result->space;
+      result = folded;
+      *fold_count_out += 1;
+    }
+  }
+  return result;
+}
+
+internal void
+e_irtree_collect_mem_reads(E_IRNode *root, E_IRMemRead *reads, U64 *read_count)
+{
+  if(root->op < RDI_EvalOp_COUNT)
+  {
+    //- gather this node, if it's a read that fits in a window
+    if(root->op == RDI_EvalOp_MemRead && root->first != &e_irnode_nil &&
+       1 <= root->value.u64 && root->value.u64 <= 8 &&
+       *read_count < E_IR_OPT_MAX_MEM_READS)
+    {
+      E_IRMemRead *read = &reads[*read_count];
+      *read_count += 1;
+      MemoryZeroStruct(read);
+      read->node = root;
+      read->base = root->first;
+      read->size = root->value.u64;
+      
+      // split `base + constant` addresses
+      E_IRNode *addr = root->first;
+      if(addr->op == RDI_EvalOp_Add &&
+         (addr->value.u64 == RDI_EvalTypeGroup_U || addr->value.u64 == RDI_EvalTypeGroup_S) &&
+         addr->first->next == addr->last &&
+         e_irnode_is_const(addr->last) &&
+         e_irnode_const_value(addr->last) <= max_U64 - 8)
+      {
+        read->base = addr->first;
+        read->off  = e_irnode_const_value(addr->last);
+      }
+    }
+    
+    //- descend into unconditionally-evaluated children
+    U64 child_count = RDI_POPN_FROM_CTRLBITS(rdi_eval_op_ctrlbits_table[root->op]);
+    U64 idx = 0;
+    for(E_IRNode *child = root->first;
+        child != &e_irnode_nil && idx < child_count;
+        child = child->next, idx += 1)
+    {
+      e_irtree_collect_mem_reads(child, reads, read_count);
+    }
+  }
+}
+
+internal E_IRNode *
+e_irtree_coalesce_mem_reads(Arena *arena, E_IRNode *root, E_IRMemRead *reads, U64 read_count, E_IRMemReadCluster *clusters, U64 hoist_count, U64 depth)
+{
+  E_IRNode *result = root;
+  
+  //- find this node's hoisted window, if it has one
+  E_IRMemRead *read = 0;
+  E_IRMemReadCluster *cluster = 0;
+  for EachIndex(idx, read_count)
+  {
+    if(reads[idx].node == root)
+    {
+      read = &reads[idx];
+      cluster = &clusters[read->cluster_num-1];
+      break;
+    }
+  }
+  
+  //- hoisted read -> pick window, extract this read's bytes
+  //
+  // `depth` is the number of values above this tree's own stack bottom at this
+  // point, and windows are hoisted in order (0 at the very bottom).
+  //
+  if(cluster != 0 && cluster->hoist_num != 0 && cluster->hoist_num <= hoist_count &&
+     hoist_count - cluster->hoist_num + depth <= max_U8)
+  {
+    result = e_push_irnode(arena, RDI_EvalOp_Pick);
+    result->value.u64 = hoist_count - cluster->hoist_num + depth;
+    if(read->off != cluster->lo)
+    {
+      result = e_irtree_binary_op_u(arena, RDI_EvalOp_RShift, result, e_irtree_const_u(arena, (read->off - cluster->lo)*8));
+    }
+    if(read->off + read->size != cluster->hi)
+    {
+      E_IRNode *trunc = e_push_irnode(arena, RDI_EvalOp_Trunc);
+      trunc->value.u64 = read->size*8;
+      e_irnode_push_child(trunc, result);
+      result = trunc;
+    }
+  }
+  
+  //- all other ops -> rebuild with coalesced unconditionally-evaluated children
+  else if(root->op < RDI_EvalOp_COUNT && root->first != &e_irnode_nil)
+  {
+    U64 child_count = RDI_POPN_FROM_CTRLBITS(rdi_eval_op_ctrlbits_table[root->op]);
+    result = e_irnode_copy(arena, root);
+    result->first = result->last = &e_irnode_nil;
+    U64 idx = 0;
+    for(E_IRNode *child = root->first; child != &e_irnode_nil; child = child->next, idx += 1)
+    {
+      E_IRNode *new_child = child;
+      if(idx < child_count)
+      {
+        new_child = e_irtree_coalesce_mem_reads(arena, child, reads, read_count, clusters, hoist_count, depth + idx);
+      }
+      e_irnode_push_child(result, e_irnode_copy(arena, new_child));
+    }
+  }
+  
+  return result;
+}
+
+internal E_IROptTree
+e_irtree_optimize(Arena *arena, E_IRNode *root)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+  E_IROptTree result = {&e_irnode_nil, &e_irnode_nil, 0, root};
+  U64 mem_read_count_in = e_irtree_mem_read_count(root);
+  U64 fold_count = 0;
+  U64 coalesced_read_count = 0;
+  
+  //- fold constants
+  result.root = e_irtree_fold_constants(arena, root, &fold_count);
+  
+  //- reads may only be moved if nothing in the tree can switch spaces -
+  // otherwise, hoisting a read may change the space from which it reads
+  E_Space primary_space = e_interpret_ctx->primary_space;
+  E_Space reg_space = e_interpret_ctx->reg_space;
+  B32 can_coalesce = (mem_read_count_in >= 2 &&
+                      !MemoryMatchStruct(&primary_space, &reg_space) &&
+                      e_irtree_space_is_uniform(result.root, primary_space));
+  
+  //- gather unconditionally-evaluated reads
+  E_IRMemRead *reads = 0;
+  U64 read_count = 0;
+  if(can_coalesce)
+  {
+    reads = push_array(scratch.arena, E_IRMemRead, E_IR_OPT_MAX_MEM_READS);
+    e_irtree_collect_mem_reads(result.root, reads, &read_count);
+  }
+  
+  //- cluster reads of matching bases which fit in one 8-byte window
+  //
+  // NOTE: all reads in a cluster would have been performed anyway, and
+  // the window's first & last bytes are covered by them, so reading the whole
+  // window cannot fail where the original reads would not.
+  //
+  E_IRMemReadCluster *clusters = push_array(scratch.arena, E_IRMemReadCluster, read_count);
+  U64 cluster_count = 0;
+  for EachIndex(read_idx, read_count)
+  {
+    E_IRMemRead *read = &reads[read_idx];
+    if(read->cluster_num != 0)
+    {
+      continue;
+    }
+    E_IRMemReadCluster *cluster = &clusters[cluster_count];
+    cluster_count += 1;
+    cluster->base            = read->base;
+    cluster->base_node_count = e_irtree_node_count(read->base);
+    cluster->lo              = read->off;
+    cluster->hi              = read->off + read->size;
+    cluster->member_count    = 1;
+    read->cluster_num = cluster_count;
+    for(U64 other_idx = read_idx+1; other_idx < read_count; other_idx += 1)
+    {
+      E_IRMemRead *other = &reads[other_idx];
+      if(other->cluster_num == 0)
+      {
+        U64 lo = Min(cluster->lo, other->off);
+        U64 hi = Max(cluster->hi, other->off + other->size);
+        if(hi - lo <= 8 && e_irtree_match(cluster->base, other->base))
+        {
+          cluster->lo = lo;
+          cluster->hi = hi;
+          cluster->member_count += 1;
+          other->cluster_num = cluster_count;
+        }
+      }
+    }
+  }
+  
+  //- hoist clusters which replace more than one read, smallest bases first -
+  // a base can only contain reads of strictly smaller bases, so by the time a
+  // window's base is evaluated, all windows it may pick from are on the stack
+  for(;result.hoist_count < E_IR_OPT_MAX_HOISTS;)
+  {
+    E_IRMemReadCluster *to_hoist = 0;
+    for EachIndex(cluster_idx, cluster_count)
+    {
+      E_IRMemReadCluster *cluster = &clusters[cluster_idx];
+      if(cluster->hoist_num == 0 && cluster->member_count >= 2 &&
+         (to_hoist == 0 || cluster->base_node_count < to_hoist->base_node_count))
+      {
+        to_hoist = cluster;
+      }
+    }
+    if(to_hoist == 0)
+    {
+      break;
+    }
+    E_IRNode *addr = e_irnode_copy(arena, e_irtree_coalesce_mem_reads(arena, to_hoist->base, reads, read_count, clusters, result.hoist_count, 0));
+    if(to_hoist->lo != 0)
+    {
+      addr = e_irtree_binary_op_u(arena, RDI_EvalOp_Add, addr, e_irtree_const_u(arena, to_hoist->lo));
+    }
+    E_IRNode *window = e_push_irnode(arena, RDI_EvalOp_MemRead);
+    window->value.u64 = to_hoist->hi - to_hoist->lo;
+    e_irnode_push_child(window, addr);
+    SLLQueuePush_NZ(&e_irnode_nil, result.first_hoist, result.last_hoist, window, next);
+    result.hoist_count += 1;
+    to_hoist->hoist_num = result.hoist_count;
+    coalesced_read_count += to_hoist->member_count;
+  }
+  
+  //- replace hoisted reads in the tree
+  if(result.hoist_count != 0)
+  {
+    result.root = e_irtree_coalesce_mem_reads(arena, result.root, reads, read_count, clusters, result.hoist_count, 0);
+  }
+  
+  //- record stats
+  U64 mem_read_count_out = e_irtree_mem_read_count(result.root);
+  for(E_IRNode *hoist = result.first_hoist; hoist != &e_irnode_nil; hoist = hoist->next)
+  {
+    mem_read_count_out += e_irtree_mem_read_count(hoist);
+  }
+  ins_atomic_u64_inc_eval(&e_ir_opt_stats.tree_count);
+  ins_atomic_u64_add_eval(&e_ir_opt_stats.folded_op_count, fold_count);
+  ins_atomic_u64_add_eval(&e_ir_opt_stats.coalesced_read_count, coalesced_read_count);
+  ins_atomic_u64_add_eval(&e_ir_opt_stats.mem_read_count_in, mem_read_count_in);
+  ins_atomic_u64_add_eval(&e_ir_opt_stats.mem_read_count_out, mem_read_count_out);
+  
+  scratch_end(scratch);
+  ProfEnd();
+  return result;
+}
+
+internal E_IROptStats
+e_ir_opt_stats_snapshot(void)
+{
+  E_IROptStats stats = {0};
+  stats.tree_count           = ins_atomic_u64_eval(&e_ir_opt_stats.tree_count);
+  stats.folded_op_count      = ins_atomic_u64_eval(&e_ir_opt_stats.folded_op_count);
+  stats.coalesced_read_count = ins_atomic_u64_eval(&e_ir_opt_stats.coalesced_read_count);
+  stats.mem_read_count_in    = ins_atomic_u64_eval(&e_ir_opt_stats.mem_read_count_in);
+  stats.mem_read_count_out   = ins_atomic_u64_eval(&e_ir_opt_stats.mem_read_count_out);
+  return stats;
+}
+
 //- rjf: irtree -> linear ops/bytecode
 
 internal void
@@ -2578,8 +3062,14 @@ e_append_oplist_from_irtree(Arena *arena, E_IRNode *root, E_Space *current_space
     
     case RDI_EvalOp_Cond:
     {
-      // rjf: generate oplists for each child
-      E_OpList prt_cond = e_oplist_from_irtree(arena, root->first);
+      // generate oplists for each child (the condition is always evaluated,
+      // so it was already optimized along with this node's tree - it may pick
+      // values hoisted by it, and so must not be optimized again on its own)
+      E_OpList prt_cond = {0};
+      {
+        E_Space cond_space = e_interpret_ctx->primary_space;
+        e_append_oplist_from_irtree(arena, root->first, &cond_space, &prt_cond);
+      }
       E_OpList prt_left = e_oplist_from_irtree(arena, root->first->next);
       E_OpList prt_right = e_oplist_from_irtree(arena, root->first->next->next);
       
@@ -2638,7 +3128,28 @@ e_oplist_from_irtree(Arena *arena, E_IRNode *root)
 {
   E_OpList ops = {0};
   E_Space space = e_interpret_ctx->primary_space;
-  e_append_oplist_from_irtree(arena, root, &space, &ops);
+  E_IROptTree opt = e_irtree_optimize(arena, root);
+  
+  // hoisted windows go first, at the bottom of the stack
+  for(E_IRNode *hoist = opt.first_hoist; hoist != &e_irnode_nil; hoist = hoist->next)
+  {
+    e_append_oplist_from_irtree(arena, hoist, &space, &ops);
+  }
+  
+  // evaluate tree
+  e_append_oplist_from_irtree(arena, opt.root, &space, &ops);
+  
+  // the result is taken from the bottom of the stack - move it below the
+  // hoisted windows & drop them
+  if(opt.hoist_count != 0)
+  {
+    e_oplist_push_op(arena, &ops, RDI_EvalOp_Insert, e_value_u64(opt.hoist_count));
+    for EachIndex(idx, opt.hoist_count)
+    {
+      e_oplist_push_op(arena, &ops, RDI_EvalOp_Pop, e_value_u64(0));
+    }
+  }
+  
   return ops;
 }
 
@@ -2728,6 +3239,35 @@ e_bytecode_from_oplist(Arena *arena, E_OpList *oplist)
   return result;
 }
 
+//- batch evaluation bytecode
+
+internal String8
+e_batch_bytecode_from_expr(Arena *arena, E_TypeKey element_type_key, E_Expr *expr, E_TypeKey *type_key_out)
+{
+  // NOTE: `expr` is evaluated against each element, as in `$`-relative
+  // expressions - the element is the parent tree, and the element's address
+  // is the per-lane input of `e_interpret_batch`.
+  String8 result = {0};
+  Temp scratch = scratch_begin(&arena, 1);
+  E_IRTreeAndType parent = {&e_irnode_nil};
+  parent.root = e_irtree_batch_input(scratch.arena);
+  parent.type_key = element_type_key;
+  parent.mode = E_Mode_Offset;
+  E_IRTreeAndType irtree = e_push_irtree_and_type_from_expr(scratch.arena, &parent, &e_default_identifier_resolution_rule, 0, 0, expr);
+  if(irtree.root != &e_irnode_nil && irtree.msgs.max_kind == E_MsgKind_Null)
+  {
+    E_IRNode *value_root = e_irtree_resolve_to_value(scratch.arena, irtree.mode, irtree.root, irtree.type_key);
+    E_OpList oplist = e_oplist_from_irtree(scratch.arena, value_root);
+    result = e_bytecode_from_oplist(arena, &oplist);
+    if(type_key_out != 0)
+    {
+      *type_key_out = irtree.type_key;
+    }
+  }
+  scratch_end(scratch);
+  return result;
+}
+
 //- rjf: leaf-bytecode expression extensions
 
 internal E_Expr *
@@ -75,9 +75,66 @@ struct E_IRState
   E_IRCacheSlot *ir_cache_slots;
 };
 
+////////////////////////////////
+//~ IR Tree Optimization Types
+
+// NOTE: trees are optimized right before they are linearized. Integer ops
+// on constants are folded, and `MemRead`s in the unconditionally-evaluated part
+// of a tree which share a base address expression and fall within one 8-byte
+// window are coalesced: the window is read once, up front ("hoisted"), kept at
+// the bottom of the stack, and each original read becomes a `Pick` of it plus
+// a shift & truncation. Repeated reads of the same address and repeated
+// evaluations of the same base (e.g. a pointer which is dereferenced for
+// several members) thus collapse into one read.
+
+#define E_IR_OPT_MAX_MEM_READS 64
+#define E_IR_OPT_MAX_HOISTS    32
+
+typedef struct E_IRMemRead E_IRMemRead;
+struct E_IRMemRead
+{
+  E_IRNode *node;
+  E_IRNode *base;
+  U64 off;
+  U64 size;
+  U64 cluster_num;
+};
+
+typedef struct E_IRMemReadCluster E_IRMemReadCluster;
+struct E_IRMemReadCluster
+{
+  E_IRNode *base;
+  U64 base_node_count;
+  U64 lo;
+  U64 hi;
+  U64 member_count;
+  U64 hoist_num;
+};
+
+typedef struct E_IROptTree E_IROptTree;
+struct E_IROptTree
+{
+  E_IRNode *first_hoist;
+  E_IRNode *last_hoist;
+  U64 hoist_count;
+  E_IRNode *root;
+};
+
+typedef struct E_IROptStats E_IROptStats;
+struct E_IROptStats
+{
+  U64 tree_count;
+  U64 folded_op_count;
+  U64 coalesced_read_count;
+  U64 mem_read_count_in;
+  U64 mem_read_count_out;
+};
+
 ////////////////////////////////
 //~ rjf: Globals
 
+global E_IROptStats e_ir_opt_stats = {0};
+
 E_IdentifierResolutionPath e_default_identifier_resolution_paths[] =
 {
   E_IdentifierResolutionPath_WildcardInst,
@@ -142,6 +199,7 @@ internal E_IRNode *e_irtree_binary_op(Arena *arena, RDI_EvalOp op, RDI_EvalTypeG
 internal E_IRNode *e_irtree_binary_op_u(Arena *arena, RDI_EvalOp op, E_IRNode *l, E_IRNode *r);
 internal E_IRNode *e_irtree_conditional(Arena *arena, E_IRNode *c, E_IRNode *l, E_IRNode *r);
 internal E_IRNode *e_irtree_bytecode_no_copy(Arena *arena, String8 bytecode);
+internal E_IRNode *e_irtree_batch_input(Arena *arena);
 internal E_IRNode *e_irtree_string_literal(Arena *arena, String8 string);
 internal E_IRNode *e_irtree_set_space(Arena *arena, E_Space space, E_IRNode *c);
 internal E_IRNode *e_irtree_mem_read_type(Arena *arena, E_IRNode *c, E_TypeKey type_key);
@@ -159,11 +217,28 @@ internal void e_expr_unpoison(E_Expr *expr);
 E_TYPE_ACCESS_FUNCTION_DEF(default);
 internal E_IRTreeAndType e_push_irtree_and_type_from_expr(Arena *arena, E_IRTreeAndType *root_parent, E_IdentifierResolutionRule *identifier_resolution_rule, B32 disallow_autohooks, B32 disallow_chained_fastpaths, E_Expr *root_expr);
 
+//- irtree optimization
+internal E_IRNode *e_irnode_copy(Arena *arena, E_IRNode *src);
+internal B32 e_irnode_is_const(E_IRNode *n);
+internal U64 e_irnode_const_value(E_IRNode *n);
+internal B32 e_irtree_match(E_IRNode *a, E_IRNode *b);
+internal U64 e_irtree_node_count(E_IRNode *root);
+internal U64 e_irtree_mem_read_count(E_IRNode *root);
+internal B32 e_irtree_space_is_uniform(E_IRNode *root, E_Space space);
+internal E_IRNode *e_irtree_fold_constants(Arena *arena, E_IRNode *root, U64 *fold_count_out);
+internal void e_irtree_collect_mem_reads(E_IRNode *root, E_IRMemRead *reads, U64 *read_count);
+internal E_IRNode *e_irtree_coalesce_mem_reads(Arena *arena, E_IRNode *root, E_IRMemRead *reads, U64 read_count, E_IRMemReadCluster *clusters, U64 hoist_count, U64 depth);
+internal E_IROptTree e_irtree_optimize(Arena *arena, E_IRNode *root);
+internal E_IROptStats e_ir_opt_stats_snapshot(void);
+
 //- rjf: irtree -> linear ops/bytecode
 internal void e_append_oplist_from_irtree(Arena *arena, E_IRNode *root, E_Space *current_space, E_OpList *out);
 internal E_OpList e_oplist_from_irtree(Arena *arena, E_IRNode *root);
 internal String8 e_bytecode_from_oplist(Arena *arena, E_OpList *oplist);
 
+//- batch evaluation bytecode
+internal String8 e_batch_bytecode_from_expr(Arena *arena, E_TypeKey element_type_key, E_Expr *expr, E_TypeKey *type_key_out);
+
 //- rjf: leaf-bytecode expression extensions
 internal E_Expr *e_expr_irext_member_access(Arena *arena, E_Expr *lhs, E_IRTreeAndType *lhs_irtree, String8 member_name);
 
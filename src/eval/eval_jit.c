@@ -0,0 +1,978 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ Code Building Helpers
+
+internal void
+e_jit_code_push(E_JITCode *code, void *bytes, U64 size)
+{
+  if(code->size + size <= code->cap)
+  {
+    MemoryCopy(code->v + code->size, bytes, size);
+    code->size += size;
+  }
+  else
+  {
+    code->overflowed = 1;
+  }
+}
+
+//- stack slots live at [rsp + 32 + 8*idx]; 32 bytes of (win64) shadow
+// space are kept below them for helper calls
+#define E_JIT_SLOT_DISP(idx) ((U32)(32 + 8*(idx)))
+
+internal void
+e_jit_code_push_slot_load(E_JITCode *code, U8 reg, U64 slot_idx)
+{
+  U32 disp = E_JIT_SLOT_DISP(slot_idx);
+  e_jit_code_pushb(code, 0x48, 0x8B, 0x84 | (reg << 3), 0x24);   // mov reg, [rsp+disp32]
+  e_jit_code_push_struct(code, &disp);
+}
+
+internal void
+e_jit_code_push_slot_store(E_JITCode *code, U64 slot_idx)
+{
+  U32 disp = E_JIT_SLOT_DISP(slot_idx);
+  e_jit_code_pushb(code, 0x48, 0x89, 0x84, 0x24);                // mov [rsp+disp32], rax
+  e_jit_code_push_struct(code, &disp);
+}
+
+internal void
+e_jit_code_push_jump(Arena *arena, E_JITCode *code, E_JITJump **jumps, U8 *opcode, U64 opcode_size, E_JITJumpTargetKind kind, U64 bytecode_off)
+{
+  e_jit_code_push(code, opcode, opcode_size);
+  e_jit_code_pushb(code, 0, 0, 0, 0);
+  E_JITJump *jump = push_array(arena, E_JITJump, 1);
+  SLLStackPush(*jumps, jump);
+  jump->rel32_off           = code->size - 4;
+  jump->target_kind         = kind;
+  jump->target_bytecode_off = bytecode_off;
+}
+
+internal void
+e_jit_code_push_exit(Arena *arena, E_JITCode *code, E_JITJump **jumps, U64 depth)
+{
+  // like the interpreter, the result is the bottom of the stack, if any
+  U8 jmp[] = {0xE9};
+  e_jit_code_push_jump(arena, code, jumps, jmp, sizeof(jmp), depth >= 1 ? E_JITJumpTargetKind_ExitSlot0 : E_JITJumpTargetKind_ExitZero, 0);
+}
+
+//- always 15 bytes, so that generated code can branch over it
+internal void
+e_jit_code_push_error(Arena *arena, E_JITCode *code, E_JITJump **jumps, E_InterpretationCode error_code, U64 depth)
+{
+  U32 code_disp = OffsetOf(E_JITRunCtx, code);
+  U32 code_imm = (U32)error_code;
+  e_jit_code_pushb(code, 0xC7, 0x83);                            // mov dword [rbx+disp32], imm32
+  e_jit_code_push_struct(code, &code_disp);
+  e_jit_code_push_struct(code, &code_imm);
+  e_jit_code_push_exit(arena, code, jumps, depth);
+}
+
+internal void
+e_jit_code_push_helper_call(Arena *arena, E_JITCode *code, E_JITJump **jumps, E_JITHelperFunction *helper, U64 b, B32 can_fail, U64 depth)
+{
+  U64 helper_addr = (U64)helper;
+#if OS_WINDOWS
+  e_jit_code_pushb(code, 0x48, 0x89, 0xD9);                      // mov rcx, rbx
+  e_jit_code_pushb(code, 0x48, 0x89, 0xC2);                      // mov rdx, rax
+  e_jit_code_pushb(code, 0x49, 0xB8);                            // mov r8, imm64
+#else
+  e_jit_code_pushb(code, 0x48, 0x89, 0xDF);                      // mov rdi, rbx
+  e_jit_code_pushb(code, 0x48, 0x89, 0xC6);                      // mov rsi, rax
+  e_jit_code_pushb(code, 0x48, 0xBA);                            // mov rdx, imm64
+#endif
+  e_jit_code_push_struct(code, &b);
+  e_jit_code_pushb(code, 0x48, 0xB8);                            // mov rax, imm64
+  e_jit_code_push_struct(code, &helper_addr);
+  e_jit_code_pushb(code, 0xFF, 0xD0);                            // call rax
+  if(can_fail)
+  {
+    U32 code_disp = OffsetOf(E_JITRunCtx, code);
+    U8 jne[] = {0x0F, 0x85};
+    e_jit_code_pushb(code, 0x83, 0xBB);                          // cmp dword [rbx+disp32], 0
+    e_jit_code_push_struct(code, &code_disp);
+    e_jit_code_pushb(code, 0x00);
+    e_jit_code_push_jump(arena, code, jumps, jne, sizeof(jne), depth >= 1 ? E_JITJumpTargetKind_ExitSlot0 : E_JITJumpTargetKind_ExitZero, 0);
+  }
+}
+
+internal void
+e_jit_code_push_helper_call_data(Arena *arena, E_JITCode *code, E_JITData **datas, E_JITHelperFunction *helper, String8 b_data)
+{
+  U64 helper_addr = (U64)helper;
+#if OS_WINDOWS
+  e_jit_code_pushb(code, 0x48, 0x89, 0xD9);                      // mov rcx, rbx
+  e_jit_code_pushb(code, 0x4C, 0x8D, 0x05, 0, 0, 0, 0);          // lea r8, [rip+disp32]
+#else
+  e_jit_code_pushb(code, 0x48, 0x89, 0xDF);                      // mov rdi, rbx
+  e_jit_code_pushb(code, 0x48, 0x8D, 0x15, 0, 0, 0, 0);          // lea rdx, [rip+disp32]
+#endif
+  E_JITData *data = push_array(arena, E_JITData, 1);
+  SLLStackPush(*datas, data);
+  data->rel32_off = code->size - 4;
+  data->data      = b_data;
+  e_jit_code_pushb(code, 0x48, 0xB8);                            // mov rax, imm64
+  e_jit_code_push_struct(code, &helper_addr);
+  e_jit_code_pushb(code, 0xFF, 0xD0);                            // call rax
+}
+
+////////////////////////////////
+//~ Runtime Helpers (Called From Generated Code)
+
+internal U64
+e_jit_helper_mem_read(E_JITRunCtx *ctx, U64 addr, U64 size)
+{
+  U64 result = 0;
+  if(!e_space_read(ctx->space, &result, r1u64(addr, addr+size)))
+  {
+    ctx->code = E_InterpretationCode_BadMemRead;
+  }
+  else if(e_space_match(ctx->space, e_interpret_ctx->reg_space))
+  {
+    ctx->space = e_interpret_ctx->primary_space;
+  }
+  return result;
+}
+
+internal U64
+e_jit_helper_reg_read(E_JITRunCtx *ctx, U64 unused, U64 imm)
+{
+  U64 result = 0;
+  U8 rdi_reg_code = (imm&0x0000FF)>>0;
+  U8 byte_size    = (imm&0x00FF00)>>8;
+  U8 byte_off     = (imm&0xFF0000)>>16;
+  REGS_RegCode base_reg_code = regs_reg_code_from_arch_rdi_code(e_interpret_ctx->reg_arch, rdi_reg_code);
+  REGS_Rng rng = regs_reg_code_rng_table_from_arch(e_interpret_ctx->reg_arch)[base_reg_code];
+  U64 off = (U64)rng.byte_off + byte_off;
+  U64 size = (U64)byte_size;
+  if(!e_space_read(e_interpret_ctx->reg_space, &result, r1u64(off, off+size)))
+  {
+    ctx->code = E_InterpretationCode_BadRegRead;
+  }
+  return result;
+}
+
+internal U64
+e_jit_helper_reg_read_dyn(E_JITRunCtx *ctx, U64 off, U64 unused)
+{
+  U64 result = 0;
+  U64 size = bit_size_from_arch(e_interpret_ctx->reg_arch)/8;
+  if(size > sizeof(result) || !e_space_read(e_interpret_ctx->reg_space, &result, r1u64(off, off+size)))
+  {
+    ctx->code = E_InterpretationCode_BadRegRead;
+  }
+  return result;
+}
+
+internal U64
+e_jit_helper_set_space(E_JITRunCtx *ctx, U64 unused, U64 space_ptr)
+{
+  MemoryCopy(&ctx->space, (void *)space_ptr, sizeof(ctx->space));
+  return 0;
+}
+
+////////////////////////////////
+//~ Compilation
+
+internal String8
+e_jit_code_from_bytecode(Arena *arena, String8 bytecode)
+{
+  String8 result = {0};
+#if ARCH_X64
+  Temp scratch = scratch_begin(&arena, 1);
+  E_JITCode code_ = {push_array_no_zero(scratch.arena, U8, E_JIT_CODE_MAX_SIZE), 0, E_JIT_CODE_MAX_SIZE};
+  E_JITCode *code = &code_;
+  E_JITJump *jumps = 0;
+  E_JITData *datas = 0;
+  U64 *code_off_from_bytecode_off = push_array(scratch.arena, U64, bytecode.size+1);
+  S64 *depth_from_bytecode_off = push_array_no_zero(scratch.arena, S64, bytecode.size+1);
+  B8 *bytecode_off_is_op = push_array(scratch.arena, B8, bytecode.size+1);
+  for EachIndex(idx, bytecode.size+1)
+  {
+    depth_from_bytecode_off[idx] = -1;
+  }
+  B32 good = (bytecode.size != 0);
+  U64 max_depth = 0;
+  
+  //- prologue - rbx <- run context, stack slots below. the layout up to
+  // the frame allocation is fixed - windows unwind info is built from it.
+  U64 frame_size_off = 0;
+  {
+    e_jit_code_pushb(code, 0x53);                                // push rbx
+    e_jit_code_pushb(code, 0x55);                                // push rbp
+    e_jit_code_pushb(code, 0x48, 0x89, 0xE5);                    // mov rbp, rsp
+    e_jit_code_pushb(code, 0x48, 0x81, 0xEC, 0, 0, 0, 0);        // sub rsp, imm32
+    frame_size_off = code->size - 4;
+    Assert(frame_size_off == E_JIT_FRAME_SIZE_OFF && code->size == E_JIT_PROLOGUE_SIZE);
+#if OS_WINDOWS
+    e_jit_code_pushb(code, 0x48, 0x89, 0xCB);                    // mov rbx, rcx
+#else
+    e_jit_code_pushb(code, 0x48, 0x89, 0xFB);                    // mov rbx, rdi
+#endif
+  }
+  
+  //- translate ops. all jumps in eval bytecode are forward, so the stack
+  // depth at every op is known (from fallthrough, or from earlier jumps) by
+  // the time it is reached - mismatching depths are left to the interpreter.
+  S64 depth = 0;
+  U8 *ptr = bytecode.str;
+  U8 *opl = bytecode.str + bytecode.size;
+  for(;good && ptr < opl;)
+  {
+    U64 op_off = (U64)(ptr - bytecode.str);
+    
+    // merge stack depth from jumps into this op
+    S64 jump_in_depth = depth_from_bytecode_off[op_off];
+    if(jump_in_depth >= 0)
+    {
+      if(depth >= 0 && depth != jump_in_depth)
+      {
+        good = 0;
+        break;
+      }
+      depth = jump_in_depth;
+    }
+    bytecode_off_is_op[op_off] = 1;
+    code_off_from_bytecode_off[op_off] = code->size;
+    
+    // consume next opcode
+    U8 op = *ptr;
+    U16 ctrlbits = 0;
+    if(op < RDI_EvalOp_COUNT)
+    {
+      ctrlbits = rdi_eval_op_ctrlbits_table[op];
+    }
+    else if(op == E_IRExtKind_SetSpace)
+    {
+      ctrlbits = RDI_EVAL_CTRLBITS(32, 0, 0);
+    }
+    else
+    {
+      good = 0;
+      break;
+    }
+    ptr += 1;
+    
+    // decode
+    U64 decode_size = RDI_DECODEN_FROM_CTRLBITS(ctrlbits);
+    if(ptr + decode_size > opl)
+    {
+      good = 0;
+      break;
+    }
+    U8 *imm_ptr = ptr;
+    U64 imm = 0;
+    MemoryCopy(&imm, imm_ptr, Min(decode_size, sizeof(imm)));
+    ptr += decode_size;
+    U64 next_off = (U64)(ptr - bytecode.str);
+    
+    // unreachable => nothing to generate
+    if(depth < 0)
+    {
+      continue;
+    }
+    
+    // pop - lhs/only operand => rax, rhs => rcx
+    U64 pop_count = RDI_POPN_FROM_CTRLBITS(ctrlbits);
+    U64 push_count = RDI_PUSHN_FROM_CTRLBITS(ctrlbits);
+    if(pop_count > (U64)depth)
+    {
+      good = 0;
+      break;
+    }
+    U64 d = (U64)depth - pop_count;
+    if(pop_count == 2)
+    {
+      e_jit_code_push_slot_load(code, 0, d+0);
+      e_jit_code_push_slot_load(code, 1, d+1);
+    }
+    else if(pop_count == 1)
+    {
+      e_jit_code_push_slot_load(code, 0, d+0);
+    }
+    
+    // translate op, given decodes/pops; result => rax
+    B32 is_int_group   = (imm == RDI_EvalTypeGroup_U || imm == RDI_EvalTypeGroup_S);
+    B32 is_float_group = (imm == RDI_EvalTypeGroup_F32 || imm == RDI_EvalTypeGroup_F64);
+    B32 falls_through = 1;
+    switch(op)
+    {
+      default:
+      {
+        good = 0;
+      }break;
+      
+      case E_IRExtKind_SetSpace:
+      {
+        e_jit_code_push_helper_call_data(scratch.arena, code, &datas, e_jit_helper_set_space, str8(imm_ptr, decode_size));
+      }break;
+      
+      case RDI_EvalOp_Stop:
+      {
+        e_jit_code_push_exit(scratch.arena, code, &jumps, d);
+        falls_through = 0;
+      }break;
+      
+      case RDI_EvalOp_Noop:
+      case RDI_EvalOp_Pop:
+      {
+      }break;
+      
+      case RDI_EvalOp_Cond:
+      case RDI_EvalOp_Skip:
+      {
+        U64 target_off = next_off + imm;
+        U8 jnz[] = {0x0F, 0x85};
+        U8 jmp[] = {0xE9};
+        U8 *jump_opcode = jmp;
+        U64 jump_opcode_size = sizeof(jmp);
+        if(op == RDI_EvalOp_Cond)
+        {
+          e_jit_code_pushb(code, 0x48, 0x85, 0xC0);              // test rax, rax
+          jump_opcode = jnz;
+          jump_opcode_size = sizeof(jnz);
+        }
+        else
+        {
+          falls_through = 0;
+        }
+        if(target_off >= bytecode.size)
+        {
+          e_jit_code_push_jump(scratch.arena, code, &jumps, jump_opcode, jump_opcode_size, d >= 1 ? E_JITJumpTargetKind_ExitSlot0 : E_JITJumpTargetKind_ExitZero, 0);
+        }
+        else if(depth_from_bytecode_off[target_off] >= 0 && depth_from_bytecode_off[target_off] != (S64)d)
+        {
+          good = 0;
+        }
+        else
+        {
+          depth_from_bytecode_off[target_off] = (S64)d;
+          e_jit_code_push_jump(scratch.arena, code, &jumps, jump_opcode, jump_opcode_size, E_JITJumpTargetKind_Bytecode, target_off);
+        }
+      }break;
+      
+      case RDI_EvalOp_MemRead:
+      {
+        if(imm == 0 || imm > sizeof(U64))
+        {
+          good = 0;
+          break;
+        }
+        e_jit_code_push_helper_call(scratch.arena, code, &jumps, e_jit_helper_mem_read, imm, 1, d);
+      }break;
+      
+      case RDI_EvalOp_RegRead:
+      {
+        U64 byte_size = (imm&0x00FF00)>>8;
+        if(byte_size == 0 || byte_size > sizeof(U64))
+        {
+          good = 0;
+          break;
+        }
+        e_jit_code_push_helper_call(scratch.arena, code, &jumps, e_jit_helper_reg_read, imm, 1, d);
+      }break;
+      
+      case RDI_EvalOp_RegReadDyn:
+      {
+        e_jit_code_push_helper_call(scratch.arena, code, &jumps, e_jit_helper_reg_read_dyn, 0, 1, d);
+      }break;
+      
+      case RDI_EvalOp_FrameOff:
+      case RDI_EvalOp_ModuleOff:
+      case RDI_EvalOp_TLSOff:
+      {
+        E_JITBaseKind base_kind = (op == RDI_EvalOp_FrameOff  ? E_JITBaseKind_Frame :
+                                   op == RDI_EvalOp_ModuleOff ? E_JITBaseKind_Module :
+                                   E_JITBaseKind_TLS);
+        E_InterpretationCode error_code = (op == RDI_EvalOp_FrameOff  ? E_InterpretationCode_BadFrameBase :
+                                           op == RDI_EvalOp_ModuleOff ? E_InterpretationCode_BadModuleBase :
+                                           E_InterpretationCode_BadTLSBase);
+        U32 valid_disp = OffsetOf(E_JITRunCtx, bases_valid);
+        U32 valid_mask = (1u << base_kind);
+        U32 base_disp = OffsetOf(E_JITRunCtx, bases) + sizeof(U64)*base_kind;
+        e_jit_code_pushb(code, 0xF7, 0x83);                      // test dword [rbx+disp32], imm32
+        e_jit_code_push_struct(code, &valid_disp);
+        e_jit_code_push_struct(code, &valid_mask);
+        e_jit_code_pushb(code, 0x75, 15);                        // jnz over error
+        e_jit_code_push_error(scratch.arena, code, &jumps, error_code, d);
+        e_jit_code_pushb(code, 0x48, 0x8B, 0x83);                // mov rax, [rbx+disp32]
+        e_jit_code_push_struct(code, &base_disp);
+        e_jit_code_pushb(code, 0x48, 0xB9);                      // mov rcx, imm64
+        e_jit_code_push_struct(code, &imm);
+        e_jit_code_pushb(code, 0x48, 0x01, 0xC8);                // add rax, rcx
+      }break;
+      
+      case RDI_EvalOp_ConstU8:
+      case RDI_EvalOp_ConstU16:
+      case RDI_EvalOp_ConstU32:
+      case RDI_EvalOp_ConstU64:
+      {
+        e_jit_code_pushb(code, 0x48, 0xB8);                      // mov rax, imm64
+        e_jit_code_push_struct(code, &imm);
+      }break;
+      
+      case RDI_EvalOp_Abs:
+      {
+        if(is_float_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x85, 0xC0);                // test rax, rax
+        e_jit_code_pushb(code, 0x79, 0x03);                      // jns done
+        e_jit_code_pushb(code, 0x48, 0xF7, 0xD8);                // neg rax
+      }break;
+      
+      case RDI_EvalOp_Neg:
+      {
+        if(is_float_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0xF7, 0xD8);                // neg rax
+      }break;
+      
+      case RDI_EvalOp_Add:
+      {
+        if(is_float_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x01, 0xC8);                // add rax, rcx
+      }break;
+      
+      case RDI_EvalOp_Sub:
+      {
+        if(is_float_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x29, 0xC8);                // sub rax, rcx
+      }break;
+      
+      case RDI_EvalOp_Mul:
+      {
+        if(is_float_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x0F, 0xAF, 0xC1);          // imul rax, rcx
+      }break;
+      
+      case RDI_EvalOp_Div:
+      {
+        // NOTE: the interpreter divides both integer groups unsigned
+        if(!is_int_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x85, 0xC9);                // test rcx, rcx
+        e_jit_code_pushb(code, 0x75, 15);                        // jnz over error
+        e_jit_code_push_error(scratch.arena, code, &jumps, E_InterpretationCode_DivideByZero, d);
+        e_jit_code_pushb(code, 0x31, 0xD2);                      // xor edx, edx
+        e_jit_code_pushb(code, 0x48, 0xF7, 0xF1);                // div rcx
+      }break;
+      
+      case RDI_EvalOp_Mod:
+      {
+        if(!is_int_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x85, 0xC9);                // test rcx, rcx
+        e_jit_code_pushb(code, 0x74, 0x0A);                      // jz zero
+        e_jit_code_pushb(code, 0x31, 0xD2);                      // xor edx, edx
+        e_jit_code_pushb(code, 0x48, 0xF7, 0xF1);                // div rcx
+        e_jit_code_pushb(code, 0x48, 0x89, 0xD0);                // mov rax, rdx
+        e_jit_code_pushb(code, 0xEB, 0x02);                      // jmp done
+        e_jit_code_pushb(code, 0x31, 0xC0);                      // zero: xor eax, eax
+      }break;
+      
+      case RDI_EvalOp_LShift:
+      {
+        if(!is_int_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0xD3, 0xE0);                // shl rax, cl
+      }break;
+      
+      case RDI_EvalOp_RShift:
+      {
+        if(!is_int_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0xD3, imm == RDI_EvalTypeGroup_S ? 0xF8 : 0xE8); // sar/shr rax, cl
+      }break;
+      
+      case RDI_EvalOp_BitAnd:
+      case RDI_EvalOp_BitOr:
+      case RDI_EvalOp_BitXor:
+      {
+        if(!is_int_group) { good = 0; break; }
+        U8 opcode = (op == RDI_EvalOp_BitAnd ? 0x21 : op == RDI_EvalOp_BitOr ? 0x09 : 0x31);
+        e_jit_code_pushb(code, 0x48, opcode, 0xC8);              // and/or/xor rax, rcx
+      }break;
+      
+      case RDI_EvalOp_BitNot:
+      {
+        if(!is_int_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0xF7, 0xD0);                // not rax
+      }break;
+      
+      case RDI_EvalOp_LogAnd:
+      {
+        if(!is_int_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x85, 0xC0);                // test rax, rax
+        e_jit_code_pushb(code, 0x0F, 0x95, 0xC0);                // setnz al
+        e_jit_code_pushb(code, 0x48, 0x85, 0xC9);                // test rcx, rcx
+        e_jit_code_pushb(code, 0x0F, 0x95, 0xC1);                // setnz cl
+        e_jit_code_pushb(code, 0x20, 0xC8);                      // and al, cl
+        e_jit_code_pushb(code, 0x0F, 0xB6, 0xC0);                // movzx eax, al
+      }break;
+      
+      case RDI_EvalOp_LogOr:
+      {
+        if(!is_int_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x09, 0xC8);                // or rax, rcx
+        e_jit_code_pushb(code, 0x0F, 0x95, 0xC0);                // setnz al
+        e_jit_code_pushb(code, 0x0F, 0xB6, 0xC0);                // movzx eax, al
+      }break;
+      
+      case RDI_EvalOp_LogNot:
+      {
+        if(!is_int_group) { good = 0; break; }
+        e_jit_code_pushb(code, 0x48, 0x85, 0xC0);                // test rax, rax
+        e_jit_code_pushb(code, 0x0F, 0x94, 0xC0);                // sete al
+        e_jit_code_pushb(code, 0x0F, 0xB6, 0xC0);                // movzx eax, al
+      }break;
+      
+      case RDI_EvalOp_EqEq:
+      case RDI_EvalOp_NtEq:
+      case RDI_EvalOp_LsEq:
+      case RDI_EvalOp_GrEq:
+      case RDI_EvalOp_Less:
+      case RDI_EvalOp_Grtr:
+      {
+        // NOTE: equality compares all bits, regardless of type group
+        if(op != RDI_EvalOp_EqEq && op != RDI_EvalOp_NtEq && !is_int_group) { good = 0; break; }
+        B32 is_signed = (imm == RDI_EvalTypeGroup_S);
+        U8 setcc = 0;
+        switch(op)
+        {
+          default:{}break;
+          case RDI_EvalOp_EqEq:{setcc = 0x94;}break;
+          case RDI_EvalOp_NtEq:{setcc = 0x95;}break;
+          case RDI_EvalOp_LsEq:{setcc = is_signed ? 0x9E : 0x96;}break;
+          case RDI_EvalOp_GrEq:{setcc = is_signed ? 0x9D : 0x93;}break;
+          case RDI_EvalOp_Less:{setcc = is_signed ? 0x9C : 0x92;}break;
+          case RDI_EvalOp_Grtr:{setcc = is_signed ? 0x9F : 0x97;}break;
+        }
+        e_jit_code_pushb(code, 0x48, 0x39, 0xC8);                // cmp rax, rcx
+        e_jit_code_pushb(code, 0x0F, setcc, 0xC0);               // setcc al
+        e_jit_code_pushb(code, 0x0F, 0xB6, 0xC0);                // movzx eax, al
+      }break;
+      
+      case RDI_EvalOp_Trunc:
+      {
+        if(imm == 0 || imm >= 64)
+        {
+          e_jit_code_pushb(code, 0x31, 0xC0);                    // xor eax, eax
+        }
+        else
+        {
+          U64 mask = max_U64 >> (64 - imm);
+          e_jit_code_pushb(code, 0x48, 0xB9);                    // mov rcx, imm64
+          e_jit_code_push_struct(code, &mask);
+          e_jit_code_pushb(code, 0x48, 0x21, 0xC8);              // and rax, rcx
+        }
+      }break;
+      
+      case RDI_EvalOp_TruncSigned:
+      {
+        // NOTE: the interpreter tests the sign bit with a 32-bit shift,
+        // so only narrower truncations are translated
+        if(imm == 0)
+        {
+          e_jit_code_pushb(code, 0x31, 0xC0);                    // xor eax, eax
+        }
+        else if(imm < 32)
+        {
+          e_jit_code_pushb(code, 0x48, 0xC1, 0xE0, (U8)(64 - imm)); // shl rax, imm8
+          e_jit_code_pushb(code, 0x48, 0xC1, 0xF8, (U8)(64 - imm)); // sar rax, imm8
+        }
+        else
+        {
+          good = 0;
+        }
+      }break;
+      
+      case RDI_EvalOp_Pick:
+      {
+        if(d <= imm) { good = 0; break; }
+        e_jit_code_push_slot_load(code, 0, d - imm - 1);
+      }break;
+      
+      case RDI_EvalOp_Insert:
+      {
+        if(d <= imm) { good = 0; break; }
+        if(imm > 0)
+        {
+          e_jit_code_push_slot_load(code, 0, d - 1);
+          for(U64 slot_idx = d - 1; slot_idx > d - 1 - imm; slot_idx -= 1)
+          {
+            U32 disp = E_JIT_SLOT_DISP(slot_idx);
+            e_jit_code_push_slot_load(code, 1, slot_idx - 1);
+            e_jit_code_pushb(code, 0x48, 0x89, 0x8C, 0x24);      // mov [rsp+disp32], rcx
+            e_jit_code_push_struct(code, &disp);
+          }
+          e_jit_code_push_slot_store(code, d - 1 - imm);
+        }
+      }break;
+      
+      case RDI_EvalOp_ByteSwap:
+      {
+        switch(imm)
+        {
+          default:{good = 0;}break;
+          case 2:
+          {
+            e_jit_code_pushb(code, 0x66, 0xC1, 0xC0, 0x08);      // rol ax, 8
+            e_jit_code_pushb(code, 0x0F, 0xB7, 0xC0);            // movzx eax, ax
+          }break;
+          case 4:{e_jit_code_pushb(code, 0x0F, 0xC8);}break;     // bswap eax
+          case 8:{e_jit_code_pushb(code, 0x48, 0x0F, 0xC8);}break; // bswap rax
+        }
+      }break;
+    }
+    
+    // push
+    if(good && push_count == 1)
+    {
+      if(d+1 > E_JIT_STACK_CAP)
+      {
+        good = 0;
+        break;
+      }
+      e_jit_code_push_slot_store(code, d);
+      d += 1;
+    }
+    depth = falls_through ? (S64)d : -1;
+    max_depth = Max(max_depth, d);
+  }
+  
+  //- falling off the end => exit
+  if(good && depth >= 0)
+  {
+    e_jit_code_push_exit(scratch.arena, code, &jumps, (U64)depth);
+  }
+  
+  //- exits & epilogue
+  U64 exit_slot0_off = code->size;
+  e_jit_code_push_slot_load(code, 0, 0);
+  e_jit_code_pushb(code, 0xEB, 0x02);                            // jmp store
+  U64 exit_zero_off = code->size;
+  e_jit_code_pushb(code, 0x31, 0xC0);                            // xor eax, eax
+  {
+    U32 value_disp = OffsetOf(E_JITRunCtx, value);
+    e_jit_code_pushb(code, 0x48, 0x89, 0x83);                    // store: mov [rbx+disp32], rax
+    e_jit_code_push_struct(code, &value_disp);
+    e_jit_code_pushb(code, 0x48, 0x89, 0xEC);                    // mov rsp, rbp
+    e_jit_code_pushb(code, 0x5D);                                // pop rbp
+    e_jit_code_pushb(code, 0x5B);                                // pop rbx
+    e_jit_code_pushb(code, 0xC3);                                // ret
+  }
+  
+  //- constant data, addressed rip-relative
+  for(E_JITData *data = datas; data != 0; data = data->next)
+  {
+    for(;code->size & 7;)
+    {
+      e_jit_code_pushb(code, 0xCC);
+    }
+    S32 rel32 = (S32)((S64)code->size - (S64)(data->rel32_off + 4));
+    e_jit_code_push(code, data->data.str, data->data.size);
+    if(!code->overflowed)
+    {
+      MemoryCopy(code->v + data->rel32_off, &rel32, sizeof(rel32));
+    }
+  }
+  
+  //- patch jumps
+  for(E_JITJump *jump = jumps; good && jump != 0; jump = jump->next)
+  {
+    U64 dst_off = 0;
+    switch(jump->target_kind)
+    {
+      case E_JITJumpTargetKind_Bytecode:
+      {
+        if(!bytecode_off_is_op[jump->target_bytecode_off])
+        {
+          good = 0;
+        }
+        dst_off = code_off_from_bytecode_off[jump->target_bytecode_off];
+      }break;
+      case E_JITJumpTargetKind_ExitSlot0:{dst_off = exit_slot0_off;}break;
+      case E_JITJumpTargetKind_ExitZero: {dst_off = exit_zero_off;}break;
+    }
+    S32 rel32 = (S32)((S64)dst_off - (S64)(jump->rel32_off + 4));
+    if(!code->overflowed)
+    {
+      MemoryCopy(code->v + jump->rel32_off, &rel32, sizeof(rel32));
+    }
+  }
+  
+  //- patch frame size - slots + shadow space, keeping rsp 16-byte aligned at calls
+  {
+    U32 frame_size = E_JIT_SLOT_DISP(Max(max_depth, 1));
+    if(frame_size%16 == 0)
+    {
+      frame_size += 8;
+    }
+    if(!code->overflowed)
+    {
+      MemoryCopy(code->v + frame_size_off, &frame_size, sizeof(frame_size));
+    }
+  }
+  
+  //- package
+  if(good && !code->overflowed)
+  {
+    result = push_str8_copy(arena, str8(code->v, code->size));
+  }
+  scratch_end(scratch);
+#endif
+  return result;
+}
+
+#if OS_WINDOWS
+//- windows unwind info - codes are listed in reverse prologue order
+typedef struct E_JITW32UnwindInfo E_JITW32UnwindInfo;
+struct E_JITW32UnwindInfo
+{
+  U8 version_flags;
+  U8 prologue_size;
+  U8 codes_count;
+  U8 frame_reg;
+  U16 codes[4];
+};
+
+internal PRUNTIME_FUNCTION
+e_jit_w32_runtime_function_callback(DWORD64 pc, PVOID user_data)
+{
+  PRUNTIME_FUNCTION result = 0;
+  E_JITCache *cache = (E_JITCache *)user_data;
+  U64 pc_off = pc - (U64)cache->code_base;
+  U64 first = 0;
+  U64 opl = cache->w32_funcs_count;
+  for(;first < opl;)
+  {
+    U64 mid = first + (opl - first)/2;
+    RUNTIME_FUNCTION *func = &cache->w32_funcs[mid];
+    if(pc_off < func->BeginAddress)     { opl = mid; }
+    else if(pc_off >= func->EndAddress) { first = mid+1; }
+    else                                { result = func; break; }
+  }
+  return result;
+}
+#endif
+
+internal U64
+e_jit_code_region_opl_from_size(U64 pos, U64 code_size)
+{
+  U64 opl = AlignPow2(pos, 16) + code_size;
+#if OS_WINDOWS
+  opl = AlignPow2(opl, 4) + sizeof(E_JITW32UnwindInfo);
+#endif
+  return opl;
+}
+
+internal E_JITFunction *
+e_jit_function_from_code(String8 code)
+{
+  E_JITFunction *result = 0;
+  E_JITCache *cache = e_jit_cache;
+  if(cache != 0 && !cache->code_is_broken && code.size != 0)
+  {
+    U64 page_size = os_get_system_info()->page_size;
+    U64 pos = AlignPow2(cache->code_pos, 16);
+    U64 opl = e_jit_code_region_opl_from_size(cache->code_pos, code.size);
+#if OS_WINDOWS
+    B32 has_unwind_room = (cache->w32_funcs_count < cache->w32_funcs_cap);
+#else
+    B32 has_unwind_room = 1;
+#endif
+    if(opl <= E_JIT_CODE_RESERVE_SIZE && has_unwind_room)
+    {
+      // commit, make writable, write, make executable. the region is
+      // owned by this thread, so no other thread can be running code in the
+      // pages while they are writable.
+      U64 page_first = AlignDownPow2(pos, page_size);
+      U64 page_opl = AlignPow2(opl, page_size);
+      B32 good = 1;
+      if(page_opl > cache->code_commit_pos)
+      {
+        good = os_commit(cache->code_base + cache->code_commit_pos, page_opl - cache->code_commit_pos);
+        if(good)
+        {
+          cache->code_commit_pos = page_opl;
+        }
+      }
+      good = good && os_protect(cache->code_base + page_first, page_opl - page_first, OS_AccessFlag_Read|OS_AccessFlag_Write);
+      if(good)
+      {
+        MemoryCopy(cache->code_base + pos, code.str, code.size);
+#if OS_WINDOWS
+        {
+          U32 frame_size = 0;
+          MemoryCopy(&frame_size, code.str + E_JIT_FRAME_SIZE_OFF, sizeof(frame_size));
+          U64 unwind_off = opl - sizeof(E_JITW32UnwindInfo);
+          E_JITW32UnwindInfo unwind = {0};
+          unwind.version_flags = 1;
+          unwind.prologue_size = E_JIT_PROLOGUE_SIZE;
+          unwind.codes_count   = 4;
+          unwind.codes[0]      = (U16)(E_JIT_PROLOGUE_SIZE | (1<<8));  // UWOP_ALLOC_LARGE: sub rsp, frame_size
+          unwind.codes[1]      = (U16)(frame_size/8);
+          unwind.codes[2]      = (U16)(2 | (0<<8) | (5<<12));          // UWOP_PUSH_NONVOL: push rbp
+          unwind.codes[3]      = (U16)(1 | (0<<8) | (3<<12));          // UWOP_PUSH_NONVOL: push rbx
+          MemoryCopy(cache->code_base + unwind_off, &unwind, sizeof(unwind));
+          RUNTIME_FUNCTION *func = &cache->w32_funcs[cache->w32_funcs_count];
+          func->BeginAddress = (DWORD)pos;
+          func->EndAddress   = (DWORD)(pos + code.size);
+          func->UnwindData   = (DWORD)unwind_off;
+        }
+#endif
+        good = os_protect(cache->code_base + page_first, page_opl - page_first, OS_AccessFlag_Read|OS_AccessFlag_Execute);
+      }
+      
+      // bad => this host won't let us make executable memory, stop trying
+      if(good)
+      {
+        result = (E_JITFunction *)(cache->code_base + pos);
+        cache->code_pos = opl;
+#if OS_WINDOWS
+        cache->w32_funcs_count += 1;
+#endif
+      }
+      else
+      {
+        cache->code_is_broken = 1;
+      }
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Cache Lookups
+
+internal void
+e_jit_cache_flush(E_JITCache *cache)
+{
+  arena_pop_to(cache->arena, cache->arena_flush_pos);
+  MemoryZero(cache->slots, sizeof(cache->slots[0])*cache->slots_count);
+  cache->node_count = 0;
+  cache->code_pos = 0;
+  cache->flush_count += 1;
+#if OS_WINDOWS
+  cache->w32_funcs_count = 0;
+#endif
+}
+
+internal E_JITNode *
+e_jit_node_alloc(E_JITCache *cache, E_JITSlot *slot, U64 hash, String8 bytecode)
+{
+  E_JITNode *node = push_array(cache->arena, E_JITNode, 1);
+  SLLQueuePush(slot->first, slot->last, node);
+  node->hash = hash;
+  node->bytecode = push_str8_copy(cache->arena, bytecode);
+  cache->node_count += 1;
+  return node;
+}
+
+internal E_JITFunction *
+e_jit_function_from_bytecode(String8 bytecode, U64 min_hit_count)
+{
+  E_JITFunction *result = 0;
+#if ARCH_X64
+  if(bytecode.size != 0)
+  {
+    //- allocate per-thread cache
+    if(e_jit_cache == 0)
+    {
+      Arena *arena = arena_alloc();
+      e_jit_cache = push_array(arena, E_JITCache, 1);
+      e_jit_cache->arena = arena;
+      e_jit_cache->slots_count = E_JIT_SLOTS_COUNT;
+      e_jit_cache->slots = push_array(arena, E_JITSlot, e_jit_cache->slots_count);
+      e_jit_cache->code_base = (U8 *)os_reserve(E_JIT_CODE_RESERVE_SIZE);
+      e_jit_cache->code_is_broken = (e_jit_cache->code_base == 0);
+#if OS_WINDOWS
+      if(!e_jit_cache->code_is_broken)
+      {
+        e_jit_cache->w32_funcs_cap = E_JIT_MAX_NODE_COUNT;
+        e_jit_cache->w32_funcs = push_array_no_zero(arena, RUNTIME_FUNCTION, e_jit_cache->w32_funcs_cap);
+        e_jit_cache->code_is_broken = !RtlInstallFunctionTableCallback((DWORD64)e_jit_cache->code_base | 3, (DWORD64)e_jit_cache->code_base, E_JIT_CODE_RESERVE_SIZE,
+                                                                       e_jit_w32_runtime_function_callback, e_jit_cache, 0);
+      }
+#endif
+      e_jit_cache->arena_flush_pos = arena_pos(arena);
+    }
+    E_JITCache *cache = e_jit_cache;
+    
+    //- generated code further up the stack => lookups only, the cache must not change
+    B32 cache_is_mutable = (e_jit_run_depth == 0);
+    
+    //- bytecode => node
+    U64 hash = u64_hash_from_str8(bytecode);
+    E_JITSlot *slot = &cache->slots[hash%cache->slots_count];
+    E_JITNode *node = 0;
+    for(E_JITNode *n = slot->first; n != 0; n = n->next)
+    {
+      if(n->hash == hash && str8_match(n->bytecode, bytecode, 0))
+      {
+        node = n;
+        break;
+      }
+    }
+    if(node == 0 && !cache->code_is_broken && cache_is_mutable)
+    {
+      if(cache->node_count >= E_JIT_MAX_NODE_COUNT)
+      {
+        e_jit_cache_flush(cache);
+      }
+      node = e_jit_node_alloc(cache, slot, hash, bytecode);
+    }
+    
+    //- hot => compile, once. a full code region flushes the cache - the
+    // node is re-added afterwards, keeping its hit count.
+    if(node != 0)
+    {
+      node->hit_count += 1;
+      if(!node->is_compiled && node->hit_count >= min_hit_count && cache_is_mutable)
+      {
+        Temp scratch = scratch_begin(0, 0);
+        String8 code = e_jit_code_from_bytecode(scratch.arena, bytecode);
+        B32 region_is_full = (e_jit_code_region_opl_from_size(cache->code_pos, code.size) > E_JIT_CODE_RESERVE_SIZE);
+#if OS_WINDOWS
+        region_is_full = region_is_full || (cache->w32_funcs_count >= cache->w32_funcs_cap);
+#endif
+        if(code.size != 0 && region_is_full && cache->code_pos != 0)
+        {
+          U64 hit_count = node->hit_count;
+          e_jit_cache_flush(cache);
+          node = e_jit_node_alloc(cache, slot, hash, bytecode);
+          node->hit_count = hit_count;
+        }
+        node->function = e_jit_function_from_code(code);
+        node->is_compiled = 1;
+        scratch_end(scratch);
+      }
+      result = node->function;
+    }
+  }
+#endif
+  return result;
+}
+
+////////////////////////////////
+//~ Execution
+
+internal E_Interpretation
+e_jit_interpret(E_JITFunction *function)
+{
+  E_Interpretation result = {0};
+  E_JITRunCtx ctx = {0};
+  ctx.space = e_interpret_ctx->primary_space;
+  U64 *bases[E_JITBaseKind_COUNT] = {e_interpret_ctx->module_base, e_interpret_ctx->frame_base, e_interpret_ctx->tls_base};
+  for EachElement(idx, bases)
+  {
+    if(bases[idx] != 0)
+    {
+      ctx.bases[idx] = *bases[idx];
+      ctx.bases_valid |= (1u << idx);
+    }
+  }
+  e_jit_run_depth += 1;
+  function(&ctx);
+  e_jit_run_depth -= 1;
+  result.value.u64 = ctx.value;
+  result.space = ctx.space;
+  result.code = (E_InterpretationCode)ctx.code;
+  return result;
+}
@@ -0,0 +1,198 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef EVAL_JIT_H
+#define EVAL_JIT_H
+
+////////////////////////////////
+//~ Bytecode JIT Notes
+//
+// Hot bytecode (evaluated at least E_JIT_HOT_HIT_COUNT times on one thread)
+// is translated into x64 machine code, which is cached per-thread by bytecode
+// hash. The generated code keeps the eval stack in fixed machine-stack slots,
+// so it only supports bytecode in which the stack depth at every instruction is
+// statically known, all values fit in 64 bits, and only the integer type
+// groups are used. Everything else - and all bytecode on non-x64 hosts - is left
+// to the interpreter, which stays the reference implementation: for any
+// bytecode the JIT accepts, results must match `e_interpret__switch` exactly.
+//
+// Memory & register reads, and space selection, are routed back through the
+// interpretation context via helper calls.
+//
+// The cache is flushed as a whole when either the code region or the node
+// budget runs out. Generated code can re-enter evaluation (a memory read helper
+// calls into the space read hook, which may evaluate other expressions), so
+// while generated code is running on a thread, nested lookups only reuse
+// compiled functions - they never compile, allocate nodes, or flush, which
+// keeps the code of every function still on the stack intact. On Windows, the code region
+// is covered by a function table callback, which hands out unwind info for
+// the generated functions, so debuggers & exception dispatch can walk through
+// them.
+
+////////////////////////////////
+//~ JIT Constants
+
+#define E_JIT_HOT_HIT_COUNT      4
+#define E_JIT_STACK_CAP          128
+#define E_JIT_CODE_RESERVE_SIZE  MB(16)
+#define E_JIT_CODE_MAX_SIZE      KB(64)
+#define E_JIT_SLOTS_COUNT        1024
+#define E_JIT_MAX_NODE_COUNT     65536
+#define E_JIT_PROLOGUE_SIZE      12
+#define E_JIT_FRAME_SIZE_OFF     8
+
+////////////////////////////////
+//~ JIT Function Types
+
+typedef struct E_JITRunCtx E_JITRunCtx;
+struct E_JITRunCtx
+{
+  U64 bases[3];   // module, frame, tls
+  U32 bases_valid;
+  U32 code;       // E_InterpretationCode
+  U64 value;
+  E_Space space;
+};
+
+typedef enum E_JITBaseKind
+{
+  E_JITBaseKind_Module,
+  E_JITBaseKind_Frame,
+  E_JITBaseKind_TLS,
+  E_JITBaseKind_COUNT
+}
+E_JITBaseKind;
+
+typedef void E_JITFunction(E_JITRunCtx *ctx);
+typedef U64 E_JITHelperFunction(E_JITRunCtx *ctx, U64 a, U64 b);
+
+////////////////////////////////
+//~ JIT Code Building Types
+
+typedef struct E_JITCode E_JITCode;
+struct E_JITCode
+{
+  U8 *v;
+  U64 size;
+  U64 cap;
+  B32 overflowed;
+};
+
+typedef enum E_JITJumpTargetKind
+{
+  E_JITJumpTargetKind_Bytecode,
+  E_JITJumpTargetKind_ExitSlot0,
+  E_JITJumpTargetKind_ExitZero,
+}
+E_JITJumpTargetKind;
+
+typedef struct E_JITJump E_JITJump;
+struct E_JITJump
+{
+  E_JITJump *next;
+  U64 rel32_off;
+  E_JITJumpTargetKind target_kind;
+  U64 target_bytecode_off;
+};
+
+typedef struct E_JITData E_JITData;
+struct E_JITData
+{
+  E_JITData *next;
+  U64 rel32_off;
+  String8 data;
+};
+
+////////////////////////////////
+//~ JIT Cache Types
+
+typedef struct E_JITNode E_JITNode;
+struct E_JITNode
+{
+  E_JITNode *next;
+  U64 hash;
+  String8 bytecode;
+  U64 hit_count;
+  B32 is_compiled;
+  E_JITFunction *function;
+};
+
+typedef struct E_JITSlot E_JITSlot;
+struct E_JITSlot
+{
+  E_JITNode *first;
+  E_JITNode *last;
+};
+
+typedef struct E_JITCache E_JITCache;
+struct E_JITCache
+{
+  Arena *arena;
+  U64 arena_flush_pos;
+  U64 slots_count;
+  E_JITSlot *slots;
+  U64 node_count;
+  U64 flush_count;
+
+  // executable code region
+  U8 *code_base;
+  U64 code_pos;
+  U64 code_commit_pos;
+  B32 code_is_broken;
+  
+#if OS_WINDOWS
+  // unwind info for the code region, sorted by address
+  RUNTIME_FUNCTION *w32_funcs;
+  U64 w32_funcs_count;
+  U64 w32_funcs_cap;
+#endif
+};
+
+////////////////////////////////
+//~ Globals
+
+thread_static E_JITCache *e_jit_cache = 0;
+thread_static U64 e_jit_run_depth = 0;
+
+////////////////////////////////
+//~ Code Building Helpers
+
+internal void e_jit_code_push(E_JITCode *code, void *bytes, U64 size);
+#define e_jit_code_pushb(code, ...) do{U8 bytes__[] = {__VA_ARGS__}; e_jit_code_push((code), bytes__, sizeof(bytes__));}while(0)
+#define e_jit_code_push_struct(code, ptr) e_jit_code_push((code), (ptr), sizeof(*(ptr)))
+internal void e_jit_code_push_slot_load(E_JITCode *code, U8 reg, U64 slot_idx);
+internal void e_jit_code_push_slot_store(E_JITCode *code, U64 slot_idx);
+internal void e_jit_code_push_jump(Arena *arena, E_JITCode *code, E_JITJump **jumps, U8 *opcode, U64 opcode_size, E_JITJumpTargetKind kind, U64 bytecode_off);
+internal void e_jit_code_push_exit(Arena *arena, E_JITCode *code, E_JITJump **jumps, U64 depth);
+internal void e_jit_code_push_error(Arena *arena, E_JITCode *code, E_JITJump **jumps, E_InterpretationCode error_code, U64 depth);
+internal void e_jit_code_push_helper_call(Arena *arena, E_JITCode *code, E_JITJump **jumps, E_JITHelperFunction *helper, U64 b, B32 can_fail, U64 depth);
+internal void e_jit_code_push_helper_call_data(Arena *arena, E_JITCode *code, E_JITData **datas, E_JITHelperFunction *helper, String8 b_data);
+
+////////////////////////////////
+//~ Runtime Helpers (Called From Generated Code)
+
+internal U64 e_jit_helper_mem_read(E_JITRunCtx *ctx, U64 addr, U64 size);
+internal U64 e_jit_helper_reg_read(E_JITRunCtx *ctx, U64 unused, U64 imm);
+internal U64 e_jit_helper_reg_read_dyn(E_JITRunCtx *ctx, U64 off, U64 unused);
+internal U64 e_jit_helper_set_space(E_JITRunCtx *ctx, U64 unused, U64 space_ptr);
+
+////////////////////////////////
+//~ Compilation
+
+internal String8 e_jit_code_from_bytecode(Arena *arena, String8 bytecode);
+internal U64 e_jit_code_region_opl_from_size(U64 pos, U64 code_size);
+internal E_JITFunction *e_jit_function_from_code(String8 code);
+
+////////////////////////////////
+//~ Cache Lookups
+
+internal void e_jit_cache_flush(E_JITCache *cache);
+internal E_JITNode *e_jit_node_alloc(E_JITCache *cache, E_JITSlot *slot, U64 hash, String8 bytecode);
+internal E_JITFunction *e_jit_function_from_bytecode(String8 bytecode, U64 min_hit_count);
+
+////////////////////////////////
+//~ Execution
+
+internal E_Interpretation e_jit_interpret(E_JITFunction *function);
+
+#endif // EVAL_JIT_H
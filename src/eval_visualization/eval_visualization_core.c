@@ -217,6 +217,11 @@ ev_view_alloc(void)
 internal void
 ev_view_release(EV_View *view)
 {
+  for(EV_FilterJob *job = view->first_filter_job, *next = 0; job != 0; job = next)
+  {
+    next = job->next;
+    ev_filter_job_release(job);
+  }
   arena_release(view->arena);
 }
 
@@ -460,6 +465,289 @@ ev_expand_rule_from_type_key(E_TypeKey type_key)
   return rule;
 }
 
+////////////////////////////////
+//~ Background Filter Jobs
+
+internal void
+ev_select_filter_job_env(EV_FilterJobEnv *env)
+{
+  ev_filter_job_env = env;
+}
+
+internal EV_FilterJob *
+ev_filter_job_from_eval(EV_View *view, E_Eval eval, String8 filter, U64 total_count)
+{
+  U64 eval_hash = ev_hash_from_seed_string(5381, eval.string);
+  eval_hash = ev_hash_from_seed_string(eval_hash, str8_struct(&eval.irtree.type_key));
+  U64 mem_gen = e_space_gen(eval.space);
+  
+  //- find existing job
+  EV_FilterJob *job = 0;
+  for(EV_FilterJob *j = view->first_filter_job; j != 0; j = j->next)
+  {
+    if(j->eval_hash == eval_hash && j->mem_gen == mem_gen && j->total_count == total_count && str8_match(j->filter, filter, 0))
+    {
+      job = j;
+      break;
+    }
+  }
+  
+  //- no job? -> determine element layout from the first two elements. the
+  // worker evaluates each element directly from its offset & type, so only
+  // evenly-strided elements in memory, with types which do not depend on
+  // this thread's evaluation cache, can be filtered in the background.
+  E_Eval first_eval = e_eval_nil;
+  B32 layout_is_good = 0;
+  if(job == 0 && ev_filter_job_env != 0)
+  {
+    first_eval = e_eval_wrapf(eval, "$[0]");
+    E_Eval second_eval = e_eval_wrapf(eval, "$[1]");
+    E_TypeKey element_type_key = first_eval.irtree.type_key;
+    U64 element_stride = e_type_byte_size_from_key(element_type_key);
+    layout_is_good = (first_eval.irtree.mode == E_Mode_Offset &&
+                      second_eval.irtree.mode == E_Mode_Offset &&
+                      (element_type_key.kind == E_TypeKeyKind_Basic || element_type_key.kind == E_TypeKeyKind_Ext) &&
+                      e_type_key_match(element_type_key, second_eval.irtree.type_key) &&
+                      MemoryMatchStruct(&first_eval.space, &second_eval.space) &&
+                      element_stride != 0 &&
+                      second_eval.value.u64 - first_eval.value.u64 == element_stride);
+  }
+  
+  //- good layout? -> stop stale jobs for this evaluation (old filters or
+  // memory generations), evict the least-recently-used job if needed, &
+  // launch a new one
+  if(layout_is_good)
+  {
+    for(EV_FilterJob *j = view->first_filter_job, *next = 0; j != 0; j = next)
+    {
+      next = j->next;
+      if(j->eval_hash == eval_hash)
+      {
+        DLLRemove(view->first_filter_job, view->last_filter_job, j);
+        view->filter_job_count -= 1;
+        ev_filter_job_release(j);
+      }
+    }
+    if(view->filter_job_count >= 8)
+    {
+      EV_FilterJob *evictee = view->last_filter_job;
+      DLLRemove(view->first_filter_job, view->last_filter_job, evictee);
+      view->filter_job_count -= 1;
+      ev_filter_job_release(evictee);
+    }
+    Arena *arena = arena_alloc();
+    job = push_array(arena, EV_FilterJob, 1);
+    job->arena              = arena;
+    job->ref_count          = 2;
+    job->eval_hash          = eval_hash;
+    job->mem_gen            = mem_gen;
+    job->filter             = push_str8_copy(arena, filter);
+    job->modules_count      = e_base_ctx->modules_count;
+    job->modules            = push_array(arena, E_Module, job->modules_count);
+    job->modules_dbgi_keys  = push_array(arena, DI_Key, job->modules_count);
+    MemoryCopy(job->modules, e_base_ctx->modules, sizeof(job->modules[0])*job->modules_count);
+    for EachIndex(idx, job->modules_count)
+    {
+      job->modules_dbgi_keys[idx].path          = push_str8_copy(arena, ev_filter_job_env->modules_dbgi_keys[idx].path);
+      job->modules_dbgi_keys[idx].min_timestamp = ev_filter_job_env->modules_dbgi_keys[idx].min_timestamp;
+    }
+    job->arch               = e_base_ctx->thread_arch;
+    job->space_rw_user_data = ev_filter_job_env->space_rw_user_data;
+    job->space_read         = ev_filter_job_env->space_read;
+    job->element_type_key   = first_eval.irtree.type_key;
+    job->element_space      = first_eval.space;
+    job->element_base_off   = first_eval.value.u64;
+    job->element_stride     = e_type_byte_size_from_key(first_eval.irtree.type_key);
+    job->total_count        = total_count;
+    job->mutex              = mutex_alloc();
+    
+    // filters starting with `$` are predicates over each element, e.g. `$.x > 4` -
+    // compile once here, against this thread's evaluation state, & run over a
+    // chunk of elements at a time in the worker. they must produce an integer,
+    // boolean, enum, or pointer, which matches when nonzero.
+    String8 filter_trimmed = str8_skip_chop_whitespace(filter);
+    if(filter_trimmed.size != 0 && filter_trimmed.str[0] == '$')
+    {
+      Temp scratch = scratch_begin(&arena, 1);
+      E_Parse parse = e_push_parse_from_string(scratch.arena, filter_trimmed);
+      E_TypeKey predicate_type_key = zero_struct;
+      String8 predicate_bytecode = e_batch_bytecode_from_expr(arena, job->element_type_key, parse.expr, &predicate_type_key);
+      E_TypeKind predicate_type_kind = e_type_kind_from_key(e_type_key_unwrap(predicate_type_key, E_TypeUnwrapFlag_AllDecorative));
+      if(parse.msgs.max_kind == E_MsgKind_Null &&
+         (e_type_kind_is_integer(predicate_type_kind) || predicate_type_kind == E_TypeKind_Bool || predicate_type_kind == E_TypeKind_Enum ||
+          e_type_kind_is_pointer_or_ref(predicate_type_kind)))
+      {
+        job->predicate_bytecode = predicate_bytecode;
+      }
+      scratch_end(scratch);
+    }
+
+    DLLPushFront(view->first_filter_job, view->last_filter_job, job);
+    view->filter_job_count += 1;
+    async_push_work(ev_filter_work, .input = job, .priority = ASYNC_Priority_Low);
+  }
+  
+  //- touch job - keep most-recently-used at the front
+  else if(job != 0 && job != view->first_filter_job)
+  {
+    DLLRemove(view->first_filter_job, view->last_filter_job, job);
+    DLLPushFront(view->first_filter_job, view->last_filter_job, job);
+  }
+  
+  return job;
+}
+
+internal void
+ev_filter_job_release(EV_FilterJob *job)
+{
+  ins_atomic_u64_eval_assign(&job->is_cancelled, 1);
+  if(ins_atomic_u64_dec_eval(&job->ref_count) == 0)
+  {
+    mutex_release(job->mutex);
+    arena_release(job->arena);
+  }
+}
+
+ASYNC_WORK_DEF(ev_filter_work)
+{
+  ProfBeginFunction();
+  EV_FilterJob *job = (EV_FilterJob *)input;
+  Temp scratch = scratch_begin(0, 0);
+  DI_Scope *di_scope = di_scope_open();
+  
+  //- save this thread's selected evaluation state
+  E_Cache *prev_cache = e_cache;
+  E_BaseCtx *prev_base_ctx = e_base_ctx;
+  E_IRCtx *prev_ir_ctx = e_ir_ctx;
+  E_InterpretCtx *prev_interpret_ctx = e_interpret_ctx;
+  EV_ExpandRuleTable *prev_expand_rule_table = ev_view_rule_info_table;
+  
+  //- build this job's evaluation state - modules w/ debug info pinned by this
+  // thread's scope, no register/local/macro state (elements are leaves), &
+  // no visualizer rules (elements are stringified with default rules)
+  E_Module *modules = push_array(scratch.arena, E_Module, job->modules_count);
+  MemoryCopy(modules, job->modules, sizeof(modules[0])*job->modules_count);
+  for EachIndex(idx, job->modules_count)
+  {
+    modules[idx].rdi = di_rdi_from_key(di_scope, &job->modules_dbgi_keys[idx], 0, 0);
+  }
+  E_Cache *cache = e_cache_alloc();
+  E_BaseCtx base_ctx = {0};
+  {
+    base_ctx.thread_arch        = job->arch;
+    base_ctx.modules            = modules;
+    base_ctx.modules_count      = job->modules_count;
+    base_ctx.space_rw_user_data = job->space_rw_user_data;
+    base_ctx.space_read         = job->space_read;
+  }
+  U64 interpret_bases[3] = {0};
+  E_InterpretCtx interpret_ctx = {0};
+  {
+    interpret_ctx.space_rw_user_data = job->space_rw_user_data;
+    interpret_ctx.space_read         = job->space_read;
+    interpret_ctx.primary_space      = job->element_space;
+    interpret_ctx.reg_arch           = job->arch;
+    interpret_ctx.module_base        = &interpret_bases[0];
+    interpret_ctx.frame_base         = &interpret_bases[1];
+    interpret_ctx.tls_base           = &interpret_bases[2];
+  }
+  E_IRCtx ir_ctx = {0};
+  e_select_cache(cache);
+  e_select_interpret_ctx(&interpret_ctx, 0, 0);
+  ev_select_expand_rule_table(0);
+  
+  //- stringify & match each element, a chunk at a time, until done or cancelled
+  EV_StringParams string_params = {EV_StringFlag_ReadOnlyDisplayRules, 10};
+  string_params.limit_strings = 1;
+  string_params.limit_strings_size = 256;
+  for(U64 chunk_base_idx = 0; chunk_base_idx < job->total_count && !ins_atomic_u64_eval(&job->is_cancelled);)
+  {
+    Temp temp = temp_begin(scratch.arena);
+    
+    // reset the evaluation cache for each chunk, to bound its memory
+    MemoryZeroStruct(&ir_ctx);
+    e_select_base_ctx(&base_ctx);
+    e_select_ir_ctx(&ir_ctx);
+    
+    // gather matches within this chunk
+    U64 chunk_count = Min(256, job->total_count - chunk_base_idx);
+    U64 *chunk_match_idxs = push_array_no_zero(temp.arena, U64, chunk_count);
+    U64 chunk_match_count = 0;
+    if(job->predicate_bytecode.size != 0)
+    {
+      U64 *inputs = push_array_no_zero(temp.arena, U64, chunk_count);
+      E_Interpretation *results = push_array_no_zero(temp.arena, E_Interpretation, chunk_count);
+      for EachIndex(idx, chunk_count)
+      {
+        inputs[idx] = job->element_base_off + (chunk_base_idx + idx)*job->element_stride;
+      }
+      e_interpret_batch(job->predicate_bytecode, chunk_count, inputs, results);
+      for EachIndex(idx, chunk_count)
+      {
+        if(results[idx].code == E_InterpretationCode_Good && results[idx].value.u64 != 0)
+        {
+          chunk_match_idxs[chunk_match_count] = chunk_base_idx + idx;
+          chunk_match_count += 1;
+        }
+      }
+    }
+    else for EachIndex(idx, chunk_count)
+    {
+      U64 element_idx = chunk_base_idx + idx;
+      E_Expr *expr = e_push_expr(temp.arena, E_ExprKind_LeafOffset, r1u64(0, 0));
+      expr->type_key  = job->element_type_key;
+      expr->space     = job->element_space;
+      expr->value.u64 = job->element_base_off + element_idx*job->element_stride;
+      E_Eval element_eval = e_eval_from_expr(expr);
+      String8List strings = {0};
+      EV_StringIter *iter = ev_string_iter_begin(temp.arena, element_eval, &string_params);
+      for(String8 string = {0}; strings.total_size < string_params.limit_strings_size && ev_string_iter_next(temp.arena, iter, &string);)
+      {
+        str8_list_push(temp.arena, &strings, string);
+      }
+      String8 string = str8_list_join(temp.arena, &strings, 0);
+      FuzzyMatchRangeList matches = fuzzy_match_find(temp.arena, job->filter, string);
+      if(matches.count == matches.needle_part_count)
+      {
+        chunk_match_idxs[chunk_match_count] = element_idx;
+        chunk_match_count += 1;
+      }
+    }
+    
+    // publish this chunk's matches & progress
+    MutexScope(job->mutex)
+    {
+      if(job->match_count + chunk_match_count > job->match_cap)
+      {
+        U64 new_cap = Max(1024, job->match_cap*2);
+        U64 *new_match_idxs = push_array_no_zero(job->arena, U64, new_cap);
+        MemoryCopy(new_match_idxs, job->match_idxs, sizeof(job->match_idxs[0])*job->match_count);
+        job->match_idxs = new_match_idxs;
+        job->match_cap = new_cap;
+      }
+      MemoryCopy(job->match_idxs + job->match_count, chunk_match_idxs, sizeof(chunk_match_idxs[0])*chunk_match_count);
+      job->match_count += chunk_match_count;
+    }
+    chunk_base_idx += chunk_count;
+    ins_atomic_u64_eval_assign(&job->scanned_count, chunk_base_idx);
+    temp_end(temp);
+  }
+  
+  //- restore this thread's selected evaluation state
+  e_cache = prev_cache;
+  e_base_ctx = prev_base_ctx;
+  e_ir_ctx = prev_ir_ctx;
+  e_interpret_ctx = prev_interpret_ctx;
+  ev_view_rule_info_table = prev_expand_rule_table;
+  e_cache_release(cache);
+  
+  di_scope_close(di_scope);
+  scratch_end(scratch);
+  ev_filter_job_release(job);
+  ProfEnd();
+  return 0;
+}
+
 ////////////////////////////////
 //~ rjf: Block Building
 
@@ -571,6 +859,45 @@ ev_block_tree_from_eval(Arena *arena, EV_View *view, String8 filter, E_Eval root
       }
       expansion_row_count = Min(0x0fffffffffffffffull, expansion_row_count);
       
+      // filtering an array-like expansion? -> the type rule cannot filter
+      // these without evaluating & stringifying every element, so do that in
+      // a background job, & show the matches it has found so far
+      U64 *filter_match_idxs = 0;
+      U64 filter_match_count = 0;
+      B32 use_filter_job = 0;
+      if(task_filter.size != 0 &&
+         viz_expand_rule == &ev_nil_expand_rule &&
+         type_expand_rule == &e_type_expand_rule__default &&
+         expansion_row_count > 1)
+      {
+        E_TypeKind expand_type_kind = e_type_kind_from_key(e_default_expansion_type_from_key(eval.irtree.type_key));
+        use_filter_job = (expand_type_kind == E_TypeKind_Array ||
+                          expand_type_kind == E_TypeKind_Ptr ||
+                          expand_type_kind == E_TypeKind_LRef ||
+                          expand_type_kind == E_TypeKind_RRef);
+      }
+      if(use_filter_job)
+      {
+        EV_FilterJob *job = ev_filter_job_from_eval(view, eval, task_filter, expansion_row_count);
+        if(job != 0)
+        {
+          U64 scanned_count = ins_atomic_u64_eval(&job->scanned_count);
+          MutexScope(job->mutex)
+          {
+            filter_match_count = job->match_count;
+            filter_match_idxs = push_array_no_zero(arena, U64, filter_match_count);
+            MemoryCopy(filter_match_idxs, job->match_idxs, sizeof(filter_match_idxs[0])*filter_match_count);
+          }
+          expansion_row_count = filter_match_count;
+          if(scanned_count < job->total_count)
+          {
+            tree.filter_is_pending = 1;
+          }
+          tree.filter_scanned_count += scanned_count;
+          tree.filter_total_count += job->total_count;
+        }
+      }
+      
       // rjf: determine if this expansion supports child expansions
       B32 allow_child_expansions = 1;
       if(viz_expand_info.single_item)
@@ -596,6 +923,8 @@ ev_block_tree_from_eval(Arena *arena, EV_View *view, String8 filter, E_Eval root
         expansion_block->viz_expand_info          = viz_expand_info;
         expansion_block->viz_expand_rule          = viz_expand_rule;
         expansion_block->row_count                = expansion_row_count;
+        expansion_block->filter_match_idxs        = filter_match_idxs;
+        expansion_block->filter_match_count       = filter_match_count;
         tree.total_row_count += expansion_row_count;
         tree.total_item_count += viz_expand_info.single_item ? 1 : expansion_row_count;
       }
@@ -618,7 +947,7 @@ ev_block_tree_from_eval(Arena *arena, EV_View *view, String8 filter, E_Eval root
           for(EV_ExpandNode *child = expand_node->first; child != 0; child = child->next, idx += 1)
           {
             child_keys[idx] = child->key;
-            child_nums[idx] = type_expand_rule->num_from_id(type_expand_info.user_data, child->key.child_id);
+            child_nums[idx] = ev_block_num_from_id(expansion_block, child->key.child_id);
             if(child_nums[idx] != child_keys[idx].child_id)
             {
               needs_sort = 1;
@@ -658,7 +987,7 @@ ev_block_tree_from_eval(Arena *arena, EV_View *view, String8 filter, E_Eval root
         child_nums  = push_array(scratch.arena, U64,    child_count);
         for(U64 idx = 0; idx < child_count; idx += 1)
         {
-          U64 child_id = type_expand_rule->id_from_num(type_expand_info.user_data, idx+1);
+          U64 child_id = ev_block_id_from_num(expansion_block, idx+1);
           child_keys[idx] = ev_key_make(ev_hash_from_key(key), child_id);
           child_nums[idx] = idx+1;
         }
@@ -677,7 +1006,7 @@ ev_block_tree_from_eval(Arena *arena, EV_View *view, String8 filter, E_Eval root
         {
           Rng1U64 child_range = r1u64(split_relative_idx, split_relative_idx+1);
           E_Eval child_eval = {0};
-          type_expand_rule->range(arena, type_expand_info.user_data, eval, task_filter, r1u64(split_relative_idx, split_relative_idx+1), &child_eval);
+          ev_block_evals_from_range(arena, expansion_block, r1u64(split_relative_idx, split_relative_idx+1), &child_eval);
           EV_Key child_key = child_keys[idx];
           BlockTreeBuildTask *task = push_array(scratch.arena, BlockTreeBuildTask, 1);
           SLLQueuePush(first_task, last_task, task);
@@ -730,7 +1059,12 @@ ev_depth_from_block(EV_Block *block)
 internal U64
 ev_block_id_from_num(EV_Block *block, U64 num)
 {
-  U64 result = block->type_expand_rule->id_from_num(block->type_expand_info.user_data, num);
+  U64 unfiltered_num = num;
+  if(block->filter_match_idxs != 0 && 1 <= num && num <= block->filter_match_count)
+  {
+    unfiltered_num = block->filter_match_idxs[num-1] + 1;
+  }
+  U64 result = block->type_expand_rule->id_from_num(block->type_expand_info.user_data, unfiltered_num);
   return result;
 }
 
@@ -738,9 +1072,51 @@ internal U64
 ev_block_num_from_id(EV_Block *block, U64 id)
 {
   U64 result = block->type_expand_rule->num_from_id(block->type_expand_info.user_data, id);
+  if(block->filter_match_idxs != 0)
+  {
+    // match indices are ascending -> binary search for the unfiltered index
+    U64 unfiltered_idx = result-1;
+    U64 filtered_num = 0;
+    U64 lo = 0;
+    U64 hi = block->filter_match_count;
+    for(;lo < hi;)
+    {
+      U64 mid = lo + (hi-lo)/2;
+      if(block->filter_match_idxs[mid] < unfiltered_idx)
+      {
+        lo = mid+1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    if(lo < block->filter_match_count && block->filter_match_idxs[lo] == unfiltered_idx)
+    {
+      filtered_num = lo+1;
+    }
+    result = filtered_num;
+  }
   return result;
 }
 
+internal void
+ev_block_evals_from_range(Arena *arena, EV_Block *block, Rng1U64 range, E_Eval *evals_out)
+{
+  if(block->filter_match_idxs == 0)
+  {
+    block->type_expand_rule->range(arena, block->type_expand_info.user_data, block->eval, block->filter, range, evals_out);
+  }
+  else
+  {
+    for(U64 idx = range.min; idx < range.max && idx < block->filter_match_count; idx += 1)
+    {
+      U64 unfiltered_idx = block->filter_match_idxs[idx];
+      block->type_expand_rule->range(arena, block->type_expand_info.user_data, block->eval, str8_zero(), r1u64(unfiltered_idx, unfiltered_idx+1), &evals_out[idx - range.min]);
+    }
+  }
+}
+
 internal EV_BlockRangeList
 ev_block_range_list_from_tree(Arena *arena, EV_BlockTree *block_tree)
 {
@@ -938,7 +1314,6 @@ ev_windowed_row_list_from_block_range_list(Arena *arena, EV_View *view, EV_Block
       Rng1U64 block_relative_range = n->v.range;
       U64 block_num_visual_rows = dim_1u64(block_relative_range);
       Rng1U64 block_global_range = r1u64(base_vnum, base_vnum + block_num_visual_rows);
-      String8 block_filter = n->v.block->filter;
       
       // rjf: get skip/chop of global range
       U64 num_skipped = 0;
@@ -995,7 +1370,7 @@ ev_windowed_row_list_from_block_range_list(Arena *arena, EV_View *view, EV_Block
         }
         else
         {
-          n->v.block->type_expand_rule->range(arena, n->v.block->type_expand_info.user_data, n->v.block->eval, block_filter, block_relative_range__windowed, range_evals);
+          ev_block_evals_from_range(arena, n->v.block, block_relative_range__windowed, range_evals);
         }
         
         // rjf: no expansion operator applied -> push row for block expression; pass through block info
@@ -60,6 +60,57 @@ struct EV_KeyViewRuleSlot
   EV_KeyViewRuleNode *last;
 };
 
+//- background filter jobs (for expansions which cannot filter cheaply)
+
+typedef struct EV_FilterJob EV_FilterJob;
+struct EV_FilterJob
+{
+  EV_FilterJob *next;
+  EV_FilterJob *prev;
+  Arena *arena;
+  U64 ref_count; // (view + worker; last release frees the job)
+  
+  // key
+  U64 eval_hash;
+  U64 mem_gen;
+  String8 filter;
+  String8 predicate_bytecode; // (filters starting with `$` are predicates over each element, run with `e_interpret_batch`)
+  
+  // evaluation environment (copied from the launching thread; immutable once launched)
+  E_Module *modules;
+  DI_Key *modules_dbgi_keys;
+  U64 modules_count;
+  Arch arch;
+  void *space_rw_user_data;
+  E_SpaceRWFunction *space_read;
+  
+  // element layout (element `i` lives at `element_base_off + i*element_stride`)
+  E_TypeKey element_type_key;
+  E_Space element_space;
+  U64 element_base_off;
+  U64 element_stride;
+  U64 total_count;
+  
+  // progress & partial results (written by the worker)
+  Mutex mutex;
+  U64 is_cancelled;
+  U64 scanned_count;
+  U64 *match_idxs; // (ascending indices into the unfiltered expansion; guarded by `mutex`)
+  U64 match_count;
+  U64 match_cap;
+};
+
+//- environment for background filter jobs - supplies what evaluation needs
+// off of the thread which built the base context
+
+typedef struct EV_FilterJobEnv EV_FilterJobEnv;
+struct EV_FilterJobEnv
+{
+  DI_Key *modules_dbgi_keys; // (parallel to `e_base_ctx->modules`)
+  void *space_rw_user_data;
+  E_SpaceRWFunction *space_read; // (must be callable from any thread)
+};
+
 //- rjf: view state bundle
 
 typedef struct EV_View EV_View;
@@ -72,6 +123,9 @@ struct EV_View
   EV_KeyViewRuleSlot *key_view_rule_slots;
   U64 key_view_rule_slots_count;
   EV_KeyViewRuleNode *free_key_view_rule_node;
+  EV_FilterJob *first_filter_job;
+  EV_FilterJob *last_filter_job;
+  U64 filter_job_count;
 };
 
 ////////////////////////////////
@@ -157,6 +211,10 @@ struct EV_Block
   
   // rjf: expansion info
   U64 row_count;
+  
+  // background filter results (if non-zero, rows map through these)
+  U64 *filter_match_idxs;
+  U64 filter_match_count;
 };
 
 typedef struct EV_BlockTree EV_BlockTree;
@@ -165,6 +223,9 @@ struct EV_BlockTree
   EV_Block *root;
   U64 total_row_count;
   U64 total_item_count;
+  B32 filter_is_pending;
+  U64 filter_scanned_count;
+  U64 filter_total_count;
 };
 
 typedef struct EV_BlockRange EV_BlockRange;
@@ -280,6 +341,7 @@ global read_only EV_ExpandRule ev_nil_expand_rule =
   EV_EXPAND_RULE_INFO_FUNCTION_NAME(nil),
 };
 thread_static EV_ExpandRuleTable *ev_view_rule_info_table = 0;
+thread_static EV_FilterJobEnv *ev_filter_job_env = 0;
 global read_only EV_Block ev_nil_block =
 {
   &ev_nil_block,
@@ -339,6 +401,14 @@ internal void ev_select_expand_rule_table(EV_ExpandRuleTable *table);
 internal EV_ExpandRule *ev_expand_rule_from_string(String8 string);
 internal EV_ExpandRule *ev_expand_rule_from_type_key(E_TypeKey type_key);
 
+////////////////////////////////
+//~ Background Filter Jobs
+
+internal void ev_select_filter_job_env(EV_FilterJobEnv *env);
+internal EV_FilterJob *ev_filter_job_from_eval(EV_View *view, E_Eval eval, String8 filter, U64 total_count);
+internal void ev_filter_job_release(EV_FilterJob *job);
+ASYNC_WORK_DEF(ev_filter_work);
+
 ////////////////////////////////
 //~ rjf: Block Building
 
@@ -350,6 +420,7 @@ internal U64 ev_depth_from_block(EV_Block *block);
 
 internal U64 ev_block_id_from_num(EV_Block *block, U64 num);
 internal U64 ev_block_num_from_id(EV_Block *block, U64 id);
+internal void ev_block_evals_from_range(Arena *arena, EV_Block *block, Rng1U64 range, E_Eval *evals_out);
 internal EV_BlockRangeList ev_block_range_list_from_tree(Arena *arena, EV_BlockTree *block_tree);
 internal EV_BlockRange ev_block_range_from_num(EV_BlockRangeList *block_ranges, U64 num);
 internal EV_Key ev_key_from_num(EV_BlockRangeList *block_ranges, U64 num);
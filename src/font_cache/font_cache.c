@@ -143,12 +143,18 @@ fnt_tag_from_path(String8 path)
   //- rjf: allocate & push new node if we don't have an existing one
   if(existing_node == 0)
   {
-    FP_Handle handle = fp_font_open(path);
+    FP_Handle handle = {0};
+    FP_Metrics metrics = {0};
+    MutexScope(fnt_state->fp_mutex)
+    {
+      handle = fp_font_open(path);
+      metrics = fp_metrics_from_font(handle);
+    }
     FNT_FontHashSlot *slot = &fnt_state->font_hash_table[slot_idx];
     existing_node = push_array(fnt_state->permanent_arena, FNT_FontHashNode, 1);
     existing_node->tag = result;
     existing_node->handle = handle;
-    existing_node->metrics = fp_metrics_from_font(existing_node->handle);
+    existing_node->metrics = metrics;
     existing_node->path = push_str8_copy(fnt_state->permanent_arena, path);
     SLLQueuePush_N(slot->first, slot->last, existing_node, hash_next);
   }
@@ -200,8 +206,11 @@ fnt_tag_from_static_data_string(String8 *data_ptr)
     FNT_FontHashSlot *slot = &fnt_state->font_hash_table[slot_idx];
     new_node = push_array(fnt_state->permanent_arena, FNT_FontHashNode, 1);
     new_node->tag = result;
-    new_node->handle = fp_font_open_from_static_data_string(data_ptr);
-    new_node->metrics = fp_metrics_from_font(new_node->handle);
+    MutexScope(fnt_state->fp_mutex)
+    {
+      new_node->handle = fp_font_open_from_static_data_string(data_ptr);
+      new_node->metrics = fp_metrics_from_font(new_node->handle);
+    }
     new_node->path = str8_lit("");
     SLLQueuePush_N(slot->first, slot->last, new_node, hash_next);
   }
@@ -460,6 +469,104 @@ fnt_atlas_region_release(FNT_Atlas *atlas, Rng2S16 region)
   }
 }
 
+internal FNT_Atlas *
+fnt_atlas_from_num(S16 num)
+{
+  FNT_Atlas *result = 0;
+  S16 idx = 0;
+  for(FNT_Atlas *a = fnt_state->first_atlas; a != 0; a = a->next, idx += 1)
+  {
+    if(idx == num)
+    {
+      result = a;
+      break;
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Glyph LRU / Eviction
+
+internal void
+fnt_raster_cache_info_touch(FNT_RasterCacheInfo *info)
+{
+  if(info->last_frame_index_touched != fnt_state->frame_index)
+  {
+    info->last_frame_index_touched = fnt_state->frame_index;
+    if(info->subrect.x1 != info->subrect.x0 && fnt_state->lru_first != info)
+    {
+      DLLRemove_NP(fnt_state->lru_first, fnt_state->lru_last, info, lru_next, lru_prev);
+      DLLPushFront_NP(fnt_state->lru_first, fnt_state->lru_last, info, lru_next, lru_prev);
+    }
+  }
+}
+
+internal void
+fnt_raster_cache_info_evict(FNT_RasterCacheInfo *info)
+{
+  //- release atlas region
+  if(info->subrect.x1 != info->subrect.x0)
+  {
+    FNT_Atlas *atlas = fnt_atlas_from_num(info->atlas_num);
+    if(atlas != 0)
+    {
+      Temp scratch = scratch_begin(0, 0);
+      Vec2S16 region_dim = dim_2s16(info->subrect);
+      U8 *zeroes = push_array(scratch.arena, U8, (U64)region_dim.x*(U64)region_dim.y*4);
+      r_fill_tex2d_region(atlas->texture, r2s32p(info->subrect.x0, info->subrect.y0, info->subrect.x1, info->subrect.y1), zeroes);
+      fnt_atlas_region_release(atlas, info->subrect);
+      scratch_end(scratch);
+    }
+    U64 region_bytes = (U64)dim_2s16(info->subrect).x * (U64)dim_2s16(info->subrect).y * 4;
+    fnt_state->atlas_bytes_used -= Min(fnt_state->atlas_bytes_used, region_bytes);
+    DLLRemove_NP(fnt_state->lru_first, fnt_state->lru_last, info, lru_next, lru_prev);
+  }
+  
+  //- unhook from owning style
+  FNT_Hash2StyleRasterCacheNode *style = info->style;
+  if(info->hash_node != 0)
+  {
+    FNT_Hash2InfoRasterCacheNode *node = info->hash_node;
+    U64 slot_idx = node->hash%style->hash2info_slots_count;
+    FNT_Hash2InfoRasterCacheSlot *slot = &style->hash2info_slots[slot_idx];
+    DLLRemove_NP(slot->first, slot->last, node, hash_next, hash_prev);
+    node->hash_next = fnt_state->free_hash2info_node;
+    fnt_state->free_hash2info_node = node;
+  }
+  else if(style != 0)
+  {
+    U64 byte = (U64)(info - style->utf8_class1_direct_map);
+    style->utf8_class1_direct_map_mask[byte/64] &= ~(1ull<<(byte%64));
+  }
+  fnt_state->evicted_glyph_count += 1;
+}
+
+internal U64
+fnt_evict_cold_glyphs(U64 target_bytes_used, U64 min_frames_untouched)
+{
+  U64 evicted_count = 0;
+  for(FNT_RasterCacheInfo *info = fnt_state->lru_last, *prev = 0;
+      info != 0 && fnt_state->atlas_bytes_used > target_bytes_used;
+      info = prev)
+  {
+    prev = info->lru_prev;
+    if(info->last_frame_index_touched + min_frames_untouched > fnt_state->frame_index)
+    {
+      break;
+    }
+    fnt_raster_cache_info_evict(info);
+    evicted_count += 1;
+  }
+  return evicted_count;
+}
+
+internal void
+fnt_set_atlas_budget(U64 budget_bytes)
+{
+  fnt_state->atlas_budget_bytes = budget_bytes;
+}
+
 ////////////////////////////////
 //~ rjf: Piece Type Functions
 
@@ -516,6 +623,55 @@ fnt_piece_array_copy(Arena *arena, FNT_PieceArray *src)
 ////////////////////////////////
 //~ rjf: Cache Usage
 
+//- asynchronous rasterization artifacts
+
+internal AC_Artifact
+fnt_raster_artifact_create(String8 key, U64 gen, U64 *requested_gen, B32 *retry_out)
+{
+  //- unpack key
+  FNT_RasterKey raster_key = {0};
+  U64 key_read_off = str8_deserial_read_struct(key, 0, &raster_key);
+  String8 string = str8_skip(key, key_read_off);
+  
+  //- rasterize
+  // NOTE: font providers are not guaranteed to be reentrant (e.g. a
+  // FreeType face carries its current pixel size, and all faces share one
+  // library), so every fp_* call, on any thread, goes through fp_mutex.
+  Arena *arena = arena_alloc();
+  FNT_RasterArtifact *artifact = push_array(arena, FNT_RasterArtifact, 1);
+  artifact->arena = arena;
+  if(raster_key.size > 0)
+  {
+    FP_RasterFlags fp_flags = 0;
+    if(raster_key.flags & FNT_RasterFlag_Smooth) { fp_flags |= FP_RasterFlag_Smooth; }
+    if(raster_key.flags & FNT_RasterFlag_Hinted) { fp_flags |= FP_RasterFlag_Hinted; }
+    MutexScope(fnt_state->fp_mutex)
+    {
+      artifact->raster = fp_raster(arena, raster_key.font, raster_key.size, fp_flags, string);
+    }
+  }
+  
+  AC_Artifact result = {0};
+  result.u64[0] = (U64)artifact;
+  return result;
+}
+
+internal void
+fnt_raster_artifact_destroy(AC_Artifact artifact)
+{
+  FNT_RasterArtifact *raster_artifact = (FNT_RasterArtifact *)artifact.u64[0];
+  if(raster_artifact == 0) { return; }
+  arena_release(raster_artifact->arena);
+}
+
+internal U64
+fnt_pending_raster_count(void)
+{
+  return fnt_state->frame_pending_raster_count;
+}
+
+//- base cache lookups
+
 internal FNT_Hash2StyleRasterCacheNode *
 fnt_hash2style_from_tag_size_flags(FNT_Tag tag, F32 size, FNT_RasterFlags flags)
 {
@@ -611,6 +767,7 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
     Vec2F32 dim = {0};
     B32 font_handle_mapped_on_miss = 0;
     FP_Handle font_handle = {0};
+    Access *access = 0;
     U64 piece_substring_start_idx = 0;
     U64 piece_substring_end_idx = 0;
     for(U64 idx = 0; idx <= string.size;)
@@ -685,11 +842,11 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
         }
       }
       
-      //- rjf: no info found -> miss... fill this hash in the cache
+      //- no info found -> miss... look for an asynchronously-produced
+      // rasterization, & fill this hash in the cache if it's ready
+      B32 is_pending = 0;
       if(info == 0)
       {
-        Temp scratch = scratch_begin(0, 0);
-        
         // rjf: grab font handle for this tag if we don't have one already
         if(font_handle_mapped_on_miss == 0)
         {
@@ -718,117 +875,187 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
           }
         }
         
-        // rjf: call into font provider to rasterize this substring
-        FP_RasterResult raster = {0};
-        if(size > 0)
+        // open access scope for all artifact lookups in this run
+        if(access == 0)
+        {
+          access = access_open();
+        }
+        
+        // form key & look up rasterization - never wait for it
+        FNT_RasterArtifact *raster_artifact = 0;
+        {
+          Temp scratch = scratch_begin(0, 0);
+          FNT_RasterKey raster_key = {0};
+          raster_key.font  = font_handle;
+          raster_key.size  = floor_f32(size);
+          raster_key.flags = flags;
+          String8List key_parts = {0};
+          str8_list_push(scratch.arena, &key_parts, str8_struct(&raster_key));
+          str8_list_push(scratch.arena, &key_parts, piece_substring);
+          String8 key = str8_list_join(scratch.arena, &key_parts, 0);
+          AC_Artifact artifact = ac_artifact_from_key(access, key, fnt_raster_artifact_create, fnt_raster_artifact_destroy, 0, .flags = AC_Flag_HighPriority);
+          raster_artifact = (FNT_RasterArtifact *)artifact.u64[0];
+          scratch_end(scratch);
+        }
+        
+        // not ready -> use placeholder metrics for this frame
+        if(raster_artifact == 0)
         {
-          FP_RasterFlags fp_flags = 0;
-          if(flags & FNT_RasterFlag_Smooth) { fp_flags |= FP_RasterFlag_Smooth; }
-          if(flags & FNT_RasterFlag_Hinted) { fp_flags |= FP_RasterFlag_Hinted; }
-          raster = fp_raster(scratch.arena, font_handle, floor_f32(size), flags, piece_substring);
+          is_pending = 1;
+          run_is_cacheable = 0;
+          fnt_state->frame_pending_raster_count += 1;
         }
         
-        // rjf: allocate portion of an atlas to upload the rasterization
-        S16 chosen_atlas_num = 0;
-        FNT_Atlas *chosen_atlas = 0;
-        Rng2S16 chosen_atlas_region = {0};
-        if(raster.atlas_dim.x != 0 && raster.atlas_dim.y != 0)
+        // ready -> upload & fill cache
+        else
         {
-          U64 num_atlases = 0;
-          for(FNT_Atlas *atlas = fnt_state->first_atlas;; atlas = atlas->next, num_atlases += 1)
+          FP_RasterResult raster = raster_artifact->raster;
+          
+          // rjf: allocate portion of an atlas to upload the rasterization
+          S16 chosen_atlas_num = 0;
+          FNT_Atlas *chosen_atlas = 0;
+          Rng2S16 chosen_atlas_region = {0};
+          if(raster.atlas_dim.x != 0 && raster.atlas_dim.y != 0)
+          {
+            Vec2S16 needed_dimensions = v2s16(raster.atlas_dim.x + 2, raster.atlas_dim.y + 2);
+            U64 atlas_bytes = 1024*1024*4;
+            for(U64 attempt_idx = 0; attempt_idx < 3 && chosen_atlas == 0; attempt_idx += 1)
+            {
+              // attempt 0 -> only create atlases within budget
+              //      attempt 1 -> evict glyphs not used this frame, try again
+              //      attempt 2 -> over budget, create atlases up to the hard limit
+              if(attempt_idx == 1)
+              {
+                fnt_evict_cold_glyphs(0, 1);
+              }
+              U64 max_atlases = (attempt_idx < 2 ? Clamp(1, fnt_state->atlas_budget_bytes/atlas_bytes, 64) : 64);
+              S16 num_atlases = 0;
+              for(FNT_Atlas *atlas = fnt_state->first_atlas;; atlas = atlas->next, num_atlases += 1)
+              {
+                // rjf: create atlas if needed
+                if(atlas == 0 && num_atlases < max_atlases)
+                {
+                  atlas = push_array(fnt_state->raster_arena, FNT_Atlas, 1);
+                  DLLPushBack(fnt_state->first_atlas, fnt_state->last_atlas, atlas);
+                  fnt_state->atlas_count += 1;
+                  atlas->root_dim = v2s16(1024, 1024);
+                  atlas->root = push_array(fnt_state->raster_arena, FNT_AtlasRegionNode, 1);
+                  atlas->root->max_free_size[Corner_00] =
+                    atlas->root->max_free_size[Corner_01] =
+                    atlas->root->max_free_size[Corner_10] =
+                    atlas->root->max_free_size[Corner_11] = v2s16(atlas->root_dim.x/2, atlas->root_dim.y/2);
+                  atlas->texture = r_tex2d_alloc(R_ResourceKind_Dynamic, v2s32((S32)atlas->root_dim.x, (S32)atlas->root_dim.y), R_Tex2DFormat_RGBA8, 0);
+                }
+                
+                // rjf: allocate from atlas
+                if(atlas != 0)
+                {
+                  chosen_atlas_region = fnt_atlas_region_alloc(fnt_state->raster_arena, atlas, needed_dimensions);
+                  if(chosen_atlas_region.x1 != chosen_atlas_region.x0)
+                  {
+                    chosen_atlas = atlas;
+                    chosen_atlas_num = num_atlases;
+                    break;
+                  }
+                }
+                else
+                {
+                  break;
+                }
+              }
+            }
+          }
+          
+          // rjf: upload rasterization to allocated region of atlas texture memory
+          if(chosen_atlas != 0)
+          {
+            Rng2S32 subregion =
+            {
+              chosen_atlas_region.x0,
+              chosen_atlas_region.y0,
+              chosen_atlas_region.x0 + raster.atlas_dim.x,
+              chosen_atlas_region.y0 + raster.atlas_dim.y
+            };
+            r_fill_tex2d_region(chosen_atlas->texture, subregion, raster.atlas);
+          }
+          
+          // rjf: allocate & fill & push node
           {
-            // rjf: create atlas if needed
-            if(atlas == 0 && num_atlases < 64)
+            FNT_Hash2InfoRasterCacheNode *node = 0;
+            if(piece_substring.size == 1)
             {
-              atlas = push_array(fnt_state->raster_arena, FNT_Atlas, 1);
-              DLLPushBack(fnt_state->first_atlas, fnt_state->last_atlas, atlas);
-              atlas->root_dim = v2s16(1024, 1024);
-              atlas->root = push_array(fnt_state->raster_arena, FNT_AtlasRegionNode, 1);
-              atlas->root->max_free_size[Corner_00] =
-                atlas->root->max_free_size[Corner_01] =
-                atlas->root->max_free_size[Corner_10] =
-                atlas->root->max_free_size[Corner_11] = v2s16(atlas->root_dim.x/2, atlas->root_dim.y/2);
-              atlas->texture = r_tex2d_alloc(R_ResourceKind_Dynamic, v2s32((S32)atlas->root_dim.x, (S32)atlas->root_dim.y), R_Tex2DFormat_RGBA8, 0);
+              info = &hash2style_node->utf8_class1_direct_map[piece_substring.str[0]];
+              hash2style_node->utf8_class1_direct_map_mask[piece_substring.str[0]/64] |= (1ull<<(piece_substring.str[0]%64));
             }
-            
-            // rjf: allocate from atlas
-            if(atlas != 0)
+            else
             {
-              Vec2S16 needed_dimensions = v2s16(raster.atlas_dim.x + 2, raster.atlas_dim.y + 2);
-              chosen_atlas_region = fnt_atlas_region_alloc(fnt_state->raster_arena, atlas, needed_dimensions);
-              if(chosen_atlas_region.x1 != chosen_atlas_region.x0)
+              U64 slot_idx = piece_hash%hash2style_node->hash2info_slots_count;
+              FNT_Hash2InfoRasterCacheSlot *slot = &hash2style_node->hash2info_slots[slot_idx];
+              node = fnt_state->free_hash2info_node;
+              if(node != 0)
               {
-                chosen_atlas = atlas;
-                chosen_atlas_num = (S32)num_atlases;
-                break;
+                fnt_state->free_hash2info_node = node->hash_next;
+              }
+              else
+              {
+                node = push_array_no_zero(fnt_state->raster_arena, FNT_Hash2InfoRasterCacheNode, 1);
               }
+              DLLPushBack_NP(slot->first, slot->last, node, hash_next, hash_prev);
+              node->hash = piece_hash;
+              info = &node->info;
             }
-            else
+            if(info != 0)
             {
-              break;
+              MemoryZeroStruct(info);
+              info->style      = hash2style_node;
+              info->hash_node  = node;
+              info->subrect    = chosen_atlas_region;
+              info->atlas_num  = chosen_atlas_num;
+              info->raster_dim = raster.atlas_dim;
+              info->advance    = raster.advance;
+              if(chosen_atlas != 0)
+              {
+                fnt_state->atlas_bytes_used += (U64)dim_2s16(chosen_atlas_region).x * (U64)dim_2s16(chosen_atlas_region).y * 4;
+                DLLPushFront_NP(fnt_state->lru_first, fnt_state->lru_last, info, lru_next, lru_prev);
+              }
             }
           }
         }
-        
-        // rjf: upload rasterization to allocated region of atlas texture memory
-        if(chosen_atlas != 0)
+      }
+      
+      //- pending rasterization -> push placeholder piece, so that layout
+      // is approximately right until the glyph arrives
+      if(is_pending)
+      {
+        F32 advance = (hash2style_node->ascent + hash2style_node->descent) * (piece_substring.size == 1 ? 0.5f : 1.f);
+        if(is_tab)
         {
-          Rng2S32 subregion =
-          {
-            chosen_atlas_region.x0,
-            chosen_atlas_region.y0,
-            chosen_atlas_region.x0 + raster.atlas_dim.x,
-            chosen_atlas_region.y0 + raster.atlas_dim.y
-          };
-          r_fill_tex2d_region(chosen_atlas->texture, subregion, raster.atlas);
+          advance = floor_f32(tab_size_px) - mod_f32(floor_f32(base_align_px), floor_f32(tab_size_px));
         }
-        
-        // rjf: allocate & fill & push node
+        FNT_Piece *piece = fnt_piece_chunk_list_push_new(fnt_state->frame_arena, &piece_chunks, string.size);
         {
-          if(piece_substring.size == 1)
-          {
-            info = &hash2style_node->utf8_class1_direct_map[piece_substring.str[0]];
-            hash2style_node->utf8_class1_direct_map_mask[piece_substring.str[0]/64] |= (1ull<<(piece_substring.str[0]%64));
-          }
-          else
-          {
-            U64 slot_idx = piece_hash%hash2style_node->hash2info_slots_count;
-            FNT_Hash2InfoRasterCacheSlot *slot = &hash2style_node->hash2info_slots[slot_idx];
-            FNT_Hash2InfoRasterCacheNode *node = push_array_no_zero(fnt_state->raster_arena, FNT_Hash2InfoRasterCacheNode, 1);
-            DLLPushBack_NP(slot->first, slot->last, node, hash_next, hash_prev);
-            node->hash = piece_hash;
-            info = &node->info;
-          }
-          if(info != 0)
-          {
-            info->subrect    = chosen_atlas_region;
-            info->atlas_num  = chosen_atlas_num;
-            info->raster_dim = raster.atlas_dim;
-            info->advance    = raster.advance;
-          }
+          MemoryZeroStruct(piece);
+          piece->texture = r_handle_zero();
+          piece->advance = advance;
+          piece->decode_size = piece_substring.size;
+          piece->offset = v2s16(0, -(hash2style_node->ascent + hash2style_node->descent));
         }
-        
-        scratch_end(scratch);
+        base_align_px += advance;
+        dim.x += piece->advance;
+        dim.y = Max(dim.y, hash2style_node->ascent + hash2style_node->descent);
       }
       
       //- rjf: push piece for this raster portion
       if(info != 0)
       {
+        // touch for LRU
+        fnt_raster_cache_info_touch(info);
+        
         // rjf: find atlas
         FNT_Atlas *atlas = 0;
+        if(info->subrect.x1 != 0 && info->subrect.y1 != 0)
         {
-          if(info->subrect.x1 != 0 && info->subrect.y1 != 0)
-          {
-            S32 num = 0;
-            for(FNT_Atlas *a = fnt_state->first_atlas; a != 0; a = a->next, num += 1)
-            {
-              if(info->atlas_num == num)
-              {
-                atlas = a;
-                break;
-              }
-            }
-          }
+          atlas = fnt_atlas_from_num(info->atlas_num);
         }
         
         // rjf: on tabs -> expand advance
@@ -858,6 +1085,12 @@ fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, F
       }
     }
     
+    //- close artifact access scope
+    if(access != 0)
+    {
+      access_close(access);
+    }
+    
     //- rjf: tighten & fill
     {
       if(piece_chunks.node_count == 1)
@@ -1095,6 +1328,8 @@ fnt_init(void)
   fnt_state->frame_arena = arena_alloc();
   fnt_state->font_hash_table_size = 64;
   fnt_state->font_hash_table = push_array(fnt_state->permanent_arena, FNT_FontHashSlot, fnt_state->font_hash_table_size);
+  fnt_state->fp_mutex = mutex_alloc();
+  fnt_state->atlas_budget_bytes = MB(64);
   fnt_reset();
 }
 
@@ -1106,6 +1341,10 @@ fnt_reset(void)
     r_tex2d_release(a->texture);
   }
   fnt_state->first_atlas = fnt_state->last_atlas = 0;
+  fnt_state->atlas_count = 0;
+  fnt_state->atlas_bytes_used = 0;
+  fnt_state->lru_first = fnt_state->lru_last = 0;
+  fnt_state->free_hash2info_node = 0;
   arena_clear(fnt_state->raster_arena);
   fnt_state->hash2style_slots_count = 1024;
   fnt_state->hash2style_slots = push_array(fnt_state->raster_arena, FNT_Hash2StyleRasterCacheSlot, fnt_state->hash2style_slots_count);
@@ -1116,4 +1355,12 @@ fnt_frame(void)
 {
   fnt_state->frame_index += 1;
   arena_clear(fnt_state->frame_arena);
+  
+  fnt_state->frame_pending_raster_count = 0;
+  
+  //- over atlas budget -> evict glyphs which were not used last frame
+  if(fnt_state->atlas_bytes_used > fnt_state->atlas_budget_bytes)
+  {
+    fnt_evict_cold_glyphs(fnt_state->atlas_budget_bytes, 2);
+  }
 }
@@ -95,16 +95,28 @@ struct FNT_FontHashSlot
 
 //- rjf: base glyph rasterization / dimensions cache 
 
+typedef struct FNT_Hash2StyleRasterCacheNode FNT_Hash2StyleRasterCacheNode;
+typedef struct FNT_Hash2InfoRasterCacheNode FNT_Hash2InfoRasterCacheNode;
+
 typedef struct FNT_RasterCacheInfo FNT_RasterCacheInfo;
 struct FNT_RasterCacheInfo
 {
+  // LRU links (glyphs which occupy atlas space only)
+  FNT_RasterCacheInfo *lru_next;
+  FNT_RasterCacheInfo *lru_prev;
+  U64 last_frame_index_touched;
+  
+  // owner (style, and hash node if not in the style's direct map)
+  FNT_Hash2StyleRasterCacheNode *style;
+  FNT_Hash2InfoRasterCacheNode *hash_node;
+  
+  // rasterization info
   Rng2S16 subrect;
   Vec2S16 raster_dim;
   S16 atlas_num;
   F32 advance;
 };
 
-typedef struct FNT_Hash2InfoRasterCacheNode FNT_Hash2InfoRasterCacheNode;
 struct FNT_Hash2InfoRasterCacheNode
 {
   FNT_Hash2InfoRasterCacheNode *hash_next;
@@ -139,7 +151,6 @@ struct FNT_RunCacheSlot
 
 //- rjf: style hash -> artifacts/metrics cache
 
-typedef struct FNT_Hash2StyleRasterCacheNode FNT_Hash2StyleRasterCacheNode;
 struct FNT_Hash2StyleRasterCacheNode
 {
   FNT_Hash2StyleRasterCacheNode *hash_next;
@@ -193,6 +204,25 @@ struct FNT_Atlas
   FNT_AtlasRegionNode *root;
 };
 
+////////////////////////////////
+//~ Asynchronous Rasterization Artifact Types
+
+typedef struct FNT_RasterKey FNT_RasterKey;
+struct FNT_RasterKey
+{
+  FP_Handle font;
+  F32 size;
+  FNT_RasterFlags flags;
+  // NOTE: followed by the piece substring in the artifact key
+};
+
+typedef struct FNT_RasterArtifact FNT_RasterArtifact;
+struct FNT_RasterArtifact
+{
+  Arena *arena;
+  FP_RasterResult raster;
+};
+
 ////////////////////////////////
 //~ rjf: Metrics
 
@@ -227,6 +257,19 @@ struct FNT_State
   // rjf: atlas list
   FNT_Atlas *first_atlas;
   FNT_Atlas *last_atlas;
+  U64 atlas_count;
+  
+  // atlas budget & glyph LRU (most recently used first)
+  U64 atlas_budget_bytes;
+  U64 atlas_bytes_used;
+  FNT_RasterCacheInfo *lru_first;
+  FNT_RasterCacheInfo *lru_last;
+  FNT_Hash2InfoRasterCacheNode *free_hash2info_node;
+  U64 evicted_glyph_count;
+  
+  // asynchronous rasterization state (fp_mutex guards all font provider calls)
+  Mutex fp_mutex;
+  U64 frame_pending_raster_count;
 };
 
 ////////////////////////////////
@@ -257,6 +300,15 @@ internal String8 fnt_path_from_tag(FNT_Tag tag);
 
 internal Rng2S16 fnt_atlas_region_alloc(Arena *arena, FNT_Atlas *atlas, Vec2S16 needed_size);
 internal void fnt_atlas_region_release(FNT_Atlas *atlas, Rng2S16 region);
+internal FNT_Atlas *fnt_atlas_from_num(S16 num);
+
+////////////////////////////////
+//~ Glyph LRU / Eviction
+
+internal void fnt_raster_cache_info_touch(FNT_RasterCacheInfo *info);
+internal void fnt_raster_cache_info_evict(FNT_RasterCacheInfo *info);
+internal U64 fnt_evict_cold_glyphs(U64 target_bytes_used, U64 min_frames_untouched);
+internal void fnt_set_atlas_budget(U64 budget_bytes);
 
 ////////////////////////////////
 //~ rjf: Piece Type Functions
@@ -269,6 +321,11 @@ internal FNT_PieceArray fnt_piece_array_copy(Arena *arena, FNT_PieceArray *src);
 ////////////////////////////////
 //~ rjf: Cache Usage
 
+//- asynchronous rasterization artifacts
+internal AC_Artifact fnt_raster_artifact_create(String8 key, U64 gen, U64 *requested_gen, B32 *retry_out);
+internal void fnt_raster_artifact_destroy(AC_Artifact artifact);
+internal U64 fnt_pending_raster_count(void);
+
 //- rjf: base cache lookups
 internal FNT_Hash2StyleRasterCacheNode *fnt_hash2style_from_tag_size_flags(FNT_Tag tag, F32 size, FNT_RasterFlags flags);
 internal FNT_Run fnt_run_from_string(FNT_Tag tag, F32 size, F32 base_align_px, F32 tab_size_px, FNT_RasterFlags flags, String8 string);
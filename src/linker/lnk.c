@@ -110,6 +110,7 @@
 #include "lnk_obj.h"
 #include "lnk_lib.h"
 #include "lnk_debug_info.h"
+#include "lnk_server.h"
 #include "lnk.h"
 
 #include "lnk_error.c"
@@ -124,6 +125,7 @@
 #include "lnk_debug_helper.c"
 #include "lnk_lib.c"
 #include "lnk_debug_info.c"
+#include "lnk_server.c"
 
 // -----------------------------------------------------------------------------
 
@@ -963,10 +965,11 @@ lnk_inputer_init(void)
 {
   Arena *arena = arena_alloc();
   LNK_Inputer *inputer = push_array(arena, LNK_Inputer, 1);
-  inputer->arena            = arena;
-  inputer->objs_ht          = hash_table_init(arena, 0x20000);
-  inputer->libs_ht          = hash_table_init(arena, 0x1000);
-  inputer->missing_lib_ht   = hash_table_init(arena, 0x100);
+  inputer->arena              = arena;
+  inputer->objs_ht            = hash_table_init(arena, 0x20000);
+  inputer->libs_ht            = hash_table_init(arena, 0x1000);
+  inputer->missing_lib_ht     = hash_table_init(arena, 0x100);
+  inputer->prefetched_objs_ht = hash_table_init(arena, 0x1000);
   return inputer;
 }
 
@@ -1143,13 +1146,19 @@ lnk_inputer_flush(Arena *arena, TP_Context *tp, LNK_Inputer *inputer, LNK_IO_Fla
   U64 thin_inputs_count = 0;
   for (LNK_Input *node = new_inputs->first; node != 0; node = node->next) {
     if (node->is_thin) {
-      thin_inputs_count += 1;
+      // take data read ahead by the lib member prefetch
+      String8 *prefetched_data = hash_table_search_path_raw(inputer->prefetched_objs_ht, node->path);
+      if (prefetched_data) {
+        node->data = *prefetched_data;
+      } else {
+        thin_inputs_count += 1;
+      }
     }
   }
   LNK_Input **thin_inputs = push_array(scratch.arena, LNK_Input *, thin_inputs_count);
   U64         thin_idx    = 0;
   for (LNK_Input *node = new_inputs->first; node != 0; node = node->next) {
-    if (node->is_thin) {
+    if (node->is_thin && node->data.size == 0) {
       thin_inputs[thin_idx++] = node;
     }
   }
@@ -1268,6 +1277,91 @@ lnk_load_objs(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *
   return new_objs;
 }
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_prefetch_lib_members_task)
+{
+  LNK_PrefetchLibMembersTask *task    = raw_task;
+  LNK_Lib                    *lib     = task->libs[task_id];
+  U32Array                    offsets = task->member_offsets[task_id];
+
+  U64 page_sum = 0;
+  for EachIndex(i, offsets.count) {
+    if (offsets.v[i] < lib->data.size) {
+      COFF_ArchiveMember member_info = coff_archive_member_from_offset(lib->data, offsets.v[i]);
+      for (U64 off = 0; off < member_info.data.size; off += KB(4)) {
+        page_sum += member_info.data.str[off];
+      }
+    }
+  }
+  task->page_sums[task_id] = page_sum;
+}
+
+internal void
+lnk_prefetch_lib_members(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *inputer, LNK_MemberSet *member_set, LNK_LibNodeArray libs)
+{
+  if (member_set->lib_count == 0 || libs.count == 0) { return; }
+
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(arena->v, arena->count);
+
+  LNK_PrefetchLibMembersTask task = {0};
+  task.libs           = push_array(scratch.arena, LNK_Lib *, libs.count);
+  task.member_offsets = push_array(scratch.arena, U32Array, libs.count);
+  task.page_sums      = push_array(scratch.arena, U64, libs.count);
+
+  String8List thin_paths = {0};
+  for EachIndex(lib_idx, libs.count) {
+    LNK_Lib  *lib     = &libs.v[lib_idx]->data;
+    U32Array  offsets = lnk_member_offsets_from_lib_path(member_set, lib->path);
+    if (offsets.count == 0) { continue; }
+
+    if (lib->type == COFF_Archive_Thin) {
+      for EachIndex(i, offsets.count) {
+        if (offsets.v[i] >= lib->data.size) { continue; }
+
+        COFF_ArchiveMember member_info = coff_archive_member_from_offset(lib->data, offsets.v[i]);
+        String8            member_name = coff_decode_member_name(lib->long_names, member_info.header.name);
+        if (member_name.size == 0) { continue; }
+
+        // obj path in thin archive is relative to the directory with lib
+        String8List obj_path_list = {0};
+        str8_list_push(scratch.arena, &obj_path_list, str8_chop_last_slash(lib->path));
+        str8_list_push(scratch.arena, &obj_path_list, member_name);
+        String8 obj_path  = str8_path_list_join_by_style(scratch.arena, &obj_path_list, config->path_style);
+        String8 full_path = os_full_path_from_path(inputer->arena, obj_path);
+
+        if (hash_table_search_path_raw(inputer->objs_ht, full_path) == 0 &&
+            hash_table_search_path_raw(inputer->prefetched_objs_ht, full_path) == 0) {
+          str8_list_push(scratch.arena, &thin_paths, full_path);
+        }
+      }
+    } else if (config->io_flags & LNK_IO_Flags_MemoryMapFiles) {
+      task.libs[task.lib_count]           = lib;
+      task.member_offsets[task.lib_count] = offsets;
+      task.lib_count                     += 1;
+    }
+  }
+
+  // fault in pages of mapped members ahead of the serial search rounds
+  tp_for_parallel(tp, 0, task.lib_count, lnk_prefetch_lib_members_task, &task);
+
+  // read predicted thin archive members in one parallel batch instead of one batch per search round
+  if (thin_paths.node_count) {
+    String8Array paths = str8_array_from_list(scratch.arena, &thin_paths);
+    String8Array datas = lnk_read_data_from_file_path_parallel(tp, inputer->arena, config->io_flags, paths);
+    for EachIndex(i, paths.count) {
+      if (datas.v[i].size) {
+        String8 *data = push_array(inputer->arena, String8, 1);
+        *data = datas.v[i];
+        hash_table_push_path_raw(inputer->arena, inputer->prefetched_objs_ht, paths.v[i], data);
+      }
+    }
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
 internal void
 lnk_load_libs(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *inputer, LNK_Link *link)
 {
@@ -1282,7 +1376,8 @@ lnk_load_libs(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *
       lnk_log(LNK_Log_InputObj, "[ Lib Input Size %M ]", input_size);
     }
 
-    lnk_lib_list_push_parallel(tp, arena, &link->libs, new_input_libs.count, new_input_libs.v);
+    LNK_LibNodeArray new_libs = lnk_lib_list_push_parallel(tp, arena, config->lib_cache_dir, &link->libs, new_input_libs.count, new_input_libs.v);
+    lnk_prefetch_lib_members(tp, arena, config, inputer, &link->prev_member_set, new_libs);
 
     ProfEnd();
   }
@@ -1730,6 +1825,12 @@ lnk_link_image(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer
   link->last_cmd_lib               = &config->input_list[LNK_Input_Lib].first;
   link->try_to_resolve_entry_point = 1;
 
+  // load lib members linked by the previous link of this image for prefetching
+  if (config->lib_cache_dir.size) {
+    String8 member_set_path = lnk_member_set_path_from_image_path(scratch.arena, config->lib_cache_dir, config->image_name);
+    link->prev_member_set   = lnk_member_set_from_file(arena->v[0], member_set_path);
+  }
+
   // input :null_obj
   String8 null_obj = lnk_make_null_obj(inputer->arena);
   lnk_inputer_push_obj_linkgen(inputer, 0, str8_lit("* Null *"), null_obj);
@@ -1997,6 +2098,14 @@ lnk_link_image(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer
   //
   lnk_link_inputs(tp, arena, config, inputer, symtab, link);
 
+  //
+  // record linked lib members for the next link
+  //
+  if (config->lib_cache_dir.size && link->libs.count) {
+    String8 member_set_path = lnk_member_set_path_from_image_path(scratch.arena, config->lib_cache_dir, config->image_name);
+    lnk_member_set_write(member_set_path, link->libs);
+  }
+
   //
   // finalize symbol table
   //
@@ -2728,6 +2837,145 @@ lnk_section_contrib_ptr_is_before(void *raw_a, void *raw_b)
   return u64_compar_is_before(&input_idx_a, &input_idx_b);
 }
 
+internal int
+lnk_section_contrib_order_is_before(void *raw_a, void *raw_b)
+{
+  LNK_SectionContribOrder *a = raw_a, *b = raw_b;
+  if (a->key != b->key) {
+    return a->key < b->key;
+  }
+  return a->input_pos < b->input_pos;
+}
+
+internal int
+lnk_order_profile_entry_is_before(void *raw_a, void *raw_b)
+{
+  LNK_OrderProfileEntry *a = raw_a, *b = raw_b;
+  if (a->count != b->count) {
+    return a->count > b->count;
+  }
+  return a->line_idx < b->line_idx;
+}
+
+internal void
+lnk_push_section_contrib_order_key(Arena *arena, LNK_SymbolTable *symtab, U64 **order_keys, String8 name, U64 key, B32 report_missing)
+{
+  LNK_Symbol *symbol = lnk_symbol_table_search(symtab, name);
+  if (symbol == 0 || lnk_interp_from_symbol(symbol) != COFF_SymbolValueInterp_Regular) {
+    if (report_missing) {
+      lnk_error(LNK_Warning_Order, "/ORDER: \"%S\" does not exist; ignored", name);
+    }
+    return;
+  }
+
+  LNK_ObjSymbolRef    ref         = lnk_ref_from_symbol(symbol);
+  COFF_ParsedSymbol   parsed      = lnk_parsed_from_symbol(symbol);
+  COFF_SectionHeader *sect_header = lnk_coff_section_header_from_section_number(ref.obj, parsed.section_number);
+
+  // only COMDATs can be moved, a regular section may pack more than one function
+  if (~sect_header->flags & COFF_SectionFlag_LnkCOMDAT) {
+    if (report_missing) {
+      lnk_error_obj(LNK_Warning_Order, ref.obj, "/ORDER: \"%S\" is not in a COMDAT section and cannot be ordered; ignored", name);
+    }
+    return;
+  }
+
+  U64 **obj_keys = &order_keys[ref.obj->input_idx];
+  if (*obj_keys == 0) {
+    *obj_keys = push_array_no_zero(arena, U64, ref.obj->header.section_count_no_null);
+    for EachIndex(sect_idx, ref.obj->header.section_count_no_null) { (*obj_keys)[sect_idx] = LNK_SECTION_CONTRIB_ORDER_KEY_UNLISTED; }
+  }
+
+  // section may be listed more than once (e.g. through different symbols), first key wins
+  U64 sect_idx = parsed.section_number - 1;
+  (*obj_keys)[sect_idx] = Min((*obj_keys)[sect_idx], key);
+}
+
+internal U64 **
+lnk_section_contrib_order_keys_from_config(Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count)
+{
+  if (config->order_file.size == 0 && config->order_profile.size == 0) {
+    return 0;
+  }
+
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  U64 **order_keys = push_array(arena, U64 *, objs_count);
+  U64   next_key   = 0;
+
+  //
+  // /ORDER:@FILE, one function per line
+  //
+  if (config->order_file.size) {
+    String8 order_data = lnk_read_data_from_file_path(scratch.arena, config->io_flags, config->order_file);
+    if (order_data.size == 0) {
+      lnk_error(LNK_Warning_FileNotFound, "/ORDER: unable to read \"%S\"", config->order_file);
+    }
+
+    String8List lines = str8_split_by_string_chars(scratch.arena, order_data, str8_lit("\r\n"), 0);
+    for EachNode(line_n, String8Node, lines.first) {
+      String8 name = str8_skip_chop_whitespace(line_n->string);
+      if (name.size == 0) { continue; }
+      lnk_push_section_contrib_order_key(arena, symtab, order_keys, name, next_key++, 1);
+    }
+  }
+
+  //
+  // Profile, "SYMBOL COUNT" per line
+  //
+  // Functions with a non-zero count are hot and are clustered right after /ORDER
+  // functions, from the most to the least frequently executed. Functions with a
+  // zero count are cold and are moved behind unlisted functions.
+  //
+  if (config->order_profile.size) {
+    String8 profile_data = lnk_read_data_from_file_path(scratch.arena, config->io_flags, config->order_profile);
+    if (profile_data.size == 0) {
+      lnk_error(LNK_Warning_FileNotFound, "/RAD_ORDER_PROFILE: unable to read \"%S\"", config->order_profile);
+    }
+
+    String8List            lines      = str8_split_by_string_chars(scratch.arena, profile_data, str8_lit("\n"), StringSplitFlag_KeepEmpties);
+    LNK_OrderProfileEntry *hot        = push_array_no_zero(scratch.arena, LNK_OrderProfileEntry, lines.node_count);
+    LNK_OrderProfileEntry *cold       = push_array_no_zero(scratch.arena, LNK_OrderProfileEntry, lines.node_count);
+    U64                    hot_count  = 0;
+    U64                    cold_count = 0;
+    U64                    line_idx   = 0;
+    for EachNode(line_n, String8Node, lines.first) {
+      String8 line = str8_skip_chop_whitespace(line_n->string);
+      line_idx += 1;
+      if (line.size == 0 || line.str[0] == '#') { continue; }
+
+      String8List parts = str8_split_by_string_chars(scratch.arena, line, str8_lit(" \t"), 0);
+      U64         count = 0;
+      if (parts.node_count != 2 || !try_u64_from_str8_c_rules(parts.last->string, &count)) {
+        lnk_error(LNK_Warning_Order, "/RAD_ORDER_PROFILE: %S(%llu): expected \"SYMBOL COUNT\"; line ignored", config->order_profile, line_idx);
+        continue;
+      }
+
+      LNK_OrderProfileEntry entry = { .name = parts.first->string, .count = count, .line_idx = line_idx };
+      if (count > 0) {
+        hot[hot_count++] = entry;
+      } else {
+        cold[cold_count++] = entry;
+      }
+    }
+
+    radsort(hot, hot_count, lnk_order_profile_entry_is_before);
+
+    // profiles are often collected from a different build, so missing symbols are expected
+    for EachIndex(hot_idx, hot_count) {
+      lnk_push_section_contrib_order_key(arena, symtab, order_keys, hot[hot_idx].name, next_key++, 0);
+    }
+    for EachIndex(cold_idx, cold_count) {
+      lnk_push_section_contrib_order_key(arena, symtab, order_keys, cold[cold_idx].name, LNK_SECTION_CONTRIB_ORDER_KEY_UNLISTED + 1 + cold_idx, 0);
+    }
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+  return order_keys;
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_sort_contribs_task)
 {
@@ -2735,6 +2983,31 @@ THREAD_POOL_TASK_FUNC(lnk_sort_contribs_task)
   LNK_SectionContribChunk *chunk = task->u.sort_contribs.chunks[task_id];
   ProfBeginV("[%llu]", chunk->count);
   radsort(chunk->v, chunk->count, lnk_section_contrib_ptr_is_before);
+
+  // apply /ORDER and profile keys on top of the input order
+  U64 **order_keys = task->u.sort_contribs.order_keys;
+  if (order_keys) {
+    Temp scratch = scratch_begin(0, 0);
+
+    B32                      has_keys = 0;
+    LNK_SectionContribOrder *order    = push_array_no_zero(scratch.arena, LNK_SectionContribOrder, chunk->count);
+    for EachIndex(sc_idx, chunk->count) {
+      LNK_SectionContrib *sc       = chunk->v[sc_idx];
+      U64                *obj_keys = order_keys[sc->u.obj_idx];
+      order[sc_idx].key       = obj_keys ? obj_keys[sc->u.obj_sect_idx] : LNK_SECTION_CONTRIB_ORDER_KEY_UNLISTED;
+      order[sc_idx].input_pos = sc_idx;
+      order[sc_idx].sc        = sc;
+      has_keys |= order[sc_idx].key != LNK_SECTION_CONTRIB_ORDER_KEY_UNLISTED;
+    }
+
+    if (has_keys) {
+      radsort(order, chunk->count, lnk_section_contrib_order_is_before);
+      for EachIndex(sc_idx, chunk->count) { chunk->v[sc_idx] = order[sc_idx].sc; }
+    }
+
+    scratch_end(scratch);
+  }
+
   ProfEnd();
 }
 
@@ -4205,6 +4478,7 @@ lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolT
         Assert(cursor == total_chunk_count);
       }
 
+      task.u.sort_contribs.order_keys = lnk_section_contrib_order_keys_from_config(scratch.arena, config, symtab, objs_count);
       tp_for_parallel(tp, 0, total_chunk_count, lnk_sort_contribs_task, &task);
 
       ProfEnd();
@@ -4916,8 +5190,63 @@ internal void
 lnk_write_thread(void *raw_ctx)
 {
   ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
   LNK_WriteThreadContext *ctx = raw_ctx;
-  lnk_write_data_to_file_path(ctx->path, ctx->temp_path, ctx->data);
+
+  // writer has its own pool since the main pool is busy with debug info
+  TP_Context *tp = tp_alloc(scratch.arena, ctx->worker_count, ctx->worker_count, str8_zero());
+
+  String8List data_list = {0};
+  str8_list_push(scratch.arena, &data_list, ctx->data);
+  lnk_write_data_list_to_file_path_parallel(tp, ctx->path, ctx->temp_path, data_list);
+
+  if (ctx->worker_count > 1) {
+    tp_release(tp);
+  }
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal
+RDIB_WRITE_FUNC(lnk_rdi_write)
+{
+  LNK_RdiWriter *writer = ud;
+  lnk_file_stream_write(writer->tp, &writer->stream, off, data);
+}
+
+internal void
+lnk_rdi_thread(void *raw_ctx)
+{
+  ProfBeginFunction();
+  LNK_RdiThreadContext *ctx    = raw_ctx;
+  LNK_Config           *config = ctx->config;
+
+  lnk_timer_begin(LNK_Timer_Rdi);
+
+  // sections are written as soon as they are serialized, so the whole RDI is never resident
+  LNK_RdiWriter writer = {0};
+  writer.tp            = ctx->tp;
+  writer.stream        = lnk_file_stream_open(config->rad_debug_name, config->temp_rad_debug_name);
+
+  lnk_build_rad_debug_info(ctx->tp,
+                           ctx->arena,
+                           config->target_os,
+                           rdi_arch_from_coff_machine(config->machine),
+                           config->image_name,
+                           ctx->image_data,
+                           ctx->input->count,
+                           ctx->input->obj_arr,
+                           ctx->input->debug_s_arr,
+                           ctx->input->total_symbol_input_count,
+                           ctx->input->symbol_inputs,
+                           ctx->input->parsed_symbols,
+                           ctx->types,
+                           lnk_rdi_write,
+                           &writer);
+
+  lnk_file_stream_close(&writer.stream);
+
+  lnk_timer_end(LNK_Timer_Rdi);
   ProfEnd();
 }
 
@@ -4946,6 +5275,15 @@ lnk_log_timers(void)
   DateTime total_time = date_time_from_micro_seconds(total_build_time_micro);
   String8 total_time_str = string_from_elapsed_time(scratch.arena, total_time);
   str8_list_pushf(scratch.arena, &output_list, "  Total Time: %S", total_time_str);
+
+  // RDI and PDB are built concurrently when possible, report how long the builds overlapped
+  U64 debug_overlap_min = Max(g_timers[LNK_Timer_Rdi].begin, g_timers[LNK_Timer_Pdb].begin);
+  U64 debug_overlap_max = Min(g_timers[LNK_Timer_Rdi].end,   g_timers[LNK_Timer_Pdb].end);
+  if (debug_overlap_min < debug_overlap_max) {
+    DateTime overlap_time     = date_time_from_micro_seconds(debug_overlap_max - debug_overlap_min);
+    String8  overlap_time_str = string_from_elapsed_time(scratch.arena, overlap_time);
+    str8_list_pushf(scratch.arena, &output_list, "  PDB/RDI Overlap: %S", overlap_time_str);
+  }
   
   StringJoin new_line_join = { str8_lit_comp(""), str8_lit_comp("\n"), str8_lit_comp("") };
   String8 output = str8_list_join(scratch.arena, &output_list, &new_line_join);
@@ -4954,12 +5292,36 @@ lnk_log_timers(void)
   scratch_end(scratch);
 }
 
+internal void
+lnk_write_bench_report(String8 path, U64 wall_micro)
+{
+  Temp scratch = scratch_begin(0, 0);
+
+  // one key=value pair per line so benchmark harnesses can parse the report without knowing the timer set
+  String8List report = {0};
+  for (U64 i = 0; i < LNK_Timer_Count; ++i) {
+    U64     time_micro = g_timers[i].end - g_timers[i].begin;
+    String8 timer_name = lower_from_str8(scratch.arena, lnk_string_from_timer_type(i));
+    str8_list_pushf(scratch.arena, &report, "%S_us=%llu\n", timer_name, time_micro);
+  }
+
+  // timers nest (PDB inside Debug) and overlap (RDI next to PDB), so total is wall time and not their sum
+  str8_list_pushf(scratch.arena, &report, "total_us=%llu\n", wall_micro);
+  str8_list_pushf(scratch.arena, &report, "peak_memory_bytes=%llu\n", lnk_get_peak_memory_usage());
+
+  String8 temp_path = push_str8f(scratch.arena, "%S.tmp%x", path, os_get_process_info()->pid);
+  lnk_write_data_list_to_file_path(path, temp_path, report);
+
+  scratch_end(scratch);
+}
+
 internal void
 lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
 {
   ProfBeginFunction();
 
-  Temp scratch = scratch_begin(arena->v, arena->count);
+  U64  link_begin_micro = os_now_microseconds();
+  Temp scratch          = scratch_begin(arena->v, arena->count);
 
   //
   // Input Context
@@ -4988,9 +5350,10 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
 
   // Write image in the background
   LNK_WriteThreadContext *image_write_ctx = push_array(scratch.arena, LNK_WriteThreadContext, 1);
-  image_write_ctx->path      = config->image_name;
-  image_write_ctx->temp_path = config->temp_image_name;
-  image_write_ctx->data      = image_ctx.image_data;
+  image_write_ctx->path         = config->image_name;
+  image_write_ctx->temp_path    = config->temp_image_name;
+  image_write_ctx->data         = image_ctx.image_data;
+  image_write_ctx->worker_count = lnk_do_debug_info(config) ? 1 : config->worker_count; // without debug info there is nothing to overlap the write with
   Thread image_write_thread = thread_launch(lnk_write_thread, image_write_ctx);
 
   //
@@ -4998,7 +5361,7 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
   //
   if (config->rad_chunk_map == LNK_SwitchState_Yes) {
     String8List rad_map = lnk_build_rad_map(scratch.arena, image_ctx.image_data, config, objs_count, objs, libs_count, libs, image_ctx.sectab);
-    lnk_write_data_list_to_file_path(config->rad_chunk_map_name, config->temp_rad_chunk_map_name, rad_map);
+    lnk_write_data_list_to_file_path_parallel(tp, config->rad_chunk_map_name, config->temp_rad_chunk_map_name, rad_map);
   }
 
   //
@@ -5033,45 +5396,60 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
     // CodeView
     //
     LNK_CodeViewInput input = lnk_make_code_view_input(tp, arena, config->io_flags, config->lib_dir_list, config->alt_pch_dirs, debug_info_objs_count, debug_info_objs);
-    CV_DebugT        *types = lnk_import_types(tp, arena, &input);
+    CV_DebugT        *types = lnk_import_types(tp, arena, &input, config->type_hash_cache_path);
+
+    B32 build_rdi       = config->rad_debug == LNK_SwitchState_Yes;
+    B32 build_pdb       = config->debug_mode == LNK_DebugMode_Full;
+    B32 hash_type_names = config->pdb_hash_type_names != LNK_TypeNameHashMode_Null && config->pdb_hash_type_names != LNK_TypeNameHashMode_None;
 
     //
     // RDI
     //
-    if (config->rad_debug == LNK_SwitchState_Yes) {
-      lnk_timer_begin(LNK_Timer_Rdi);
-
-      String8List rdi_data = lnk_build_rad_debug_info(tp,
-                                                      arena,
-                                                      config->target_os,
-                                                      rdi_arch_from_coff_machine(config->machine),
-                                                      config->image_name,
-                                                      image_ctx.image_data,
-                                                      input.count,
-                                                      input.obj_arr,
-                                                      input.debug_s_arr,
-                                                      input.total_symbol_input_count,
-                                                      input.symbol_inputs,
-                                                      input.parsed_symbols,
-                                                      types);
-
-      lnk_write_data_list_to_file_path(config->rad_debug_name, config->temp_rad_debug_name, rdi_data);
-
-      lnk_timer_end(LNK_Timer_Rdi);
+    // Both builds read the same CodeView input. PDB build patches only module
+    // private copies of C13 sub-sections and, when the builds overlap, works on
+    // a private copy of the parsed symbol lists since it unlinks GSI symbols,
+    // assigns symbol offsets, and patches scope parent/end offsets. So when both
+    // are requested RDI is built on a separate thread with its own thread pool,
+    // and workers are split between the two pools while the builds overlap.
+    // Type name hashing rewrites TPI leaves in place and RDI must see the
+    // original names, in that case builds run back to back.
+    B32                   is_rdi_threaded = build_rdi && build_pdb && !hash_type_names && config->worker_count > 1;
+    Thread                rdi_thread      = {0};
+    LNK_RdiThreadContext *rdi_ctx         = push_array(scratch.arena, LNK_RdiThreadContext, 1);
+    rdi_ctx->tp         = tp;
+    rdi_ctx->arena      = arena;
+    rdi_ctx->config     = config;
+    rdi_ctx->image_data = image_ctx.image_data;
+    rdi_ctx->input      = &input;
+    rdi_ctx->types      = types;
+    if (is_rdi_threaded) {
+      // a pool shared between linker processes is keyed by name, RDI pool must not join the main pool
+      String8 rdi_thread_pool_name = config->shared_thread_pool_name.size ? push_str8f(scratch.arena, "%S_rdi", config->shared_thread_pool_name) : str8_zero();
+      U32 rdi_worker_count = config->worker_count / 2;
+      tp_set_active_worker_count(tp, config->worker_count - rdi_worker_count);
+      rdi_ctx->tp    = tp_alloc(scratch.arena, rdi_worker_count, config->max_worker_count, rdi_thread_pool_name);
+      rdi_ctx->arena = tp_arena_alloc(rdi_ctx->tp);
+      rdi_thread     = thread_launch(lnk_rdi_thread, rdi_ctx);
+    } else if (build_rdi) {
+      lnk_rdi_thread(rdi_ctx);
     }
 
     //
     // PDB
     //
-    // TODO: Parallel debug info builds are currently blocked by the patch
-    // strings in $$FILE_CHECKSUM step in `lnk_process_c13_data_task`.
-    if (config->debug_mode == LNK_DebugMode_Full) {
+    if (build_pdb) {
       lnk_timer_begin(LNK_Timer_Pdb);
 
-      if (config->pdb_hash_type_names != LNK_TypeNameHashMode_Null && config->pdb_hash_type_names != LNK_TypeNameHashMode_None) {
+      if (hash_type_names) {
         lnk_replace_type_names_with_hashes(tp, arena, types[CV_TypeIndexSource_TPI], config->pdb_hash_type_names, config->pdb_hash_type_name_length, config->pdb_hash_type_name_map);
       }
 
+      // RDI thread is still reading the symbol lists
+      CV_SymbolListArray *pdb_parsed_symbols = input.parsed_symbols;
+      if (is_rdi_threaded) {
+        pdb_parsed_symbols = lnk_copy_parsed_symbols(tp, arena, input.count, input.parsed_symbols);
+      }
+
       String8List pdb_data = lnk_build_pdb(tp,
                                            arena,
                                            image_ctx.image_data,
@@ -5082,13 +5460,23 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
                                            input.debug_s_arr,
                                            input.total_symbol_input_count,
                                            input.symbol_inputs,
-                                           input.parsed_symbols,
+                                           pdb_parsed_symbols,
                                            types);
 
-      lnk_write_data_list_to_file_path(config->pdb_name, config->temp_pdb_name, pdb_data);
+      lnk_write_data_list_to_file_path_parallel(tp, config->pdb_name, config->temp_pdb_name, pdb_data);
       lnk_timer_end(LNK_Timer_Pdb);
     }
 
+    // wait for the RDI thread to finish building and writing RDI to disk
+    if (is_rdi_threaded) {
+      thread_join(rdi_thread, -1);
+      if (lnk_server_is_active()) {
+        tp_arena_release(&rdi_ctx->arena);
+      }
+      tp_release(rdi_ctx->tp);
+      tp_set_active_worker_count(tp, tp->worker_count);
+    }
+
     lnk_timer_end(LNK_Timer_Debug);
     ProfEnd();
   }
@@ -5102,6 +5490,15 @@ lnk_run(TP_Context *tp, TP_Arena *arena, LNK_Config *config)
   if (lnk_get_log_status(LNK_Log_Timers)) {
     lnk_log_timers();
   }
+  if (config->bench_report_path.size) {
+    lnk_write_bench_report(config->bench_report_path, os_now_microseconds() - link_begin_micro);
+  }
+
+  // resident server reuses the process, release memory that is not owned by the link arenas
+  if (lnk_server_is_active()) {
+    lnk_section_table_release(&image_ctx.sectab);
+    arena_release(inputer->arena);
+  }
   
   scratch_end(scratch);
   ProfEnd();
@@ -5112,7 +5509,42 @@ entry_point(CmdLine *cmdline)
 {
   Temp scratch = scratch_begin(0,0);
   lnk_init_error_handler();
-  LNK_Config *config   = lnk_config_from_argcv(scratch.arena, cmdline->argc, cmdline->argv);
+
+  // strip server switches, they are not part of the link command line
+  B32     is_server      = 0;
+  B32     is_server_link = 0;
+  String8 server_name    = str8_lit(LNK_SERVER_DEFAULT_NAME);
+  int     argc           = 0;
+  char  **argv           = push_array(scratch.arena, char *, cmdline->argc + 1);
+  for (U64 arg_idx = 0; arg_idx < cmdline->argc; ++arg_idx) {
+    String8 arg = str8_cstring(cmdline->argv[arg_idx]);
+    if (arg_idx > 0 && str8_match(arg, str8_lit("--server"), StringMatchFlag_CaseInsensitive)) {
+      is_server = 1;
+    } else if (arg_idx > 0 && str8_match(arg, str8_lit("--server_link"), StringMatchFlag_CaseInsensitive)) {
+      is_server_link = 1;
+    } else if (arg_idx > 0 && str8_match(arg, str8_lit("--server_name:"), StringMatchFlag_CaseInsensitive|StringMatchFlag_RightSideSloppy)) {
+      server_name = str8_skip(arg, str8_lit("--server_name:").size);
+    } else {
+      argv[argc++] = cmdline->argv[arg_idx];
+    }
+  }
+
+  if (is_server) {
+    lnk_server_run(str8_cstring(cmdline->argv[0]), server_name);
+  }
+  if (is_server_link) {
+    int exit_code = 0;
+    if (lnk_server_link(server_name, argc, argv, &exit_code)) {
+      if (exit_code != 0) {
+        lnk_exit(exit_code);
+      }
+      scratch_end(scratch);
+      return;
+    }
+    // no server is running, link in-process
+  }
+
+  LNK_Config *config   = lnk_config_from_argcv(scratch.arena, argc, argv);
   TP_Context *tp       = tp_alloc(scratch.arena, config->worker_count, config->max_worker_count, config->shared_thread_pool_name);
   TP_Arena   *tp_arena = tp_arena_alloc(tp);
   lnk_run(tp, tp_arena, config);
@@ -64,6 +64,7 @@ typedef struct LNK_Inputer
 
   HashTable     *libs_ht;
   HashTable     *missing_lib_ht;
+  HashTable     *prefetched_objs_ht;
   LNK_InputList  libs;
   LNK_InputList  new_libs[LNK_InputSource_Count];
 } LNK_Inputer;
@@ -87,6 +88,7 @@ typedef struct LNK_Link
   String8Node            **last_obj_lib;
   LNK_LibMemberRefList     imports;
   B32                      try_to_resolve_entry_point;
+  LNK_MemberSet            prev_member_set;
 } LNK_Link;
 
 // -- Image Layout ------------------------------------------------------------
@@ -187,6 +189,14 @@ typedef struct
   LNK_LibMemberRefList *member_ref_lists;
 } LNK_SearchLibTask;
 
+typedef struct
+{
+  U64        lib_count;
+  LNK_Lib  **libs;
+  U32Array  *member_offsets;
+  U64       *page_sums;
+} LNK_PrefetchLibMembersTask;
+
 typedef struct
 {
   LNK_SymbolTable   *symtab;
@@ -221,6 +231,24 @@ typedef struct
   };
 } LNK_BaseRelocsTask;
 
+// contribs without an order key keep input order and are placed after ordered
+// (/ORDER and hot profile) contribs and before cold profile contribs
+#define LNK_SECTION_CONTRIB_ORDER_KEY_UNLISTED (1ull << 62)
+
+typedef struct
+{
+  U64                 key;
+  U64                 input_pos;
+  LNK_SectionContrib *sc;
+} LNK_SectionContribOrder;
+
+typedef struct
+{
+  String8 name;
+  U64     count;
+  U64     line_idx;
+} LNK_OrderProfileEntry;
+
 typedef struct LNK_ImageFillNode
 {
   U64                  base_foff;
@@ -253,6 +281,7 @@ typedef struct
     } common_block;
     struct {
       LNK_SectionContribChunk **chunks;
+      U64                     **order_keys;
     } sort_contribs;
     struct {
       B8                        **was_symbol_patched;
@@ -273,8 +302,25 @@ typedef struct
   String8 path;
   String8 temp_path;
   String8 data;
+  U64     worker_count;
 } LNK_WriteThreadContext;
 
+typedef struct
+{
+  TP_Context        *tp;
+  TP_Arena          *arena;
+  LNK_Config        *config;
+  String8            image_data;
+  LNK_CodeViewInput *input;
+  CV_DebugT         *types;
+} LNK_RdiThreadContext;
+
+typedef struct
+{
+  TP_Context     *tp;
+  LNK_FileStream  stream;
+} LNK_RdiWriter;
+
 typedef struct
 {
   String8  data;
@@ -341,6 +387,7 @@ internal int                 lnk_lib_member_ref_is_before(void *raw_a, void *raw
 internal LNK_LibMemberRef ** lnk_array_from_lib_member_list(Arena *arena, LNK_LibMemberRefList list);
 
 internal LNK_ObjNode * lnk_load_objs  (TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *inputer, LNK_SymbolTable *symtab, LNK_Link *link, U64 *objs_count_out);
+internal void          lnk_prefetch_lib_members(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *inputer, LNK_MemberSet *member_set, LNK_LibNodeArray libs);
 internal void          lnk_load_libs  (TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *inputer, LNK_Link *link);
 internal void          lnk_link_inputs(TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *inputer, LNK_SymbolTable *symtab, LNK_Link *link);
 internal LNK_Link *    lnk_link_image (TP_Context *tp, TP_Arena *arena, LNK_Config *config, LNK_Inputer *inputer, LNK_SymbolTable *symtab);
@@ -356,8 +403,14 @@ internal String8          lnk_build_base_relocs(TP_Context *tp, TP_Arena *tp_tem
 internal String8List      lnk_build_win32_image_header(Arena *arena, LNK_SymbolTable *symtab, LNK_Config *config, LNK_SectionArray sect_arr, U64 expected_image_header_size);
 internal LNK_ImageContext lnk_build_image(TP_Arena *arena, TP_Context *tp, LNK_Config *config, LNK_SymbolTable *symtab, U64 obj_count, LNK_Obj **objs);
 
+// --- Section Contrib Order ---------------------------------------------------
+
+internal void   lnk_push_section_contrib_order_key(Arena *arena, LNK_SymbolTable *symtab, U64 **order_keys, String8 name, U64 key, B32 report_missing);
+internal U64 ** lnk_section_contrib_order_keys_from_config(Arena *arena, LNK_Config *config, LNK_SymbolTable *symtab, U64 objs_count);
+
 // --- Logger ------------------------------------------------------------------
 
 internal void lnk_log_link_stats(LNK_ObjList obj_list, LNK_LibList *lib_index, LNK_SectionTable *sectab);
 internal void lnk_log_timers(void);
+internal void lnk_write_bench_report(String8 path, U64 wall_micro);
 
@@ -92,7 +92,7 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_NoLogo,             0, "NOLOGO",               "", ""                                                                                                      },
   { LNK_CmdSwitch_NxCompat,           0, "NXCOMPAT",             "[:NO]", ""                                                                                                 },
   { LNK_CmdSwitch_Opt,                0, "OPT",                  "", ""                                                                                                      },
-  { LNK_CmdSwitch_NotImplemented,     0, "ORDER",                "", ""                                                                                                      },
+  { LNK_CmdSwitch_Order,              0, "ORDER",                ":@FILENAME", "File lists COMDAT functions, one per line, in the order they are placed in the image."            },
   { LNK_CmdSwitch_Out,                0, "OUT",                  ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_Pdb,                0, "PDB",                  ":FILENAME", ""                                                                                             },
   { LNK_CmdSwitch_PdbAltPath,         0, "PDBALTPATH",           "", ""                                                                                                      },
@@ -125,6 +125,7 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   //- internal switches
   { LNK_CmdSwitch_Rad_Age,                          0, "RAD_AGE",                              ":#",        "Age embeded in EXE and PDB, used to validate incremental build. Default is 1."    },
   { LNK_CmdSwitch_Rad_AltPchDir,                    0, "RAD_ALT_PCH_DIR",                      ":PATH",     "Alternative directory to search for PCH object files."                            },
+  { LNK_CmdSwitch_Rad_BenchReport,                  0, "RAD_BENCH_REPORT",                     ":FILENAME", "Write link phase times and peak memory usage to a file as key=value lines."     },
   { LNK_CmdSwitch_Rad_BuildInfo,                    0, "RAD_BUILD_INFO",                       "",          "Print build info and exit."                                                       },
   { LNK_CmdSwitch_Rad_CheckUnusedDelayLoadDll,      0, "RAD_CHECK_UNUSED_DELAY_LOAD_DLL",      "[:NO]",     ""                                                                                 },
   { LNK_CmdSwitch_Rad_Map,                          0, "RAD_MAP",                              ":FILENAME", "Emit file with the output image's layout description."                            },
@@ -139,9 +140,11 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_Rad_Exe,                          0, "RAD_EXE",                              "[:NO]", ""                                                                                     },
   { LNK_CmdSwitch_Rad_Guid,                         0, "RAD_GUID",                             ":{IMAGEBLAKE3|XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXXXXXX}", ""                                   },
   { LNK_CmdSwitch_Rad_LargePages,                   0, "RAD_LARGE_PAGES",                      "[:NO]",     "Disabled by default on Windows."                                                  },
+  { LNK_CmdSwitch_Rad_LibCache,                     0, "RAD_LIB_CACHE",                        ":PATH",     "Directory for cached library symbol indices, reused while the library is unchanged." },
   { LNK_CmdSwitch_Rad_LinkVer,                      0, "RAD_LINK_VER",                         ":##,##", ""                                                                                    },
   { LNK_CmdSwitch_Rad_Log,                          0, "RAD_LOG",                              ":{ALL,INPUT_OBJ,INPUT_LIB,IO,LINK_STATS,TIMERS}", ""                                           },
   { LNK_CmdSwitch_Rad_MtPath,                       0, "RAD_MT_PATH",                          ":EXEPATH",  "Exe path to manifest tool, default: " LNK_MANIFEST_MERGE_TOOL_NAME                },
+  { LNK_CmdSwitch_Rad_OrderProfile,                 0, "RAD_ORDER_PROFILE",                    ":FILENAME", "File with \"SYMBOL COUNT\" lines; functions with non-zero counts are clustered from hottest to coldest, zero count functions are moved to the end." },
   { LNK_CmdSwitch_Rad_OsVer,                        0, "RAD_OS_VER",                           ":##,##", ""                                                                                    },
   { LNK_CmdSwitch_Rad_PageSize,                     0, "RAD_PAGE_SIZE",                        ":#",        "Must be power of two."                                                            },
   { LNK_CmdSwitch_Rad_PathStyle,                    0, "RAD_PATH_STYLE",                       ":{WindowsAbsolute|UnixAbsolute}", ""                                                           },
@@ -155,6 +158,7 @@ global read_only LNK_CmdSwitch g_cmd_switch_map[] =
   { LNK_CmdSwitch_Rad_TargetOs,                     0, "RAD_TARGET_OS",                        ":{WINDOWS,LINUX,MAC}"                                                                          },
   { LNK_CmdSwitch_Rad_WriteTempFiles,               0, "RAD_WRITE_TEMP_FILES",                 "[:NO]",     "When speicifed linker writes image and debug info to temporary files and renames after link is done." },
   { LNK_CmdSwitch_Rad_TimeStamp,                    0, "RAD_TIME_STAMP",                       ":#",        "Time stamp embeded in EXE and PDB."                                               },
+  { LNK_CmdSwitch_Rad_TypeHashCache,                0, "RAD_TYPE_HASH_CACHE",                  ":PATH",     "File for cached CodeView type hashes, reused for objects with unchanged .debug$T." },
   { LNK_CmdSwitch_Rad_UnresolvedSymbolLimit,        0, "RAD_UNRESOLVED_SYMBOL_LIMIT",          ":#",        "Limits number of unresolved symbol errors linker reports."                        },
   { LNK_CmdSwitch_Rad_UnresolvedSymbolRefLimit,     0, "RAD_UNRESOLVED_SYMBOL_REF_LIMIT",      ":#",        "Limit number of unresolved symbol references linker reports."                     },
   { LNK_CmdSwitch_Rad_Version,                      0, "RAD_VERSION",                          "",          "Print version and exit."                                                          },
@@ -1680,6 +1684,18 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     }
   } break;
 
+  case LNK_CmdSwitch_Order: {
+    String8 order_file = {0};
+    if (lnk_cmd_switch_parse_string(obj, cmd_switch, value_strings, &order_file)) {
+      if (str8_match(str8_prefix(order_file, 1), str8_lit("@"), 0)) {
+        order_file = str8_skip(order_file, 1);
+      } else {
+        lnk_error_cmd_switch(LNK_Warning_Cmdl, obj, cmd_switch, "expected '@' before file name");
+      }
+      config->order_file = push_str8_copy(config->arena, order_file);
+    }
+  } break;
+
   case LNK_CmdSwitch_Out: {
     lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->image_name);
   } break;
@@ -1789,6 +1805,10 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     str8_list_concat_in_place(&config->alt_pch_dirs, &dirs);
   } break;
 
+  case LNK_CmdSwitch_Rad_BenchReport: {
+    lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->bench_report_path);
+  } break;
+
   case LNK_CmdSwitch_Rad_BuildInfo: {
     lnk_print_build_info();
     os_abort(0);
@@ -1859,6 +1879,10 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     }
   } break;
 
+  case LNK_CmdSwitch_Rad_LibCache: {
+    lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->lib_cache_dir);
+  } break;
+
   case LNK_CmdSwitch_Rad_LargePages: {
     if (value_strings.node_count == 0) {
       OS_ProcessInfo *process_info = os_get_process_info();
@@ -1922,6 +1946,10 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->mt_path);
   } break;
 
+  case LNK_CmdSwitch_Rad_OrderProfile: {
+    lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->order_profile);
+  } break;
+
   case LNK_CmdSwitch_Rad_OsVer: {
     lnk_cmd_switch_parse_version(obj, cmd_switch, value_strings, &config->os_ver);
   } break;
@@ -2036,6 +2064,10 @@ lnk_apply_cmd_option_to_config(LNK_Config *config, String8 cmd_name, String8List
     lnk_cmd_switch_parse_u32(obj, cmd_switch, value_strings, &config->time_stamp, 0);
   } break;
 
+  case LNK_CmdSwitch_Rad_TypeHashCache: {
+    lnk_cmd_switch_parse_string_copy(config->arena, obj, cmd_switch, value_strings, &config->type_hash_cache_path);
+  } break;
+
   case LNK_CmdSwitch_Rad_UnresolvedSymbolLimit: {
     lnk_cmd_switch_parse_u64(obj, cmd_switch, value_strings, &config->unresolved_symbol_limit, 0);
   } break;
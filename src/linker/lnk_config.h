@@ -76,6 +76,7 @@ typedef enum
   LNK_CmdSwitch_NoLogo,
   LNK_CmdSwitch_NxCompat,
   LNK_CmdSwitch_Opt,
+  LNK_CmdSwitch_Order,
   LNK_CmdSwitch_Out,
   LNK_CmdSwitch_Pdb,
   LNK_CmdSwitch_PdbAltPath,
@@ -129,7 +130,6 @@ typedef enum
   LNK_CmdSwitch_Midl,
   LNK_CmdSwitch_NoAssembly,
   LNK_CmdSwitch_NoEntry,
-  LNK_CmdSwitch_Order,
   LNK_CmdSwitch_PdbStripped,
   LNK_CmdSwitch_Profile,
   LNK_CmdSwitch_Release,
@@ -152,6 +152,7 @@ typedef enum
 
   LNK_CmdSwitch_Rad_Age,
   LNK_CmdSwitch_Rad_AltPchDir,
+  LNK_CmdSwitch_Rad_BenchReport,
   LNK_CmdSwitch_Rad_BuildInfo,
   LNK_CmdSwitch_Rad_CheckUnusedDelayLoadDll,
   LNK_CmdSwitch_Rad_Debug,
@@ -163,6 +164,7 @@ typedef enum
   LNK_CmdSwitch_Rad_Exe,
   LNK_CmdSwitch_Rad_Guid,
   LNK_CmdSwitch_Rad_LargePages,
+  LNK_CmdSwitch_Rad_LibCache,
   LNK_CmdSwitch_Rad_LinkVer, 
   LNK_CmdSwitch_Rad_Log,
   LNK_CmdSwitch_Rad_Logo,
@@ -170,6 +172,7 @@ typedef enum
   LNK_CmdSwitch_Rad_MapLinesForUnresolvedSymbols,
   LNK_CmdSwitch_Rad_MemoryMapFiles,
   LNK_CmdSwitch_Rad_MtPath,
+  LNK_CmdSwitch_Rad_OrderProfile,
   LNK_CmdSwitch_Rad_OsVer,
   LNK_CmdSwitch_Rad_PageSize,
   LNK_CmdSwitch_Rad_PathStyle,
@@ -182,6 +185,7 @@ typedef enum
   LNK_CmdSwitch_Rad_SuppressError,
   LNK_CmdSwitch_Rad_TargetOs,
   LNK_CmdSwitch_Rad_TimeStamp,
+  LNK_CmdSwitch_Rad_TypeHashCache,
   LNK_CmdSwitch_Rad_UnresolvedSymbolLimit,
   LNK_CmdSwitch_Rad_UnresolvedSymbolRefLimit,
   LNK_CmdSwitch_Rad_Version,
@@ -419,6 +423,11 @@ typedef struct LNK_Config
   U64                         unresolved_symbol_ref_limit;
   LNK_SwitchState             map_lines_for_unresolved_symbols;
   String8List                 alt_pch_dirs;
+  String8                     lib_cache_dir;
+  String8                     order_file;
+  String8                     order_profile;
+  String8                     type_hash_cache_path;
+  String8                     bench_report_path;
 } LNK_Config;
 
 // --- MSVC Error Codes --------------------------------------------------------
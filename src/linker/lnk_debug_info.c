@@ -1507,6 +1507,50 @@ THREAD_POOL_TASK_FUNC(lnk_hash_debug_t_task)
     ti_ranges[ti_source] = rng_1u64(task->input->pch_arr[obj_idx].ti_lo, task->input->pch_arr[obj_idx].ti_hi + debug_t.count);
   }
 
+  // resident server and on-disk cache keep hashes for self-contained type streams across links
+  B32  is_cacheable = 0;
+  U128 cache_key    = {0};
+  if (lnk_server_is_active() || task->disk_cache) {
+    is_cacheable = task->debug_t_arr == task->input->internal_debug_t_arr &&
+                   task->input->pch_arr[obj_idx].ti_lo == task->input->pch_arr[obj_idx].ti_hi &&
+                   task->input->internal_debug_p_arr[obj_idx].count == 0;
+    if (is_cacheable) {
+      cache_key = lnk_server_key_from_debug_t(debug_t);
+      cache_key.u64[0] ^= task->input->pch_arr[obj_idx].ti_lo;
+
+      if (task->disk_cache) {
+        task->is_cacheable[obj_idx] = 1;
+        task->cache_keys[obj_idx]   = cache_key;
+      }
+
+      B32 is_hashed = lnk_server_is_active() && lnk_server_type_hashes_from_key(cache_key, out_hashes);
+
+      if (task->disk_cache) {
+        // server hits are checked against the disk cache too, otherwise the file is rewritten on every link
+        U64 entry_idx = lnk_type_hash_cache_find(task->disk_cache, cache_key, out_hashes.count);
+        if (entry_idx < task->disk_cache->entry_count) {
+          task->disk_cache_used[entry_idx] = 1;
+          ins_atomic_u64_inc_eval(&task->disk_cache_hit_count);
+          if (!is_hashed) {
+            LNK_TypeHashCacheEntry *entry = &task->disk_cache->entries[entry_idx];
+            MemoryCopyTyped(out_hashes.v, task->disk_cache->hashes + entry->first_hash, out_hashes.count);
+            if (lnk_server_is_active()) {
+              lnk_server_push_type_hashes(cache_key, out_hashes);
+            }
+            is_hashed = 1;
+          }
+        } else {
+          ins_atomic_u64_inc_eval(&task->disk_cache_miss_count);
+        }
+      }
+
+      if (is_hashed) {
+        ProfEnd();
+        return;
+      }
+    }
+  }
+
   for (U64 leaf_idx = 0; leaf_idx < debug_t.count; ++leaf_idx) {
     Temp temp = temp_begin(fixed_arena);
 
@@ -1530,6 +1574,10 @@ THREAD_POOL_TASK_FUNC(lnk_hash_debug_t_task)
     temp_end(temp);
   }
 
+  if (is_cacheable && lnk_server_is_active()) {
+    lnk_server_push_type_hashes(cache_key, out_hashes);
+  }
+
   ProfEnd();
 }
 
@@ -2244,8 +2292,174 @@ THREAD_POOL_TASK_FUNC(lnk_post_process_cv_symbols_task)
   }
 }
 
+internal LNK_TypeHashCache
+lnk_type_hash_cache_open(String8 path)
+{
+  ProfBeginFunction();
+
+  // map cache file
+  String8   data = {0};
+  OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, path);
+  if (!os_handle_match(file, os_handle_zero())) {
+    FileProperties props = os_properties_from_file(file);
+    if (props.size >= sizeof(LNK_TypeHashCacheHeader)) {
+      OS_Handle map = os_file_map_open(OS_AccessFlag_Read, file);
+      if (!os_handle_match(map, os_handle_zero())) {
+        void *ptr = os_file_map_view_open(map, OS_AccessFlag_Read, r1u64(0, props.size));
+        if (ptr) {
+          data = str8(ptr, props.size);
+        }
+        os_file_map_close(map);
+      }
+    }
+    os_file_close(file);
+  }
+
+  // validate header
+  LNK_TypeHashCache        cache  = {0};
+  LNK_TypeHashCacheHeader *header = (LNK_TypeHashCacheHeader *)data.str;
+  B32 is_valid = 0;
+  if (data.size >= sizeof(*header)) {
+    // offsets are checked before use so a corrupt header can't overflow the size math
+    is_valid = header->magic == LNK_TYPE_HASH_CACHE_MAGIC &&
+               header->version == LNK_TYPE_HASH_CACHE_VERSION &&
+               header->build_stamp == lnk_type_hash_cache_build_stamp() &&
+               header->entries_off <= data.size &&
+               header->hashes_off <= data.size &&
+               header->entry_count <= (data.size - header->entries_off) / sizeof(LNK_TypeHashCacheEntry) &&
+               header->hashes_count <= (data.size - header->hashes_off) / sizeof(U128);
+  }
+
+  if (is_valid) {
+    cache.data         = data;
+    cache.entries      = (LNK_TypeHashCacheEntry *)(data.str + header->entries_off);
+    cache.entry_count  = header->entry_count;
+    cache.hashes       = (U128 *)(data.str + header->hashes_off);
+    cache.hashes_count = header->hashes_count;
+  } else if (data.size) {
+    os_file_map_view_close(os_handle_zero(), data.str, r1u64(0, data.size));
+  }
+
+  ProfEnd();
+  return cache;
+}
+
+internal void
+lnk_type_hash_cache_close(LNK_TypeHashCache *cache)
+{
+  if (cache->data.size) {
+    os_file_map_view_close(os_handle_zero(), cache->data.str, r1u64(0, cache->data.size));
+  }
+  MemoryZeroStruct(cache);
+}
+
+internal int
+lnk_type_hash_cache_key_compare(U128 a, U128 b)
+{
+  if (a.u64[1] != b.u64[1]) { return a.u64[1] < b.u64[1] ? -1 : +1; }
+  if (a.u64[0] != b.u64[0]) { return a.u64[0] < b.u64[0] ? -1 : +1; }
+  return 0;
+}
+
+internal U64
+lnk_type_hash_cache_build_stamp(void)
+{
+  String8 build_string = str8_lit(LNK_TYPE_HASH_CACHE_BUILD_STRING);
+  return XXH3_64bits(build_string.str, build_string.size);
+}
+
+internal U64
+lnk_type_hash_cache_find(LNK_TypeHashCache *cache, U128 key, U64 leaf_count)
+{
+  U64 entry_idx = max_U64;
+  for (U64 l = 0, r = cache->entry_count; l < r; ) {
+    U64                     m     = l + (r - l) / 2;
+    LNK_TypeHashCacheEntry *entry = &cache->entries[m];
+    int                     cmp   = lnk_type_hash_cache_key_compare(entry->key, key);
+    if (cmp == 0) {
+      if (entry->leaf_count == leaf_count &&
+          entry->first_hash <= cache->hashes_count &&
+          entry->leaf_count <= cache->hashes_count - entry->first_hash) {
+        entry_idx = m;
+      }
+      break;
+    } else if (cmp < 0) {
+      l = m + 1;
+    } else {
+      r = m;
+    }
+  }
+  return entry_idx;
+}
+
+internal int
+lnk_type_hash_cache_entry_is_before(void *raw_a, void *raw_b)
+{
+  LNK_TypeHashCacheEntry *a = raw_a;
+  LNK_TypeHashCacheEntry *b = raw_b;
+  return lnk_type_hash_cache_key_compare(a->key, b->key) < 0;
+}
+
+internal void
+lnk_type_hash_cache_write(String8 path, U64 count, U128 *keys, U128Array *hashes)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  // sort entries on key and drop duplicates so lookups can binary search
+  LNK_TypeHashCacheEntry *entries      = push_array_no_zero(scratch.arena, LNK_TypeHashCacheEntry, count);
+  U64                    *entry_hashes = push_array_no_zero(scratch.arena, U64, count);
+  for EachIndex(i, count) {
+    entries[i].key        = keys[i];
+    entries[i].first_hash = i; // temporarily holds index of the source hash array
+    entries[i].leaf_count = hashes[i].count;
+  }
+  radsort(entries, count, lnk_type_hash_cache_entry_is_before);
+
+  U64 entry_count  = 0;
+  U64 hashes_count = 0;
+  for EachIndex(i, count) {
+    if (entry_count > 0 && u128_match(entries[entry_count-1].key, entries[i].key)) {
+      continue;
+    }
+    entry_hashes[entry_count]       = entries[i].first_hash;
+    entries[entry_count]            = entries[i];
+    entries[entry_count].first_hash = hashes_count;
+    hashes_count += entries[i].leaf_count;
+    entry_count  += 1;
+  }
+
+  LNK_TypeHashCacheHeader header = {0};
+  header.magic        = LNK_TYPE_HASH_CACHE_MAGIC;
+  header.version      = LNK_TYPE_HASH_CACHE_VERSION;
+  header.build_stamp  = lnk_type_hash_cache_build_stamp();
+  header.entry_count  = entry_count;
+  header.entries_off  = sizeof(header);
+  header.hashes_off   = header.entries_off + entry_count * sizeof(entries[0]);
+  header.hashes_count = hashes_count;
+
+  String8List data = {0};
+  str8_list_push(scratch.arena, &data, str8_struct(&header));
+  str8_list_push(scratch.arena, &data, str8_array(entries, entry_count));
+  for EachIndex(i, entry_count) {
+    U128Array h = hashes[entry_hashes[i]];
+    str8_list_push(scratch.arena, &data, str8_array(h.v, h.count));
+  }
+
+  // write to a temp file and move it in place so concurrent links never observe partial caches
+  String8 temp_path = push_str8f(scratch.arena, "%S.%u.%llx.tmp", path, os_get_process_info()->pid, os_now_microseconds());
+  if (os_write_data_list_to_file_path(temp_path, data)) {
+    if (!os_replace_file_path(path, temp_path)) {
+      os_delete_file_at_path(temp_path);
+    }
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
 internal CV_DebugT *
-lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
+lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input, String8 type_hash_cache_path)
 {
   ProfBegin("Import Types");
 
@@ -2306,10 +2520,46 @@ lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input)
     String8 count_string = str8_from_count(scratch.arena, input->internal_count);
     ProfBegin("Hash .debug$T [Count: %.*s]", str8_varg(count_string));
 #endif
+    LNK_TypeHashCache disk_cache = {0};
+    if (type_hash_cache_path.size) {
+      disk_cache           = lnk_type_hash_cache_open(type_hash_cache_path);
+      task.disk_cache      = &disk_cache;
+      task.is_cacheable    = push_array(scratch.arena, B8, input->internal_count);
+      task.cache_keys      = push_array(scratch.arena, U128, input->internal_count);
+      task.disk_cache_used = push_array(scratch.arena, B8, disk_cache.entry_count);
+    }
+
     task.debug_t_arr = input->internal_debug_t_arr;
     tp_for_parallel(tp, 0, input->internal_count, lnk_hash_debug_t_task, &task);
     ProfEnd();
 
+    if (type_hash_cache_path.size) {
+      // rewrite cache when objects changed or some of the cached entries went unused,
+      // identical objects hit the same entry so used entries are counted instead of hits
+      U64 used_entry_count = 0;
+      for EachIndex(entry_idx, disk_cache.entry_count) {
+        used_entry_count += task.disk_cache_used[entry_idx];
+      }
+      if (task.disk_cache_miss_count > 0 || used_entry_count != disk_cache.entry_count) {
+        ProfBegin("Write Type Hash Cache");
+        U64        cache_count  = 0;
+        U128      *cache_keys   = push_array_no_zero(scratch.arena, U128, input->internal_count);
+        U128Array *cache_hashes = push_array_no_zero(scratch.arena, U128Array, input->internal_count);
+        for EachIndex(obj_idx, input->internal_count) {
+          if (task.is_cacheable[obj_idx]) {
+            cache_keys[cache_count]   = task.cache_keys[obj_idx];
+            cache_hashes[cache_count] = hashes->internal_hashes[obj_idx][CV_TypeIndexSource_TPI];
+            cache_count += 1;
+          }
+        }
+        lnk_type_hash_cache_close(&disk_cache);
+        lnk_type_hash_cache_write(type_hash_cache_path, cache_count, cache_keys, cache_hashes);
+        ProfEnd();
+      } else {
+        lnk_type_hash_cache_close(&disk_cache);
+      }
+    }
+
     ProfBegin("Hash Type Server Leaves [Count: %.*s]", str8_varg(count_string));
     tp_for_parallel(tp, 0, input->external_count, lnk_hash_type_server_leaves_task, &task);
     ProfEnd();
@@ -2788,9 +3038,16 @@ THREAD_POOL_TASK_FUNC(lnk_process_c13_data_task)
   LNK_ProcessC13DataTask *task    = raw_task;
   CV_DebugS               debug_s = task->debug_s_arr[obj_idx];
 
+  // copy checksum data
+  //
+  // obj sub-sections are shared with the RDI builder which may run concurrently
+  // and expects offsets relative to the obj string table, so string offsets are
+  // patched in a module private copy
+  String8List *checksum_data = cv_sub_section_ptr_from_debug_s(&debug_s, CV_C13SubSectionKind_FileChksms);
+  *checksum_data = str8_list_copy(arena, checksum_data);
+
   // parse checksum data
-  String8List     checksum_data = cv_sub_section_from_debug_s(debug_s, CV_C13SubSectionKind_FileChksms);
-  CV_ChecksumList checksum_list = cv_c13_parse_checksum_data_list(scratch.arena, checksum_data);
+  CV_ChecksumList checksum_list = cv_c13_parse_checksum_data_list(scratch.arena, *checksum_data);
 
   // get strings sub-section
   String8 string_data = cv_string_table_from_debug_s(debug_s);
@@ -2811,10 +3068,12 @@ THREAD_POOL_TASK_FUNC(lnk_process_c13_data_task)
   U64          checksum_base            = mod_checksum_data->total_size;
   B32          is_checksum_patch_needed = checksum_base > 0;
   if (is_checksum_patch_needed) {
-    String8List line_data  = cv_sub_section_from_debug_s(debug_s, CV_C13SubSectionKind_Lines);
-    String8List frame_data = cv_sub_section_from_debug_s(debug_s, CV_C13SubSectionKind_FrameData);
-    cv_c13_patch_checksum_offsets_in_line_data_list(line_data, checksum_base);
-    cv_c13_patch_checksum_offsets_in_frame_data_list(frame_data, checksum_base);
+    String8List *line_data  = cv_sub_section_ptr_from_debug_s(&debug_s, CV_C13SubSectionKind_Lines);
+    String8List *frame_data = cv_sub_section_ptr_from_debug_s(&debug_s, CV_C13SubSectionKind_FrameData);
+    *line_data  = str8_list_copy(arena, line_data);
+    *frame_data = str8_list_copy(arena, frame_data);
+    cv_c13_patch_checksum_offsets_in_line_data_list(*line_data, checksum_base);
+    cv_c13_patch_checksum_offsets_in_frame_data_list(*frame_data, checksum_base);
   }
 
   // push obj c13 data to module
@@ -3083,6 +3342,46 @@ lnk_build_pdb_public_symbols(TP_Context            *tp,
   ProfEnd();
 }
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_copy_parsed_symbols_task)
+{
+  U64                        obj_idx = task_id;
+  LNK_CopyParsedSymbolsTask *task    = raw_task;
+  CV_SymbolListArray         src     = task->src[obj_idx];
+  CV_SymbolListArray        *dst     = &task->dst[obj_idx];
+
+  dst->count = src.count;
+  dst->v     = push_array(arena, CV_SymbolList, src.count);
+  for EachIndex(list_idx, src.count) {
+    CV_SymbolList *src_list = &src.v[list_idx];
+    CV_SymbolList *dst_list = &dst->v[list_idx];
+    dst_list->signature     = src_list->signature;
+
+    CV_SymbolNode *nodes    = cv_symbol_list_push_many(arena, dst_list, src_list->count);
+    U64            node_idx = 0;
+    for (CV_SymbolNode *src_n = src_list->first; src_n != 0; src_n = src_n->next, ++node_idx) {
+      nodes[node_idx].data = src_n->data;
+
+      // serialization patches parent and end offsets in scope symbols, give them private data
+      if (cv_is_scope_symbol(src_n->data.kind)) {
+        nodes[node_idx].data.data = push_str8_copy(arena, src_n->data.data);
+      }
+    }
+  }
+}
+
+internal CV_SymbolListArray *
+lnk_copy_parsed_symbols(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_SymbolListArray *parsed_symbols)
+{
+  ProfBeginFunction();
+  LNK_CopyParsedSymbolsTask task = {0};
+  task.src                       = parsed_symbols;
+  task.dst                       = push_array(arena->v[0], CV_SymbolListArray, obj_count);
+  tp_for_parallel(tp, arena, obj_count, lnk_copy_parsed_symbols_task, &task);
+  ProfEnd();
+  return task.dst;
+}
+
 internal String8List
 lnk_build_pdb(TP_Context               *tp,
               TP_Arena                 *tp_arena,
@@ -3140,7 +3439,7 @@ lnk_build_pdb(TP_Context               *tp,
   CV_StringHashTable string_ht = cv_dedup_string_tables(tp_arena, tp, obj_count, debug_s_arr);
   cv_string_hash_table_assign_buffer_offsets(tp, string_ht);
   U64 string_data_base_offset = pdb->info->strtab.size;
-  pdb_strtab_add_cv_string_hash_table(&pdb->info->strtab, string_ht);
+  pdb_strtab_add_cv_string_hash_table(tp, &pdb->info->strtab, string_ht);
   ProfEnd();
 
   ProfBegin("Build DBI Modules");
@@ -5315,7 +5614,7 @@ THREAD_POOL_TASK_FUNC(lnk_collect_obj_virtual_ranges_task)
   ProfEnd();
 }
 
-internal String8List
+internal U64
 lnk_build_rad_debug_info(TP_Context               *tp,
                          TP_Arena                 *tp_arena,
                          OperatingSystem           os,
@@ -5328,7 +5627,9 @@ lnk_build_rad_debug_info(TP_Context               *tp,
                          U64                       total_symbol_input_count,
                          LNK_CodeViewSymbolsInput *symbol_inputs,
                          CV_SymbolListArray       *parsed_symbols,
-                         CV_DebugT                 types[CV_TypeIndexSource_COUNT])
+                         CV_DebugT                 types[CV_TypeIndexSource_COUNT],
+                         RDIB_WriteFunc           *write_func,
+                         void                     *write_ud)
 {
   ProfBegin("RDI");
   Temp scratch = scratch_begin(tp_arena->v,tp_arena->count);
@@ -5580,10 +5881,10 @@ lnk_build_rad_debug_info(TP_Context               *tp,
   }
   ProfEnd();
 
-  String8List rdi_data = rdib_finish(tp, tp_arena, &input);
+  U64 rdi_size = rdib_finish(tp, tp_arena, &input, write_func, write_ud);
 
   scratch_end(scratch);
   ProfEnd();
-  return rdi_data;
+  return rdi_size;
 }
 
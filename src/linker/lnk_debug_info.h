@@ -118,6 +118,46 @@ typedef union
   U128Array **v[CV_TypeIndexSource_COUNT];
 } LNK_LeafHashes;
 
+// --- Type Hash Cache ---------------------------------------------------------
+
+#define LNK_TYPE_HASH_CACHE_MAGIC   0x4853414859544c52ull // "RLTYHASH"
+#define LNK_TYPE_HASH_CACHE_VERSION 2
+
+// leaf hashing may change between linker builds, cache written by another build is discarded
+#define LNK_TYPE_HASH_CACHE_BUILD_STRING BUILD_VERSION_STRING_LITERAL BUILD_GIT_HASH_STRING_LITERAL_APPEND " " __DATE__ " " __TIME__
+
+// Cache file layout, offsets are relative to the start of the file:
+//  LNK_TypeHashCacheHeader
+//  LNK_TypeHashCacheEntry entries[entry_count] (sorted on key)
+//  U128                   hashes[]
+typedef struct LNK_TypeHashCacheHeader
+{
+  U64 magic;
+  U32 version;
+  U32 pad;
+  U64 build_stamp;  // see LNK_TYPE_HASH_CACHE_BUILD_STRING
+  U64 entry_count;
+  U64 entries_off;
+  U64 hashes_off;
+  U64 hashes_count;
+} LNK_TypeHashCacheHeader;
+
+typedef struct LNK_TypeHashCacheEntry
+{
+  U128 key;         // see lnk_server_key_from_debug_t
+  U64  first_hash;  // index into hashes
+  U64  leaf_count;
+} LNK_TypeHashCacheEntry;
+
+typedef struct LNK_TypeHashCache
+{
+  String8                 data;
+  LNK_TypeHashCacheEntry *entries;
+  U64                     entry_count;
+  U128                   *hashes;
+  U64                     hashes_count;
+} LNK_TypeHashCache;
+
 // --- Symbol Parsing Tasks ----------------------------------------------------
 
 typedef struct
@@ -169,6 +209,12 @@ typedef struct
   LNK_LeafHashes    *hashes;
   Arena            **fixed_arenas;
   CV_DebugT         *debug_t_arr;
+  LNK_TypeHashCache *disk_cache;
+  B8                *is_cacheable;  // [internal_count]
+  U128              *cache_keys;    // [internal_count]
+  B8                *disk_cache_used; // [disk_cache->entry_count]
+  U64                disk_cache_hit_count;
+  U64                disk_cache_miss_count;
 } LNK_LeafHasherTask;
 
 typedef struct
@@ -290,6 +336,12 @@ typedef struct
   CV_SymbolList             *gsi_list_arr;
 } LNK_ProcessSymDataTaskData;
 
+typedef struct
+{
+  CV_SymbolListArray *src;
+  CV_SymbolListArray *dst;
+} LNK_CopyParsedSymbolsTask;
+
 typedef struct
 {
   CV_DebugS          *debug_s_arr;
@@ -531,7 +583,13 @@ internal void                lnk_patch_symbols(TP_Context *tp, LNK_CodeViewInput
 internal void                lnk_patch_inlines(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, U64 obj_count, CV_DebugS *debug_s_arr);
 internal void                lnk_patch_leaves(TP_Context *tp, LNK_CodeViewInput *input, LNK_LeafHashes *hashes, LNK_LeafHashTable *leaf_ht_arr, LNK_LeafBucketArray bucket_arr);
 internal String8Node *       lnk_copy_raw_leaf_arr_to_type_server(TP_Context *tp, CV_DebugT types, PDB_TypeServer *type_server);
-internal CV_DebugT *         lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input);
+internal CV_DebugT *         lnk_import_types(TP_Context *tp, TP_Arena *tp_temp, LNK_CodeViewInput *input, String8 type_hash_cache_path);
+
+internal LNK_TypeHashCache lnk_type_hash_cache_open(String8 path);
+internal void              lnk_type_hash_cache_close(LNK_TypeHashCache *cache);
+internal U64               lnk_type_hash_cache_build_stamp(void);
+internal U64               lnk_type_hash_cache_find(LNK_TypeHashCache *cache, U128 key, U64 leaf_count);
+internal void              lnk_type_hash_cache_write(String8 path, U64 count, U128 *keys, U128Array *hashes);
 
 internal void lnk_replace_type_names_with_hashes(TP_Context *tp, TP_Arena *arena, CV_DebugT debug_t, LNK_TypeNameHashMode mode, U64 hash_length, String8 map_name);
 
@@ -547,19 +605,21 @@ internal RDI_MemberKind         lnk_rdib_method_kind_from_cv_prop(CV_MethodProp
 internal LNK_SourceFileBucket * lnk_src_file_hash_table_hash(String8 file_path, CV_C13ChecksumKind checksum_kind, String8 checksum_bytes);
 internal LNK_SourceFileBucket * lnk_src_file_hash_table_lookup_slot(LNK_SourceFileBucket **src_file_buckets, U64 src_file_buckets_cap, U64 hash, String8 file_path, CV_C13ChecksumKind checksum_kind, String8 checksum_bytes);
 
-internal String8List lnk_build_rad_debug_info(TP_Context               *tp,
-                                              TP_Arena                 *tp_arena,
-                                              OperatingSystem           os,
-                                              RDI_Arch                  arch,
-                                              String8                   image_name,
-                                              String8                   image_data,
-                                              U64                       obj_count,
-                                              LNK_Obj                 **obj_arr,
-                                              CV_DebugS                *debug_s_arr,
-                                              U64                       total_symbol_input_count,
-                                              LNK_CodeViewSymbolsInput *symbol_inputs,
-                                              CV_SymbolListArray       *parsed_symbols,
-                                              CV_DebugT                 types[CV_TypeIndexSource_COUNT]);
+internal U64 lnk_build_rad_debug_info(TP_Context               *tp,
+                                      TP_Arena                 *tp_arena,
+                                      OperatingSystem           os,
+                                      RDI_Arch                  arch,
+                                      String8                   image_name,
+                                      String8                   image_data,
+                                      U64                       obj_count,
+                                      LNK_Obj                 **obj_arr,
+                                      CV_DebugS                *debug_s_arr,
+                                      U64                       total_symbol_input_count,
+                                      LNK_CodeViewSymbolsInput *symbol_inputs,
+                                      CV_SymbolListArray       *parsed_symbols,
+                                      CV_DebugT                 types[CV_TypeIndexSource_COUNT],
+                                      RDIB_WriteFunc           *write_func,
+                                      void                     *write_ud);
 
 // --- PDB ---------------------------------------------------------------------
 
@@ -570,6 +630,8 @@ internal CV_SymbolPtrArray            lnk_dedup_gsi_symbols(TP_Context *tp, Aren
 
 internal void lnk_build_pdb_public_symbols(TP_Context *tp, TP_Arena *arena, LNK_SymbolTable *symtab, PDB_PsiContext *psi);
 
+internal CV_SymbolListArray * lnk_copy_parsed_symbols(TP_Context *tp, TP_Arena *arena, U64 obj_count, CV_SymbolListArray *parsed_symbols);
+
 internal String8List lnk_build_pdb(TP_Context               *tp,
                                    TP_Arena                 *tp_arena,
                                    String8                   image_data,
@@ -8,12 +8,17 @@ static B32 g_log_status[LNK_Log_Count];
 internal void
 lnk_exit(int code)
 {
+  if (lnk_server_is_active()) {
+    lnk_server_exit(code);
+  }
   exit(code);
 }
 
 internal void
 lnk_init_error_handler(void)
 {
+  MemoryZeroArray(g_error_code_status_arr);
+  MemoryZeroArray(g_log_status);
   for (int i = LNK_Error_StopFirst; i < LNK_Error_StopLast; ++i) {
     g_error_mode_arr[i] = LNK_ErrorMode_Stop;
   }
@@ -51,6 +56,7 @@ lnk_errorfv(LNK_ErrorCode code, char *fmt, va_list args)
   String8 message = push_str8fv(scratch.arena, fmt, args);
   String8 string = push_str8f(scratch.arena, "%S(%03d): %S\n", lnk_string_from_error_mode(g_error_mode_arr[code]), code, message);
   fprintf(stderr, "%.*s", str8_varg(string));
+  lnk_server_push_output(string);
   scratch_end(scratch);
   
   if (g_error_mode_arr[code] == LNK_ErrorMode_Stop) {
@@ -104,6 +110,7 @@ lnk_supplement_error(char *fmt, ...)
   fprintf(stderr, "\t");
   fprintf(stderr, "%.*s", str8_varg(string));
   fprintf(stderr, "\n");
+  lnk_server_push_output(push_str8f(scratch.arena, "\t%S\n", string));
 
   va_end(args);
   scratch_end(scratch);
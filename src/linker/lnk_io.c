@@ -91,7 +91,7 @@ lnk_file_open_with_rename_permissions(String8 path)
   String16            path16              = str16_from_8(scratch.arena, path);
   SECURITY_ATTRIBUTES security_attributes = { sizeof(security_attributes) };
   HANDLE native_handle = CreateFileW((WCHAR*)path16.str,
-                                     GENERIC_WRITE|DELETE,
+                                     GENERIC_READ|GENERIC_WRITE|DELETE,
                                      FILE_SHARE_READ|FILE_SHARE_WRITE|FILE_SHARE_DELETE,
                                      &security_attributes,
                                      CREATE_ALWAYS,
@@ -145,6 +145,46 @@ lnk_file_rename(OS_Handle handle, String8 new_name)
   return is_renamed;
 }
 
+internal U8 *
+lnk_file_map_for_write(OS_Handle handle, U64 size, OS_Handle *map_out)
+{
+  U8 *view = 0;
+  *map_out = os_handle_zero();
+#if OS_WINDOWS
+  // mapping with an explicit size grows the file to that size
+  HANDLE map_handle = CreateFileMappingA((HANDLE)handle.u64[0], 0, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)(size & max_U32), 0);
+  if (map_handle != 0) {
+    view = MapViewOfFile(map_handle, FILE_MAP_WRITE, 0, 0, size);
+    if (view) {
+      map_out->u64[0] = (U64)map_handle;
+    } else {
+      CloseHandle(map_handle);
+    }
+  }
+#elif OS_LINUX
+  int fd = (int)handle.u64[0];
+  if (ftruncate(fd, size) == 0) {
+    void *ptr = mmap(0, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr != MAP_FAILED) {
+      view     = ptr;
+      *map_out = handle;
+    }
+  }
+#endif
+  return view;
+}
+
+internal void
+lnk_file_unmap(OS_Handle map, U8 *view, U64 size)
+{
+#if OS_WINDOWS
+  UnmapViewOfFile(view);
+  CloseHandle((HANDLE)map.u64[0]);
+#elif OS_LINUX
+  munmap(view, size);
+#endif
+}
+
 internal void
 lnk_log_read(String8 path, U64 size)
 {
@@ -226,6 +266,10 @@ THREAD_POOL_TASK_FUNC(lnk_memory_map_file_task)
 internal String8Array
 lnk_read_data_from_file_path_parallel(TP_Context *tp, Arena *arena, LNK_IO_Flags io_flags, String8Array path_arr)
 {
+  if (lnk_server_is_active()) {
+    return lnk_server_read_data_from_file_path_parallel(tp, arena, path_arr);
+  }
+
   LNK_DiskReader reader = {0};
 
   if (io_flags & LNK_IO_Flags_MemoryMapFiles) {
@@ -276,10 +320,53 @@ lnk_read_data_from_file_path_parallel(TP_Context *tp, Arena *arena, LNK_IO_Flags
   return result;
 }
 
+internal
+THREAD_POOL_TASK_FUNC(lnk_write_block_task)
+{
+  LNK_DiskWriter *writer = raw_task;
+  Rng1U64         block  = r1u64(task_id * LNK_WRITE_BLOCK_SIZE, Min(writer->total_size, (task_id + 1) * LNK_WRITE_BLOCK_SIZE));
+
+  // find last node that starts at or before the block
+  U64 node_lo = 0, node_hi = writer->node_count;
+  while (node_lo + 1 < node_hi) {
+    U64 node_mid = node_lo + (node_hi - node_lo) / 2;
+    if (writer->node_offs[node_mid] <= block.min) {
+      node_lo = node_mid;
+    } else {
+      node_hi = node_mid;
+    }
+  }
+
+  // copy or write parts of the nodes that overlap the block
+  U64 bytes_written = 0;
+  for (U64 node_idx = node_lo; node_idx < writer->node_count && writer->node_offs[node_idx] < block.max; node_idx += 1) {
+    String8 node       = writer->nodes[node_idx];
+    Rng1U64 node_range = r1u64(writer->node_offs[node_idx], writer->node_offs[node_idx] + node.size);
+    Rng1U64 copy_range = intersect_1u64(node_range, block);
+    U64     copy_size  = dim_1u64(copy_range);
+    if (copy_size == 0) { continue; }
+
+    U8 *src = node.str + (copy_range.min - node_range.min);
+    if (writer->file_view) {
+      MemoryCopy(writer->file_view + copy_range.min, src, copy_size);
+      bytes_written += copy_size;
+    } else {
+      U64 write_size = lnk_write_file(&writer->file_handle, writer->base_off + copy_range.min, src, copy_size);
+      bytes_written += write_size;
+      if (write_size != copy_size) {
+        break;
+      }
+    }
+  }
+
+  writer->bytes_written[task_id] = bytes_written;
+}
+
 internal void
-lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List data)
+lnk_write_data_list_to_file_path_parallel(TP_Context *tp, String8 path, String8 temp_path, String8List data)
 {
   ProfBeginV("Write %M to %S", data.total_size, path);
+  Temp scratch = scratch_begin(0,0);
 
   B32       open_with_rename = (temp_path.size > 0);
   OS_Handle file_handle      = {0};
@@ -293,27 +380,54 @@ lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List da
       lnk_error(LNK_Error_IO, "failed to update file disposition on %S", open_file_path);
     }
   } else {
-    lnk_open_file_write((char*)path.str, path.size, &file_handle, sizeof(file_handle));
+    // read access is needed to map the file
+    file_handle    = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_Write, path);
     open_file_path = path;
   }
 
   if (!os_handle_match(file_handle, os_handle_zero())) {
-    // try to reserve up front file size
-    if (!os_file_reserve_size(file_handle, data.total_size)) {
-      lnk_log(LNK_Log_IO_Write, "Failed to pre-allocate file %S with size %M", open_file_path, data.total_size);
+    // size the file up front and map it, otherwise fall back to positional writes
+    OS_Handle file_map  = os_handle_zero();
+    U8       *file_view = 0;
+    if (data.total_size > 0) {
+      file_view = lnk_file_map_for_write(file_handle, data.total_size, &file_map);
+    }
+    if (file_view == 0) {
+      if (!os_file_reserve_size(file_handle, data.total_size)) {
+        lnk_log(LNK_Log_IO_Write, "Failed to pre-allocate file %S with size %M", open_file_path, data.total_size);
+      }
     }
 
-    // write data nodes
-    U64 bytes_written = 0;
-    for (String8Node *data_n = data.first; data_n != 0; data_n = data_n->next) {
-      U64 write_size = lnk_write_file(&file_handle, bytes_written, data_n->string.str, data_n->string.size);
-      if (write_size != data_n->string.size) {
-        break;
+    // assign file offsets to data nodes
+    LNK_DiskWriter writer = {0};
+    writer.file_handle    = file_handle;
+    writer.file_view      = file_view;
+    writer.total_size     = data.total_size;
+    writer.node_count     = data.node_count;
+    writer.nodes          = push_array_no_zero(scratch.arena, String8, data.node_count);
+    writer.node_offs      = push_array_no_zero(scratch.arena, U64,     data.node_count);
+    {
+      U64 node_idx = 0, node_off = 0;
+      for EachNode(data_n, String8Node, data.first) {
+        writer.nodes[node_idx]     = data_n->string;
+        writer.node_offs[node_idx] = node_off;
+        node_off += data_n->string.size;
+        node_idx += 1;
       }
-      bytes_written += data_n->string.size;
     }
+
+    // copy blocks in parallel
+    U64 block_count      = CeilIntegerDiv(data.total_size, LNK_WRITE_BLOCK_SIZE);
+    writer.bytes_written = push_array(scratch.arena, U64, block_count);
+    tp_for_parallel(tp, 0, block_count, lnk_write_block_task, &writer);
+
+    U64 bytes_written     = sum_array_u64(block_count, writer.bytes_written);
     B32 is_write_complete = (bytes_written == data.total_size);
 
+    if (file_view) {
+      lnk_file_unmap(file_map, file_view, data.total_size);
+    }
+
     if (is_write_complete) {
       // rename temp file
       if (open_with_rename) {
@@ -336,7 +450,7 @@ lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List da
     // log write
     if (is_write_complete) {
       if (lnk_get_log_status(LNK_Log_IO_Write)) {
-        lnk_log(LNK_Log_IO_Write, "File \"%S\" %M written", path, data.total_size);
+        lnk_log(LNK_Log_IO_Write, "File \"%S\" %M %s (%llu blocks)", path, data.total_size, file_view ? "mapped" : "written", block_count);
       }
     } else {
       lnk_error(LNK_Error_IO, "incomplete write, %M written, expected %M, file %S", bytes_written, data.total_size, path);
@@ -344,10 +458,20 @@ lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List da
   } else {
     lnk_error(LNK_Error_NoAccess, "don't have access to write to %S", path);
   }
-  
+
+  scratch_end(scratch);
   ProfEnd();
 }
 
+internal void
+lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List data)
+{
+  Temp scratch = scratch_begin(0,0);
+  TP_Context *single_thread_ctx = tp_alloc(scratch.arena, 1, 1, str8_zero());
+  lnk_write_data_list_to_file_path_parallel(single_thread_ctx, path, temp_path, data);
+  scratch_end(scratch);
+}
+
 internal void
 lnk_write_data_to_file_path(String8 path, String8 temp_path, String8 data)
 {
@@ -358,3 +482,97 @@ lnk_write_data_to_file_path(String8 path, String8 temp_path, String8 data)
   scratch_end(scratch);
 }
 
+internal LNK_FileStream
+lnk_file_stream_open(String8 path, String8 temp_path)
+{
+  LNK_FileStream stream = {0};
+  stream.path      = path;
+  stream.temp_path = temp_path;
+
+  if (temp_path.size > 0) {
+    stream.file_handle = lnk_file_open_with_rename_permissions(temp_path);
+
+    // mark file to be deleted on exit, so we don't leave corrupted files on disk
+    if (!os_handle_match(stream.file_handle, os_handle_zero())) {
+      if (!lnk_file_set_delete_on_close(stream.file_handle, 1)) {
+        lnk_error(LNK_Error_IO, "failed to update file disposition on %S", temp_path);
+      }
+    }
+  } else {
+    stream.file_handle = os_file_open(OS_AccessFlag_Write, path);
+  }
+
+  if (os_handle_match(stream.file_handle, os_handle_zero())) {
+    lnk_error(LNK_Error_NoAccess, "don't have access to write to %S", path);
+  }
+
+  return stream;
+}
+
+internal void
+lnk_file_stream_write(TP_Context *tp, LNK_FileStream *stream, U64 off, String8List data)
+{
+  if (os_handle_match(stream->file_handle, os_handle_zero())) { return; }
+
+  ProfBeginV("Stream %M to %S", data.total_size, stream->path);
+  Temp scratch = scratch_begin(0,0);
+
+  // assign offsets to data nodes
+  LNK_DiskWriter writer = {0};
+  writer.file_handle    = stream->file_handle;
+  writer.base_off       = off;
+  writer.total_size     = data.total_size;
+  writer.node_count     = data.node_count;
+  writer.nodes          = push_array_no_zero(scratch.arena, String8, data.node_count);
+  writer.node_offs      = push_array_no_zero(scratch.arena, U64,     data.node_count);
+  {
+    U64 node_idx = 0, node_off = 0;
+    for EachNode(data_n, String8Node, data.first) {
+      writer.nodes[node_idx]     = data_n->string;
+      writer.node_offs[node_idx] = node_off;
+      node_off += data_n->string.size;
+      node_idx += 1;
+    }
+  }
+
+  // write blocks in parallel
+  U64 block_count      = CeilIntegerDiv(data.total_size, LNK_WRITE_BLOCK_SIZE);
+  writer.bytes_written = push_array(scratch.arena, U64, block_count);
+  tp_for_parallel(tp, 0, block_count, lnk_write_block_task, &writer);
+
+  stream->bytes_expected += data.total_size;
+  stream->bytes_written  += sum_array_u64(block_count, writer.bytes_written);
+  stream->size            = Max(stream->size, off + data.total_size);
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal void
+lnk_file_stream_close(LNK_FileStream *stream)
+{
+  if (os_handle_match(stream->file_handle, os_handle_zero())) { return; }
+
+  B32 is_write_complete = (stream->bytes_written == stream->bytes_expected);
+  if (is_write_complete) {
+    if (stream->temp_path.size > 0) {
+      // all writes succeeded, remove delete on exit flag
+      if (!lnk_file_set_delete_on_close(stream->file_handle, 0)) {
+        lnk_error(LNK_Error_IO, "failed to update file disposition on %S", stream->temp_path);
+      }
+
+      if (lnk_file_rename(stream->file_handle, stream->path)) {
+        lnk_log(LNK_Log_IO_Write, "Renamed %S -> %S", stream->temp_path, stream->path);
+      } else {
+        lnk_error(LNK_Error_IO, "failed to rename %S -> %S", stream->temp_path, stream->path);
+      }
+    }
+    lnk_log(LNK_Log_IO_Write, "File \"%S\" %M streamed", stream->path, stream->size);
+  } else {
+    lnk_error(LNK_Error_IO, "incomplete write, %M written, expected %M, file %S", stream->bytes_written, stream->bytes_expected, stream->path);
+  }
+
+  lnk_close_file(&stream->file_handle);
+  MemoryZeroStruct(&stream->file_handle);
+}
+
@@ -17,6 +17,32 @@ typedef struct
   U8          *buffer;
 } LNK_DiskReader;
 
+// output is copied (or written when file can't be mapped) in blocks of this size, one block per task
+#define LNK_WRITE_BLOCK_SIZE MB(16)
+
+typedef struct
+{
+  OS_Handle  file_handle;
+  U8        *file_view;
+  U64        base_off;
+  U64        total_size;
+  U64        node_count;
+  String8   *nodes;
+  U64       *node_offs;
+  U64       *bytes_written;
+} LNK_DiskWriter;
+
+// output written in pieces at arbitrary offsets, renamed into place on close when every piece landed
+typedef struct
+{
+  String8   path;
+  String8   temp_path;
+  OS_Handle file_handle;
+  U64       bytes_expected;
+  U64       bytes_written;
+  U64       size;
+} LNK_FileStream;
+
 // --- Shared File API ---------------------------------------------------------
 
 shared_function int      lnk_open_file_read(char *path, uint64_t path_size, void *handle_buffer, uint64_t handle_buffer_max);
@@ -31,10 +57,17 @@ shared_function uint64_t lnk_write_file(void *raw_handle, uint64_t offset, void
 internal OS_Handle lnk_file_open_with_rename_permissions(String8 path);
 internal B32       lnk_file_set_delete_on_close(OS_Handle handle, B32 delete_file);
 internal B32       lnk_file_rename(OS_Handle handle, String8 new_name);
+internal U8 *      lnk_file_map_for_write(OS_Handle handle, U64 size, OS_Handle *map_out);
+internal void      lnk_file_unmap(OS_Handle map, U8 *view, U64 size);
 
 internal String8      lnk_read_data_from_file_path(Arena *arena, LNK_IO_Flags io_flags, String8 path);
 internal String8Array lnk_read_data_from_file_path_parallel(TP_Context *tp, Arena *arena, LNK_IO_Flags io_flags, String8Array path_arr);
 
+internal void lnk_write_data_list_to_file_path_parallel(TP_Context *tp, String8 path, String8 temp_path, String8List data);
 internal void lnk_write_data_list_to_file_path(String8 path, String8 temp_path, String8List list);
 internal void lnk_write_data_to_file_path(String8 path, String8 temp_path, String8 data);
 
+internal LNK_FileStream lnk_file_stream_open(String8 path, String8 temp_path);
+internal void           lnk_file_stream_write(TP_Context *tp, LNK_FileStream *stream, U64 off, String8List data);
+internal void           lnk_file_stream_close(LNK_FileStream *stream);
+
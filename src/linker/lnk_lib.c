@@ -149,6 +149,395 @@ lnk_lib_from_data(Arena *arena, String8 data, String8 path, U64 input_idx, LNK_L
   return 1;
 }
 
+internal LNK_LibCacheKey
+lnk_lib_cache_key_from_data(String8 path, String8 data)
+{
+  // contents are hashed lazily, only when size and time stamp are not enough to match a cache
+  FileProperties  props = os_properties_from_file_path(path);
+  LNK_LibCacheKey key   = {0};
+  key.size     = data.size;
+  key.modified = props.modified;
+  return key;
+}
+
+internal void
+lnk_lib_cache_key_hash(LNK_LibCacheKey *key, String8 data)
+{
+  if (key->hash[0] == 0 && key->hash[1] == 0) {
+    XXH128_hash_t hash = XXH3_128bits(data.str, data.size);
+    key->hash[0] = hash.low64;
+    key->hash[1] = hash.high64;
+  }
+}
+
+internal B32
+lnk_lib_cache_key_match(LNK_LibCacheKey *cached, LNK_LibCacheKey *key, String8 data)
+{
+  // fast path: lib (the cache file name is derived from its path) has the same size and time stamp
+  B32 is_match = cached->size == key->size && cached->modified == key->modified;
+
+  // time stamp was bumped, contents may still be the same
+  if (!is_match && cached->size == key->size) {
+    lnk_lib_cache_key_hash(key, data);
+    is_match = cached->hash[0] == key->hash[0] && cached->hash[1] == key->hash[1];
+  }
+
+  return is_match;
+}
+
+internal String8
+lnk_lib_cache_path_from_lib_path(Arena *arena, String8 cache_dir, String8 lib_path)
+{
+  Temp    scratch   = scratch_begin(&arena, 1);
+  String8 full_path = lower_from_str8(scratch.arena, os_full_path_from_path(scratch.arena, lib_path));
+  U64     path_hash = XXH3_64bits(full_path.str, full_path.size);
+  String8 result    = push_str8f(arena, "%S/%S.%016llx.libidx", cache_dir, str8_skip_last_slash(lib_path), path_hash);
+  scratch_end(scratch);
+  return result;
+}
+
+internal B32
+lnk_lib_cache_range_is_valid(U64 off, U64 size, U64 max)
+{
+  // written as a subtraction so corrupt offsets and sizes can't wrap around
+  return off <= max && size <= max - off;
+}
+
+internal B32
+lnk_lib_from_cache_data(Arena *arena, String8 cache_data, LNK_LibCacheKey *key, String8 data, String8 path, U64 input_idx, LNK_Lib *lib_out)
+{
+  B32 is_loaded = 0;
+
+  // validate header
+  LNK_LibCacheHeader *header = (LNK_LibCacheHeader *)cache_data.str;
+  B32 is_valid = 0;
+  if (cache_data.size >= sizeof(*header)) {
+    is_valid = header->magic == LNK_LIB_CACHE_MAGIC &&
+               header->version == LNK_LIB_CACHE_VERSION &&
+               lnk_lib_cache_key_match(&header->key, key, data) &&
+               lnk_lib_cache_range_is_valid(header->long_names_off,          header->long_names_size,                    data.size) &&
+               lnk_lib_cache_range_is_valid(header->member_offsets_off,      (U64)header->member_count*sizeof(U32),      cache_data.size) &&
+               lnk_lib_cache_range_is_valid(header->symbol_name_offsets_off, ((U64)header->symbol_count+1)*sizeof(U32),  cache_data.size) &&
+               lnk_lib_cache_range_is_valid(header->symbol_indices_off,      (U64)header->symbol_count*sizeof(U16),      cache_data.size) &&
+               lnk_lib_cache_range_is_valid(header->symbol_name_blob_off,    header->symbol_name_blob_size,              cache_data.size);
+  }
+
+  // validate member offsets, members are read straight out of the archive
+  if (is_valid) {
+    U32 *member_offsets = (U32 *)(cache_data.str + header->member_offsets_off);
+    for (U32 member_idx = 0; is_valid && member_idx < header->member_count; member_idx += 1) {
+      is_valid = member_offsets[member_idx] < data.size;
+    }
+  }
+
+  // validate symbol index
+  if (is_valid) {
+    U32 *symbol_name_offsets = (U32 *)(cache_data.str + header->symbol_name_offsets_off);
+    U16 *symbol_indices      = (U16 *)(cache_data.str + header->symbol_indices_off);
+    is_valid = symbol_name_offsets[header->symbol_count] <= header->symbol_name_blob_size;
+    for (U32 symbol_idx = 0; is_valid && symbol_idx < header->symbol_count; symbol_idx += 1) {
+      is_valid = symbol_name_offsets[symbol_idx] < symbol_name_offsets[symbol_idx+1] &&
+                 symbol_indices[symbol_idx] >= 1 && symbol_indices[symbol_idx] <= header->member_count;
+    }
+  }
+
+  // init lib directly from the mapped cache
+  if (is_valid) {
+    MemoryZeroStruct(lib_out);
+    lib_out->path                = push_str8_copy(arena, path);
+    lib_out->data                = data;
+    lib_out->type                = header->type;
+    lib_out->member_count        = header->member_count;
+    lib_out->symbol_count        = header->symbol_count;
+    lib_out->member_offsets      = (U32 *)(cache_data.str + header->member_offsets_off);
+    lib_out->symbol_indices      = (U16 *)(cache_data.str + header->symbol_indices_off);
+    lib_out->member_links        = push_array(arena, LNK_Symbol *, header->member_count);
+    lib_out->symbol_name_offsets = (U32 *)(cache_data.str + header->symbol_name_offsets_off);
+    lib_out->symbol_name_blob    = cache_data.str + header->symbol_name_blob_off;
+    lib_out->long_names          = str8_substr(data, r1u64(header->long_names_off, header->long_names_off + header->long_names_size));
+    lib_out->input_idx           = input_idx;
+    is_loaded = 1;
+  }
+
+  return is_loaded;
+}
+
+internal B32
+lnk_lib_from_cache(Arena *arena, String8 cache_path, LNK_LibCacheKey *key, String8 data, String8 path, U64 input_idx, LNK_Lib *lib_out)
+{
+  ProfBeginFunction();
+
+  // map cache file
+  String8   cache_data = {0};
+  OS_Handle file       = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, cache_path);
+  if (!os_handle_match(file, os_handle_zero())) {
+    FileProperties props = os_properties_from_file(file);
+    if (props.size >= sizeof(LNK_LibCacheHeader)) {
+      OS_Handle map = os_file_map_open(OS_AccessFlag_Read, file);
+      if (!os_handle_match(map, os_handle_zero())) {
+        void *ptr = os_file_map_view_open(map, OS_AccessFlag_Read, r1u64(0, props.size));
+        if (ptr) {
+          cache_data = str8(ptr, props.size);
+        }
+        os_file_map_close(map);
+      }
+    }
+    os_file_close(file);
+  }
+
+  // time stamp was bumped since the cache was written -> load from a private copy
+  // with the new key and refresh the file, so the next link skips hashing the lib
+  B32 is_key_stale = 0;
+  if (cache_data.size >= sizeof(LNK_LibCacheHeader)) {
+    LNK_LibCacheHeader *header = (LNK_LibCacheHeader *)cache_data.str;
+    if (header->key.modified != key->modified && lnk_lib_cache_key_match(&header->key, key, data)) {
+      String8 cache_copy = push_str8_copy(arena, cache_data);
+      os_file_map_view_close(os_handle_zero(), cache_data.str, r1u64(0, cache_data.size));
+      cache_data   = cache_copy;
+      header       = (LNK_LibCacheHeader *)cache_data.str;
+      header->key  = *key;
+      is_key_stale = 1;
+    }
+  }
+
+  // init lib, lib points directly into the mapping so keep it alive on success
+  B32 is_loaded = lnk_lib_from_cache_data(arena, cache_data, key, data, path, input_idx, lib_out);
+  if (is_loaded && is_key_stale) {
+    lnk_lib_cache_write_data(cache_path, cache_data);
+  }
+  if (!is_loaded && !is_key_stale && cache_data.size) {
+    os_file_map_view_close(os_handle_zero(), cache_data.str, r1u64(0, cache_data.size));
+  }
+
+  ProfEnd();
+  return is_loaded;
+}
+
+internal String8
+lnk_lib_cache_data_from_lib(Arena *arena, LNK_LibCacheKey key, LNK_Lib *lib)
+{
+  ProfBeginFunction();
+
+  // lay out sections
+  U64 symbol_name_blob_size = 0;
+  for EachIndex(symbol_idx, lib->symbol_count) {
+    symbol_name_blob_size += lnk_lib_symbol_name_from_idx(lib, symbol_idx).size + 1;
+  }
+
+  // cache files always carry the content hash, time stamps alone are not trusted across copies
+  lnk_lib_cache_key_hash(&key, lib->data);
+
+  LNK_LibCacheHeader header      = {0};
+  header.magic                   = LNK_LIB_CACHE_MAGIC;
+  header.version                 = LNK_LIB_CACHE_VERSION;
+  header.type                    = lib->type;
+  header.key                     = key;
+  header.member_count            = lib->member_count;
+  header.symbol_count            = lib->symbol_count;
+  header.long_names_off          = lib->long_names.size ? (U64)(lib->long_names.str - lib->data.str) : 0;
+  header.long_names_size         = lib->long_names.size;
+  header.member_offsets_off      = AlignPow2(sizeof(header), 8);
+  header.symbol_name_offsets_off = AlignPow2(header.member_offsets_off + (U64)lib->member_count*sizeof(U32), 8);
+  header.symbol_indices_off      = AlignPow2(header.symbol_name_offsets_off + ((U64)lib->symbol_count+1)*sizeof(U32), 8);
+  header.symbol_name_blob_off    = AlignPow2(header.symbol_indices_off + (U64)lib->symbol_count*sizeof(U16), 8);
+  header.symbol_name_blob_size   = symbol_name_blob_size;
+
+  // cache offsets are 32-bit
+  String8 result = {0};
+  if (symbol_name_blob_size <= max_U32) {
+    U64 cache_size = header.symbol_name_blob_off + header.symbol_name_blob_size;
+    U8 *cache      = push_array(arena, U8, cache_size);
+
+    MemoryCopyStruct((LNK_LibCacheHeader *)cache, &header);
+    MemoryCopy(cache + header.member_offsets_off, lib->member_offsets, (U64)lib->member_count*sizeof(U32));
+    MemoryCopy(cache + header.symbol_indices_off, lib->symbol_indices, (U64)lib->symbol_count*sizeof(U16));
+
+    U32 *symbol_name_offsets = (U32 *)(cache + header.symbol_name_offsets_off);
+    U8  *symbol_name_blob    = cache + header.symbol_name_blob_off;
+    U32  blob_cursor         = 0;
+    for EachIndex(symbol_idx, lib->symbol_count) {
+      String8 name = lnk_lib_symbol_name_from_idx(lib, symbol_idx);
+      symbol_name_offsets[symbol_idx] = blob_cursor;
+      MemoryCopy(symbol_name_blob + blob_cursor, name.str, name.size);
+      blob_cursor += name.size + 1;
+    }
+    symbol_name_offsets[lib->symbol_count] = blob_cursor;
+
+    result = str8(cache, cache_size);
+  }
+
+  ProfEnd();
+  return result;
+}
+
+internal void
+lnk_lib_cache_write_data(String8 cache_path, String8 cache_data)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  // write to a temp file and move it over the old cache so concurrent links never observe partial caches
+  String8 temp_path = push_str8f(scratch.arena, "%S.%u.%llx.tmp", cache_path, os_get_process_info()->pid, os_now_microseconds());
+  if (os_write_data_to_file_path(temp_path, cache_data)) {
+    if (!os_replace_file_path(cache_path, temp_path)) {
+      os_delete_file_at_path(temp_path);
+    }
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal void
+lnk_lib_cache_write(String8 cache_path, LNK_LibCacheKey key, LNK_Lib *lib)
+{
+  Temp scratch = scratch_begin(0,0);
+  String8 cache_data = lnk_lib_cache_data_from_lib(scratch.arena, key, lib);
+  if (cache_data.size) {
+    lnk_lib_cache_write_data(cache_path, cache_data);
+  }
+  scratch_end(scratch);
+}
+
+internal String8
+lnk_member_set_path_from_image_path(Arena *arena, String8 cache_dir, String8 image_path)
+{
+  Temp    scratch   = scratch_begin(&arena, 1);
+  String8 full_path = lower_from_str8(scratch.arena, os_full_path_from_path(scratch.arena, image_path));
+  U64     path_hash = XXH3_64bits(full_path.str, full_path.size);
+  String8 result    = push_str8f(arena, "%S/%S.%016llx.members", cache_dir, str8_skip_last_slash(image_path), path_hash);
+  scratch_end(scratch);
+  return result;
+}
+
+internal LNK_MemberSet
+lnk_member_set_from_file(Arena *arena, String8 path)
+{
+  ProfBeginFunction();
+
+  LNK_MemberSet        set    = {0};
+  String8              data   = os_data_from_file_path(arena, path);
+  LNK_MemberSetHeader *header = (LNK_MemberSetHeader *)data.str;
+
+  // validate header
+  B32 is_valid = 0;
+  U64 libs_off = sizeof(LNK_MemberSetHeader), member_offsets_off = 0, path_blob_off = 0;
+  if (data.size >= sizeof(*header)) {
+    member_offsets_off = libs_off + (U64)header->lib_count * sizeof(LNK_MemberSetLib);
+    path_blob_off      = member_offsets_off + header->member_offset_count * sizeof(U32);
+    is_valid = header->magic == LNK_MEMBER_SET_MAGIC &&
+               header->version == LNK_MEMBER_SET_VERSION &&
+               header->member_offset_count <= data.size / sizeof(U32) &&
+               header->path_blob_size <= data.size &&
+               path_blob_off + header->path_blob_size <= data.size;
+  }
+
+  // validate libs
+  LNK_MemberSetLib *libs = (LNK_MemberSetLib *)(data.str + libs_off);
+  for (U32 lib_idx = 0; is_valid && lib_idx < header->lib_count; lib_idx += 1) {
+    is_valid = libs[lib_idx].path_off <= header->path_blob_size &&
+               libs[lib_idx].path_size <= header->path_blob_size - libs[lib_idx].path_off &&
+               libs[lib_idx].first_member <= header->member_offset_count &&
+               libs[lib_idx].member_count <= header->member_offset_count - libs[lib_idx].first_member;
+  }
+
+  if (is_valid) {
+    set.lib_count      = header->lib_count;
+    set.libs           = libs;
+    set.member_offsets = (U32 *)(data.str + member_offsets_off);
+    set.path_blob      = data.str + path_blob_off;
+    set.lib_ht         = hash_table_init(arena, Max(header->lib_count, 1));
+    for EachIndex(lib_idx, set.lib_count) {
+      String8 lib_path = str8(set.path_blob + libs[lib_idx].path_off, libs[lib_idx].path_size);
+      hash_table_push_path_u64(arena, set.lib_ht, lib_path, lib_idx);
+    }
+  }
+
+  ProfEnd();
+  return set;
+}
+
+internal U32Array
+lnk_member_offsets_from_lib_path(LNK_MemberSet *set, String8 lib_path)
+{
+  U32Array result = {0};
+  if (set->lib_count) {
+    Temp    scratch   = scratch_begin(0,0);
+    String8 full_path = lower_from_str8(scratch.arena, os_full_path_from_path(scratch.arena, lib_path));
+    U64     lib_idx;
+    if (hash_table_search_path_u64(set->lib_ht, full_path, &lib_idx)) {
+      result.count = set->libs[lib_idx].member_count;
+      result.v     = set->member_offsets + set->libs[lib_idx].first_member;
+    }
+    scratch_end(scratch);
+  }
+  return result;
+}
+
+internal void
+lnk_member_set_write(String8 path, LNK_LibList libs)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  // count linked members
+  U64 max_member_count = 0;
+  for EachNode(lib_n, LNK_LibNode, libs.first) {
+    max_member_count += lib_n->data.member_count;
+  }
+
+  // gather member offsets of linked members per lib
+  LNK_MemberSetLib *set_libs            = push_array(scratch.arena, LNK_MemberSetLib, libs.count);
+  U32              *member_offsets      = push_array_no_zero(scratch.arena, U32, max_member_count);
+  U64               member_offset_count = 0;
+  U64               lib_count           = 0;
+  String8List       path_blob           = {0};
+  for EachNode(lib_n, LNK_LibNode, libs.first) {
+    LNK_Lib *lib = &lib_n->data;
+
+    U64 first_member = member_offset_count;
+    for EachIndex(member_idx, lib->member_count) {
+      if (lib->member_links[member_idx]) {
+        member_offsets[member_offset_count++] = lib->member_offsets[member_idx];
+      }
+    }
+
+    if (member_offset_count > first_member) {
+      String8           full_path = lower_from_str8(scratch.arena, os_full_path_from_path(scratch.arena, lib->path));
+      LNK_MemberSetLib *set_lib   = &set_libs[lib_count++];
+      set_lib->path_off     = path_blob.total_size;
+      set_lib->path_size    = full_path.size;
+      set_lib->first_member = first_member;
+      set_lib->member_count = member_offset_count - first_member;
+      str8_list_push(scratch.arena, &path_blob, full_path);
+    }
+  }
+
+  LNK_MemberSetHeader header = {0};
+  header.magic               = LNK_MEMBER_SET_MAGIC;
+  header.version             = LNK_MEMBER_SET_VERSION;
+  header.lib_count           = lib_count;
+  header.member_offset_count = member_offset_count;
+  header.path_blob_size      = path_blob.total_size;
+
+  String8List data = {0};
+  str8_list_push(scratch.arena, &data, str8_struct(&header));
+  str8_list_push(scratch.arena, &data, str8_array(set_libs, lib_count));
+  str8_list_push(scratch.arena, &data, str8_array(member_offsets, member_offset_count));
+  str8_list_concat_in_place(&data, &path_blob);
+
+  // write to a temp file and move it in place so concurrent links never observe partial sets
+  String8 temp_path = push_str8f(scratch.arena, "%S.%u.%llx.tmp", path, os_get_process_info()->pid, os_now_microseconds());
+  if (os_write_data_list_to_file_path(temp_path, data)) {
+    if (!os_replace_file_path(path, temp_path)) {
+      os_delete_file_at_path(temp_path);
+    }
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
 internal
 THREAD_POOL_TASK_FUNC(lnk_lib_initer)
 {
@@ -158,7 +547,42 @@ THREAD_POOL_TASK_FUNC(lnk_lib_initer)
   U64          lib_node_idx = ins_atomic_u64_inc_eval(&task->next_free_lib_idx)-1;
   LNK_LibNode *lib_node     = &task->free_libs[lib_node_idx];
 
-  B32 is_valid_lib = lnk_lib_from_data(arena, input->data, input->path, task->lib_id_base + task_id, &lib_node->data);
+  B32 is_valid_lib = 0;
+  if (task->cache_dir.size || lnk_server_is_active()) {
+    Temp            scratch   = scratch_begin(&arena, 1);
+    LNK_LibCacheKey cache_key = lnk_lib_cache_key_from_data(input->path, input->data);
+
+    // try index kept in memory by the resident server
+    B32 is_from_server = 0;
+    if (lnk_server_is_active()) {
+      String8 lib_index = lnk_server_lib_index_from_path(arena, input->path, cache_key);
+      is_valid_lib   = lnk_lib_from_cache_data(arena, lib_index, &cache_key, input->data, input->path, task->lib_id_base + task_id, &lib_node->data);
+      is_from_server = is_valid_lib;
+    }
+
+    // try on-disk cache
+    String8 cache_path = {0};
+    if (!is_valid_lib && task->cache_dir.size) {
+      cache_path   = lnk_lib_cache_path_from_lib_path(scratch.arena, task->cache_dir, input->path);
+      is_valid_lib = lnk_lib_from_cache(arena, cache_path, &cache_key, input->data, input->path, task->lib_id_base + task_id, &lib_node->data);
+    }
+
+    // parse archive and populate caches
+    if (!is_valid_lib) {
+      is_valid_lib = lnk_lib_from_data(arena, input->data, input->path, task->lib_id_base + task_id, &lib_node->data);
+      if (is_valid_lib && cache_path.size) {
+        lnk_lib_cache_write(cache_path, cache_key, &lib_node->data);
+      }
+    }
+    if (is_valid_lib && !is_from_server && lnk_server_is_active()) {
+      String8 lib_index = lnk_lib_cache_data_from_lib(scratch.arena, cache_key, &lib_node->data);
+      lnk_server_set_lib_index(input->path, cache_key, lib_index);
+    }
+
+    scratch_end(scratch);
+  } else {
+    is_valid_lib = lnk_lib_from_data(arena, input->data, input->path, task->lib_id_base + task_id, &lib_node->data);
+  }
   if (is_valid_lib) {
     U64 valid_lib_idx = ins_atomic_u64_inc_eval(&task->valid_libs_count)-1;
     task->valid_libs[valid_lib_idx] = lib_node;
@@ -187,17 +611,22 @@ lnk_lib_list_push_node(LNK_LibList *list, LNK_LibNode *node)
 }
 
 internal LNK_LibNodeArray
-lnk_lib_list_push_parallel(TP_Context *tp, TP_Arena *arena, LNK_LibList *list, U64 inputs_count, LNK_Input **inputs)
+lnk_lib_list_push_parallel(TP_Context *tp, TP_Arena *arena, String8 cache_dir, LNK_LibList *list, U64 inputs_count, LNK_Input **inputs)
 {
   Temp scratch = scratch_begin(arena->v, arena->count);
 
   U64 lib_id_base = list->count;
 
+  if (cache_dir.size) {
+    os_make_directory(cache_dir);
+  }
+
   // parse libs in parallel
   LNK_LibIniter task = {0};
+  task.cache_dir     = cache_dir;
   task.lib_id_base   = list->count;
   task.free_libs     = push_array(arena->v[0], LNK_LibNode, inputs_count);
-  task.valid_libs    = push_array(scratch.arena, LNK_LibNode *, inputs_count);
+  task.valid_libs    = push_array(arena->v[0], LNK_LibNode *, inputs_count); // returned to caller
   task.invalid_libs  = push_array(scratch.arena, LNK_LibNode *, inputs_count);
   task.inputs        = inputs;
   tp_for_parallel(tp, arena, inputs_count, lnk_lib_initer, &task);
@@ -255,10 +684,43 @@ lnk_lib_set_link_symbol(LNK_Lib *lib, U32 member_idx, LNK_Symbol *link_symbol)
   return was_linked;
 }
 
+internal String8
+lnk_lib_symbol_name_from_idx(LNK_Lib *lib, U64 symbol_idx)
+{
+  String8 name = {0};
+  if (symbol_idx < lib->symbol_count) {
+    if (lib->symbol_name_offsets) {
+      U32 name_off = lib->symbol_name_offsets[symbol_idx];
+      name = str8(lib->symbol_name_blob + name_off, lib->symbol_name_offsets[symbol_idx+1] - name_off - 1);
+    } else {
+      name = lib->symbol_names.v[symbol_idx];
+    }
+  }
+  return name;
+}
+
 internal force_inline B32
 lnk_search_lib(LNK_Lib *lib, String8 symbol_name, U32 *member_idx_out)
 {
-  U64 symbol_idx = str8_array_bsearch(lib->symbol_names, symbol_name);
+  U64 symbol_idx = max_U64;
+  if (lib->symbol_name_offsets) {
+    // binary search symbol names directly in the mapped lib cache
+    for (U64 l = 0, r = lib->symbol_count; l < r; ) {
+      U64     m    = l + (r - l) / 2;
+      String8 name = lnk_lib_symbol_name_from_idx(lib, m);
+      int     cmp  = str8_compar_case_sensitive(&name, &symbol_name);
+      if (cmp == 0) {
+        symbol_idx = m;
+        break;
+      } else if (cmp < 0) {
+        l = m + 1;
+      } else {
+        r = m;
+      }
+    }
+  } else {
+    symbol_idx = str8_array_bsearch(lib->symbol_names, symbol_name);
+  }
   if (symbol_idx < lib->symbol_count) {
     if (member_idx_out) {
       *member_idx_out = lib->symbol_indices[symbol_idx]-1;
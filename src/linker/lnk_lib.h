@@ -14,6 +14,8 @@ typedef struct LNK_Lib
   U16                 *symbol_indices;
   LNK_Symbol         **member_links;
   String8Array         symbol_names;
+  U32                 *symbol_name_offsets; // set when the symbol index was loaded from the lib cache, offsets into symbol_name_blob
+  U8                  *symbol_name_blob;
   String8              long_names;
   U64                  input_idx;
 } LNK_Lib;
@@ -43,10 +45,85 @@ typedef struct LNK_FirstMemberSortKey
   U16     member_off_idx;
 } LNK_FirstMemberSortKey;
 
+// --- Lib Index Cache ---------------------------------------------------------
+
+#define LNK_LIB_CACHE_MAGIC   0x5844494249424c52ull // "RLBIBIDX"
+#define LNK_LIB_CACHE_VERSION 1
+
+typedef struct LNK_LibCacheKey
+{
+  U64 size;
+  U64 modified;
+  U64 hash[2];
+} LNK_LibCacheKey;
+
+// Cache file layout, all sections are 8-byte aligned and offsets are relative to the start of the file:
+//  LNK_LibCacheHeader
+//  U32 member_offsets[member_count]
+//  U32 symbol_name_offsets[symbol_count + 1]
+//  U16 symbol_indices[symbol_count]
+//  U8  symbol_name_blob[symbol_name_blob_size] (null terminated names, sorted)
+typedef struct LNK_LibCacheHeader
+{
+  U64             magic;
+  U32             version;
+  U32             type;
+  LNK_LibCacheKey key;
+  U32             member_count;
+  U32             symbol_count;
+  U64             long_names_off; // relative to the start of the archive
+  U64             long_names_size;
+  U64             member_offsets_off;
+  U64             symbol_name_offsets_off;
+  U64             symbol_indices_off;
+  U64             symbol_name_blob_off;
+  U64             symbol_name_blob_size;
+} LNK_LibCacheHeader;
+
+// --- Lib Member Set ----------------------------------------------------------
+
+#define LNK_MEMBER_SET_MAGIC   0x5445534d424d4c52ull // "RLMBMSET"
+#define LNK_MEMBER_SET_VERSION 1
+
+// Members pulled from each lib by the previous link of the same image, used only
+// to prefetch member data ahead of the symbol search; stale entries are harmless.
+//
+// File layout, offsets are relative to the start of the file:
+//  LNK_MemberSetHeader
+//  LNK_MemberSetLib libs[lib_count]
+//  U32              member_offsets[member_offset_count]
+//  U8               path_blob[path_blob_size] (lower case full paths)
+typedef struct LNK_MemberSetHeader
+{
+  U64 magic;
+  U32 version;
+  U32 lib_count;
+  U64 member_offset_count;
+  U64 path_blob_size;
+} LNK_MemberSetHeader;
+
+typedef struct LNK_MemberSetLib
+{
+  U64 path_off;
+  U64 path_size;
+  U64 first_member;
+  U64 member_count;
+} LNK_MemberSetLib;
+
+typedef struct LNK_MemberSet
+{
+  U64               lib_count;
+  LNK_MemberSetLib *libs;
+  U32              *member_offsets;
+  U8               *path_blob;
+  HashTable        *lib_ht; // lib path -> lib index
+} LNK_MemberSet;
+
 // --- Workers Contexts --------------------------------------------------------
  
 typedef struct
 {
+  String8             cache_dir;
   struct LNK_Input  **inputs;
   U64                 lib_id_base;
   U64                 next_free_lib_idx;
@@ -65,9 +142,25 @@ internal int lnk_lib_node_ptr_is_before(void *raw_a, void *raw_b);
 internal B32              lnk_lib_from_data(Arena *arena, String8 data, String8 path, U64 input_idx, LNK_Lib *lib_out);
 internal LNK_Lib **       lnk_array_from_lib_list(Arena *arena, LNK_LibList list);
 internal void             lnk_lib_list_push_node(LNK_LibList *list, LNK_LibNode *node);
-internal LNK_LibNodeArray lnk_lib_list_push_parallel(TP_Context *tp, TP_Arena *arena, LNK_LibList *list, U64 inputs_count, struct LNK_Input **inputs);
+internal LNK_LibNodeArray lnk_lib_list_push_parallel(TP_Context *tp, TP_Arena *arena, String8 cache_dir, LNK_LibList *list, U64 inputs_count, struct LNK_Input **inputs);
+
+internal LNK_LibCacheKey lnk_lib_cache_key_from_data(String8 path, String8 data);
+internal void            lnk_lib_cache_key_hash(LNK_LibCacheKey *key, String8 data);
+internal B32             lnk_lib_cache_key_match(LNK_LibCacheKey *cached, LNK_LibCacheKey *key, String8 data);
+internal String8         lnk_lib_cache_path_from_lib_path(Arena *arena, String8 cache_dir, String8 lib_path);
+internal B32             lnk_lib_from_cache_data(Arena *arena, String8 cache_data, LNK_LibCacheKey *key, String8 data, String8 path, U64 input_idx, LNK_Lib *lib_out);
+internal B32             lnk_lib_from_cache(Arena *arena, String8 cache_path, LNK_LibCacheKey *key, String8 data, String8 path, U64 input_idx, LNK_Lib *lib_out);
+internal String8         lnk_lib_cache_data_from_lib(Arena *arena, LNK_LibCacheKey key, LNK_Lib *lib);
+internal void            lnk_lib_cache_write_data(String8 cache_path, String8 cache_data);
+internal void            lnk_lib_cache_write(String8 cache_path, LNK_LibCacheKey key, LNK_Lib *lib);
+
+internal String8       lnk_member_set_path_from_image_path(Arena *arena, String8 cache_dir, String8 image_path);
+internal LNK_MemberSet lnk_member_set_from_file(Arena *arena, String8 path);
+internal U32Array      lnk_member_offsets_from_lib_path(LNK_MemberSet *set, String8 lib_path);
+internal void          lnk_member_set_write(String8 path, LNK_LibList libs);
 
 internal B32 lnk_lib_set_link_symbol(LNK_Lib *lib, U32 member_idx, LNK_Symbol *link_symbol);
 
-internal B32 lnk_search_lib(LNK_Lib *lib, String8 symbol_name, U32 *member_idx_out);
+internal String8 lnk_lib_symbol_name_from_idx(LNK_Lib *lib, U64 symbol_idx);
+internal B32     lnk_search_lib(LNK_Lib *lib, String8 symbol_name, U32 *member_idx_out);
 
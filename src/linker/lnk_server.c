@@ -0,0 +1,795 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+global LNK_ServerCache *g_lnk_server = 0;
+
+internal B32
+lnk_server_is_active(void)
+{
+  return g_lnk_server != 0;
+}
+
+// --- File Cache --------------------------------------------------------------
+
+internal U64
+lnk_server_file_hash_from_path(Arena *arena, String8 path, String8 *full_path_out)
+{
+  String8 full_path = os_full_path_from_path(arena, path);
+  full_path = lower_from_str8(arena, full_path);
+  full_path = path_convert_slashes(arena, full_path, PathStyle_UnixAbsolute);
+  *full_path_out = full_path;
+  return u64_hash_from_str8(full_path);
+}
+
+internal LNK_ServerFile *
+lnk_server_file_lookup(String8 full_path, U64 hash)
+{
+  LNK_ServerFile *file = 0;
+  U64 slot_idx = hash % g_lnk_server->file_slots_count;
+  for (LNK_ServerFile *f = g_lnk_server->file_slots[slot_idx]; f != 0; f = f->hash_next) {
+    if (str8_match(f->path, full_path, 0)) {
+      file = f;
+      break;
+    }
+  }
+  return file;
+}
+
+internal void
+lnk_server_file_remove(LNK_ServerFile *file, U64 hash)
+{
+  U64 slot_idx = hash % g_lnk_server->file_slots_count;
+  for (LNK_ServerFile **ptr = &g_lnk_server->file_slots[slot_idx]; *ptr != 0; ptr = &(*ptr)->hash_next) {
+    if (*ptr == file) {
+      *ptr = file->hash_next;
+      break;
+    }
+  }
+}
+
+internal LNK_ServerFile *
+lnk_server_file_from_path(String8 path)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  String8        full_path = {0};
+  U64            hash      = lnk_server_file_hash_from_path(scratch.arena, path, &full_path);
+  FileProperties props     = os_properties_from_file_path(path);
+
+  // fast path: size and time stamp match
+  LNK_ServerFile *file = 0;
+  MutexScope(g_lnk_server->mutex) {
+    LNK_ServerFile *f = lnk_server_file_lookup(full_path, hash);
+    if (f && f->data.size == props.size && f->modified == props.modified) {
+      f->last_link_idx = g_lnk_server->link_idx;
+      ins_atomic_u64_inc_eval(&g_lnk_server->file_hit_count);
+      file = f;
+    }
+  }
+
+  if (file == 0 && props.size) {
+    Arena   *file_arena = arena_alloc();
+    String8  data       = os_data_from_file_path(file_arena, path);
+    if (data.size) {
+      XXH128_hash_t data_hash = XXH3_128bits(data.str, data.size);
+      MutexScope(g_lnk_server->mutex) {
+        LNK_ServerFile *f = lnk_server_file_lookup(full_path, hash);
+        if (f && f->hash.u64[0] == data_hash.low64 && f->hash.u64[1] == data_hash.high64) {
+          // time stamp changed but contents are same, keep cached data
+          f->modified      = props.modified;
+          f->last_link_idx = g_lnk_server->link_idx;
+          ins_atomic_u64_inc_eval(&g_lnk_server->file_hit_count);
+          file = f;
+        } else {
+          if (f) {
+            // contents changed, retire stale entry (data may still be referenced by this link)
+            lnk_server_file_remove(f, hash);
+            f->hash_next = g_lnk_server->retired_files;
+            g_lnk_server->retired_files = f;
+          }
+
+          LNK_ServerFile *new_file = push_array(file_arena, LNK_ServerFile, 1);
+          new_file->arena          = file_arena;
+          new_file->path           = push_str8_copy(file_arena, full_path);
+          new_file->modified       = props.modified;
+          new_file->hash.u64[0]    = data_hash.low64;
+          new_file->hash.u64[1]    = data_hash.high64;
+          new_file->data           = data;
+          new_file->last_link_idx  = g_lnk_server->link_idx;
+
+          U64 slot_idx = hash % g_lnk_server->file_slots_count;
+          new_file->hash_next = g_lnk_server->file_slots[slot_idx];
+          g_lnk_server->file_slots[slot_idx] = new_file;
+
+          ins_atomic_u64_inc_eval(&g_lnk_server->file_miss_count);
+          file       = new_file;
+          file_arena = 0;
+        }
+      }
+    }
+    if (file_arena) {
+      arena_release(file_arena);
+    }
+  }
+
+  scratch_end(scratch);
+  return file;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_server_resolve_file_task)
+{
+  LNK_ServerFileReader *task = raw_task;
+  task->file_arr[task_id] = lnk_server_file_from_path(task->path_arr.v[task_id]);
+}
+
+internal
+THREAD_POOL_TASK_FUNC(lnk_server_copy_file_task)
+{
+  LNK_ServerFileReader *task = raw_task;
+  LNK_ServerFile       *file = task->file_arr[task_id];
+  if (file) {
+    U8 *dst = task->buffer + task->off_arr[task_id];
+    MemoryCopy(dst, file->data.str, file->data.size);
+    task->data_arr.v[task_id] = str8(dst, file->data.size);
+  }
+}
+
+internal String8Array
+lnk_server_read_data_from_file_path_parallel(TP_Context *tp, Arena *arena, String8Array path_arr)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+
+  LNK_ServerFileReader task = {0};
+  task.path_arr       = path_arr;
+  task.file_arr       = push_array(scratch.arena, LNK_ServerFile *, path_arr.count);
+  task.off_arr        = push_array(scratch.arena, U64, path_arr.count);
+  task.data_arr.count = path_arr.count;
+  task.data_arr.v     = push_array(arena, String8, path_arr.count);
+
+  ProfBegin("Resolve Cached Files");
+  tp_for_parallel(tp, 0, path_arr.count, lnk_server_resolve_file_task, &task);
+  ProfEnd();
+
+  U64 buffer_size = 0;
+  for EachIndex(path_idx, path_arr.count) {
+    task.off_arr[path_idx] = buffer_size;
+    if (task.file_arr[path_idx]) {
+      buffer_size += task.file_arr[path_idx]->data.size;
+    }
+  }
+
+  // linker patches inputs in place, hand out private copies
+  ProfBegin("Copy Cached Files");
+  task.buffer = push_array_no_zero(arena, U8, buffer_size);
+  tp_for_parallel(tp, 0, path_arr.count, lnk_server_copy_file_task, &task);
+  ProfEnd();
+
+  scratch_end(scratch);
+  ProfEnd();
+  return task.data_arr;
+}
+
+internal String8
+lnk_server_lib_index_from_path(Arena *arena, String8 path, LNK_LibCacheKey key)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  String8 lib_index = {0};
+
+  String8 full_path = {0};
+  U64     hash      = lnk_server_file_hash_from_path(scratch.arena, path, &full_path);
+  MutexScope(g_lnk_server->mutex) {
+    LNK_ServerFile *file = lnk_server_file_lookup(full_path, hash);
+    if (file && file->lib_index.size >= sizeof(LNK_LibCacheHeader) && file->data.size == key.size && file->modified == key.modified) {
+      // entries are replaced when contents change, so the index was built for the same contents
+      // (time stamp may have been bumped since, the file read refreshes it after comparing hashes).
+      // cached index is shared with other links, patch the key on a private copy
+      lib_index = file->lib_index;
+      LNK_LibCacheHeader *header = (LNK_LibCacheHeader *)lib_index.str;
+      if (header->key.modified != key.modified) {
+        lib_index = push_str8_copy(arena, lib_index);
+        header    = (LNK_LibCacheHeader *)lib_index.str;
+        header->key.modified = key.modified;
+      }
+      ins_atomic_u64_inc_eval(&g_lnk_server->lib_index_hit_count);
+    }
+  }
+
+  scratch_end(scratch);
+  return lib_index;
+}
+
+internal void
+lnk_server_set_lib_index(String8 path, LNK_LibCacheKey key, String8 lib_index)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  String8 full_path = {0};
+  U64     hash      = lnk_server_file_hash_from_path(scratch.arena, path, &full_path);
+  MutexScope(g_lnk_server->mutex) {
+    LNK_ServerFile *file = lnk_server_file_lookup(full_path, hash);
+    if (file && file->lib_index.size == 0 && file->data.size == key.size && file->modified == key.modified) {
+      file->lib_index = push_str8_copy(file->arena, lib_index);
+    }
+  }
+
+  scratch_end(scratch);
+}
+
+// --- Type Hash Cache ---------------------------------------------------------
+
+internal U128
+lnk_server_key_from_debug_t(CV_DebugT debug_t)
+{
+  XXH3_state_t state;
+  XXH3_INITSTATE(&state);
+  XXH3_128bits_reset(&state);
+  for EachIndex(leaf_idx, debug_t.count) {
+    CV_Leaf leaf = cv_debug_t_get_leaf(debug_t, leaf_idx);
+    XXH3_128bits_update(&state, &leaf.kind, sizeof(leaf.kind));
+    XXH3_128bits_update(&state, &leaf.data.size, sizeof(leaf.data.size));
+    XXH3_128bits_update(&state, leaf.data.str, leaf.data.size);
+  }
+  XXH128_hash_t hash = XXH3_128bits_digest(&state);
+
+  U128 key = {0};
+  key.u64[0] = hash.low64;
+  key.u64[1] = hash.high64;
+  return key;
+}
+
+internal B32
+lnk_server_type_hashes_from_key(U128 key, U128Array hashes_out)
+{
+  B32 is_found = 0;
+  MutexScope(g_lnk_server->mutex) {
+    U64 slot_idx = key.u64[0] % g_lnk_server->type_hash_slots_count;
+    for (LNK_ServerTypeHashes *h = g_lnk_server->type_hash_slots[slot_idx]; h != 0; h = h->hash_next) {
+      if (u128_match(h->key, key) && h->hashes.count == hashes_out.count) {
+        MemoryCopyTyped(hashes_out.v, h->hashes.v, hashes_out.count);
+        h->last_link_idx = g_lnk_server->link_idx;
+        is_found = 1;
+        break;
+      }
+    }
+  }
+  if (is_found) {
+    ins_atomic_u64_inc_eval(&g_lnk_server->type_hash_hit_count);
+  } else {
+    ins_atomic_u64_inc_eval(&g_lnk_server->type_hash_miss_count);
+  }
+  return is_found;
+}
+
+internal void
+lnk_server_push_type_hashes(U128 key, U128Array hashes)
+{
+  MutexScope(g_lnk_server->mutex) {
+    U64 slot_idx = key.u64[0] % g_lnk_server->type_hash_slots_count;
+
+    B32 is_present = 0;
+    for (LNK_ServerTypeHashes *h = g_lnk_server->type_hash_slots[slot_idx]; h != 0; h = h->hash_next) {
+      if (u128_match(h->key, key)) {
+        is_present = 1;
+        break;
+      }
+    }
+
+    if (!is_present) {
+      LNK_ServerTypeHashes *h = push_array(g_lnk_server->type_hash_arena, LNK_ServerTypeHashes, 1);
+      h->key           = key;
+      h->hashes.count  = hashes.count;
+      h->hashes.v      = push_array_no_zero(g_lnk_server->type_hash_arena, U128, hashes.count);
+      MemoryCopyTyped(h->hashes.v, hashes.v, hashes.count);
+      h->last_link_idx = g_lnk_server->link_idx;
+      h->hash_next     = g_lnk_server->type_hash_slots[slot_idx];
+      g_lnk_server->type_hash_slots[slot_idx] = h;
+      g_lnk_server->type_hash_live_size += sizeof(*h) + sizeof(h->hashes.v[0]) * h->hashes.count;
+    }
+  }
+}
+
+internal void
+lnk_server_cache_gc(void)
+{
+  ProfBeginFunction();
+  U64 link_idx = g_lnk_server->link_idx;
+
+  // files retired during the last link are no longer referenced
+  for (LNK_ServerFile *file = g_lnk_server->retired_files, *next; file != 0; file = next) {
+    next = file->hash_next;
+    arena_release(file->arena);
+  }
+  g_lnk_server->retired_files = 0;
+
+  // evict files that were not used by recent links
+  for EachIndex(slot_idx, g_lnk_server->file_slots_count) {
+    for (LNK_ServerFile **ptr = &g_lnk_server->file_slots[slot_idx]; *ptr != 0;) {
+      LNK_ServerFile *file = *ptr;
+      if (link_idx - file->last_link_idx > LNK_SERVER_MAX_IDLE_LINKS) {
+        *ptr = file->hash_next;
+        arena_release(file->arena);
+      } else {
+        ptr = &file->hash_next;
+      }
+    }
+  }
+
+  // evict type hashes and compact arena once more than half of it is dead
+  U64 live_size = 0;
+  for EachIndex(slot_idx, g_lnk_server->type_hash_slots_count) {
+    for (LNK_ServerTypeHashes **ptr = &g_lnk_server->type_hash_slots[slot_idx]; *ptr != 0;) {
+      LNK_ServerTypeHashes *h = *ptr;
+      if (link_idx - h->last_link_idx > LNK_SERVER_MAX_IDLE_LINKS) {
+        *ptr = h->hash_next;
+      } else {
+        live_size += sizeof(*h) + sizeof(h->hashes.v[0]) * h->hashes.count;
+        ptr = &h->hash_next;
+      }
+    }
+  }
+  g_lnk_server->type_hash_live_size = live_size;
+
+  if (arena_pos(g_lnk_server->type_hash_arena) > live_size*2 + MB(1)) {
+    Arena                  *new_arena = arena_alloc();
+    LNK_ServerTypeHashes  **new_slots = push_array(new_arena, LNK_ServerTypeHashes *, g_lnk_server->type_hash_slots_count);
+    for EachIndex(slot_idx, g_lnk_server->type_hash_slots_count) {
+      for (LNK_ServerTypeHashes *h = g_lnk_server->type_hash_slots[slot_idx]; h != 0; h = h->hash_next) {
+        LNK_ServerTypeHashes *new_h = push_array(new_arena, LNK_ServerTypeHashes, 1);
+        new_h->key           = h->key;
+        new_h->hashes.count  = h->hashes.count;
+        new_h->hashes.v      = push_array_no_zero(new_arena, U128, h->hashes.count);
+        MemoryCopyTyped(new_h->hashes.v, h->hashes.v, h->hashes.count);
+        new_h->last_link_idx = h->last_link_idx;
+        new_h->hash_next     = new_slots[slot_idx];
+        new_slots[slot_idx]  = new_h;
+      }
+    }
+    arena_release(g_lnk_server->type_hash_arena);
+    g_lnk_server->type_hash_arena = new_arena;
+    g_lnk_server->type_hash_slots = new_slots;
+  }
+
+  ProfEnd();
+}
+
+// --- Output ------------------------------------------------------------------
+
+internal void
+lnk_server_push_output(String8 string)
+{
+  if (g_lnk_server && g_lnk_server->is_serving) {
+    MutexScope(g_lnk_server->mutex) {
+      str8_list_push(g_lnk_server->output_arena, &g_lnk_server->output, push_str8_copy(g_lnk_server->output_arena, string));
+    }
+  }
+}
+
+internal void
+lnk_server_respond(int code)
+{
+  Temp           scratch = scratch_begin(0,0);
+  LNK_ServerIPC *ipc     = &g_lnk_server->ipc;
+
+  // copy as much of the output as fits, leaving room for a note when it does not
+  U64 output_size = g_lnk_server->output.total_size;
+  U64 copy_max    = output_size <= ipc->buffer_max ? ipc->buffer_max : ipc->buffer_max - 256;
+  U64 response_size = 0;
+  for (String8Node *node = g_lnk_server->output.first; node != 0; node = node->next) {
+    U64 copy_size = Min(node->string.size, copy_max - response_size);
+    MemoryCopy(ipc->buffer + response_size, node->string.str, copy_size);
+    response_size += copy_size;
+  }
+  if (response_size < output_size) {
+    String8 note = push_str8f(scratch.arena, "RADLINK: server output truncated, %llu bytes were dropped\n", output_size - response_size);
+    U64     copy_size = Min(note.size, ipc->buffer_max - response_size);
+    MemoryCopy(ipc->buffer + response_size, note.str, copy_size);
+    response_size += copy_size;
+  }
+
+  ipc->shared->exit_code     = code;
+  ipc->shared->response_size = response_size;
+  ins_atomic_u64_eval_assign(&ipc->shared->response_id, ipc->shared->request_id);
+  os_semaphore_drop(ipc->response_signal);
+
+  scratch_end(scratch);
+}
+
+internal void
+lnk_server_relaunch(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  OS_ProcessLaunchParams params = {0};
+  params.path = g_lnk_server->work_dir;
+  params.env  = g_lnk_server->env;
+  str8_list_push(scratch.arena, &params.cmd_line, g_lnk_server->exe_path);
+  str8_list_push(scratch.arena, &params.cmd_line, str8_lit("--server"));
+  str8_list_pushf(scratch.arena, &params.cmd_line, "--server_name:%S", g_lnk_server->name);
+  OS_Handle process = os_process_launch(&params);
+  if (os_handle_match(process, os_handle_zero())) {
+    fprintf(stderr, "RADLINK: unable to launch replacement server \"%.*s\"\n", str8_varg(g_lnk_server->name));
+  } else {
+    os_process_detach(process);
+  }
+  scratch_end(scratch);
+}
+
+internal void
+lnk_server_exit(int code)
+{
+  if (g_lnk_server->is_serving) {
+    // first fatal error hands the server over, errors raised concurrently on other threads wait for the exit
+    if (ins_atomic_u32_eval_cond_assign(&g_lnk_server->is_exiting, 1, 0) != 0) {
+      for (;;) {
+        os_sleep_milliseconds(max_U32);
+      }
+    }
+
+    fprintf(stdout, "RADLINK: link #%llu failed with a fatal error, restarting server\n", g_lnk_server->link_idx);
+    fflush(stdout);
+
+    lnk_server_respond(code != 0 ? code : 1);
+    ins_atomic_u32_eval_assign(&g_lnk_server->ipc.shared->is_busy, 0);
+    lnk_server_relaunch();
+  }
+  exit(code);
+}
+
+// --- IPC ---------------------------------------------------------------------
+
+internal LNK_ServerIPC
+lnk_server_ipc_open(Arena *arena, String8 name, B32 create)
+{
+  String8 shared_memory_name   = push_str8f(arena, "_radlink_server_%S_shared_memory_",   name);
+  String8 client_lock_name     = push_str8f(arena, "_radlink_server_%S_client_lock_",     name);
+  String8 request_signal_name  = push_str8f(arena, "_radlink_server_%S_request_signal_",  name);
+  String8 response_signal_name = push_str8f(arena, "_radlink_server_%S_response_signal_", name);
+
+  LNK_ServerIPC ipc = {0};
+  if (create) {
+    ipc.shared_memory   = os_shared_memory_alloc(LNK_SERVER_SHARED_MEMORY_SIZE, shared_memory_name);
+    ipc.client_lock     = os_semaphore_alloc(1, 1, client_lock_name);
+    ipc.request_signal  = os_semaphore_alloc(0, 1, request_signal_name);
+    ipc.response_signal = os_semaphore_alloc(0, 1, response_signal_name);
+  } else {
+    ipc.shared_memory   = os_shared_memory_open(shared_memory_name);
+    ipc.client_lock     = os_semaphore_open(client_lock_name);
+    ipc.request_signal  = os_semaphore_open(request_signal_name);
+    ipc.response_signal = os_semaphore_open(response_signal_name);
+  }
+
+  B32 is_open = !os_handle_match(ipc.shared_memory, os_handle_zero()) &&
+                ipc.client_lock.u64[0] != 0 &&
+                ipc.request_signal.u64[0] != 0 &&
+                ipc.response_signal.u64[0] != 0;
+  if (is_open) {
+    U8 *base = os_shared_memory_view_open(ipc.shared_memory, r1u64(0, LNK_SERVER_SHARED_MEMORY_SIZE));
+    if (base) {
+      ipc.shared     = (LNK_ServerShared *)base;
+      ipc.buffer     = base + sizeof(LNK_ServerShared);
+      ipc.buffer_max = LNK_SERVER_SHARED_MEMORY_SIZE - sizeof(LNK_ServerShared);
+    }
+  }
+  if (ipc.shared == 0) {
+    lnk_server_ipc_close(&ipc);
+  }
+
+  return ipc;
+}
+
+internal void
+lnk_server_ipc_close(LNK_ServerIPC *ipc)
+{
+  if (ipc->shared) {
+    os_shared_memory_view_close(ipc->shared_memory, ipc->shared, r1u64(0, LNK_SERVER_SHARED_MEMORY_SIZE));
+  }
+  if (!os_handle_match(ipc->shared_memory, os_handle_zero())) {
+    os_shared_memory_close(ipc->shared_memory);
+  }
+  if (ipc->client_lock.u64[0])     { os_semaphore_close(ipc->client_lock);     }
+  if (ipc->request_signal.u64[0])  { os_semaphore_close(ipc->request_signal);  }
+  if (ipc->response_signal.u64[0]) { os_semaphore_close(ipc->response_signal); }
+  MemoryZeroStruct(ipc);
+}
+
+internal B32
+lnk_server_is_alive(LNK_ServerShared *shared, U64 *last_heartbeat, U64 *last_heartbeat_us)
+{
+  U64 now_us    = os_now_microseconds();
+  U64 heartbeat = ins_atomic_u64_eval(&shared->heartbeat);
+  if (heartbeat != *last_heartbeat || *last_heartbeat_us == 0) {
+    *last_heartbeat    = heartbeat;
+    *last_heartbeat_us = now_us;
+  }
+  B32 is_alive = shared->magic == LNK_SERVER_MAGIC && (now_us - *last_heartbeat_us) < LNK_SERVER_HEARTBEAT_TIMEOUT_US;
+  return is_alive;
+}
+
+internal String8
+lnk_server_serialize_request(Arena *arena, LNK_ServerRequest request)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  String8List srl = {0};
+  str8_serial_begin(scratch.arena, &srl);
+  str8_serial_push_u64(scratch.arena, &srl, request.work_dir.size);
+  str8_serial_push_data(scratch.arena, &srl, request.work_dir.str, request.work_dir.size);
+  String8List lists[] = { request.args, request.environment };
+  for EachElement(list_idx, lists) {
+    str8_serial_push_u64(scratch.arena, &srl, lists[list_idx].node_count);
+    for (String8Node *node = lists[list_idx].first; node != 0; node = node->next) {
+      str8_serial_push_u64(scratch.arena, &srl, node->string.size);
+      str8_serial_push_data(scratch.arena, &srl, node->string.str, node->string.size);
+    }
+  }
+  String8 result = str8_serial_end(arena, &srl);
+  scratch_end(scratch);
+  return result;
+}
+
+internal LNK_ServerRequest
+lnk_server_deserialize_request(Arena *arena, String8 data)
+{
+  LNK_ServerRequest request = {0};
+  U64 cursor = 0;
+
+  U64 work_dir_size = 0;
+  cursor += str8_deserial_read_struct(data, cursor, &work_dir_size);
+  cursor += str8_deserial_read_block(data, cursor, work_dir_size, &request.work_dir);
+  request.work_dir = push_str8_copy(arena, request.work_dir);
+
+  String8List *lists[] = { &request.args, &request.environment };
+  for EachElement(list_idx, lists) {
+    U64 count = 0;
+    cursor += str8_deserial_read_struct(data, cursor, &count);
+    for (U64 i = 0; i < count && cursor < data.size; ++i) {
+      U64     size   = 0;
+      String8 string = {0};
+      cursor += str8_deserial_read_struct(data, cursor, &size);
+      cursor += str8_deserial_read_block(data, cursor, size, &string);
+      str8_list_push(arena, lists[list_idx], push_str8_copy(arena, string));
+    }
+  }
+
+  return request;
+}
+
+// --- Server ------------------------------------------------------------------
+
+internal void
+lnk_server_heartbeat_thread(void *raw_shared)
+{
+  LNK_ServerShared *shared = raw_shared;
+  for (;;) {
+    ins_atomic_u64_inc_eval(&shared->heartbeat);
+    os_sleep_milliseconds(LNK_SERVER_HEARTBEAT_PERIOD_MS);
+  }
+}
+
+internal B32
+lnk_server_is_process_alive(U32 pid)
+{
+#if OS_WINDOWS
+  B32    is_alive = 0;
+  HANDLE process  = OpenProcess(SYNCHRONIZE, FALSE, pid);
+  if (process) {
+    is_alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+  } else {
+    // process exists but we can't open it
+    is_alive = GetLastError() == ERROR_ACCESS_DENIED;
+  }
+#else
+  B32 is_alive = kill((pid_t)pid, 0) == 0 || errno == EPERM;
+#endif
+  return is_alive;
+}
+
+internal TP_Context *
+lnk_server_thread_pool_from_config(LNK_Config *config)
+{
+  if (g_lnk_server->tp == 0 ||
+      g_lnk_server->tp_worker_count != config->worker_count ||
+      g_lnk_server->tp_max_worker_count != config->max_worker_count ||
+      !str8_match(g_lnk_server->tp_name, config->shared_thread_pool_name, 0)) {
+    // pool memory stays in the server arena, detached workers still read it on their way out
+    if (g_lnk_server->tp) {
+      tp_release(g_lnk_server->tp);
+    }
+    g_lnk_server->tp                  = tp_alloc(g_lnk_server->arena, config->worker_count, config->max_worker_count, config->shared_thread_pool_name);
+    g_lnk_server->tp_worker_count     = config->worker_count;
+    g_lnk_server->tp_max_worker_count = config->max_worker_count;
+    g_lnk_server->tp_name             = push_str8_copy(g_lnk_server->arena, config->shared_thread_pool_name);
+  }
+  return g_lnk_server->tp;
+}
+
+internal B32
+lnk_server_set_current_path(String8 path)
+{
+  Temp scratch = scratch_begin(0,0);
+#if OS_WINDOWS
+  String16 path16 = str16_from_8(scratch.arena, path);
+  B32 is_set = !!SetCurrentDirectoryW((WCHAR *)path16.str);
+#else
+  String8 path_copy = push_str8_copy(scratch.arena, path);
+  B32 is_set = chdir((char *)path_copy.str) == 0;
+#endif
+  scratch_end(scratch);
+  return is_set;
+}
+
+internal void
+lnk_server_run(String8 exe_path, String8 name)
+{
+  Arena          *arena        = arena_alloc();
+  OS_ProcessInfo *process_info = os_get_process_info();
+
+  g_lnk_server                        = push_array(arena, LNK_ServerCache, 1);
+  g_lnk_server->arena                 = arena;
+  g_lnk_server->mutex                 = mutex_alloc();
+  g_lnk_server->file_slots_count      = 4096;
+  g_lnk_server->file_slots            = push_array(arena, LNK_ServerFile *, g_lnk_server->file_slots_count);
+  g_lnk_server->type_hash_arena       = arena_alloc();
+  g_lnk_server->type_hash_slots_count = 16384;
+  g_lnk_server->type_hash_slots       = push_array(g_lnk_server->type_hash_arena, LNK_ServerTypeHashes *, g_lnk_server->type_hash_slots_count);
+  g_lnk_server->output_arena          = arena_alloc();
+  g_lnk_server->ipc                   = lnk_server_ipc_open(arena, name, 1);
+  g_lnk_server->name                  = push_str8_copy(arena, name);
+  g_lnk_server->exe_path              = push_str8f(arena, "%S/%S", process_info->binary_path, str8_skip_last_slash(exe_path));
+  g_lnk_server->work_dir              = os_get_current_path(arena);
+  g_lnk_server->env                   = process_info->environment;
+
+  LNK_ServerIPC *ipc = &g_lnk_server->ipc;
+  if (ipc->shared == 0) {
+    fprintf(stderr, "RADLINK: unable to create server \"%.*s\"\n", str8_varg(name));
+    lnk_exit(1);
+  }
+  ipc->shared->magic = LNK_SERVER_MAGIC;
+  thread_launch(lnk_server_heartbeat_thread, ipc->shared);
+
+  fprintf(stdout, "RADLINK: server \"%.*s\" is ready\n", str8_varg(name));
+  fflush(stdout);
+
+  for (;;) {
+    if (!os_semaphore_take(ipc->request_signal, max_U64)) {
+      continue;
+    }
+    ins_atomic_u32_eval_assign(&ipc->shared->is_busy, 1);
+
+    Temp scratch = scratch_begin(0,0);
+
+    LNK_ServerRequest request = lnk_server_deserialize_request(scratch.arena, str8(ipc->buffer, Min(ipc->shared->request_size, ipc->buffer_max)));
+
+    // reset per-link state
+    lnk_init_error_handler();
+    MemoryZeroArray(g_timers);
+    arena_clear(g_lnk_server->output_arena);
+    MemoryZeroStruct(&g_lnk_server->output);
+    g_lnk_server->link_idx       += 1;
+    g_lnk_server->is_serving      = 1;
+    process_info->environment     = request.environment;
+
+    // build null terminated argv
+    int    argc = (int)request.args.node_count;
+    char **argv = push_array(scratch.arena, char *, argc + 1);
+    {
+      U64 arg_idx = 0;
+      for (String8Node *node = request.args.first; node != 0; node = node->next, ++arg_idx) {
+        argv[arg_idx] = (char *)push_str8_copy(scratch.arena, node->string).str;
+      }
+    }
+
+    // fatal errors don't return here, lnk_server_exit replies and restarts the server
+    U64 link_begin_us = os_now_microseconds();
+    int exit_code     = 0;
+    if (lnk_server_set_current_path(request.work_dir)) {
+      LNK_Config *config   = lnk_config_from_argcv(scratch.arena, argc, argv);
+      TP_Context *tp       = lnk_server_thread_pool_from_config(config);
+      TP_Arena   *tp_arena = tp_arena_alloc(tp);
+      lnk_run(tp, tp_arena, config);
+      tp_arena_release(&tp_arena);
+      arena_release(config->arena);
+    } else {
+      lnk_server_push_output(push_str8f(scratch.arena, "RADLINK: unable to switch to working directory \"%S\"\n", request.work_dir));
+      exit_code = 1;
+    }
+
+    lnk_server_respond(exit_code);
+    g_lnk_server->is_serving = 0;
+    ins_atomic_u32_eval_assign(&ipc->shared->is_busy, 0);
+
+    U64 link_time_us = os_now_microseconds() - link_begin_us;
+    fprintf(stdout, "RADLINK: link #%llu done in %.3fs (files: %llu hit, %llu miss; lib indices: %llu hit; type hashes: %llu hit, %llu miss)\n",
+            g_lnk_server->link_idx, (F64)link_time_us / 1000000.0,
+            g_lnk_server->file_hit_count, g_lnk_server->file_miss_count,
+            g_lnk_server->lib_index_hit_count,
+            g_lnk_server->type_hash_hit_count, g_lnk_server->type_hash_miss_count);
+    fflush(stdout);
+
+    lnk_server_cache_gc();
+    g_lnk_server->file_hit_count       = 0;
+    g_lnk_server->file_miss_count      = 0;
+    g_lnk_server->lib_index_hit_count  = 0;
+    g_lnk_server->type_hash_hit_count  = 0;
+    g_lnk_server->type_hash_miss_count = 0;
+
+    process_info->environment = g_lnk_server->env;
+    scratch_end(scratch);
+  }
+}
+
+// --- Client ------------------------------------------------------------------
+
+internal B32
+lnk_server_link(String8 name, U64 argc, char **argv, int *exit_code_out)
+{
+  Temp scratch = scratch_begin(0,0);
+  B32 is_linked = 0;
+
+  LNK_ServerIPC ipc = lnk_server_ipc_open(scratch.arena, name, 0);
+  if (ipc.shared && ipc.shared->magic == LNK_SERVER_MAGIC) {
+    U64 last_heartbeat    = 0;
+    U64 last_heartbeat_us = 0;
+    U32 pid               = os_get_process_info()->pid;
+
+    // wait for other clients
+    B32 is_locked = 0;
+    while (lnk_server_is_alive(ipc.shared, &last_heartbeat, &last_heartbeat_us)) {
+      if (os_semaphore_take(ipc.client_lock, os_now_microseconds() + 500000)) {
+        ins_atomic_u32_eval_assign(&ipc.shared->client_pid, pid);
+        is_locked = 1;
+        break;
+      }
+
+      // holder died without dropping the lock, take it over
+      U32 holder_pid = ins_atomic_u32_eval(&ipc.shared->client_pid);
+      if (holder_pid != 0 && !lnk_server_is_process_alive(holder_pid)) {
+        if (ins_atomic_u32_eval_cond_assign(&ipc.shared->client_pid, pid, holder_pid) == holder_pid) {
+          // server may still be serving the dead client and writes its response to the shared buffer
+          while (ins_atomic_u32_eval(&ipc.shared->is_busy) && lnk_server_is_alive(ipc.shared, &last_heartbeat, &last_heartbeat_us)) {
+            os_sleep_milliseconds(LNK_SERVER_HEARTBEAT_PERIOD_MS);
+          }
+          is_locked = 1;
+          break;
+        }
+      }
+    }
+
+    if (is_locked) {
+      LNK_ServerRequest request = {0};
+      request.work_dir    = os_get_current_path(scratch.arena);
+      request.environment = os_get_process_info()->environment;
+      for EachIndex(arg_idx, argc) {
+        str8_list_push(scratch.arena, &request.args, str8_cstring(argv[arg_idx]));
+      }
+      String8 request_data = lnk_server_serialize_request(scratch.arena, request);
+
+      if (request_data.size <= ipc.buffer_max) {
+        MemoryCopy(ipc.buffer, request_data.str, request_data.size);
+        ipc.shared->request_size = request_data.size;
+        U64 request_id = ins_atomic_u64_inc_eval(&ipc.shared->request_id);
+        os_semaphore_drop(ipc.request_signal);
+
+        // wait for response, bail if server dies mid-link
+        while (lnk_server_is_alive(ipc.shared, &last_heartbeat, &last_heartbeat_us)) {
+          os_semaphore_take(ipc.response_signal, os_now_microseconds() + 500000);
+          if (ins_atomic_u64_eval(&ipc.shared->response_id) == request_id) {
+            String8 output = str8(ipc.buffer, Min(ipc.shared->response_size, ipc.buffer_max));
+            fprintf(stderr, "%.*s", str8_varg(output));
+            *exit_code_out = ipc.shared->exit_code;
+            is_linked = 1;
+            break;
+          }
+        }
+      }
+
+      ins_atomic_u32_eval_assign(&ipc.shared->client_pid, 0);
+      os_semaphore_drop(ipc.client_lock);
+    }
+  }
+
+  lnk_server_ipc_close(&ipc);
+  scratch_end(scratch);
+  return is_linked;
+}
@@ -0,0 +1,173 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#pragma once
+
+// --- Server Protocol ---------------------------------------------------------
+//
+// Clients and the resident server talk through a named shared memory block guarded
+// by three named semaphores:
+//  client_lock     - serializes clients, held by a client for the duration of its link
+//  request_signal  - client -> server, request is written to the shared buffer
+//  response_signal - server -> client, exit code and linker output are written to the shared buffer
+//
+// The server bumps the heartbeat while it is alive, a client that sees the heartbeat stall
+// gives up on the server and links in-process.
+//
+// Named semaphores are not released when their holder dies, so the client holding
+// client_lock also publishes its PID. A waiting client that finds the holder dead
+// takes the lock over by swapping in its own PID, then waits for the server to go
+// idle before it writes its request.
+//
+// Linker output that does not fit into the shared buffer is truncated, and a note with
+// the number of dropped bytes is appended.
+//
+// A fatal link error may be raised on any thread, while the link holds arenas, file
+// handles and locks that can't be reclaimed in-process. The server replies to the client,
+// launches a fresh server under the same name and exits, so caches start cold again after
+// a failed link. Named objects stay alive while the client holds them, a waiting client
+// sees the replacement server pick up the heartbeat.
+
+#define LNK_SERVER_MAGIC                0x3252565245534b4cull // "LKSERVR2"
+#define LNK_SERVER_DEFAULT_NAME         "radlink"
+#define LNK_SERVER_SHARED_MEMORY_SIZE   MB(4)
+#define LNK_SERVER_HEARTBEAT_PERIOD_MS  100
+#define LNK_SERVER_HEARTBEAT_TIMEOUT_US 10000000
+#define LNK_SERVER_MAX_IDLE_LINKS       32
+
+typedef struct LNK_ServerShared
+{
+  U64 magic;
+  U64 heartbeat;
+  U64 request_id;  // bumped by the client for every request, echoed back in response_id
+  U64 request_size;
+  U64 response_id;
+  U64 response_size;
+  S32 exit_code;
+  U32 client_pid;  // holder of client_lock, zero when the lock is free
+  U32 is_busy;     // server is handling a request
+  U32 pad;
+} LNK_ServerShared;
+
+typedef struct LNK_ServerIPC
+{
+  LNK_ServerShared *shared;
+  U8               *buffer;
+  U64               buffer_max;
+  OS_Handle         shared_memory;
+  Semaphore         client_lock;
+  Semaphore         request_signal;
+  Semaphore         response_signal;
+} LNK_ServerIPC;
+
+typedef struct LNK_ServerRequest
+{
+  String8     work_dir;
+  String8List args;
+  String8List environment;
+} LNK_ServerRequest;
+
+// --- Server Cache ------------------------------------------------------------
+
+typedef struct LNK_ServerFile
+{
+  struct LNK_ServerFile *hash_next;
+  Arena                 *arena;
+  String8                path;
+  U64                    modified;
+  U128                   hash;
+  String8                data;
+  String8                lib_index; // serialized lib symbol index (see LNK_LibCacheHeader)
+  U64                    last_link_idx;
+} LNK_ServerFile;
+
+typedef struct LNK_ServerTypeHashes
+{
+  struct LNK_ServerTypeHashes *hash_next;
+  U128                         key;
+  U128Array                    hashes;
+  U64                          last_link_idx;
+} LNK_ServerTypeHashes;
+
+typedef struct LNK_ServerCache
+{
+  Arena                 *arena;
+  Mutex                  mutex;
+  U64                    link_idx;
+
+  // file contents, keyed on full path and invalidated by content hash
+  U64                    file_slots_count;
+  LNK_ServerFile       **file_slots;
+  LNK_ServerFile        *retired_files;
+
+  // CodeView type hashes, keyed on .debug$T contents
+  Arena                 *type_hash_arena;
+  U64                    type_hash_slots_count;
+  LNK_ServerTypeHashes **type_hash_slots;
+  U64                    type_hash_live_size;
+
+  // linker output of the request that is being served
+  Arena                 *output_arena;
+  String8List            output;
+  B32                    is_serving;
+  LNK_ServerIPC          ipc;
+
+  // thread pool outlives links, recreated when a client asks for a different configuration
+  TP_Context            *tp;
+  U64                    tp_worker_count;
+  U64                    tp_max_worker_count;
+  String8                tp_name;
+
+  // command line and environment of the replacement server launched after a fatal error
+  String8                name;
+  String8                exe_path;
+  String8                work_dir;
+  String8List            env;
+  U32                    is_exiting;
+
+  // stats
+  U64                    file_hit_count;
+  U64                    file_miss_count;
+  U64                    lib_index_hit_count;
+  U64                    type_hash_hit_count;
+  U64                    type_hash_miss_count;
+} LNK_ServerCache;
+
+// --- Workers Contexts --------------------------------------------------------
+
+typedef struct
+{
+  String8Array     path_arr;
+  LNK_ServerFile **file_arr;
+  U64             *off_arr;
+  U8              *buffer;
+  String8Array     data_arr;
+} LNK_ServerFileReader;
+
+// -----------------------------------------------------------------------------
+
+internal B32 lnk_server_is_active(void);
+
+// cache
+internal String8Array lnk_server_read_data_from_file_path_parallel(TP_Context *tp, Arena *arena, String8Array path_arr);
+internal String8      lnk_server_lib_index_from_path(Arena *arena, String8 path, LNK_LibCacheKey key);
+internal void         lnk_server_set_lib_index(String8 path, LNK_LibCacheKey key, String8 lib_index);
+internal U128         lnk_server_key_from_debug_t(CV_DebugT debug_t);
+internal B32          lnk_server_type_hashes_from_key(U128 key, U128Array hashes_out);
+internal void         lnk_server_push_type_hashes(U128 key, U128Array hashes);
+internal void         lnk_server_cache_gc(void);
+
+// output
+internal void lnk_server_push_output(String8 string);
+internal void lnk_server_exit(int code);
+
+// ipc
+internal LNK_ServerIPC     lnk_server_ipc_open(Arena *arena, String8 name, B32 create);
+internal void              lnk_server_ipc_close(LNK_ServerIPC *ipc);
+internal B32               lnk_server_is_alive(LNK_ServerShared *shared, U64 *last_heartbeat, U64 *last_heartbeat_us);
+internal String8           lnk_server_serialize_request(Arena *arena, LNK_ServerRequest request);
+internal LNK_ServerRequest lnk_server_deserialize_request(Arena *arena, String8 data);
+
+// entry points
+internal void lnk_server_run(String8 exe_path, String8 name);
+internal B32  lnk_server_link(String8 name, U64 argc, char **argv, int *exit_code_out);
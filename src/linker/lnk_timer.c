@@ -1,6 +1,12 @@
 // Copyright (c) Epic Games Tools
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
+#if OS_WINDOWS
+# include <psapi.h>
+#elif OS_LINUX
+# include <sys/resource.h>
+#endif
+
 global LNK_Timer g_timers[LNK_Timer_Count];
 
 internal void
@@ -29,3 +35,21 @@ lnk_string_from_timer_type(LNK_TimerType type)
   return str8_zero();
 }
 
+internal U64
+lnk_get_peak_memory_usage(void)
+{
+  U64 peak_bytes = 0;
+#if OS_WINDOWS
+  PROCESS_MEMORY_COUNTERS counters = {0};
+  counters.cb = sizeof(counters);
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    peak_bytes = counters.PeakWorkingSetSize;
+  }
+#elif OS_LINUX
+  struct rusage usage = {0};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    peak_bytes = (U64)usage.ru_maxrss * 1024; // ru_maxrss is in kilobytes
+  }
+#endif
+  return peak_bytes;
+}
@@ -22,3 +22,5 @@ typedef struct LNK_Timer
 internal void lnk_timer_begin(LNK_TimerType timer);
 internal void lnk_timer_end(LNK_TimerType timer);
 
+internal U64 lnk_get_peak_memory_usage(void);
+
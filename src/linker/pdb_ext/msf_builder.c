@@ -14,14 +14,10 @@ msf_page_data_list_push(Arena *arena, MSF_PageDataList *list, MSF_UInt page_size
 {
   U64 data_size = msf_get_data_node_size(page_size);
   for (MSF_UInt i = 0; i < count; i += 1) {
-    // TODO: clearing memory to zero here is expensive,
-    // with 4KiB pages we have to zero-out 128 MiB 
-    // memory block
-    // 
-    // we can make API for stream allocation to let user 
-    // choose between zeroed and dirty allocations
-    //
-    U8 *data = push_array_aligned(arena, U8, data_size, page_size);
+    // MSF arena only grows so data nodes land on freshly committed memory
+    // which is already zeroed, pages that are handed out for the second time
+    // are zeroed on allocation when caller asks for it (see msf_alloc_pages_ex)
+    U8 *data = push_array_no_zero_aligned(arena, U8, data_size, page_size);
 
     // init node
     MSF_PageDataNode *node = push_array_no_zero(arena, MSF_PageDataNode, 1);
@@ -573,15 +569,38 @@ msf_free_pn_arr(MSF_Context *msf, MSF_PageNumber *pn_arr, MSF_UInt pn_count)
   msf->page_count -= pn_count;
 }
 
+internal void
+msf_zero_page(MSF_Context *msf, MSF_PageNumber pn)
+{
+  String8 page_data = msf_data_from_pn(msf->page_data_list, msf->page_size, pn);
+  MemoryZero(page_data.str, page_data.size);
+}
+
 internal MSF_PageList
-msf_alloc_pages(MSF_Context *msf, MSF_UInt alloc_count)
+msf_alloc_pages_ex(MSF_Context *msf, MSF_UInt alloc_count, B32 zero_pages)
 {
   Temp scratch = scratch_begin(0, 0);
   
   MSF_PageList alloc_list = {0};
-  MSF_PageNumber *pn_arr = msf_alloc_pn_arr(scratch.arena, msf, alloc_count);
+
+  // reuse pages freed by other streams
+  MSF_UInt reuse_count = Min(alloc_count, msf->free_page_list.count);
+  for (MSF_UInt page_idx = 0; page_idx < reuse_count; page_idx += 1) {
+    MSF_PageNode *page_node = msf->free_page_list.first;
+    DLLRemove(msf->free_page_list.first, msf->free_page_list.last, page_node);
+    msf->free_page_list.count -= 1;
+    msf_page_list_push_node(&alloc_list, page_node);
+
+    if (zero_pages) {
+      msf_zero_page(msf, page_node->pn);
+    }
+  }
+
+  // allocate rest of the pages from the FPM
+  MSF_UInt        fpm_alloc_count = alloc_count - reuse_count;
+  MSF_PageNumber *pn_arr          = msf_alloc_pn_arr(scratch.arena, msf, fpm_alloc_count);
   if (pn_arr) {
-    for (MSF_UInt page_idx = 0; page_idx < alloc_count; page_idx += 1) {
+    for (MSF_UInt page_idx = 0; page_idx < fpm_alloc_count; page_idx += 1) {
       // get page node
       MSF_PageNode *page_node = 0;
       if (msf->page_pool.count) {
@@ -593,6 +612,12 @@ msf_alloc_pages(MSF_Context *msf, MSF_UInt alloc_count)
       
       // copy page number
       page_node->pn = pn_arr[page_idx];
+
+      // page might have been used before
+      if (zero_pages && page_node->pn < msf->fresh_pn_lo) {
+        msf_zero_page(msf, page_node->pn);
+      }
+      msf->fresh_pn_lo = Max(msf->fresh_pn_lo, page_node->pn + 1);
     }
   }
   
@@ -600,21 +625,51 @@ msf_alloc_pages(MSF_Context *msf, MSF_UInt alloc_count)
   return alloc_list;
 }
 
+internal MSF_PageList
+msf_alloc_pages(MSF_Context *msf, MSF_UInt alloc_count)
+{
+  return msf_alloc_pages_ex(msf, alloc_count, 1);
+}
+
 internal void
 msf_free_pages(MSF_Context *msf, MSF_PageList *page_list)
+{
+  // keep pages allocated in the FPM so next allocation can pick them up
+  // without scanning FPM or growing the file
+  msf_page_list_concat_in_place(&msf->free_page_list, page_list);
+}
+
+internal void
+msf_release_free_pages(MSF_Context *msf)
 {
   Temp scratch = scratch_begin(0, 0);
   
   // free page numbers
-  MSF_PageNumber *pn_arr = msf_page_list_to_arr(scratch.arena, *page_list);
-  msf_free_pn_arr(msf, pn_arr, page_list->count);
+  MSF_PageNumber *pn_arr = msf_page_list_to_arr(scratch.arena, msf->free_page_list);
+  msf_free_pn_arr(msf, pn_arr, msf->free_page_list.count);
   
   // push free nodes
-  msf_page_list_concat_in_place(&msf->page_pool, page_list);
+  msf_page_list_concat_in_place(&msf->page_pool, &msf->free_page_list);
 
   scratch_end(scratch);
 }
 
+internal void
+msf_resize_page_list(MSF_Context *msf, MSF_PageList *page_list, MSF_UInt page_count, B32 zero_pages)
+{
+  if (page_count > page_list->count) {
+    MSF_PageList alloc_list = msf_alloc_pages_ex(msf, page_count - page_list->count, zero_pages);
+    msf_page_list_concat_in_place(page_list, &alloc_list);
+  } else {
+    MSF_PageList free_page_list = {0};
+    for (MSF_UInt i = page_list->count; i > page_count; i -= 1) {
+      MSF_PageNode *page_node = msf_page_list_pop_last(page_list);
+      msf_page_list_push_node(&free_page_list, page_node);
+    }
+    msf_free_pages(msf, &free_page_list);
+  }
+}
+
 internal MSF_PageNumber
 msf_find_max_pn_(MSF_PageDataList page_data_list, MSF_UInt page_size, MSF_PageNumberArray fpm_pn_arr)
 {
@@ -811,23 +866,10 @@ msf_stream_alloc(MSF_Context *msf)
 }
 
 internal B32
-msf_stream_resize_ex(MSF_Context *msf, MSF_Stream *stream, MSF_UInt size)
+msf_stream_resize__(MSF_Context *msf, MSF_Stream *stream, MSF_UInt size, B32 zero_pages)
 {
   MSF_UInt new_page_count = msf_count_pages(msf->page_size, size);
-  MSF_UInt cur_page_count = stream->page_list.count;
-  
-  if (new_page_count > cur_page_count) {
-    MSF_UInt alloc_count = new_page_count - cur_page_count;
-    MSF_PageList page_list = msf_alloc_pages(msf, alloc_count);
-    msf_page_list_concat_in_place(&stream->page_list, &page_list);
-  } else {
-    MSF_PageList free_page_list = {0};
-    for (MSF_UInt i = cur_page_count; i > new_page_count; i -= 1) {
-      MSF_PageNode *page_node = msf_page_list_pop_last(&stream->page_list);
-      msf_page_list_push_node(&free_page_list, page_node);
-    }
-    msf_free_pages(msf, &free_page_list);
-  }
+  msf_resize_page_list(msf, &stream->page_list, new_page_count, zero_pages);
   
   // update stream
   stream->size = Min(stream->size, stream->page_list.count * msf->page_size);
@@ -837,6 +879,23 @@ msf_stream_resize_ex(MSF_Context *msf, MSF_Stream *stream, MSF_UInt size)
   return 1;
 }
 
+internal void
+msf_stream_zero_tail__(MSF_Context *msf, MSF_Stream *stream, MSF_UInt end)
+{
+  // zero bytes past end in the last page so padding writes over them read back zeroes
+  MSF_UInt tail_offset = end % msf->page_size;
+  if (tail_offset != 0 && stream->page_list.last) {
+    String8 page_data = msf_data_from_pn(msf->page_data_list, msf->page_size, stream->page_list.last->pn);
+    MemoryZero(page_data.str + tail_offset, page_data.size - tail_offset);
+  }
+}
+
+internal B32
+msf_stream_resize_ex(MSF_Context *msf, MSF_Stream *stream, MSF_UInt size)
+{
+  return msf_stream_resize__(msf, stream, size, 1);
+}
+
 internal B32
 msf_stream_resize(MSF_Context *msf, MSF_StreamNumber sn, MSF_UInt new_size)
 {
@@ -966,10 +1025,14 @@ msf_stream_write__(MSF_Context *msf, MSF_Stream *stream, void *buffer, MSF_UInt
   MSF_UInt stream_pos_opl = stream->pos + buffer_size;
   B32 grow_stream = stream_pos_opl > stream_cap;
   if (grow_stream) {
-    B32 is_resize_ok = msf_stream_resize_ex(msf, stream, stream_pos_opl);
+    // buffer overwrites new pages, so only null writes need zeroed pages
+    B32 is_resize_ok = msf_stream_resize__(msf, stream, stream_pos_opl, buffer == 0);
     if (!is_resize_ok) {
       goto exit;
     }
+    if (buffer) {
+      msf_stream_zero_tail__(msf, stream, stream_pos_opl);
+    }
   }
   
   if (buffer) {
@@ -1018,6 +1081,43 @@ msf_stream_reserve__(MSF_Context *msf, MSF_Stream *stream, MSF_UInt res)
   return is_ok;
 } 
 
+internal B32
+msf_stream_reserve_dirty__(MSF_Context *msf, MSF_Stream *stream, MSF_UInt res)
+{
+  ProfBeginV("MSF Reserve Dirty %m", res);
+
+  B32 is_ok = 1;
+
+  MSF_UInt cap = msf_stream_get_cap__(msf, stream);
+  MSF_UInt pos = msf_stream_get_pos__(msf, stream);
+  MSF_UInt cur = cap - pos;
+
+  if (cur < res) {
+    MSF_UInt pos_opl = pos + res;
+    is_ok = msf_stream_resize__(msf, stream, pos_opl, 0);
+    AssertAlways(is_ok);
+    msf_stream_zero_tail__(msf, stream, pos_opl);
+
+    // reserved bytes count towards stream size same as in msf_stream_reserve,
+    // but they are not zeroed, caller has to overwrite all of them
+    stream->size = Max(stream->size, pos_opl);
+  }
+
+  ProfEnd();
+  return is_ok;
+}
+
+internal B32
+msf_stream_reserve_dirty(MSF_Context *msf, MSF_StreamNumber sn, MSF_UInt res)
+{
+  MSF_Stream *stream = msf_find_stream(msf, sn);
+  B32 is_res_ok = 0;
+  if (stream) {
+    is_res_ok = msf_stream_reserve_dirty__(msf, stream, res);
+  }
+  return is_res_ok;
+}
+
 internal B32
 msf_stream_reserve(MSF_Context *msf, MSF_StreamNumber sn, MSF_UInt res)
 {
@@ -1150,7 +1250,8 @@ msf_stream_write_parallel(TP_Context *tp, MSF_Context *msf, MSF_StreamNumber sn,
 
   MSF_Stream *stream = msf_find_stream(msf, sn);
 
-  B32 is_write_ok = msf_stream_reserve__(msf, stream, buffer_size);
+  // buffer overwrites all reserved bytes
+  B32 is_write_ok = msf_stream_reserve_dirty__(msf, stream, buffer_size);
 
   if (is_write_ok) {
     U64 expected_pos = stream->pos + buffer_size;
@@ -1186,6 +1287,7 @@ msf_stream_write_parallel(TP_Context *tp, MSF_Context *msf, MSF_StreamNumber sn,
 
       // we rely on low-level msf_write__ to copy bytes which doesn't advance stream pos
       U64 after_mid = stream->pos + mid_size;
+      stream->size  = Max(stream->size, after_mid);
       B32 is_seek_ok = msf_stream_seek__(msf, stream, after_mid);
       AssertAlways(is_seek_ok);
 	  
@@ -1646,6 +1748,7 @@ msf_open(String8 data, MSF_Context **msf_out)
     msf->root_page_list   = root_page_list;
     msf->st_page_list     = st_page_list;
     msf->sectab               = stream_list;
+    msf->fresh_pn_lo      = msf_get_page_count_cap(page_data_list, header->page_size);
     
     *msf_out = msf;
     
@@ -1750,8 +1853,7 @@ msf_build_stream_table(MSF_Context *msf, MSF_UInt *stream_table_size_out)
   String8List st_data_list = msf_build_stream_table_data(scratch.arena, &msf->sectab, msf->page_size, msf->page_count);
   
   MSF_UInt st_page_count = msf_count_pages(msf->page_size, st_data_list.total_size);
-  msf_free_pages(msf, &msf->st_page_list); // TODO: page reuse
-  msf->st_page_list = msf_alloc_pages(msf, st_page_count);
+  msf_resize_page_list(msf, &msf->st_page_list, st_page_count, 0);
   
   MSF_UInt cursor = 0;
   for (String8Node *node = st_data_list.first; node != 0; node = node->next) {
@@ -1796,8 +1898,7 @@ msf_build_root_directory(MSF_Context *msf)
   MSF_UInt root_page_count = msf_count_pages(msf->page_size, pn_count * sizeof(pn_arr[0]));
   Assert(root_page_count == 1);
   
-  msf_free_pages(msf, &msf->root_page_list); // TODO: page reuse
-  msf->root_page_list = msf_alloc_pages(msf, root_page_count);
+  msf_resize_page_list(msf, &msf->root_page_list, root_page_count, 0);
   B32 is_root_written = msf_write(msf->page_data_list, msf->page_size, msf->root_page_list, 0, pn_arr, sizeof(pn_arr[0]) * pn_count);
   if (!is_root_written) {
     error = MSF_BuildError_UNABLE_TO_WRITE_ROOT_DIRECTORY;
@@ -1853,6 +1954,9 @@ msf_build(MSF_Context *msf)
     if (err != MSF_Error_OK) {
       break;
     }
+
+    // mark unused pages as free in the FPM before header picks up page count
+    msf_release_free_pages(msf);
     
     err = msf_build_header(msf, stream_table_size);
     if (err != MSF_Error_OK) {
@@ -83,6 +83,13 @@ typedef struct MSF_Context
   MSF_PageList     st_page_list;
   MSF_PageList     page_pool;
   MSF_StreamList   sectab;
+
+  // pages freed by streams, still marked as allocated in the FPM,
+  // handed out first and released to the FPM on build
+  MSF_PageList     free_page_list;
+
+  // pages at and above this number were never handed out and are still zero
+  MSF_PageNumber   fresh_pn_lo;
 } MSF_Context;
 
 typedef enum MSF_Error
@@ -139,8 +146,11 @@ internal MSF_Stream *     msf_find_stream(MSF_Context *msf, MSF_StreamNumber sn)
 internal B32              msf_grow(MSF_Context *msf, MSF_PageNumber page_count);
 internal MSF_PageNumber * msf_alloc_pn_arr(Arena *arena, MSF_Context *msf, MSF_UInt alloc_count);
 internal void             msf_free_pn_arr(MSF_Context *msf, MSF_PageNumber *pn_arr, MSF_UInt pn_count);
+internal MSF_PageList     msf_alloc_pages_ex(MSF_Context *msf, MSF_UInt alloc_count, B32 zero_pages);
 internal MSF_PageList     msf_alloc_pages(MSF_Context *msf, MSF_UInt alloc_count);
 internal void             msf_free_pages(MSF_Context *msf, MSF_PageList *page_list);
+internal void             msf_release_free_pages(MSF_Context *msf);
+internal void             msf_resize_page_list(MSF_Context *msf, MSF_PageList *page_list, MSF_UInt page_count, B32 zero_pages);
 
 internal MSF_StreamNumber msf_stream_alloc_ex(MSF_Context *msf, MSF_UInt size);
 internal MSF_StreamNumber msf_stream_alloc(MSF_Context *msf);
@@ -153,6 +163,7 @@ internal MSF_UInt         msf_stream_get_cap(MSF_Context *msf, MSF_StreamNumber)
 internal MSF_UInt         msf_stream_get_pos(MSF_Context *msf, MSF_StreamNumber sn);
 internal void             msf_stream_align(MSF_Context *msf, MSF_StreamNumber sn, MSF_UInt align);
 internal B32              msf_stream_reserve(MSF_Context *msf, MSF_StreamNumber sn, MSF_UInt size);
+internal B32              msf_stream_reserve_dirty(MSF_Context *msf, MSF_StreamNumber sn, MSF_UInt size);
 internal B32              msf_stream_seek(MSF_Context *msf, MSF_StreamNumber sn, MSF_UInt new_pos);
 internal B32              msf_stream_seek_start(MSF_Context *msf, MSF_StreamNumber sn);
 internal B32              msf_stream_seek_end(MSF_Context *msf, MSF_StreamNumber sn);
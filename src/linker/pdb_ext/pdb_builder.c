@@ -690,7 +690,7 @@ pdb_strtab_build(PDB_StringTable *strtab, MSF_Context *msf, MSF_StreamNumber sn)
                         + strtab->size
                         + sizeof(bucket_offset_arr[0]) * strtab->bucket_max
                         + sizeof(strtab->bucket_count);
-  msf_stream_reserve(msf, sn, reserve_size);
+  msf_stream_reserve_dirty(msf, sn, reserve_size);
 
   // write out string table
   msf_stream_write_struct(msf, sn, &header);
@@ -739,15 +739,14 @@ pdb_strtab_hash(PDB_StringTable *strtab, String8 string)
 }
 
 internal B32
-pdb_strtab_add_(PDB_StringTable *strtab, U64 hash, PDB_StringTableBucket *bucket)
+pdb_strtab_insert_bucket(PDB_StringTable *strtab, U64 hash, PDB_StringTableBucket *bucket)
 {
   U64 best_bucket_idx = hash;
   U64 bucket_idx      = best_bucket_idx;
   do {
     if (strtab->bucket_array[bucket_idx] == 0) {
-      strtab->ibucket_array[bucket->istr]  = bucket_idx;
-      strtab->bucket_array[bucket_idx]     = bucket;
-      strtab->size                        += bucket->data.size + /* null: */ 1;
+      strtab->ibucket_array[bucket->istr] = bucket_idx;
+      strtab->bucket_array[bucket_idx]    = bucket;
       return 1;
     }
     bucket_idx = (bucket_idx + 1) % strtab->bucket_max;
@@ -755,34 +754,204 @@ pdb_strtab_add_(PDB_StringTable *strtab, U64 hash, PDB_StringTableBucket *bucket
   return 0;
 }
 
+internal B32
+pdb_strtab_add_(PDB_StringTable *strtab, U64 hash, PDB_StringTableBucket *bucket)
+{
+  B32 was_added = pdb_strtab_insert_bucket(strtab, hash, bucket);
+  if (was_added) {
+    strtab->size += bucket->data.size + /* null: */ 1;
+  }
+  return was_added;
+}
+
+internal U64
+pdb_strtab_part_from_home(U32 *part_los, U64 part_count, U32 home)
+{
+  // homes before the first part belong to the last part, which wraps around
+  if (home < part_los[0]) {
+    return part_count - 1;
+  }
+  U64 lo = 0, hi = part_count;
+  while (hi - lo > 1) {
+    U64 mid = lo + (hi - lo) / 2;
+    if (part_los[mid] <= home) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+internal
+THREAD_POOL_TASK_FUNC(pdb_strtab_count_strings_task)
+{
+  PDB_StringTableInsertTask *task  = raw_task;
+  Rng1U64                    range = task->bucket_ranges[task_id];
+  for (U64 bucket_idx = range.min; bucket_idx < range.max; ++bucket_idx) {
+    if (task->string_ht.buckets[bucket_idx] != 0) {
+      task->counts[task_id] += 1;
+    }
+  }
+}
+
+internal
+THREAD_POOL_TASK_FUNC(pdb_strtab_hash_strings_task)
+{
+  PDB_StringTableInsertTask *task       = raw_task;
+  Rng1U64                    range      = task->bucket_ranges[task_id];
+  U64                        string_idx = task->offsets[task_id];
+  for (U64 bucket_idx = range.min; bucket_idx < range.max; ++bucket_idx) {
+    CV_StringBucket *src = task->string_ht.buckets[bucket_idx];
+    if (src != 0) {
+      PDB_StringTableBucket *dst = &task->buckets[string_idx];
+      dst->data                  = src->string;
+      dst->offset                = task->base_offset + src->u.offset;
+      dst->istr                  = task->base_istr + string_idx;
+
+      U32 home = pdb_strtab_hash(task->strtab, dst->data);
+      task->homes[string_idx] = home;
+      ins_atomic_u32_inc_eval(&task->home_counts[home]);
+
+      task->string_sizes[task_id] += dst->data.size + /* null: */ 1;
+      string_idx += 1;
+    }
+  }
+}
+
+internal
+THREAD_POOL_TASK_FUNC(pdb_strtab_count_parts_task)
+{
+  PDB_StringTableInsertTask *task   = raw_task;
+  Rng1U64                    range  = task->item_ranges[task_id];
+  U32                       *counts = task->part_cursors + task_id * task->part_count;
+  for (U64 item_idx = range.min; item_idx < range.max; ++item_idx) {
+    U64 part_idx = pdb_strtab_part_from_home(task->part_los, task->part_count, task->homes[item_idx]);
+    counts[part_idx] += 1;
+  }
+}
+
+internal
+THREAD_POOL_TASK_FUNC(pdb_strtab_scatter_parts_task)
+{
+  PDB_StringTableInsertTask *task    = raw_task;
+  Rng1U64                    range   = task->item_ranges[task_id];
+  U32                       *cursors = task->part_cursors + task_id * task->part_count;
+  for (U64 item_idx = range.min; item_idx < range.max; ++item_idx) {
+    U64 part_idx = pdb_strtab_part_from_home(task->part_los, task->part_count, task->homes[item_idx]);
+    task->part_items[cursors[part_idx]++] = item_idx;
+  }
+}
+
+internal
+THREAD_POOL_TASK_FUNC(pdb_strtab_insert_parts_task)
+{
+  PDB_StringTableInsertTask *task  = raw_task;
+  Rng1U64                    range = task->part_ranges[task_id];
+  for (U64 i = range.min; i < range.max; ++i) {
+    U32 item_idx  = task->part_items[i];
+    B32 was_added = pdb_strtab_insert_bucket(task->strtab, task->homes[item_idx], &task->buckets[item_idx]);
+    Assert(was_added);
+  }
+}
+
 internal void
-pdb_strtab_add_cv_string_hash_table(PDB_StringTable *strtab, CV_StringHashTable string_ht)
+pdb_strtab_add_cv_string_hash_table(TP_Context *tp, PDB_StringTable *strtab, CV_StringHashTable string_ht)
 {
   ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
 
   // reserve enough slots for new strings
   pdb_strtab_grow(strtab, string_ht.total_insert_count);
 
-  // upfront push buckets
-  PDB_StringTableBucket *buckets = push_array_no_zero(strtab->arena, PDB_StringTableBucket, string_ht.total_insert_count);
+  PDB_StringTableInsertTask task = {0};
+  task.strtab        = strtab;
+  task.string_ht     = string_ht;
+  task.base_offset   = strtab->size;
+  task.base_istr     = strtab->bucket_count;
+  task.bucket_ranges = tp_divide_work(scratch.arena, string_ht.bucket_cap, tp->worker_count);
+  task.counts        = push_array(scratch.arena, U64, tp->worker_count);
+  task.string_sizes  = push_array(scratch.arena, U64, tp->worker_count);
 
-  U64 base_offset = strtab->size;
+  ProfBegin("Count Strings");
+  tp_for_parallel(tp, 0, tp->worker_count, pdb_strtab_count_strings_task, &task);
+  ProfEnd();
 
-  // proceed to fill out buckets & add them to the string table
-  for (U64 bucket_idx = 0, string_idx = 0; bucket_idx < string_ht.bucket_cap; ++bucket_idx) {
-    if (string_ht.buckets[bucket_idx] != 0) {
-      PDB_StringTableBucket *dst = &buckets[string_idx++];
-      dst->data                  = string_ht.buckets[bucket_idx]->string;
-      dst->offset                = base_offset + string_ht.buckets[bucket_idx]->u.offset;
-      dst->istr                  = strtab->bucket_count++;
+  ProfBegin("Hash Strings");
+  U64 string_count = sum_array_u64(tp->worker_count, task.counts);
+  task.offsets     = offsets_from_counts_array_u64(scratch.arena, task.counts, tp->worker_count);
+  task.buckets     = push_array_no_zero(strtab->arena, PDB_StringTableBucket, string_count);
+  task.homes       = push_array_no_zero(scratch.arena, U32, string_count);
+  task.home_counts = push_array(scratch.arena, U32, strtab->bucket_max);
+  tp_for_parallel(tp, 0, tp->worker_count, pdb_strtab_hash_strings_task, &task);
+  ProfEnd();
 
-      // TODO: precompute hashes in parallel
-      U64 hash = pdb_strtab_hash(strtab, dst->data);
-      B32 was_added = pdb_strtab_add_(strtab, hash, dst);
-      Assert(was_added);
+  //
+  // Strings are inserted with linear probing in string index order. The set of
+  // occupied buckets doesn't depend on the insertion order, so we compute it
+  // upfront from the home counts and cut the table into parts at buckets that
+  // stay empty. No probe sequence crosses an empty bucket, so each part can be
+  // filled independently and the result matches serial insertion exactly.
+  //
+  ProfBegin("Partition Buckets");
+  {
+    U64 part_max = tp->worker_count * 4;
+    task.part_los = push_array_no_zero(scratch.arena, U32, part_max);
+
+    // carry out of the last bucket wraps around to the first bucket
+    U64 carry = 0;
+    for (U64 bucket_idx = 0; bucket_idx < strtab->bucket_max; ++bucket_idx) {
+      U64 occupancy = carry + task.home_counts[bucket_idx] + (strtab->bucket_array[bucket_idx] != 0);
+      carry = occupancy > 0 ? occupancy - 1 : 0;
     }
+
+    U64 next_part_lo = 0;
+    for (U64 bucket_idx = 0; bucket_idx < strtab->bucket_max && task.part_count < part_max; ++bucket_idx) {
+      U64 occupancy = carry + task.home_counts[bucket_idx] + (strtab->bucket_array[bucket_idx] != 0);
+      if (occupancy == 0 && bucket_idx >= next_part_lo) {
+        task.part_los[task.part_count++] = bucket_idx;
+        next_part_lo = (task.part_count * strtab->bucket_max) / part_max;
+      }
+      carry = occupancy > 0 ? occupancy - 1 : 0;
+    }
+
+    // table always has more buckets than strings
+    Assert(task.part_count > 0);
   }
+  ProfEnd();
 
+  ProfBegin("Sort Strings By Part");
+  {
+    task.item_ranges  = tp_divide_work(scratch.arena, string_count, tp->worker_count);
+    task.part_cursors = push_array(scratch.arena, U32, tp->worker_count * task.part_count);
+    task.part_ranges  = push_array_no_zero(scratch.arena, Rng1U64, task.part_count);
+    task.part_items   = push_array_no_zero(scratch.arena, U32, string_count);
+    tp_for_parallel(tp, 0, tp->worker_count, pdb_strtab_count_parts_task, &task);
+
+    // keep string index order within each part
+    U32 cursor = 0;
+    for (U64 part_idx = 0; part_idx < task.part_count; ++part_idx) {
+      task.part_ranges[part_idx].min = cursor;
+      for (U64 worker_idx = 0; worker_idx < tp->worker_count; ++worker_idx) {
+        U32 *count  = &task.part_cursors[worker_idx * task.part_count + part_idx];
+        U32  temp   = *count;
+        *count      = cursor;
+        cursor     += temp;
+      }
+      task.part_ranges[part_idx].max = cursor;
+    }
+
+    tp_for_parallel(tp, 0, tp->worker_count, pdb_strtab_scatter_parts_task, &task);
+  }
+  ProfEnd();
+
+  ProfBegin("Insert Strings");
+  tp_for_parallel(tp, 0, task.part_count, pdb_strtab_insert_parts_task, &task);
+  strtab->bucket_count += string_count;
+  strtab->size         += sum_array_u64(tp->worker_count, task.string_sizes);
+  ProfEnd();
+
+  scratch_end(scratch);
   ProfEnd();
 }
 
@@ -2151,11 +2320,11 @@ gsi_write_build_result(TP_Context         *tp,
   U64 gsi_size                   = sizeof(build.header) + hash_record_arr_size + bitmap_size + compressed_bucket_arr_size;
   
   ProfBeginV("Reserve %M for GSI hash table", gsi_size);
-  msf_stream_reserve(msf, gsi_sn, gsi_size);
+  msf_stream_reserve_dirty(msf, gsi_sn, gsi_size);
   ProfEnd();
 
   ProfBeginV("Reserve %M for symbols", build.symbol_data.size);
-  msf_stream_reserve(msf, symbols_sn, build.symbol_data.size);
+  msf_stream_reserve_dirty(msf, symbols_sn, build.symbol_data.size);
   ProfEnd();
 
   ProfBegin("Write GSI header");
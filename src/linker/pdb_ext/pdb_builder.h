@@ -61,6 +61,27 @@ typedef struct PDB_StringTable
   PDB_StringTableBucket **bucket_array;
 } PDB_StringTable;
 
+typedef struct
+{
+  PDB_StringTable       *strtab;
+  CV_StringHashTable     string_ht;
+  U64                    base_offset;
+  U64                    base_istr;
+  Rng1U64               *bucket_ranges;
+  U64                   *counts;
+  U64                   *offsets;
+  U64                   *string_sizes;
+  PDB_StringTableBucket *buckets;
+  U32                   *homes;
+  U32                   *home_counts;
+  Rng1U64               *item_ranges;
+  U64                    part_count;
+  U32                   *part_los;
+  U32                   *part_cursors;
+  Rng1U64               *part_ranges;
+  U32                   *part_items;
+} PDB_StringTableInsertTask;
+
 typedef enum
 {
   PDB_StringTableOpenError_OK,
@@ -462,6 +483,7 @@ internal U32                      pdb_strtab_get_serialized_size(PDB_StringTable
 internal B32                      pdb_strtab_try_add(PDB_StringTable *strtab, String8 string, PDB_StringIndex *index_out);
 internal void                     pdb_strtab_grow(PDB_StringTable *strtab, U64 new_max);
 internal U32                      pdb_strtab_hash(PDB_StringTable *strtab, String8 string);
+internal void                     pdb_strtab_add_cv_string_hash_table(TP_Context *tp, PDB_StringTable *strtab, CV_StringHashTable string_ht);
 
 ////////////////////////////////
 // Type Server
@@ -3291,138 +3291,140 @@ rdib_sort_procs_radix_32(RDIB_Procedure **v, U64 count)
   ProfEnd();
 }
 
-internal String8List
-rdib_data_from_vmap(Arena *arena, U64 range_count, RDIB_VMapRange *ranges)
+internal U64
+rdib_vmap_range_digit(RDIB_VMapRange *r, B32 is_size_digit, U64 digit_shift, U64 digit_bit_count)
 {
-  ProfBeginFunction();
-  Temp scratch = scratch_begin(&arena, 1);
-
-  const U64 size_bit_count0 = 8;
-  const U64 size_bit_count1 = 8;
-  const U64 size_bit_count2 = 16;
-
-  const U64 voff_bit_count0 = 11;
-  const U64 voff_bit_count1 = 11;
-  const U64 voff_bit_count2 = 10;
-
-  ProfBegin("Push shared buffer");
-  U64 radix_memory_size = sizeof(RDIB_VMapRange) * range_count +
-                          sizeof(U32) * ((1 << size_bit_count0) + (1 << size_bit_count1) + (1 << size_bit_count2)) +
-                          sizeof(U32) * ((1 << voff_bit_count0) + (1 << voff_bit_count1) + (1 << voff_bit_count2));
-  U8 *radix_memory      = push_array_no_zero(arena, U8, radix_memory_size);
-  ProfEnd();
-
-  // TODO: windows caps images at 4GiB so we use 32-bit radix sort, but on linux
-  // images can have > 4GiB and we need to detect when vmap uses upper 32bits
-  // in voffs do a 64-bit radix sort.
-  ProfBegin("Sort");
-  {
-    RDIB_VMapRange *src = ranges;
-    RDIB_VMapRange *dst = (RDIB_VMapRange *)radix_memory;
-
-    U32 *size_count0 = (U32 *)(dst + range_count);
-    U32 *size_count1 = size_count0 + (1 << size_bit_count0);
-    U32 *size_count2 = size_count1 + (1 << size_bit_count1);
-
-    U32 *voff_count0 = size_count2 + (1 << size_bit_count2);
-    U32 *voff_count1 = voff_count0 + (1 << voff_bit_count0);
-    U32 *voff_count2 = voff_count1 + (1 << voff_bit_count1);
-
-    //
-    // Build histogram
-    //
-
-    MemoryZeroTyped(size_count0, 1 << size_bit_count0);
-    MemoryZeroTyped(size_count1, 1 << size_bit_count1);
-    MemoryZeroTyped(size_count2, 1 << size_bit_count2);
-
-    MemoryZeroTyped(voff_count0, 1 << voff_bit_count0);
-    MemoryZeroTyped(voff_count1, 1 << voff_bit_count1);
-    MemoryZeroTyped(voff_count2, 1 << voff_bit_count2);
-
-    for (U64 i = 0; i < range_count; ++i) {
-      RDIB_VMapRange *r = src+i;
-
-      U32 size_digit0 = (-r->size >> 0)                                   % (1 << size_bit_count0);
-      U32 size_digit1 = (-r->size >> size_bit_count0)                     % (1 << size_bit_count1);
-      U32 size_digit2 = (-r->size >> (size_bit_count0 + size_bit_count1)) % (1 << size_bit_count2);
-
-      U64 voff_digit0 = (r->voff >> 0)                                   % (1 << voff_bit_count0);
-      U64 voff_digit1 = (r->voff >> voff_bit_count0)                     % (1 << voff_bit_count1);
-      U64 voff_digit2 = (r->voff >> (voff_bit_count0 + voff_bit_count1)) % (1 << voff_bit_count2);
-
-      ++size_count0[size_digit0];
-      ++size_count1[size_digit1];
-      ++size_count2[size_digit2];
-
-      ++voff_count0[voff_digit0];
-      ++voff_count1[voff_digit1];
-      ++voff_count2[voff_digit2];
-    }
-
-    counts_to_offsets_array_u32((1 << size_bit_count0), size_count0);
-    counts_to_offsets_array_u32((1 << size_bit_count1), size_count1);
-    counts_to_offsets_array_u32((1 << size_bit_count2), size_count2);
+  // sizes are sorted high to low, hence negation
+  U64 key   = is_size_digit ? (U64)(U32)(-r->size) : r->voff;
+  U64 digit = (key >> digit_shift) & ((1ull << digit_bit_count) - 1);
+  return digit;
+}
 
-    counts_to_offsets_array_u32((1 << voff_bit_count0), voff_count0);
-    counts_to_offsets_array_u32((1 << voff_bit_count1), voff_count1);
-    counts_to_offsets_array_u32((1 << voff_bit_count2), voff_count2);
+internal
+THREAD_POOL_TASK_FUNC(rdib_vmap_max_voff_task)
+{
+  RDIB_VMapRadixSort *task = raw_task;
+  U64 max_voff = 0;
+  for (U64 i = task->ranges[task_id].min; i < task->ranges[task_id].max; ++i) {
+    max_voff = Max(max_voff, task->src[i].voff);
+  }
+  task->max_voffs[task_id] = max_voff;
+}
 
-    //
-    // Sort on range size (high to low)
-    //
+internal
+THREAD_POOL_TASK_FUNC(rdib_vmap_radix_histo_task)
+{
+  RDIB_VMapRadixSort *task  = raw_task;
+  U32                *histo = task->histos[task_id];
+  MemoryZeroTyped(histo, 1 << task->digit_bit_count);
+  for (U64 i = task->ranges[task_id].min; i < task->ranges[task_id].max; ++i) {
+    U64 digit = rdib_vmap_range_digit(&task->src[i], task->is_size_digit, task->digit_shift, task->digit_bit_count);
+    ++histo[digit];
+  }
+}
 
-    for (U64 i = 0; i < range_count; ++i) {
-      RDIB_VMapRange r = src[i];
-      U32 digit = (-r.size >> 0) % (1 << size_bit_count0);
-      dst[size_count0[digit]++] = r;
-    }
+internal
+THREAD_POOL_TASK_FUNC(rdib_vmap_radix_scatter_task)
+{
+  RDIB_VMapRadixSort *task    = raw_task;
+  U32                *offsets = task->histos[task_id];
+  for (U64 i = task->ranges[task_id].min; i < task->ranges[task_id].max; ++i) {
+    U64 digit = rdib_vmap_range_digit(&task->src[i], task->is_size_digit, task->digit_shift, task->digit_bit_count);
+    task->dst[offsets[digit]++] = task->src[i];
+  }
+}
 
-    for (U64 i = 0; i < range_count; ++i) {
-      RDIB_VMapRange r = dst[i];
-      U32 digit = (-r.size >> size_bit_count0) % (1 << size_bit_count1);
-      src[size_count1[digit]++] = r;
-    }
+internal void
+rdib_vmap_sort(TP_Context *tp, U64 range_count, RDIB_VMapRange *ranges)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
 
-    for (U64 i = 0; i < range_count; ++i) {
-      RDIB_VMapRange r = src[i];
-      U32 digit = (-r.size >> (size_bit_count0 + size_bit_count1)) % (1 << size_bit_count2);
-      dst[size_count2[digit]++] = r;
-    }
+  const U64 max_digit_bit_count = 11;
+
+  RDIB_VMapRadixSort task = {0};
+  task.ranges    = tp_divide_work(scratch.arena, range_count, tp->worker_count);
+  task.histos    = push_array_no_zero(scratch.arena, U32 *, tp->worker_count);
+  task.max_voffs = push_array(scratch.arena, U64, tp->worker_count);
+  task.src       = ranges;
+  task.dst       = push_array_no_zero(scratch.arena, RDIB_VMapRange, range_count);
+  for (U64 worker_idx = 0; worker_idx < tp->worker_count; ++worker_idx) {
+    task.histos[worker_idx] = push_array_no_zero(scratch.arena, U32, 1 << max_digit_bit_count);
+  }
+
+  //
+  // Pick key width for voffs: windows caps images at 4GiB, so 32 bits are enough
+  // almost always, but on linux images can be larger and need all 64 bits.
+  //
+  ProfBegin("Max Voff");
+  tp_for_parallel(tp, 0, tp->worker_count, rdib_vmap_max_voff_task, &task);
+  U64 max_voff = 0;
+  for (U64 worker_idx = 0; worker_idx < tp->worker_count; ++worker_idx) {
+    max_voff = Max(max_voff, task.max_voffs[worker_idx]);
+  }
+  U64 voff_bit_count = max_voff > max_U32 ? 64 : 32;
+  ProfEnd();
+
+  //
+  // LSD radix sort on range size (high to low), then on range voff (low to high).
+  // Each worker scatters its own contiguous slice through its own offsets so
+  // passes stay stable.
+  //
+  U64 key_bit_counts[] = { 32, voff_bit_count };
+  for (U64 key_idx = 0; key_idx < ArrayCount(key_bit_counts); ++key_idx) {
+    U64 key_bit_count = key_bit_counts[key_idx];
+    U64 pass_count    = CeilIntegerDiv(key_bit_count, max_digit_bit_count);
+    U64 digit_shift   = 0;
+    for (U64 pass_idx = 0; pass_idx < pass_count; ++pass_idx) {
+      task.is_size_digit   = key_idx == 0;
+      task.digit_shift     = digit_shift;
+      task.digit_bit_count = key_bit_count / pass_count + (pass_idx < key_bit_count % pass_count);
+
+      ProfBegin("Histogram");
+      tp_for_parallel(tp, 0, tp->worker_count, rdib_vmap_radix_histo_task, &task);
+      ProfEnd();
 
-    //
-    // Sort on range voff (low to high)
-    //
+      ProfBegin("Offsets");
+      U32 cursor = 0;
+      for (U64 digit = 0; digit < (1 << task.digit_bit_count); ++digit) {
+        for (U64 worker_idx = 0; worker_idx < tp->worker_count; ++worker_idx) {
+          U32 count = task.histos[worker_idx][digit];
+          task.histos[worker_idx][digit] = cursor;
+          cursor += count;
+        }
+      }
+      ProfEnd();
 
-    for (U64 i = 0; i < range_count; ++i) {
-      RDIB_VMapRange r = dst[i];
-      U32 digit = (r.voff >> 0) % (1 << voff_bit_count0);
-      src[voff_count0[digit]++] = r;
-    }
+      ProfBegin("Scatter");
+      tp_for_parallel(tp, 0, tp->worker_count, rdib_vmap_radix_scatter_task, &task);
+      Swap(RDIB_VMapRange *, task.src, task.dst);
+      ProfEnd();
 
-    for (U64 i = 0; i < range_count; ++i) {
-      RDIB_VMapRange r = src[i];
-      U32 digit = (r.voff >> voff_bit_count0) % (1 << voff_bit_count1);
-      dst[voff_count1[digit]++] = r;
+      digit_shift += task.digit_bit_count;
     }
+  }
 
-    for (U64 i = 0; i < range_count; ++i) {
-      RDIB_VMapRange r = dst[i];
-      U32 digit = (r.voff >> (voff_bit_count0 + voff_bit_count1)) % (1 << voff_bit_count2);
-      src[voff_count2[digit]++] = r;
-    }
+  if (task.src != ranges) {
+    MemoryCopyTyped(ranges, task.src, range_count);
   }
+
+  scratch_end(scratch);
   ProfEnd();
+}
+
+internal String8List
+rdib_data_from_vmap(Arena *arena, U64 range_count, RDIB_VMapRange *ranges)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
 
   ProfBegin("Layout virtual map");
   String8List raw_vmap = {0};
   {
     U64            default_vme_cap = 4096;
-    U64            vme_block_cap   = radix_memory_size / sizeof(RDI_VMapEntry);
+    U64            vme_block_cap   = Max(default_vme_cap, range_count);
     U64            vme_block_size  = 0;
-    RDI_VMapEntry *vme_block       = (RDI_VMapEntry *)radix_memory;
-
-    // Recycle radix sort memory
+    RDI_VMapEntry *vme_block       = push_array_no_zero(arena, RDI_VMapEntry, vme_block_cap);
     str8_list_push(arena, &raw_vmap, str8_array(vme_block, vme_block_cap));
 
 #define push_vme() (vme_block_size < raw_vmap.last->string.size/sizeof(vme_block[0])) ? &vme_block[vme_block_size++] :    \
@@ -3657,6 +3659,12 @@ rdib_data_sections_from_unit_gvar_scope_vmaps(TP_Context           *tp,
   task.vmaps[1]       = gvar_vmaps;
   task.vmaps[2]       = scope_vmaps;
 
+  ProfBegin("Sort VMaps");
+  for (U64 vmap_idx = 0; vmap_idx < ArrayCount(task.vmaps); ++vmap_idx) {
+    rdib_vmap_sort(tp, task.vmap_counts[vmap_idx], task.vmaps[vmap_idx]);
+  }
+  ProfEnd();
+
   ProfBegin("Fill RDI VMaps");
   MemoryZeroArray(task.raw_vmaps);
   tp_for_parallel(tp, arena, 3, rdib_fill_scope_vmaps_task, &task);
@@ -5041,8 +5049,47 @@ rdib_init_input(Arena *arena)
   return input;
 }
 
-internal String8List
-rdib_finish(TP_Context *tp, TP_Arena *arena, RDIB_Input *input)
+internal void
+rdib_section_stream_flush(RDIB_SectionStream *stream, RDIB_DataSectionList *sections)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0,0);
+
+  // group section data on tag, each tag is serialized by exactly one pass
+  String8List raw_section_datas[RDI_SectionKind_COUNT] = {0};
+  for (RDIB_DataSectionNode *n = sections->first; n != 0; n = n->next) {
+    Assert(stream->sections[n->v.tag].off == 0);
+    str8_list_concat_in_place(&raw_section_datas[n->v.tag], &n->v.data);
+  }
+
+  // stream offset is kept 8-byte aligned so aligning relative to the batch aligns in the file
+  String8List data = {0};
+  U64         base = stream->off;
+  for (U64 sect_idx = 0; sect_idx < RDI_SectionKind_COUNT; ++sect_idx) {
+    if (raw_section_datas[sect_idx].total_size > 0) {
+      str8_list_push_aligner(scratch.arena, &data, 0, 8);
+
+      RDI_Section *dst   = &stream->sections[sect_idx];
+      dst->off           = base + data.total_size;
+      dst->encoded_size  = raw_section_datas[sect_idx].total_size;
+      dst->unpacked_size = raw_section_datas[sect_idx].total_size;
+
+      str8_list_concat_in_place(&data, &raw_section_datas[sect_idx]);
+    }
+  }
+
+  if (data.total_size > 0) {
+    str8_list_push_aligner(scratch.arena, &data, 0, 8);
+    stream->write_func(stream->write_ud, base, data);
+    stream->off += data.total_size;
+  }
+
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal U64
+rdib_finish(TP_Context *tp, TP_Arena *arena, RDIB_Input *input, RDIB_WriteFunc *write_func, void *write_ud)
 {
   ProfBeginFunction();
   Temp scratch = scratch_begin(arena->v, arena->count);
@@ -5517,81 +5564,68 @@ if (((RDIB_Type*)(t))->kind == RDI_TypeKindExt_VirtualTable) break; \
   }
   ProfEnd();
 
-  ProfBegin("Serialize Data Sections");
-  RDIB_DataSectionList sections = {0};
-  rdib_data_sections_from_top_level_info(arena->v[0], &sections, string_map, &input->top_level_info);
-  rdib_data_sections_from_binary_sections(arena->v[0], &sections, string_map, input->sections, input->sect_count);
-  rdib_data_sections_from_path_tree(tp, arena->v[0], &sections, string_map, path_tree);
-  rdib_data_sections_from_string_map(tp, arena->v[0], &sections, string_map_buckets, string_map_bucket_count);
-  rdib_data_sections_from_index_runs(tp, arena->v[0], &sections, idx_run_buckets, idx_run_bucket_count);
-  rdib_data_sections_from_name_maps(tp, arena, &sections, string_map, idx_run_map, name_map_buckets, name_map_bucket_counts);
-  rdib_data_sections_from_types(tp, arena->v[0], &sections, input->top_level_info.arch, string_map, idx_run_map, all_udt_member_types.count, all_udt_member_type_chunks, all_enum_member_types.count, all_enum_member_type_chunks, total_type_node_count, all_types.count, all_type_chunks, type_stats);
-  rdib_data_sections_from_line_tables(tp, arena, &sections, total_line_table_count, all_line_tables.count, all_line_table_chunks);
-  rdib_data_sections_from_source_line_maps(tp, arena, &sections, total_src_file_count, all_src_files.count, all_src_file_chunks);
-  rdib_data_sections_from_source_files(tp, arena, &sections, string_map, path_tree, total_src_file_count, all_src_files.count, all_src_file_chunks);
-  rdib_data_sections_from_units(arena->v[0], &sections, string_map, path_tree, total_unit_count, all_units.count, all_unit_chunks);
-  rdib_data_sections_from_global_variables(tp, arena, &sections, string_map, total_gvar_count, all_gvars.count, all_gvar_chunks);
-  rdib_data_sections_from_thread_variables(tp, arena, &sections, string_map, total_tvar_count, all_tvars.count, all_tvar_chunks);
-  rdib_data_sections_from_procedures(tp, arena, &sections, string_map, total_proc_count, all_procs.count, all_proc_chunks);
-  rdib_data_sections_from_scopes(tp, arena, &sections, string_map, total_scope_count, all_scopes.count, all_scope_chunks);
-  rdib_data_sections_from_unit_gvar_scope_vmaps(tp, arena, &sections, all_units.count, all_unit_chunks, all_gvars.count, all_gvar_chunks, all_scopes.count, all_scope_chunks);
-  rdib_data_sections_from_inline_sites(tp, arena->v[0], &sections, string_map, total_inline_site_count, all_inline_sites.count, all_inline_site_chunks);
-  //rdib_data_sections_from_checksums(tp, arena->v[0], &sections);
-  ProfEnd();
-
-  ProfBegin("Make RDI header and sections");
-  String8List rdi_data = {0};
-  {
-    // concat section datas
-    String8List raw_section_datas[RDI_SectionKind_COUNT] = {0};
-    for (RDIB_DataSectionNode *n = sections.first; n != 0; n = n->next) {
-      str8_list_concat_in_place(&raw_section_datas[n->v.tag], &n->v.data);
-    }
+  // data sections follow the header and section table
+  RDI_Header  *rdi_header   = push_array(scratch.arena, RDI_Header,  1);
+  RDI_Section *rdi_sections = push_array(scratch.arena, RDI_Section, RDI_SectionKind_COUNT);
+  for (U64 sect_idx = 0; sect_idx < RDI_SectionKind_COUNT; ++sect_idx) {
+    rdi_sections[sect_idx].encoding = RDI_SectionEncoding_Unpacked;
+  }
+
+  RDIB_SectionStream stream = {0};
+  stream.write_func         = write_func;
+  stream.write_ud           = write_ud;
+  stream.sections           = rdi_sections;
+  stream.off                = AlignPow2(sizeof(*rdi_header) + sizeof(rdi_sections[0]) * RDI_SectionKind_COUNT, 8);
 
-    RDI_Header  *rdi_header   = push_array(arena->v[0], RDI_Header,  1);
-    RDI_Section *rdi_sections = push_array(arena->v[0], RDI_Section, RDI_SectionKind_COUNT);
+  // each pass serializes into temp memory which is released right after its sections are written
+#define rdib_stream_sections(...) do {                   \
+    TP_Temp              temp__   = tp_temp_begin(arena); \
+    RDIB_DataSectionList sections = {0};                  \
+    __VA_ARGS__;                                          \
+    rdib_section_stream_flush(&stream, &sections);        \
+    tp_temp_end(temp__);                                  \
+  } while (0)
 
+  ProfBegin("Serialize Data Sections");
+  rdib_stream_sections(rdib_data_sections_from_top_level_info(arena->v[0], &sections, string_map, &input->top_level_info));
+  rdib_stream_sections(rdib_data_sections_from_binary_sections(arena->v[0], &sections, string_map, input->sections, input->sect_count));
+  rdib_stream_sections(rdib_data_sections_from_path_tree(tp, arena->v[0], &sections, string_map, path_tree));
+  rdib_stream_sections(rdib_data_sections_from_string_map(tp, arena->v[0], &sections, string_map_buckets, string_map_bucket_count));
+  rdib_stream_sections(rdib_data_sections_from_index_runs(tp, arena->v[0], &sections, idx_run_buckets, idx_run_bucket_count));
+  rdib_stream_sections(rdib_data_sections_from_name_maps(tp, arena, &sections, string_map, idx_run_map, name_map_buckets, name_map_bucket_counts));
+  rdib_stream_sections(rdib_data_sections_from_types(tp, arena->v[0], &sections, input->top_level_info.arch, string_map, idx_run_map, all_udt_member_types.count, all_udt_member_type_chunks, all_enum_member_types.count, all_enum_member_type_chunks, total_type_node_count, all_types.count, all_type_chunks, type_stats));
+  rdib_stream_sections(rdib_data_sections_from_line_tables(tp, arena, &sections, total_line_table_count, all_line_tables.count, all_line_table_chunks));
+  rdib_stream_sections(rdib_data_sections_from_source_line_maps(tp, arena, &sections, total_src_file_count, all_src_files.count, all_src_file_chunks));
+  rdib_stream_sections(rdib_data_sections_from_source_files(tp, arena, &sections, string_map, path_tree, total_src_file_count, all_src_files.count, all_src_file_chunks));
+  rdib_stream_sections(rdib_data_sections_from_units(arena->v[0], &sections, string_map, path_tree, total_unit_count, all_units.count, all_unit_chunks));
+  rdib_stream_sections(rdib_data_sections_from_global_variables(tp, arena, &sections, string_map, total_gvar_count, all_gvars.count, all_gvar_chunks));
+  rdib_stream_sections(rdib_data_sections_from_thread_variables(tp, arena, &sections, string_map, total_tvar_count, all_tvars.count, all_tvar_chunks));
+  rdib_stream_sections(rdib_data_sections_from_procedures(tp, arena, &sections, string_map, total_proc_count, all_procs.count, all_proc_chunks));
+  rdib_stream_sections(rdib_data_sections_from_scopes(tp, arena, &sections, string_map, total_scope_count, all_scopes.count, all_scope_chunks));
+  rdib_stream_sections(rdib_data_sections_from_unit_gvar_scope_vmaps(tp, arena, &sections, all_units.count, all_unit_chunks, all_gvars.count, all_gvar_chunks, all_scopes.count, all_scope_chunks));
+  rdib_stream_sections(rdib_data_sections_from_inline_sites(tp, arena->v[0], &sections, string_map, total_inline_site_count, all_inline_sites.count, all_inline_site_chunks));
+  //rdib_stream_sections(rdib_data_sections_from_checksums(tp, arena->v[0], &sections));
+  ProfEnd();
+#undef rdib_stream_sections
+
+  ProfBegin("Write RDI header and sections");
+  {
     rdi_header->magic              = RDI_MAGIC_CONSTANT;
     rdi_header->encoding_version   = RDI_ENCODING_VERSION;
     rdi_header->data_section_off   = sizeof(*rdi_header);
     rdi_header->data_section_count = RDI_SectionKind_COUNT;
 
-    str8_list_push(arena->v[0], &rdi_data, str8_struct(rdi_header));
-    str8_list_push(arena->v[0], &rdi_data, str8_array(rdi_sections, RDI_SectionKind_COUNT));
-
-    for (U64 sect_idx = 0; sect_idx < RDI_SectionKind_COUNT; ++sect_idx) {
-      RDI_Section *dst   = &rdi_sections[sect_idx];
-      dst->encoding      = RDI_SectionEncoding_Unpacked;
-      dst->pad           = 0;
-      dst->off           = 0;
-      dst->encoded_size  = 0;
-      dst->unpacked_size = 0;
-
-      if (raw_section_datas[sect_idx].total_size > 0) {
-        str8_list_push_aligner(arena->v[0], &rdi_data, 0, 8);
-
-        dst->off           = rdi_data.total_size;
-        dst->encoded_size  = raw_section_datas[sect_idx].total_size;
-        dst->unpacked_size = raw_section_datas[sect_idx].total_size;
-
-        str8_list_concat_in_place(&rdi_data, &raw_section_datas[sect_idx]);
-
-#if BUILD_DEBUG
-        {
-          U64 expected_total_size = 0;
-          for (String8Node *n = rdi_data.first; n != 0; n = n->next) {
-            expected_total_size += n->string.size;
-          }
-          Assert(expected_total_size == rdi_data.total_size);
-        }
-#endif
-      }
-    }
+    String8List header_data = {0};
+    str8_list_push(scratch.arena, &header_data, str8_struct(rdi_header));
+    str8_list_push(scratch.arena, &header_data, str8_array(rdi_sections, RDI_SectionKind_COUNT));
+    write_func(write_ud, 0, header_data);
   }
   ProfEnd();
 
+  U64 rdi_size = stream.off;
+
   scratch_end(scratch);
   ProfEnd();
-  return rdi_data;
+  return rdi_size;
 }
 
@@ -466,6 +466,18 @@ typedef struct RDIB_DataSectionList
   RDIB_DataSectionNode *last;
 } RDIB_DataSectionList;
 
+#define RDIB_WRITE_FUNC(name) void name(void *ud, U64 off, String8List data)
+typedef RDIB_WRITE_FUNC(RDIB_WriteFunc);
+
+// Sections are handed to the write callback as soon as they are serialized,
+// the header and section table are written last at offset zero.
+typedef struct RDIB_SectionStream
+{
+  RDIB_WriteFunc *write_func;
+  void           *write_ud;
+  RDI_Section    *sections;
+  U64             off;
+} RDIB_SectionStream;
 
 typedef struct RDIB_UnitChunk
 {
@@ -933,6 +945,18 @@ typedef union
   };
 } RDIB_VMapBuilderTask;
 
+typedef struct
+{
+  Rng1U64        *ranges;
+  RDIB_VMapRange *src;
+  RDIB_VMapRange *dst;
+  U32           **histos;
+  U64            *max_voffs;
+  B32             is_size_digit;
+  U64             digit_shift;
+  U64             digit_bit_count;
+} RDIB_VMapRadixSort;
+
 typedef struct
 {
   U64                   sorter_idx;
@@ -1239,5 +1263,6 @@ internal void rdib_data_sections_from_inline_sites         (TP_Context *tp, Aren
 internal void rdib_data_sections_from_checksums            (TP_Context *tp, Arena *arena, RDIB_DataSectionList *sect_list);
 
 internal RDIB_Input  rdib_init_input(Arena *arena);
-internal String8List rdib_finish(TP_Context *tp, TP_Arena *arena, RDIB_Input *input);
+internal void        rdib_section_stream_flush(RDIB_SectionStream *stream, RDIB_DataSectionList *sections);
+internal U64         rdib_finish(TP_Context *tp, TP_Arena *arena, RDIB_Input *input, RDIB_WriteFunc *write_func, void *write_ud);
 
@@ -81,13 +81,14 @@ tp_alloc(Arena *arena, U32 worker_count, U32 max_worker_count, String8 name)
   void *worker_entry = is_shared ? tp_worker_main_shared : tp_worker_main;
 
   // init pool
-  TP_Context *pool     = push_array(arena, TP_Context, 1);
-  pool->exec_semaphore = exec_semaphore;
-  pool->task_semaphore = task_semaphore;
-  pool->main_semaphore = main_semaphore;
-  pool->is_live        = 1;
-  pool->worker_count   = worker_count;
-  pool->worker_arr     = push_array(arena, TP_Worker, worker_count);
+  TP_Context *pool          = push_array(arena, TP_Context, 1);
+  pool->exec_semaphore      = exec_semaphore;
+  pool->task_semaphore      = task_semaphore;
+  pool->main_semaphore      = main_semaphore;
+  pool->is_live             = 1;
+  pool->worker_count        = worker_count;
+  pool->active_worker_count = worker_count;
+  pool->worker_arr          = push_array(arena, TP_Worker, worker_count);
   
   // init worker data
   for (U64 i = 0; i < worker_count; i += 1) {
@@ -132,6 +133,12 @@ tp_release(TP_Context *pool)
   MemoryZeroStruct(pool);
 }
 
+internal void
+tp_set_active_worker_count(TP_Context *pool, U32 active_worker_count)
+{
+  pool->active_worker_count = Clamp(1, active_worker_count, pool->worker_count);
+}
+
 internal TP_Arena *
 tp_arena_alloc(TP_Context *pool)
 {
@@ -206,7 +213,7 @@ tp_for_parallel(TP_Context *pool, TP_Arena *task_arena, U64 task_count, TP_TaskF
     pool->task_done  = 0;
     ins_atomic_u64_eval_assign(&pool->task_left, task_count);
 
-    U64 drop_count = Min(task_count, pool->worker_count);
+    U64 drop_count = Min(task_count, pool->active_worker_count);
 
     // if we are in shared mode ping local semaphore
     if (pool->exec_semaphore.u64[0] != 0) {
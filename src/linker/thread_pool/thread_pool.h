@@ -33,6 +33,7 @@ typedef struct TP_Context
   Semaphore    main_semaphore;
 
   U32          worker_count;
+  U32          active_worker_count; // workers woken up per run, rest stay parked
   TP_Worker   *worker_arr;
 
   TP_Arena    *task_arena;
@@ -45,6 +46,7 @@ typedef struct TP_Context
 
 internal TP_Context * tp_alloc(Arena *arena, U32 worker_count, U32 max_worker_count, String8 name);
 internal void         tp_release(TP_Context *pool);
+internal void         tp_set_active_worker_count(TP_Context *pool, U32 active_worker_count);
 internal TP_Arena *   tp_arena_alloc(TP_Context *pool);
 internal void         tp_arena_release(TP_Arena **arena_ptr);
 internal TP_Temp      tp_temp_begin(TP_Arena *arena);
@@ -204,6 +204,17 @@ os_release(void *ptr, U64 size)
   munmap(ptr, size);
 }
 
+internal B32
+os_protect(void *ptr, U64 size, OS_AccessFlags flags)
+{
+  int prot = PROT_NONE;
+  if(flags & OS_AccessFlag_Read)    {prot |= PROT_READ;}
+  if(flags & OS_AccessFlag_Write)   {prot |= PROT_WRITE;}
+  if(flags & OS_AccessFlag_Execute) {prot |= PROT_EXEC;}
+  B32 result = (mprotect(ptr, size, prot) == 0);
+  return result;
+}
+
 //- rjf: large pages
 
 internal void *
@@ -455,6 +466,13 @@ os_move_file_path(String8 dst, String8 src)
   return good;
 }
 
+internal B32
+os_replace_file_path(String8 dst, String8 src)
+{
+  // NOTE: rename already replaces an existing destination atomically
+  return os_move_file_path(dst, src);
+}
+
 internal String8
 os_full_path_from_path(Arena *arena, String8 path)
 {
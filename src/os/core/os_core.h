@@ -170,6 +170,7 @@ internal void *os_reserve(U64 size);
 internal B32   os_commit(void *ptr, U64 size);
 internal void  os_decommit(void *ptr, U64 size);
 internal void  os_release(void *ptr, U64 size);
+internal B32   os_protect(void *ptr, U64 size, OS_AccessFlags flags);
 
 //- rjf: large pages
 internal void *os_reserve_large(U64 size);
@@ -202,6 +203,7 @@ internal B32            os_file_reserve_size(OS_Handle file, U64 size);
 internal B32            os_delete_file_at_path(String8 path);
 internal B32            os_copy_file_path(String8 dst, String8 src);
 internal B32            os_move_file_path(String8 dst, String8 src);
+internal B32            os_replace_file_path(String8 dst, String8 src);
 internal String8        os_full_path_from_path(Arena *arena, String8 path);
 internal B32            os_file_path_exists(String8 path);
 internal B32            os_folder_path_exists(String8 path);
@@ -225,6 +225,34 @@ os_release(void *ptr, U64 size)
   VirtualFree(ptr, 0, MEM_RELEASE);
 }
 
+internal B32
+os_protect(void *ptr, U64 size, OS_AccessFlags flags)
+{
+  DWORD protect_flags = PAGE_NOACCESS;
+  switch(flags & (OS_AccessFlag_Read|OS_AccessFlag_Write|OS_AccessFlag_Execute))
+  {
+    default:{}break;
+    case OS_AccessFlag_Read:
+    {protect_flags = PAGE_READONLY;}break;
+    case OS_AccessFlag_Write:
+    case OS_AccessFlag_Read|OS_AccessFlag_Write:
+    {protect_flags = PAGE_READWRITE;}break;
+    case OS_AccessFlag_Execute:
+    case OS_AccessFlag_Read|OS_AccessFlag_Execute:
+    {protect_flags = PAGE_EXECUTE_READ;}break;
+    case OS_AccessFlag_Execute|OS_AccessFlag_Write|OS_AccessFlag_Read:
+    case OS_AccessFlag_Execute|OS_AccessFlag_Write:
+    {protect_flags = PAGE_EXECUTE_READWRITE;}break;
+  }
+  DWORD old_protect_flags = 0;
+  B32 result = !!VirtualProtect(ptr, size, protect_flags, &old_protect_flags);
+  if(result && (flags & OS_AccessFlag_Execute))
+  {
+    FlushInstructionCache(GetCurrentProcess(), ptr, size);
+  }
+  return result;
+}
+
 //- rjf: large pages
 
 internal void *
@@ -513,6 +541,17 @@ os_move_file_path(String8 dst, String8 src)
   return result;
 }
 
+internal B32
+os_replace_file_path(String8 dst, String8 src)
+{
+  Temp scratch = scratch_begin(0, 0);
+  String16 dst16 = str16_from_8(scratch.arena, dst);
+  String16 src16 = str16_from_8(scratch.arena, src);
+  B32 result = MoveFileExW((WCHAR*)src16.str, (WCHAR*)dst16.str, MOVEFILE_REPLACE_EXISTING);
+  scratch_end(scratch);
+  return result;
+}
+
 internal String8
 os_full_path_from_path(Arena *arena, String8 path)
 {
@@ -6,6 +6,736 @@
 
 #include "radbin/generated/radbin.meta.c"
 
+////////////////////////////////
+//~ Input File Functions
+
+internal void
+rb_file_load(Arena *arena, RB_File *file)
+{
+  //- try to map the file read-only - pages are then shared with the page
+  // cache, and only touched as the converters read them
+  OS_Handle handle = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, file->path);
+  FileProperties props = os_properties_from_file(handle);
+  OS_Handle map = {0};
+  void *base = 0;
+  if(!os_handle_match(handle, os_handle_zero()) && props.size != 0)
+  {
+    map = os_file_map_open(OS_AccessFlag_Read, handle);
+    if(!os_handle_match(map, os_handle_zero()))
+    {
+      base = os_file_map_view_open(map, OS_AccessFlag_Read, r1u64(0, props.size));
+    }
+  }
+  
+  //- mapped -> keep handles until unload
+  if(base != 0)
+  {
+    file->file      = handle;
+    file->file_map  = map;
+    file->is_mapped = 1;
+    file->data      = str8((U8 *)base, props.size);
+  }
+  
+  //- not mappable (e.g. pipes, empty files) -> fall back to reading
+  else
+  {
+    if(!os_handle_match(map, os_handle_zero()))
+    {
+      os_file_map_close(map);
+    }
+    if(!os_handle_match(handle, os_handle_zero()))
+    {
+      os_file_close(handle);
+    }
+    file->data = os_data_from_file_path(arena, file->path);
+  }
+}
+
+internal void
+rb_file_unload(RB_File *file)
+{
+  if(file->is_mapped)
+  {
+    os_file_map_view_close(file->file_map, file->data.str, r1u64(0, file->data.size));
+    os_file_map_close(file->file_map);
+    os_file_close(file->file);
+    file->is_mapped = 0;
+    file->data = str8_zero();
+  }
+}
+
+////////////////////////////////
+//~ Output Stream Functions
+
+internal void
+rb_output_stream_open(RB_OutputStream *stream, String8 path)
+{
+  MemoryZeroStruct(stream);
+  stream->is_stdout = (path.size == 0);
+  if(!stream->is_stdout)
+  {
+    stream->file = os_file_open(OS_AccessFlag_Write, path);
+    if(os_handle_match(stream->file, os_handle_zero()))
+    {
+      log_user_errorf("Could not open %S for writing\n", path);
+    }
+  }
+}
+
+internal void
+rb_output_stream_close(RB_OutputStream *stream)
+{
+  if(stream->is_stdout)
+  {
+    fflush(stdout);
+  }
+  else if(!os_handle_match(stream->file, os_handle_zero()))
+  {
+    os_file_close(stream->file);
+  }
+  MemoryZeroStruct(stream);
+}
+
+internal void
+rb_output_stream_write(RB_OutputStream *stream, String8 data)
+{
+  if(stream->is_stdout)
+  {
+    for(U64 off = 0; off < data.size;)
+    {
+      U64 size_to_write = Min(data.size - off, GB(2));
+      fwrite(data.str + off, size_to_write, 1, stdout);
+      off += size_to_write;
+    }
+  }
+  else if(!os_handle_match(stream->file, os_handle_zero()))
+  {
+    stream->off += os_file_write(stream->file, r1u64(stream->off, stream->off + data.size), data.str);
+  }
+}
+
+internal void
+rb_output_stream_write_list(RB_OutputStream *stream, String8List list)
+{
+  for(String8Node *n = list.first; n != 0; n = n->next)
+  {
+    rb_output_stream_write(stream, n->string);
+  }
+}
+
+internal void
+rb_output_stream_write_rdi_dump(void *user_data, String8 string)
+{
+  rb_output_stream_write((RB_OutputStream *)user_data, string);
+}
+
+////////////////////////////////
+//~ Breakpad Generation Functions
+
+internal U64
+rb_breakpad_scope_vmap_opl_from_voff(RDI_VMapEntry *vmap, U64 vmap_count, U64 voff)
+{
+  U64 result = max_U64;
+  if(vmap_count != 0 && voff < vmap[0].voff)
+  {
+    result = vmap[0].voff;
+  }
+  else if(vmap_count != 0)
+  {
+    U64 lo = 0;
+    U64 hi = vmap_count;
+    for(;hi - lo > 1;)
+    {
+      U64 mid = (lo + hi)/2;
+      if(vmap[mid].voff <= voff)
+      {
+        lo = mid;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    if(lo+1 < vmap_count)
+    {
+      result = vmap[lo+1].voff;
+    }
+  }
+  return result;
+}
+
+internal RDI_LineTable *
+rb_breakpad_line_table_from_scope(RDI_Parsed *rdi, RDI_Scope *scope, U64 voff)
+{
+  // NOTE: the lines of a frame come from the innermost enclosing inline
+  // site which has its own line table - failing that, from the unit's.
+  RDI_Scope *nil_scope = rdi_element_from_name_idx(rdi, Scopes, 0);
+  RDI_LineTable *result = 0;
+  U64 depth = 0;
+  for(RDI_Scope *s = scope;
+      s != nil_scope && depth < RB_MAX_INLINE_DEPTH;
+      s = rdi_parent_from_scope(rdi, s), depth += 1)
+  {
+    if(s->inline_site_idx != 0)
+    {
+      RDI_InlineSite *inline_site = rdi_inline_site_from_scope(rdi, s);
+      if(inline_site->line_table_idx != 0)
+      {
+        result = rdi_element_from_name_idx(rdi, LineTables, inline_site->line_table_idx);
+        break;
+      }
+    }
+  }
+  if(result == 0)
+  {
+    result = rdi_line_table_from_unit(rdi, rdi_unit_from_voff(rdi, voff));
+  }
+  return result;
+}
+
+internal void
+rb_breakpad_push_func(Arena *arena, String8List *out, RDI_Parsed *rdi, RDI_Procedure *procedure)
+{
+  //- unpack procedure range
+  // NOTE(rjf): breakpad does not support multiple voff ranges per procedure.
+  RDI_Scope *root_scope = rdi_root_scope_from_procedure(rdi, procedure);
+  U64 scope_voffs_count = 0;
+  U64 *scope_voffs = rdi_table_from_name(rdi, ScopeVOffData, &scope_voffs_count);
+  if(root_scope->voff_range_first+2 > root_scope->voff_range_opl ||
+     root_scope->voff_range_opl > scope_voffs_count)
+  {
+    return;
+  }
+  Rng1U64 voff_range = r1u64(scope_voffs[root_scope->voff_range_first], scope_voffs[root_scope->voff_range_first+1]);
+  if(voff_range.min >= voff_range.max)
+  {
+    return;
+  }
+  
+  //- dump function record
+  String8 name = {0};
+  name.str = rdi_name_from_procedure(rdi, procedure, &name.size);
+  str8_list_pushf(arena, out, "FUNC %I64x %I64x %I64x %S\n", voff_range.min, voff_range.max-voff_range.min, 0ull, name);
+  
+  //- dump INLINE records, by walking the procedure's scope tree
+  RDI_Scope *nil_scope = rdi_element_from_name_idx(rdi, Scopes, 0);
+  for(RDI_Scope *scope = root_scope, *rec_next = nil_scope; scope != nil_scope; scope = rec_next)
+  {
+    if(scope->inline_site_idx != 0)
+    {
+      Temp scratch = scratch_begin(&arena, 1);
+      
+      // gather this scope's ranges, clamped to the function's
+      String8List ranges = {0};
+      U64 first_voff = max_U64;
+      U64 range_lo = ClampTop(scope->voff_range_first, scope_voffs_count);
+      U64 range_hi = ClampTop(scope->voff_range_opl, scope_voffs_count);
+      for(U64 idx = range_lo; idx+2 <= range_hi; idx += 2)
+      {
+        Rng1U64 range = intersect_1u64(voff_range, r1u64(scope_voffs[idx], scope_voffs[idx+1]));
+        if(range.min < range.max)
+        {
+          str8_list_pushf(scratch.arena, &ranges, " %I64x %I64x", range.min, range.max-range.min);
+          first_voff = Min(first_voff, range.min);
+        }
+      }
+      
+      // inline depth = number of enclosing inline sites
+      U64 inline_depth = 0;
+      RDI_Scope *parent = rdi_parent_from_scope(rdi, scope);
+      {
+        U64 depth = 0;
+        for(RDI_Scope *s = parent;
+            s != nil_scope && depth < RB_MAX_INLINE_DEPTH;
+            s = rdi_parent_from_scope(rdi, s), depth += 1)
+        {
+          inline_depth += (s->inline_site_idx != 0);
+        }
+      }
+      
+      // call site = line of the parent frame at the inlined code's start
+      if(ranges.node_count != 0)
+      {
+        RDI_LineTable *call_site_line_table = rb_breakpad_line_table_from_scope(rdi, parent, first_voff);
+        RDI_Line call_site_line = rdi_line_from_line_table_voff(rdi, call_site_line_table, first_voff);
+        String8 ranges_string = str8_list_join(scratch.arena, &ranges, 0);
+        str8_list_pushf(arena, out, "INLINE %I64u %I64u %I64u %I64u%S\n",
+                        inline_depth,
+                        (U64)call_site_line.line_num,
+                        (U64)call_site_line.file_idx,
+                        (U64)scope->inline_site_idx,
+                        ranges_string);
+      }
+      scratch_end(scratch);
+    }
+    
+    // get next recursion
+    rec_next = nil_scope;
+    if(scope->first_child_scope_idx != 0)
+    {
+      rec_next = rdi_element_from_name_idx(rdi, Scopes, scope->first_child_scope_idx);
+    }
+    else for(RDI_Scope *p = scope; p != nil_scope && p != root_scope; p = rdi_parent_from_scope(rdi, p))
+    {
+      if(p->next_sibling_scope_idx != 0)
+      {
+        rec_next = rdi_element_from_name_idx(rdi, Scopes, p->next_sibling_scope_idx);
+        break;
+      }
+    }
+  }
+  
+  //- dump line records, from the innermost frame's line table at each
+  // voff; split at line & scope boundaries, merge adjacent equal lines
+  U64 scope_vmap_count = 0;
+  RDI_VMapEntry *scope_vmap = rdi_table_from_name(rdi, ScopeVMap, &scope_vmap_count);
+  Rng1U64 pending_range = {0};
+  RDI_Line pending_line = {0};
+  for(U64 voff = voff_range.min; voff < voff_range.max;)
+  {
+    RDI_Scope *scope = rdi_scope_from_voff(rdi, voff);
+    RDI_LineTable *line_table = rb_breakpad_line_table_from_scope(rdi, scope, voff);
+    RDI_ParsedLineTable line_info = {0};
+    rdi_parsed_from_line_table(rdi, line_table, &line_info);
+    U64 segment_opl = Min(voff_range.max, rb_breakpad_scope_vmap_opl_from_voff(scope_vmap, scope_vmap_count, voff));
+    U64 line_info_idx = rdi_line_info_idx_from_voff(&line_info, voff);
+    if(line_info_idx < line_info.count)
+    {
+      RDI_Line *line = &line_info.lines[line_info_idx];
+      segment_opl = Min(segment_opl, line_info.voffs[line_info_idx+1]);
+      if(pending_range.max == voff && pending_line.file_idx == line->file_idx && pending_line.line_num == line->line_num)
+      {
+        pending_range.max = segment_opl;
+      }
+      else
+      {
+        if(pending_line.file_idx != 0 && pending_range.min < pending_range.max)
+        {
+          str8_list_pushf(arena, out, "%I64x %I64x %I64u %I64u\n", pending_range.min, pending_range.max-pending_range.min, (U64)pending_line.line_num, (U64)pending_line.file_idx);
+        }
+        pending_range = r1u64(voff, segment_opl);
+        pending_line = *line;
+      }
+    }
+    if(segment_opl <= voff)
+    {
+      break;
+    }
+    voff = segment_opl;
+  }
+  if(pending_line.file_idx != 0 && pending_range.min < pending_range.max)
+  {
+    str8_list_pushf(arena, out, "%I64x %I64x %I64u %I64u\n", pending_range.min, pending_range.max-pending_range.min, (U64)pending_line.line_num, (U64)pending_line.file_idx);
+  }
+}
+
+internal String8List
+rb_breakpad_dump_from_rdi(Arena *arena, RDI_Parsed *rdi, String8 os_name)
+{
+  //- rjf: set up shared state
+  typedef struct RB_BreakpadShared RB_BreakpadShared;
+  struct RB_BreakpadShared
+  {
+    String8List dump;
+    String8List *lane_file_dumps;
+    String8List *lane_inline_origin_dumps;
+    String8List *lane_func_dumps;
+  };
+  local_persist RB_BreakpadShared *shared = 0;
+  if(lane_idx() == 0)
+  {
+    shared = push_array(arena, RB_BreakpadShared, 1);
+    shared->lane_file_dumps          = push_array(arena, String8List, lane_count());
+    shared->lane_inline_origin_dumps = push_array(arena, String8List, lane_count());
+    shared->lane_func_dumps          = push_array(arena, String8List, lane_count());
+  }
+  lane_sync();
+  
+  //- rjf: dump MODULE record
+  if(lane_idx() == 0)
+  {
+    RDI_TopLevelInfo *tli = rdi_element_from_name_idx(rdi, TopLevelInfo, 0);
+    String8 arch_name = str8_lit("unknown");
+    switch(tli->arch)
+    {
+      default:{}break;
+      case RDI_Arch_X86:{arch_name = str8_lit("x86");}break;
+      case RDI_Arch_X64:{arch_name = str8_lit("x86_64");}break;
+    }
+    String8 exe_name = {0};
+    exe_name.str = rdi_string_from_idx(rdi, tli->exe_name_string_idx, &exe_name.size);
+    str8_list_pushf(arena, &shared->dump, "MODULE %S %S %I64x %S\n", os_name, arch_name, tli->exe_hash, exe_name);
+  }
+  
+  //- rjf: dump FILE records
+  ProfScope("dump FILE records")
+  {
+    U64 count = 0;
+    RDI_SourceFile *v = rdi_table_from_name(rdi, SourceFiles, &count);
+    Rng1U64 range = lane_range(count);
+    for EachInRange(idx, range)
+    {
+      if(idx == 0) { continue; }
+      String8 src_path = {0};
+      src_path.str = rdi_string_from_idx(rdi, v[idx].normal_full_path_string_idx, &src_path.size);
+      str8_list_pushf(arena, &shared->lane_file_dumps[lane_idx()], "FILE %I64u %S\n", idx, src_path);
+    }
+  }
+  
+  //- dump INLINE_ORIGIN records
+  ProfScope("dump INLINE_ORIGIN records")
+  {
+    U64 count = 0;
+    RDI_InlineSite *v = rdi_table_from_name(rdi, InlineSites, &count);
+    Rng1U64 range = lane_range(count);
+    for EachInRange(idx, range)
+    {
+      if(idx == 0) { continue; }
+      String8 name = {0};
+      name.str = rdi_string_from_idx(rdi, v[idx].name_string_idx, &name.size);
+      str8_list_pushf(arena, &shared->lane_inline_origin_dumps[lane_idx()], "INLINE_ORIGIN %I64u %S\n", idx, name);
+    }
+  }
+  
+  //- rjf: dump FUNC records
+  ProfScope("dump FUNC records")
+  {
+    U64 count = 0;
+    RDI_Procedure *v = rdi_table_from_name(rdi, Procedures, &count);
+    Rng1U64 range = lane_range(count);
+    for EachInRange(idx, range)
+    {
+      if(idx == 0) { continue; }
+      rb_breakpad_push_func(arena, &shared->lane_func_dumps[lane_idx()], rdi, &v[idx]);
+    }
+  }
+  
+  //- rjf: join
+  lane_sync();
+  if(lane_idx() == 0)
+  {
+    for EachIndex(l_idx, lane_count())
+    {
+      str8_list_concat_in_place(&shared->dump, &shared->lane_file_dumps[l_idx]);
+    }
+    for EachIndex(l_idx, lane_count())
+    {
+      str8_list_concat_in_place(&shared->dump, &shared->lane_inline_origin_dumps[l_idx]);
+    }
+    for EachIndex(l_idx, lane_count())
+    {
+      str8_list_concat_in_place(&shared->dump, &shared->lane_func_dumps[l_idx]);
+    }
+  }
+  lane_sync();
+  String8List result = shared->dump;
+  lane_sync();
+  return result;
+}
+
+////////////////////////////////
+//~ Symbolication Functions
+
+internal U64
+rb_sym_line_start_from_off(String8 text, U64 off)
+{
+  U64 result = off;
+  if(0 < result && result < text.size && text.str[result-1] != '\n')
+  {
+    for(;result < text.size && text.str[result-1] != '\n'; result += 1);
+  }
+  result = Min(result, text.size);
+  return result;
+}
+
+internal RB_SymRecord
+rb_sym_record_from_line(String8 line)
+{
+  RB_SymRecord record = {0};
+  record.line = str8_skip_chop_whitespace(line);
+  if(record.line.size != 0 && record.line.str[0] != '#')
+  {
+    // NOTE: the voff is the last token on the line - everything before it
+    // is the module, so module paths may contain spaces.
+    U64 split_off = record.line.size;
+    for(;split_off > 0 && !char_is_space(record.line.str[split_off-1]); split_off -= 1);
+    String8 module_name = str8_skip_chop_whitespace(str8_prefix(record.line, split_off));
+    String8 voff_string = str8_skip(record.line, split_off);
+    U64 voff = 0;
+    if(module_name.size != 0 && try_u64_from_str8_c_rules(voff_string, &voff))
+    {
+      record.module_name = module_name;
+      record.voff = voff;
+      record.is_valid = 1;
+    }
+  }
+  return record;
+}
+
+internal RB_SymModule *
+rb_sym_module_from_name(RB_SymShared *sym, String8 name)
+{
+  RB_SymModule *result = 0;
+  U64 hash = u64_hash_from_str8(name);
+  RB_SymModuleSlot *slot = &sym->module_slots[hash%sym->module_slots_count];
+  for(RB_SymModule *m = slot->first; m != 0; m = m->next)
+  {
+    if(str8_match(m->name, name, 0))
+    {
+      result = m;
+      break;
+    }
+  }
+  return result;
+}
+
+internal RB_SymModule *
+rb_sym_module_open(Arena *arena, RB_SymShared *sym, String8 name)
+{
+  RB_SymModule *module = push_array(arena, RB_SymModule, 1);
+  module->name = push_str8_copy(arena, name);
+  module->rdi = rdi_parsed_nil;
+  
+  //- map the first candidate path which holds an RDI - either the module
+  // path itself, or the module path with its extension swapped for .rdi
+  String8 candidate_paths[] =
+  {
+    module->name,
+    push_str8f(arena, "%S.rdi", str8_chop_last_dot(module->name)),
+  };
+  for EachElement(idx, candidate_paths)
+  {
+    OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, candidate_paths[idx]);
+    FileProperties file_props = os_properties_from_file(file);
+    OS_Handle file_map = {0};
+    void *file_base = 0;
+    if(!os_handle_match(file, os_handle_zero()) && file_props.size >= sizeof(RDI_Header))
+    {
+      file_map = os_file_map_open(OS_AccessFlag_Read, file);
+      file_base = os_file_map_view_open(file_map, OS_AccessFlag_Read, r1u64(0, file_props.size));
+    }
+    if(file_base != 0 && ((RDI_Header *)file_base)->magic == RDI_MAGIC_CONSTANT)
+    {
+      module->rdi_path   = candidate_paths[idx];
+      module->file       = file;
+      module->file_map   = file_map;
+      module->file_props = file_props;
+      module->file_base  = file_base;
+      break;
+    }
+    if(file_base != 0)
+    {
+      os_file_map_view_close(file_map, file_base, r1u64(0, file_props.size));
+    }
+    if(!os_handle_match(file_map, os_handle_zero()))
+    {
+      os_file_map_close(file_map);
+    }
+    if(!os_handle_match(file, os_handle_zero()))
+    {
+      os_file_close(file);
+    }
+  }
+  
+  //- parse, decompress & re-parse if necessary
+  if(module->file_base != 0)
+  {
+    RDI_Parsed rdi_maybe_compressed = rdi_parsed_nil;
+    RDI_ParseStatus parse_status = rdi_parse((U8 *)module->file_base, module->file_props.size, &rdi_maybe_compressed);
+    if(parse_status == RDI_ParseStatus_Good)
+    {
+      module->rdi = rdi_maybe_compressed;
+      module->is_good = 1;
+      U64 decompressed_size = rdi_decompressed_size_from_parsed(&rdi_maybe_compressed);
+      if(decompressed_size > module->file_props.size)
+      {
+        module->decompression_arena = arena_alloc();
+        U8 *decompressed_data = push_array_no_zero(module->decompression_arena, U8, decompressed_size);
+        rdi_decompress_parsed(decompressed_data, decompressed_size, &rdi_maybe_compressed);
+        parse_status = rdi_parse(decompressed_data, decompressed_size, &module->rdi);
+        module->is_good = (parse_status == RDI_ParseStatus_Good);
+      }
+    }
+    if(module->is_good)
+    {
+      log_infof("%S: symbolicating with %S\n", module->name, module->rdi_path);
+    }
+    else
+    {
+      log_user_errorf("%S: could not parse %S\n", module->name, module->rdi_path);
+    }
+  }
+  else
+  {
+    log_user_errorf("%S: could not find debug info (tried %S)\n", module->name, candidate_paths[1]);
+  }
+  
+  //- insert into cache
+  U64 hash = u64_hash_from_str8(module->name);
+  RB_SymModuleSlot *slot = &sym->module_slots[hash%sym->module_slots_count];
+  SLLQueuePush(slot->first, slot->last, module);
+  sym->module_count += 1;
+  return module;
+}
+
+internal void
+rb_sym_module_close(RB_SymModule *module)
+{
+  if(module->decompression_arena != 0)
+  {
+    arena_release(module->decompression_arena);
+  }
+  if(module->file_base != 0)
+  {
+    os_file_map_view_close(module->file_map, module->file_base, r1u64(0, module->file_props.size));
+    os_file_map_close(module->file_map);
+    os_file_close(module->file);
+  }
+}
+
+internal void
+rb_sym_next_block(RB_SymShared *sym)
+{
+  //- move the partial line carried over from the last block to the front
+  MemoryCopy(sym->buffer, sym->buffer + sym->carry_off, sym->carry_size);
+  U64 size = sym->carry_size;
+  
+  //- fill the rest of the buffer from the inputs, in order
+  for(;size < sym->buffer_cap && sym->input_n != 0;)
+  {
+    if(!sym->input_is_open)
+    {
+      sym->input_is_open  = 1;
+      sym->input_is_stdin = str8_match(sym->input_n->string, str8_lit("-"), 0);
+      sym->input_off      = 0;
+      if(!sym->input_is_stdin)
+      {
+        sym->input_file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead, sym->input_n->string);
+        if(os_handle_match(sym->input_file, os_handle_zero()))
+        {
+          log_user_errorf("Could not open %S\n", sym->input_n->string);
+        }
+      }
+    }
+    U64 read_size = 0;
+    if(sym->input_is_stdin)
+    {
+      read_size = fread(sym->buffer + size, 1, sym->buffer_cap - size, stdin);
+    }
+    else if(!os_handle_match(sym->input_file, os_handle_zero()))
+    {
+      read_size = os_file_read(sym->input_file, r1u64(sym->input_off, sym->input_off + (sym->buffer_cap - size)), sym->buffer + size);
+    }
+    sym->input_off += read_size;
+    size += read_size;
+    if(read_size == 0)
+    {
+      // NOTE: terminate the last line of each input, so it never merges
+      // with the first line of the next input.
+      sym->buffer[size] = '\n';
+      size += 1;
+      if(!sym->input_is_stdin && !os_handle_match(sym->input_file, os_handle_zero()))
+      {
+        os_file_close(sym->input_file);
+      }
+      sym->input_file = os_handle_zero();
+      sym->input_is_open = 0;
+      sym->input_n = sym->input_n->next;
+    }
+  }
+  
+  //- cut the block after its last complete line - carry the rest
+  U64 text_size = size;
+  if(sym->input_n != 0)
+  {
+    for(;text_size > 0 && sym->buffer[text_size-1] != '\n'; text_size -= 1);
+    if(text_size == 0)
+    {
+      // NOTE: a single line which exceeds the block size - split it.
+      text_size = size;
+    }
+  }
+  sym->text       = str8(sym->buffer, text_size);
+  sym->carry_off  = text_size;
+  sym->carry_size = size - text_size;
+  sym->done       = (sym->input_n == 0 && sym->carry_size == 0);
+}
+
+internal void
+rb_sym_push_record_result(Arena *arena, String8List *out, RB_SymRecord *record)
+{
+  //- comment/blank lines -> skip; malformed records -> echo
+  if(!record->is_valid)
+  {
+    if(record->line.size != 0 && record->line.str[0] != '#')
+    {
+      str8_list_pushf(arena, out, "%S ??\n", record->line);
+    }
+    return;
+  }
+  str8_list_pushf(arena, out, "%S 0x%I64x", record->module_name, record->voff);
+  
+  //- no debug info -> unresolved
+  RB_SymModule *module = record->module;
+  if(module == 0 || !module->is_good)
+  {
+    str8_list_push(arena, out, str8_lit(" ??\n"));
+    return;
+  }
+  
+  //- walk from the innermost scope out, emitting one frame per inline
+  // site, then one for the procedure. inline sites carry their own line
+  // tables; the outermost frame's line comes from the unit line table.
+  RDI_Parsed *rdi = &module->rdi;
+  RDI_Scope *nil_scope = rdi_element_from_name_idx(rdi, Scopes, 0);
+  RDI_Scope *scope = rdi_scope_from_voff(rdi, record->voff);
+  RDI_Procedure *procedure = rdi_procedure_from_scope(rdi, scope);
+  U64 depth = 0;
+  for(RDI_Scope *s = scope;
+      s != nil_scope && depth < RB_MAX_INLINE_DEPTH;
+      s = rdi_parent_from_scope(rdi, s), depth += 1)
+  {
+    if(s->inline_site_idx == 0)
+    {
+      continue;
+    }
+    RDI_InlineSite *inline_site = rdi_inline_site_from_scope(rdi, s);
+    String8 name = {0};
+    name.str = rdi_string_from_idx(rdi, inline_site->name_string_idx, &name.size);
+    RDI_Line line = {0};
+    if(inline_site->line_table_idx != 0)
+    {
+      RDI_LineTable *line_table = rdi_element_from_name_idx(rdi, LineTables, inline_site->line_table_idx);
+      line = rdi_line_from_line_table_voff(rdi, line_table, record->voff);
+    }
+    String8 path = {0};
+    path.str = rdi_normal_path_from_source_file(rdi, rdi_source_file_from_line(rdi, &line), &path.size);
+    if(line.file_idx != 0 && path.size != 0)
+    {
+      str8_list_pushf(arena, out, " %S [inline] (%S:%I64u) <-", name.size ? name : str8_lit("??"), path, (U64)line.line_num);
+    }
+    else
+    {
+      str8_list_pushf(arena, out, " %S [inline] <-", name.size ? name : str8_lit("??"));
+    }
+  }
+  {
+    String8 name = {0};
+    name.str = rdi_name_from_procedure(rdi, procedure, &name.size);
+    RDI_Line line = rdi_line_from_voff(rdi, record->voff);
+    String8 path = {0};
+    path.str = rdi_normal_path_from_source_file(rdi, rdi_source_file_from_line(rdi, &line), &path.size);
+    if(line.file_idx != 0 && path.size != 0)
+    {
+      str8_list_pushf(arena, out, " %S (%S:%I64u)\n", name.size ? name : str8_lit("??"), path, (U64)line.line_num);
+    }
+    else
+    {
+      str8_list_pushf(arena, out, " %S\n", name.size ? name : str8_lit("??"));
+    }
+  }
+}
+
 ////////////////////////////////
 //~ rjf: Top-Level Entry Points
 
@@ -279,11 +1009,13 @@ rb_thread_entry_point(void *p)
       //////////////////////////
       //- rjf: load recognized files
       //
-      String8 file_data = {0};
+      RB_File loaded_file = {0};
+      loaded_file.path = n->string;
       if(file_format != RB_FileFormat_Null) ProfScope("load recognized file")
       {
-        file_data = os_data_from_file_path(arena, n->string);
+        rb_file_load(arena, &loaded_file);
       }
+      String8 file_data = loaded_file.data;
       
       //////////////////////////
       //- rjf: PE format => generate new implicit path tasks for PDBs
@@ -358,10 +1090,9 @@ rb_thread_entry_point(void *p)
       //
       {
         RB_File *f = push_array(arena, RB_File, 1);
+        *f = loaded_file;
         f->format       = file_format;
         f->format_flags = file_format_flags;
-        f->path         = n->string;
-        f->data         = file_data;
         RB_FileNode *file_n = push_array(arena, RB_FileNode, 1);
         file_n->v = f;
         SLLQueuePush(rb_shared->input_files.first, rb_shared->input_files.last, file_n);
@@ -397,6 +1128,7 @@ rb_thread_entry_point(void *p)
     OutputKind_RDI,
     OutputKind_Dump,
     OutputKind_Breakpad,
+    OutputKind_Symbolicate,
     OutputKind_COUNT
   }
   OutputKind;
@@ -411,6 +1143,7 @@ rb_thread_entry_point(void *p)
     {str8_lit_comp("rdi"),      str8_lit_comp("RAD Debug Info (.rdi) Conversion")},
     {str8_lit_comp("dump"),     str8_lit_comp("Textual Dumping")},
     {str8_lit_comp("breakpad"), str8_lit_comp("Breakpad Debug Info Conversion")},
+    {str8_lit_comp("symbolicate"), str8_lit_comp("Batch Symbolication")},
   };
   OutputKind output_kind = OutputKind_Null;
   String8 output_path = cmd_line_string(cmdline, str8_lit("out"));
@@ -430,7 +1163,11 @@ rb_thread_entry_point(void *p)
     }
     
     //- rjf: we can infer from the user-specified output path
-    if(str8_match(str8_skip_last_dot(output_path), str8_lit("rdi"), StringMatchFlag_CaseInsensitive))
+    if(output_kind == OutputKind_Symbolicate)
+    {
+      // NOTE: symbolication writes text to any output path.
+    }
+    else if(str8_match(str8_skip_last_dot(output_path), str8_lit("rdi"), StringMatchFlag_CaseInsensitive))
     {
       output_kind = OutputKind_RDI;
       log_infof("Output path has .rdi extension; performing `%S`\n", output_kind_info[output_kind].title);
@@ -492,6 +1229,10 @@ rb_thread_entry_point(void *p)
       fprintf(stderr, "radbin --dump program.rdi\n");
       fprintf(stderr, "Outputs the textual dump of the debug information stored in `program.rdi`.\n\n");
       
+      fprintf(stderr, "radbin --symbolicate addresses.txt --out:symbols.txt\n");
+      fprintf(stderr, "Resolves each `<module> <voff>` record in `addresses.txt` to a procedure,\n");
+      fprintf(stderr, "inline chain, and file:line, and writes the results to `symbols.txt`.\n\n");
+      
       fprintf(stderr, "-------------------------------------------------------------------------------\n\n");
       
       fprintf(stderr, "DESCRIPTION\n\n");
@@ -514,6 +1255,9 @@ rb_thread_entry_point(void *p)
       fprintf(stderr, "--breakpad       Specifies that the utility should convert debug information\n");
       fprintf(stderr, "                 data to the textual Breakpad format.\n\n");
       
+      fprintf(stderr, "--symbolicate    Specifies that the utility should resolve a stream of module\n");
+      fprintf(stderr, "                 & virtual offset records to symbols, using RDI files.\n\n");
+      
       fprintf(stderr, "--out:<path>     Specifies the path to which output data should be written. If\n");
       fprintf(stderr, "                 not specified, the utility will choose a fallback. If dumping\n");
       fprintf(stderr, "                 textual contents, the utility will write to `stdout`. If\n");
@@ -563,8 +1307,9 @@ rb_thread_entry_point(void *p)
         }break;
         case OutputKind_Breakpad:
         {
-          fprintf(stderr, "All input files specified on the command line will be dumped. The following\n");
-          fprintf(stderr, "formats are currently supported: PE, COFF, RDI, and ELF\n\n");
+          fprintf(stderr, "Debug information found in the input files is converted to Breakpad symbols,\n");
+          fprintf(stderr, "including INLINE and INLINE_ORIGIN records. The following inputs are\n");
+          fprintf(stderr, "currently supported: PDB, PE or ELF with DWARF, and RDI.\n\n");
         }
       }
       
@@ -605,6 +1350,8 @@ rb_thread_entry_point(void *p)
       //- rjf: convert inputs to RDI info
       B32 convert_done = 0;
       RDIM_BakeParams bake_params = {0};
+      String8 breakpad_rdi_data = {0};
+      String8 breakpad_os_name = str8_lit("windows");
       {
         //- rjf: PE inputs w/ DWARF, or ELF inputs => DWARF -> RDI conversion
         if(!convert_done &&
@@ -696,11 +1443,23 @@ rb_thread_entry_point(void *p)
             convert_params.deterministic  = cmd_line_has_flag(cmdline, str8_lit("deterministic"));
           }
           ProfScope("convert") bake_params = d2r_convert(arena, &convert_params);
+          if(convert_params.exe_kind != ExecutableImageKind_CoffPe)
+          {
+            breakpad_os_name = str8_lit("Linux");
+          }
           
           // rjf: no output path? -> pick one based on debug
-          if(output_path.size == 0)
+          if(output_path.size == 0) switch(output_kind)
           {
-            output_path = push_str8f(arena, "%S.rdi", str8_chop_last_dot(convert_params.dbg_name));
+            default:{}break;
+            case OutputKind_RDI:
+            {
+              output_path = push_str8f(arena, "%S.rdi", str8_chop_last_dot(convert_params.dbg_name));
+            }break;
+            case OutputKind_Breakpad:
+            {
+              output_path = push_str8f(arena, "%S.psym", str8_chop_last_dot(convert_params.dbg_name));
+            }break;
           }
         }
         
@@ -745,12 +1504,45 @@ rb_thread_entry_point(void *p)
             }break;
           }
         }
+        
+        //- RDI inputs => breakpad can be generated directly
+        if(!convert_done &&
+           output_kind == OutputKind_Breakpad &&
+           input_files_from_format_table[RB_FileFormat_RDI].count != 0)
+        {
+          log_infof("RDIs specified; producing Breakpad from RDI data\n");
+          RB_File *rdi_file = rb_file_list_first(&input_files_from_format_table[RB_FileFormat_RDI]);
+          breakpad_rdi_data = rdi_file->data;
+          
+          // pick OS from the image name
+          {
+            RDI_Parsed rdi = rdi_parsed_nil;
+            rdi_parse(rdi_file->data.str, rdi_file->data.size, &rdi);
+            RDI_TopLevelInfo *tli = rdi_element_from_name_idx(&rdi, TopLevelInfo, 0);
+            String8 exe_name = {0};
+            exe_name.str = rdi_string_from_idx(&rdi, tli->exe_name_string_idx, &exe_name.size);
+            String8 exe_ext = str8_skip_last_dot(exe_name);
+            if(exe_name.size != 0 &&
+               !str8_match(exe_ext, str8_lit("exe"), StringMatchFlag_CaseInsensitive) &&
+               !str8_match(exe_ext, str8_lit("dll"), StringMatchFlag_CaseInsensitive) &&
+               !str8_match(exe_ext, str8_lit("sys"), StringMatchFlag_CaseInsensitive))
+            {
+              breakpad_os_name = str8_lit("Linux");
+            }
+          }
+          
+          // no output path? -> pick one based on RDI
+          if(output_path.size == 0)
+          {
+            output_path = push_str8f(arena, "%S.psym", str8_chop_last_dot(rdi_file->path));
+          }
+        }
       }
       
       //- rjf: no viable input paths
-      if(!convert_done && cmdline->inputs.node_count != 0)
+      if(!convert_done && breakpad_rdi_data.size == 0 && cmdline->inputs.node_count != 0)
       {
-        log_user_errorf("Could not load debug info from the specified inputs. You must provide either a valid PDB file or an executable image (PE, ELF) file with DWARF debug info.");
+        log_user_errorf("Could not load debug info from the specified inputs. You must provide either a valid PDB file or an executable image (PE, ELF) file with DWARF debug info, or an RDI file when generating Breakpad info.");
       }
       
       //- rjf: bake
@@ -784,140 +1576,53 @@ rb_thread_entry_point(void *p)
           str8_list_concat_in_place(&output_blobs, &blobs);
         }break;
         
-        //- rjf: generate breakpad text
+        //- serialize RDI in memory, for breakpad generation
         case OutputKind_Breakpad:
         {
-          //- rjf: set up shared state
-          typedef struct P2B_Shared P2B_Shared;
-          struct P2B_Shared
-          {
-            String8List dump;
-            String8List *lane_chunk_file_dumps;
-            String8List *lane_chunk_func_dumps;
-          };
-          local_persist P2B_Shared *p2b_shared = 0;
-          if(lane_idx() == 0)
-          {
-            p2b_shared = push_array(arena, P2B_Shared, 1);
-            p2b_shared->lane_chunk_file_dumps = push_array(arena, String8List, lane_count()*bake_params.src_files.chunk_count);
-            p2b_shared->lane_chunk_func_dumps = push_array(arena, String8List, lane_count()*bake_params.procedures.chunk_count);
-          }
-          lane_sync();
-          
-          //- rjf: dump MODULE record
-          if(lane_idx() == 0)
-          {
-            str8_list_pushf(arena, &p2b_shared->dump, "MODULE windows x86_64 %I64x %S\n", bake_params.top_level_info.exe_hash, bake_params.top_level_info.exe_name);
-          }
-          
-          //- rjf: dump FILE records
-          ProfScope("dump FILE records")
-          {
-            U64 chunk_idx = 0;
-            for EachNode(n, RDIM_SrcFileChunkNode, bake_params.src_files.first)
-            {
-              Rng1U64 range = lane_range(n->count);
-              for EachInRange(idx, range)
-              {
-                U64 file_idx = rdim_idx_from_src_file(&n->v[idx]);
-                String8 src_path = n->v[idx].path;
-                str8_list_pushf(arena, &p2b_shared->lane_chunk_file_dumps[lane_idx()*bake_params.src_files.chunk_count + chunk_idx], "FILE %I64u %S\n", file_idx, src_path);
-              }
-              chunk_idx += 1;
-            }
-          }
-          
-          //- rjf: dump FUNC records
-          ProfScope("dump FUNC records")
+          RDIM_SerializedSectionBundle serialized_section_bundle = {0};
+          ProfScope("serialize") serialized_section_bundle = rdim_serialized_section_bundle_from_bake_results(&bake_results);
+          String8List blobs = rdim_file_blobs_from_section_bundle(arena, &serialized_section_bundle);
+          if(lane_idx() == 0) ProfScope("join")
           {
-            U64 chunk_idx = 0;
-            for EachNode(n, RDIM_SymbolChunkNode, bake_params.procedures.first)
-            {
-              String8List *out = &p2b_shared->lane_chunk_func_dumps[lane_idx()*bake_params.procedures.chunk_count + chunk_idx];
-              Rng1U64 range = lane_range(n->count);
-              for EachInRange(idx, range)
-              {
-                // NOTE(rjf): breakpad does not support multiple voff ranges per procedure.
-                RDIM_Symbol *proc = &n->v[idx];
-                RDIM_Scope *root_scope = proc->root_scope;
-                if(root_scope != 0 && root_scope->voff_ranges.first != 0)
-                {
-                  // rjf: dump function record
-                  RDIM_Rng1U64 voff_range = root_scope->voff_ranges.first->v;
-                  str8_list_pushf(arena, out, "FUNC %I64x %I64x %I64x %S\n", voff_range.min, voff_range.max-voff_range.min, 0ull, proc->name);
-                  
-                  // rjf: dump function lines
-                  U64 unit_idx = rdi_vmap_idx_from_voff(bake_results.unit_vmap.vmap.vmap, bake_results.unit_vmap.vmap.count, voff_range.min);
-                  if(0 < unit_idx && unit_idx <= bake_results.units.units_count)
-                  {
-                    U32 line_table_idx = bake_results.units.units[unit_idx].line_table_idx;
-                    if(0 < line_table_idx && line_table_idx <= bake_results.line_tables.line_tables_count)
-                    {
-                      // rjf: unpack unit line info
-                      RDI_LineTable *line_table = &bake_results.line_tables.line_tables[line_table_idx];
-                      RDI_ParsedLineTable line_info =
-                      {
-                        bake_results.line_tables.line_table_voffs + line_table->voffs_base_idx,
-                        bake_results.line_tables.line_table_lines + line_table->lines_base_idx,
-                        0,
-                        line_table->lines_count,
-                        0
-                      };
-                      for(U64 voff = voff_range.min, last_voff = 0;
-                          voff < voff_range.max && voff > last_voff;)
-                      {
-                        RDI_U64 line_info_idx = rdi_line_info_idx_from_voff(&line_info, voff);
-                        if(line_info_idx < line_info.count)
-                        {
-                          RDI_Line *line = &line_info.lines[line_info_idx];
-                          U64 line_voff_min = line_info.voffs[line_info_idx];
-                          U64 line_voff_opl = line_info.voffs[line_info_idx+1];
-                          if(line->file_idx != 0)
-                          {
-                            str8_list_pushf(arena, out, "%I64x %I64x %I64u %I64u\n",
-                                            line_voff_min,
-                                            line_voff_opl-line_voff_min,
-                                            (U64)line->line_num,
-                                            (U64)line->file_idx);
-                          }
-                          last_voff = voff;
-                          voff = line_voff_opl;
-                        }
-                        else
-                        {
-                          break;
-                        }
-                      }
-                    }
-                  }
-                }
-              }
-              chunk_idx += 1;
-            }
+            breakpad_rdi_data = str8_list_join(arena, &blobs, 0);
           }
-          
-          //- rjf: join
-          lane_sync();
-          if(lane_idx() == 0)
+          lane_sync_u64(&breakpad_rdi_data.str, 0);
+          lane_sync_u64(&breakpad_rdi_data.size, 0);
+        }break;
+      }
+      
+      //- generate breakpad text from RDI
+      if(output_kind == OutputKind_Breakpad && breakpad_rdi_data.size != 0)
+      {
+        RDI_Parsed rdi = rdi_parsed_nil;
+        RDI_ParseStatus rdi_status = rdi_parse(breakpad_rdi_data.str, breakpad_rdi_data.size, &rdi);
+        
+        // decompress RDI inputs, if needed
+        if(rdi_status == RDI_ParseStatus_Good)
+        {
+          U64 decompressed_size = rdi_decompressed_size_from_parsed(&rdi);
+          if(decompressed_size > breakpad_rdi_data.size)
           {
-            for EachIndex(chunk_idx, bake_params.src_files.chunk_count)
+            U8 *decompressed_data = 0;
+            if(lane_idx() == 0) ProfScope("decompress")
             {
-              for EachIndex(ln_idx, lane_count())
-              {
-                str8_list_concat_in_place(&p2b_shared->dump, &p2b_shared->lane_chunk_file_dumps[ln_idx*bake_params.src_files.chunk_count + chunk_idx]);
-              }
-            }
-            for EachIndex(chunk_idx, bake_params.procedures.chunk_count)
-            {
-              for EachIndex(ln_idx, lane_count())
-              {
-                str8_list_concat_in_place(&p2b_shared->dump, &p2b_shared->lane_chunk_func_dumps[ln_idx*bake_params.procedures.chunk_count + chunk_idx]);
-              }
+              decompressed_data = push_array_no_zero(arena, U8, decompressed_size);
+              rdi_decompress_parsed(decompressed_data, decompressed_size, &rdi);
             }
+            lane_sync_u64(&decompressed_data, 0);
+            rdi_status = rdi_parse(decompressed_data, decompressed_size, &rdi);
           }
-          lane_sync();
-          output_blobs = p2b_shared->dump;
-        }break;
+        }
+        
+        // dump
+        if(rdi_status == RDI_ParseStatus_Good)
+        {
+          ProfScope("dump breakpad") output_blobs = rb_breakpad_dump_from_rdi(arena, &rdi, breakpad_os_name);
+        }
+        else if(lane_idx() == 0)
+        {
+          log_user_errorf("Could not parse RDI data for Breakpad generation.\n");
+        }
       }
     }break;
     
@@ -997,13 +1702,24 @@ rb_thread_entry_point(void *p)
         }
       }
       
+      //- open output stream - dumps are written as they are produced,
+      // rather than gathered in memory first
+      if(lane_idx() == 0)
+      {
+        rb_output_stream_open(&rb_shared->output, output_path);
+      }
+      lane_sync();
+      RB_OutputStream *output = &rb_shared->output;
+      
       //- rjf: dump input files in order
       for(RB_FileNode *n = input_files.first; n != 0; n = n->next)
       {
         RB_File *f = n->v;
         if(lane_idx() == 0)
         {
-          str8_list_pushf(arena, &output_blobs, "// %S (%S)\n\n", deterministic ? str8_skip_last_slash(f->path) : f->path, f->format ? rb_file_format_display_name_table[f->format] : str8_lit("Unsupported format"));
+          Temp scratch = scratch_begin(&arena, 1);
+          rb_output_stream_write(output, push_str8f(scratch.arena, "// %S (%S)\n\n", deterministic ? str8_skip_last_slash(f->path) : f->path, f->format ? rb_file_format_display_name_table[f->format] : str8_lit("Unsupported format")));
+          scratch_end(scratch);
         }
         lane_sync();
         
@@ -1098,11 +1814,7 @@ rb_thread_entry_point(void *p)
               case RDI_ParseStatus_InvalidDataSecionLayout: {log_user_errorf("RDI parse failure: invalid data section layout\n");}break;
               case RDI_ParseStatus_Good:
               {
-                String8List dump = rdi_dump_list_from_parsed(arena, &rdi, rdi_dump_subset_flags);
-                if(lane_idx() == 0)
-                {
-                  str8_list_concat_in_place(&output_blobs, &dump);
-                }
+                rdi_dump_parsed(&rdi, rdi_dump_subset_flags, rb_output_stream_write_rdi_dump, output);
               }break;
             }
           }break;
@@ -1113,17 +1825,185 @@ rb_thread_entry_point(void *p)
         {
           if(lane_idx() == 0)
           {
-            str8_list_pushf(arena, &output_blobs, "// %S (%S) (DWARF)\n\n", deterministic ? str8_skip_last_slash(f->path) : f->path, f->format ? rb_file_format_display_name_table[f->format] : str8_lit("Unsupported format"));
+            Temp scratch = scratch_begin(&arena, 1);
+            rb_output_stream_write(output, push_str8f(scratch.arena, "// %S (%S) (DWARF)\n\n", deterministic ? str8_skip_last_slash(f->path) : f->path, f->format ? rb_file_format_display_name_table[f->format] : str8_lit("Unsupported format")));
+            scratch_end(scratch);
           }
           lane_sync();
           {
             String8List dump = dw_dump_list_from_sections(arena, &dw, arch, dw_dump_subset_flags);
             if(lane_idx() == 0)
             {
-              str8_list_concat_in_place(&output_blobs, &dump);
+              rb_output_stream_write_list(output, dump);
+            }
+          }
+        }
+      }
+      
+      //- close output stream
+      lane_sync();
+      if(lane_idx() == 0)
+      {
+        rb_output_stream_close(output);
+        log_infof("Results written to %S", output_path.size != 0 ? output_path : str8_lit("stdout"));
+      }
+    }break;
+    
+    ////////////////////////////
+    //- symbolicate -> resolve streamed (module, voff) records
+    //
+    case OutputKind_Symbolicate:
+    {
+      //- rjf: no inputs => help
+      if(lane_idx() == 0 && cmdline->inputs.node_count == 0)
+      {
+        fprintf(stderr, "All input files specified on the command line are read, in order, as text\n");
+        fprintf(stderr, "records of the form `<module> <voff>`, one per line. `-` reads from `stdin`.\n");
+        fprintf(stderr, "The module is a path to an RDI file, or to an image whose RDI file sits next\n");
+        fprintf(stderr, "to it (e.g. `program.exe` -> `program.rdi`). The voff is a virtual offset\n");
+        fprintf(stderr, "from the module's base, in C integer syntax (e.g. `0x1a2b0`).\n\n");
+        fprintf(stderr, "Each record produces one line, in input order, with its innermost frame first:\n\n");
+        fprintf(stderr, "<module> <voff> <inlinee> [inline] (<file>:<line>) <- <procedure> (<file>:<line>)\n\n");
+      }
+      
+      //- set up shared symbolication state
+      if(lane_idx() == 0)
+      {
+        RB_SymShared *sym = push_array(arena, RB_SymShared, 1);
+        sym->module_slots_count = RB_SYM_MODULE_SLOTS;
+        sym->module_slots       = push_array(arena, RB_SymModuleSlot, sym->module_slots_count);
+        sym->input_n            = cmdline->inputs.first;
+        sym->buffer_cap         = RB_SYM_BLOCK_SIZE;
+        sym->buffer             = push_array_no_zero(arena, U8, sym->buffer_cap);
+        rb_output_stream_open(&rb_shared->output, output_path);
+        sym->lane_records = push_array(arena, RB_SymRecordArray, lane_count());
+        sym->lane_outputs = push_array(arena, String8, lane_count());
+        rb_shared->sym = sym;
+      }
+      lane_sync();
+      RB_SymShared *sym = rb_shared->sym;
+      RB_OutputStream *output = &rb_shared->output;
+      
+      //- stream blocks of records through all lanes
+      Arena *batch_arena = arena_alloc();
+      for(;;)
+      {
+        // read next block
+        if(lane_idx() == 0) ProfScope("read block")
+        {
+          rb_sym_next_block(sym);
+        }
+        lane_sync();
+        if(sym->text.size == 0 && sym->done)
+        {
+          break;
+        }
+        arena_clear(batch_arena);
+        
+        // parse this lane's lines into records
+        RB_SymRecordArray *records = &sym->lane_records[lane_idx()];
+        ProfScope("parse records")
+        {
+          String8 text = sym->text;
+          Rng1U64 range = lane_range(text.size);
+          U64 min = rb_sym_line_start_from_off(text, range.min);
+          U64 opl = rb_sym_line_start_from_off(text, range.max);
+          U64 line_count = 0;
+          for(U64 off = min; off < opl; off += 1)
+          {
+            line_count += (text.str[off] == '\n');
+          }
+          line_count += 1;
+          records->v = push_array(batch_arena, RB_SymRecord, line_count);
+          records->count = 0;
+          records->unresolved_count = 0;
+          RB_SymModule *last_module = 0;
+          for(U64 line_off = min; line_off < opl;)
+          {
+            U64 line_opl = line_off;
+            for(;line_opl < opl && text.str[line_opl] != '\n'; line_opl += 1);
+            RB_SymRecord *record = &records->v[records->count];
+            records->count += 1;
+            *record = rb_sym_record_from_line(str8_substr(text, r1u64(line_off, line_opl)));
+            if(record->is_valid)
+            {
+              // NOTE: the module cache is only written by lane 0 between
+              // syncs, so it can be read here without a lock.
+              if(last_module != 0 && str8_match(last_module->name, record->module_name, 0))
+              {
+                record->module = last_module;
+              }
+              else
+              {
+                record->module = last_module = rb_sym_module_from_name(sym, record->module_name);
+              }
+              records->unresolved_count += (record->module == 0);
+            }
+            line_off = line_opl + 1;
+          }
+        }
+        lane_sync();
+        
+        // open modules seen for the first time
+        if(lane_idx() == 0) ProfScope("open new modules")
+        {
+          for EachIndex(l_idx, lane_count())
+          {
+            RB_SymRecordArray *lane_records = &sym->lane_records[l_idx];
+            for(U64 idx = 0; idx < lane_records->count && lane_records->unresolved_count != 0; idx += 1)
+            {
+              RB_SymRecord *record = &lane_records->v[idx];
+              if(record->is_valid && record->module == 0)
+              {
+                record->module = rb_sym_module_from_name(sym, record->module_name);
+                if(record->module == 0)
+                {
+                  record->module = rb_sym_module_open(arena, sym, record->module_name);
+                }
+                lane_records->unresolved_count -= 1;
+              }
             }
           }
         }
+        lane_sync();
+        
+        // resolve this lane's records
+        ProfScope("symbolicate records")
+        {
+          String8List out = {0};
+          for EachIndex(idx, records->count)
+          {
+            rb_sym_push_record_result(batch_arena, &out, &records->v[idx]);
+          }
+          sym->lane_outputs[lane_idx()] = str8_list_join(batch_arena, &out, 0);
+        }
+        lane_sync();
+        
+        // stream results out, in input order
+        if(lane_idx() == 0) ProfScope("write results")
+        {
+          for EachIndex(l_idx, lane_count())
+          {
+            rb_output_stream_write(output, sym->lane_outputs[l_idx]);
+            sym->record_count += sym->lane_records[l_idx].count;
+          }
+        }
+      }
+      arena_release(batch_arena);
+      
+      //- close modules & output
+      if(lane_idx() == 0)
+      {
+        for EachIndex(slot_idx, sym->module_slots_count)
+        {
+          for(RB_SymModule *m = sym->module_slots[slot_idx].first; m != 0; m = m->next)
+          {
+            rb_sym_module_close(m);
+          }
+        }
+        rb_output_stream_close(output);
+        log_infof("Results written to %S", output_path.size != 0 ? output_path : str8_lit("stdout"));
+        log_infof("Symbolicated %I64u lines against %I64u modules\n", sym->record_count, sym->module_count);
       }
     }break;
   }
@@ -1131,7 +2011,7 @@ rb_thread_entry_point(void *p)
   //////////////////////////////
   //- rjf: write outputs
   //
-  if(lane_idx() == 0)
+  if(lane_idx() == 0 && output_kind != OutputKind_Dump && output_kind != OutputKind_Symbolicate)
   {
     if(output_path.size != 0) ProfScope("write outputs [file]")
     {
@@ -1154,6 +2034,17 @@ rb_thread_entry_point(void *p)
   }
   lane_sync();
   
+  //////////////////////////////
+  //- unload inputs
+  //
+  if(lane_idx() == 0)
+  {
+    for(RB_FileNode *n = input_files.first; n != 0; n = n->next)
+    {
+      rb_file_unload(n->v);
+    }
+  }
+  
   //////////////////////////////
   //- rjf: write info & errors
   //
@@ -35,6 +35,9 @@ struct RB_File
   RB_FileFormatFlags format_flags;
   String8 path;
   String8 data;
+  OS_Handle file;
+  OS_Handle file_map;
+  B32 is_mapped;
 };
 
 typedef struct RB_FileNode RB_FileNode;
@@ -55,6 +58,101 @@ struct RB_FileList
 read_only global RB_File rb_file_nil = {0};
 #define rb_file_list_first(list) ((list)->first ? (list)->first->v : &rb_file_nil)
 
+////////////////////////////////
+//~ Scope Walking Limits
+
+#define RB_MAX_INLINE_DEPTH 256
+
+////////////////////////////////
+//~ Output Stream Types
+
+typedef struct RB_OutputStream RB_OutputStream;
+struct RB_OutputStream
+{
+  B32 is_stdout;
+  OS_Handle file;
+  U64 off;
+};
+
+////////////////////////////////
+//~ Symbolication Types
+
+// NOTE: `--symbolicate` consumes text records of the form
+// `<module> <voff>`, one per line, in blocks of RB_SYM_BLOCK_SIZE bytes. Each
+// block's lines are split across lanes, every lane resolves its own records,
+// and lane 0 streams the results out in input order before reading the next
+// block. A module's RDI is mapped & parsed once, the first time it is seen.
+
+#define RB_SYM_BLOCK_SIZE        MB(16)
+#define RB_SYM_MODULE_SLOTS      1024
+
+typedef struct RB_SymModule RB_SymModule;
+struct RB_SymModule
+{
+  RB_SymModule *next;
+  String8 name;
+  String8 rdi_path;
+  OS_Handle file;
+  OS_Handle file_map;
+  FileProperties file_props;
+  void *file_base;
+  Arena *decompression_arena;
+  RDI_Parsed rdi;
+  B32 is_good;
+};
+
+typedef struct RB_SymModuleSlot RB_SymModuleSlot;
+struct RB_SymModuleSlot
+{
+  RB_SymModule *first;
+  RB_SymModule *last;
+};
+
+typedef struct RB_SymRecord RB_SymRecord;
+struct RB_SymRecord
+{
+  String8 line;
+  String8 module_name;
+  RB_SymModule *module;
+  U64 voff;
+  B32 is_valid;
+};
+
+typedef struct RB_SymRecordArray RB_SymRecordArray;
+struct RB_SymRecordArray
+{
+  RB_SymRecord *v;
+  U64 count;
+  U64 unresolved_count;
+};
+
+typedef struct RB_SymShared RB_SymShared;
+struct RB_SymShared
+{
+  // module cache
+  RB_SymModuleSlot *module_slots;
+  U64 module_slots_count;
+  U64 module_count;
+  
+  // input stream state
+  String8Node *input_n;
+  B32 input_is_open;
+  B32 input_is_stdin;
+  OS_Handle input_file;
+  U64 input_off;
+  U8 *buffer;
+  U64 buffer_cap;
+  U64 carry_off;
+  U64 carry_size;
+  String8 text;
+  B32 done;
+  
+  // per-lane batch results
+  RB_SymRecordArray *lane_records;
+  String8 *lane_outputs;
+  U64 record_count;
+};
+
 ////////////////////////////////
 //~ rjf: Cross-Thread State
 
@@ -63,6 +161,8 @@ struct RB_Shared
 {
   RB_FileList input_files;
   RB_FileList input_files_from_format_table[RB_FileFormat_COUNT];
+  RB_OutputStream output;
+  RB_SymShared *sym;
 };
 
 ////////////////////////////////
@@ -70,6 +170,40 @@ struct RB_Shared
 
 global RB_Shared *rb_shared = 0;
 
+////////////////////////////////
+//~ Input File Functions
+
+internal void rb_file_load(Arena *arena, RB_File *file);
+internal void rb_file_unload(RB_File *file);
+
+////////////////////////////////
+//~ Output Stream Functions
+
+internal void rb_output_stream_open(RB_OutputStream *stream, String8 path);
+internal void rb_output_stream_close(RB_OutputStream *stream);
+internal void rb_output_stream_write(RB_OutputStream *stream, String8 data);
+internal void rb_output_stream_write_list(RB_OutputStream *stream, String8List list);
+internal void rb_output_stream_write_rdi_dump(void *user_data, String8 string);
+
+////////////////////////////////
+//~ Breakpad Generation Functions
+
+internal U64 rb_breakpad_scope_vmap_opl_from_voff(RDI_VMapEntry *vmap, U64 vmap_count, U64 voff);
+internal RDI_LineTable *rb_breakpad_line_table_from_scope(RDI_Parsed *rdi, RDI_Scope *scope, U64 voff);
+internal void rb_breakpad_push_func(Arena *arena, String8List *out, RDI_Parsed *rdi, RDI_Procedure *procedure);
+internal String8List rb_breakpad_dump_from_rdi(Arena *arena, RDI_Parsed *rdi, String8 os_name);
+
+////////////////////////////////
+//~ Symbolication Functions
+
+internal U64 rb_sym_line_start_from_off(String8 text, U64 off);
+internal RB_SymRecord rb_sym_record_from_line(String8 line);
+internal RB_SymModule *rb_sym_module_from_name(RB_SymShared *sym, String8 name);
+internal RB_SymModule *rb_sym_module_open(Arena *arena, RB_SymShared *sym, String8 name);
+internal void rb_sym_module_close(RB_SymModule *module);
+internal void rb_sym_next_block(RB_SymShared *sym);
+internal void rb_sym_push_record_result(Arena *arena, String8List *out, RB_SymRecord *record);
+
 ////////////////////////////////
 //~ rjf: Top-Level Entry Points
 
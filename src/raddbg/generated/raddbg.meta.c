@@ -419,7 +419,7 @@ RD_VocabInfo rd_vocab_info_table[352] =
 RD_NameSchemaInfo rd_name_schema_info_table[24] =
 {
 {str8_lit_comp("user"), str8_lit_comp("@expand_commands(edit_user_theme) x:\n{\n  //- rjf: animations\n  @display_name('Animations') @description(\"Enables animations.\")\n  @default(1) 'animations': bool,\n  @display_name('Scrolling Animations') @description(\"Enables scrolling animations.\")\n  @expand_if(\"$.animations\") @default(1) 'scrolling_animations': bool,\n  @display_name('Tooltip Animations') @description(\"Enables tooltip animations.\")\n  @expand_if(\"$.animations\") @default(1) 'tooltip_animations': bool,\n  @display_name('Menu Animations') @description(\"Enables menu animations.\")\n  @expand_if(\"$.animations\") @default(1) 'menu_animations': bool,\n\n  //- rjf: fonts\n  @display_name('UI Font') @description(\"The name of, or path to, the font used when displaying non-code UI elements.\")\n  @default('') 'main_font': string,\n  @display_name('Code Font') @description(\"The name of, or path to, the font used when displaying code.\")\n  @default('') 'code_font': string,\n\n  //- rjf: theme\n  @default(\"Default (Dark)\") @display_name('User Theme')\n  @description(\"The user's theme, which describes all colors used throughout the UI.\")\n  'theme': string,\n  @no_expand @display_name('User Theme')\n  'theme_colors': query,\n\n  //- rjf: autocompletion\n  @display_name('Autocompletion Lister') @description(\"Enables the autocompletion lister while typing expressions.\") @default(1)\n  'autocompletion_lister': bool,\n  @display_name('View Call Argument Helper') @description(\"Enables the view call argument helper, which shows view arguments and documentation, while typing expressions.\") @default(1)\n  'view_call_argument_helper': bool,\n\n  //- rjf: scope decorations\n  @default(1) @display_name('Cursor Scope Lines') @description(\"Controls whether or not scopes containing the cursor in text views are drawn.\")\n  'cursor_scope_lines': bool,\n\n  //- rjf: thread & breakpoint decorations\n  @default(1) @display_name('Thread Lines') @description(\"Controls whether or not a long horizontal line is drawn before the next line or instruction that the selected thread will execute in source and disassembly views.\")\n  'thread_lines': bool,\n  @default(1) @display_name('Thread Glow') @description(\"Controls whether or not a glowing effect is drawn on the selected thread in source and disassembly views.\")\n  'thread_glow': bool,\n  @default(1) @display_name('Breakpoint Lines') @description(\"Controls whether or not a long horizontal line is drawn before the line or instruction at which a breakpoint is placed, in source and disassembly views.\")\n  'breakpoint_lines': bool,\n  @default(1) @display_name('Breakpoint Glow') @description(\"Controls whether or not a glowing effect is drawn on breakpoints in source and disassembly views.\")\n  'breakpoint_glow': bool,\n\n  //- rjf: occluding background settings\n  @default(0) @display_name('Opaque Backgrounds') @description(\"Controls whether or not all floating background colors are forced to be fully opaque.\")\n  'opaque_backgrounds': bool,\n  @default(1) @display_name('Background Blur') @description(\"Controls whether or not occluded regions behind floating elements are blurred.\")\n  'background_blur': bool,\n\n  //- rjf: appearance settings\n  @default(1) @display_name('Drop Shadows') @description(\"Controls whether or not drop shadows are drawn.\")\n  'drop_shadows': bool,\n  @default(1.f) @display_name('Rounded Corner Amount') @description(\"Controls the degree to which UI corners are rounded.\")\n  'rounded_corner_amount': @range[0, 1] f32,\n\n  //- rjf: code formatting settings\n  @default(2) @display_name('User Tab Width') 'tab_width': @range[1, 32] u64,\n\n  //- rjf: windows style menu bar\n  @default(1) @display_name('Focus Menu Bar With Alt') @description(\"Mimics standard Windows behavior of focusing the menu bar using the Alt key.\")\n  'focus_menu_bar_with_alt': bool,\n\n  //- rjf: native filesystem dialogues\n  @default(0) @display_name('Use Native File System Dialog') @description(\"Uses the operating system's file system dialog box, rather than the debugger's built-in UI.\")\n  'use_native_file_system_dialog': bool,\n}\n")},
-{str8_lit_comp("project"), str8_lit_comp("@expand_commands(edit_project_theme) x:\n{\n  @default(2) @display_name('Project Tab Width') 'tab_width': @range[1, 32] u64,\n\n  //- rjf: visualizers\n  @display_name('Use Default C++ STL Type Visualizers') @description(\"Enables the built-in type views for C++ STL types.\")\n  @default(1) use_default_stl_type_views: bool,\n  @display_name('Use Default Unreal Engine Type Visualizers') @description(\"Enables the built-in type views for Unreal Engine types.\")\n  @default(1) use_default_ue_type_views: bool,\n\n  //- rjf: theme\n  @default(\"None\") @display_name('Project Theme') @description(\"The project's theme, which describes all colors used throughout the UI, and can override the user's theme.\")\n  'theme': string,\n  @no_expand @display_name('Project Theme') @description(\"The project's theme, which describes all colors used throughout the UI, and can override the user's theme.\")\n  'theme_colors': query,\n\n  //- rjf: exception settings\n  @default(1) @display_name(\"Break On Win32 Control-C Exceptions\") @description(\"Code: 0x40010005\")\n  win32_ctrl_c: bool;\n  @default(1) @display_name(\"Break On Win32 Control-Break Exceptions\") @description(\"Code: 0x40010008\")\n  win32_ctrl_break: bool;\n  @default(0) @display_name(\"Break On Win32 WinRT Originate Error Exceptions\") @description(\"Code: 0x40080201\")\n  win32_win_rt_originate_error: bool;\n  @default(0) @display_name(\"Break On Win32 WinRT Transform Error Exceptions\") @description(\"Code: 0x40080202\")\n  win32_win_rt_transform_error: bool;\n  @default(0) @display_name(\"Break On Win32 RPC Call Cancelled Exceptions\") @description(\"Code: 0x0000071a\")\n  win32_rpc_call_cancelled: bool;\n  @default(0) @display_name(\"Break On Win32 Data Type Misalignment Exceptions\") @description(\"Code: 0x80000002\")\n  win32_datatype_misalignment: bool;\n  @default(1) @display_name(\"Break On Win32 Access Violation Exceptions\") @description(\"Code: 0xc0000005\")\n  win32_access_violation: bool;\n  @default(0) @display_name(\"Break On Win32 In Page Error Exceptions\") @description(\"Code: 0xc0000006\")\n  win32_in_page_error: bool;\n  @default(1) @display_name(\"Break On Win32 Invalid Handle Specified Exceptions\") @description(\"Code: 0xc0000008\")\n  win32_invalid_handle: bool;\n  @default(0) @display_name(\"Break On Win32 Not Enough Quota Exceptions\") @description(\"Code: 0xc0000017\")\n  win32_not_enough_quota: bool;\n  @default(0) @display_name(\"Break On Win32 Illegal Instruction Exceptions\") @description(\"Code: 0xc000001d\")\n  win32_illegal_instruction: bool;\n  @default(0) @display_name(\"Break On Win32 Cannot Continue From Exception Exceptions\") @description(\"Code: 0xc0000025\")\n  win32_cannot_continue_exception: bool;\n  @default(0) @display_name(\"Break On Win32 Invalid Exception Disposition Returned By Handler Exceptions\") @description(\"Code: 0xc0000026\")\n  win32_invalid_exception_disposition: bool;\n  @default(0) @display_name(\"Break On Win32 Array Bounds Exceeded Exceptions\") @description(\"Code: 0xc000008c\")\n  win32_array_bounds_exceeded: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Denormal Operand Exceptions\") @description(\"Code: 0xc000008d\")\n  win32_floating_point_denormal_operand: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Division By Zero Exceptions\") @description(\"Code: 0xc000008e\")\n  win32_floating_point_division_by_zero: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Inexact Result Exceptions\") @description(\"Code: 0xc000008f\")\n  win32_floating_point_inexact_result: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Invalid Operation Exceptions\") @description(\"Code: 0xc0000090\")\n  win32_floating_point_invalid_operation: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Overflow Exceptions\") @description(\"Code: 0xc0000091\")\n  win32_floating_point_overflow: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Stack Check Exceptions\") @description(\"Code: 0xc0000092\")\n  win32_floating_point_stack_check: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Underflow Exceptions\") @description(\"Code: 0xc0000093\")\n  win32_floating_point_underflow: bool;\n  @default(0) @display_name(\"Break On Win32 Integer Division By Zero Exceptions\") @description(\"Code: 0xc0000094\")\n  win32_integer_division_by_zero: bool;\n  @default(0) @display_name(\"Break On Win32 Integer Overflow Exceptions\") @description(\"Code: 0xc0000095\")\n  win32_integer_overflow: bool;\n  @default(0) @display_name(\"Break On Win32 Privileged Instruction Exceptions\") @description(\"Code: 0xc0000096\")\n  win32_privileged_instruction: bool;\n  @default(0) @display_name(\"Break On Win32 Stack Overflow Exceptions\") @description(\"Code: 0xc00000fd\")\n  win32_stack_overflow: bool;\n  @default(0) @display_name(\"Break On Win32 Unable To Locate DLL Exceptions\") @description(\"Code: 0xc0000135\")\n  win32_unable_to_locate_dll: bool;\n  @default(0) @display_name(\"Break On Win32 Ordinal Not Found Exceptions\") @description(\"Code: 0xc0000138\")\n  win32_ordinal_not_found: bool;\n  @default(0) @display_name(\"Break On Win32 Entry Point Not Found Exceptions\") @description(\"Code: 0xc0000139\")\n  win32_entry_point_not_found: bool;\n  @default(0) @display_name(\"Break On Win32 DLL Initialization Failed Exceptions\") @description(\"Code: 0xc0000142\")\n  win32_dll_initialization_failed: bool;\n  @default(0) @display_name(\"Break On Win32 Floating Point SSE Multiple Faults Exceptions\") @description(\"Code: 0xc00002b4\")\n  win32_floating_point_sse_multiple_faults: bool;\n  @default(0) @display_name(\"Break On Win32 Floating Point SSE Multiple Traps Exceptions\") @description(\"Code: 0xc00002b5\")\n  win32_floating_point_sse_multiple_traps: bool;\n  @default(1) @display_name(\"Break On Win32 Assertion Failed Exceptions\") @description(\"Code: 0xc0000420\")\n  win32_assertion_failed: bool;\n  @default(0) @display_name(\"Break On Win32 Module Not Found Exceptions\") @description(\"Code: 0xc06d007e\")\n  win32_module_not_found: bool;\n  @default(0) @display_name(\"Break On Win32 Procedure Not Found Exceptions\") @description(\"Code: 0xc06d007f\")\n  win32_procedure_not_found: bool;\n  @default(1) @display_name(\"Break On Win32 Sanitizer Error Detected Exceptions\") @description(\"Code: 0xe073616e\")\n  win32_sanitizer_error_detected: bool;\n  @default(0) @display_name(\"Break On Win32 Sanitizer Raw Access Violation Exceptions\") @description(\"Code: 0xe0736171\")\n  win32_sanitizer_raw_access_violation: bool;\n  @default(1) @display_name(\"Break On Win32 DirectX Debug Layer Exceptions\") @description(\"Code: 0x0000087a\")\n  win32_directx_debug_layer: bool;\n}\n")},
+{str8_lit_comp("project"), str8_lit_comp("@expand_commands(edit_project_theme) x:\n{\n  @default(2) @display_name('Project Tab Width') 'tab_width': @range[1, 32] u64,\n\n  //- rjf: visualizers\n  @display_name('Use Default C++ STL Type Visualizers') @description(\"Enables the built-in type views for C++ STL types.\")\n  @default(1) use_default_stl_type_views: bool,\n  @display_name('Use Default Unreal Engine Type Visualizers') @description(\"Enables the built-in type views for Unreal Engine types.\")\n  @default(1) use_default_ue_type_views: bool,\n\n  //- conditional breakpoints\n  @default(0) @display_name('Evaluate Breakpoint Conditions In Target') @description(\"Evaluates simple breakpoint conditions inside the debugged process, so it only stops when they hold. Currently only supported for x64 Linux targets.\")\n  'in_target_breakpoint_conditions': bool,\n\n  //- rjf: theme\n  @default(\"None\") @display_name('Project Theme') @description(\"The project's theme, which describes all colors used throughout the UI, and can override the user's theme.\")\n  'theme': string,\n  @no_expand @display_name('Project Theme') @description(\"The project's theme, which describes all colors used throughout the UI, and can override the user's theme.\")\n  'theme_colors': query,\n\n  //- rjf: exception settings\n  @default(1) @display_name(\"Break On Win32 Control-C Exceptions\") @description(\"Code: 0x40010005\")\n  win32_ctrl_c: bool;\n  @default(1) @display_name(\"Break On Win32 Control-Break Exceptions\") @description(\"Code: 0x40010008\")\n  win32_ctrl_break: bool;\n  @default(0) @display_name(\"Break On Win32 WinRT Originate Error Exceptions\") @description(\"Code: 0x40080201\")\n  win32_win_rt_originate_error: bool;\n  @default(0) @display_name(\"Break On Win32 WinRT Transform Error Exceptions\") @description(\"Code: 0x40080202\")\n  win32_win_rt_transform_error: bool;\n  @default(0) @display_name(\"Break On Win32 RPC Call Cancelled Exceptions\") @description(\"Code: 0x0000071a\")\n  win32_rpc_call_cancelled: bool;\n  @default(0) @display_name(\"Break On Win32 Data Type Misalignment Exceptions\") @description(\"Code: 0x80000002\")\n  win32_datatype_misalignment: bool;\n  @default(1) @display_name(\"Break On Win32 Access Violation Exceptions\") @description(\"Code: 0xc0000005\")\n  win32_access_violation: bool;\n  @default(0) @display_name(\"Break On Win32 In Page Error Exceptions\") @description(\"Code: 0xc0000006\")\n  win32_in_page_error: bool;\n  @default(1) @display_name(\"Break On Win32 Invalid Handle Specified Exceptions\") @description(\"Code: 0xc0000008\")\n  win32_invalid_handle: bool;\n  @default(0) @display_name(\"Break On Win32 Not Enough Quota Exceptions\") @description(\"Code: 0xc0000017\")\n  win32_not_enough_quota: bool;\n  @default(0) @display_name(\"Break On Win32 Illegal Instruction Exceptions\") @description(\"Code: 0xc000001d\")\n  win32_illegal_instruction: bool;\n  @default(0) @display_name(\"Break On Win32 Cannot Continue From Exception Exceptions\") @description(\"Code: 0xc0000025\")\n  win32_cannot_continue_exception: bool;\n  @default(0) @display_name(\"Break On Win32 Invalid Exception Disposition Returned By Handler Exceptions\") @description(\"Code: 0xc0000026\")\n  win32_invalid_exception_disposition: bool;\n  @default(0) @display_name(\"Break On Win32 Array Bounds Exceeded Exceptions\") @description(\"Code: 0xc000008c\")\n  win32_array_bounds_exceeded: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Denormal Operand Exceptions\") @description(\"Code: 0xc000008d\")\n  win32_floating_point_denormal_operand: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Division By Zero Exceptions\") @description(\"Code: 0xc000008e\")\n  win32_floating_point_division_by_zero: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Inexact Result Exceptions\") @description(\"Code: 0xc000008f\")\n  win32_floating_point_inexact_result: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Invalid Operation Exceptions\") @description(\"Code: 0xc0000090\")\n  win32_floating_point_invalid_operation: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Overflow Exceptions\") @description(\"Code: 0xc0000091\")\n  win32_floating_point_overflow: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Stack Check Exceptions\") @description(\"Code: 0xc0000092\")\n  win32_floating_point_stack_check: bool;\n  @default(0) @display_name(\"Break On Win32 Floating-Point Underflow Exceptions\") @description(\"Code: 0xc0000093\")\n  win32_floating_point_underflow: bool;\n  @default(0) @display_name(\"Break On Win32 Integer Division By Zero Exceptions\") @description(\"Code: 0xc0000094\")\n  win32_integer_division_by_zero: bool;\n  @default(0) @display_name(\"Break On Win32 Integer Overflow Exceptions\") @description(\"Code: 0xc0000095\")\n  win32_integer_overflow: bool;\n  @default(0) @display_name(\"Break On Win32 Privileged Instruction Exceptions\") @description(\"Code: 0xc0000096\")\n  win32_privileged_instruction: bool;\n  @default(0) @display_name(\"Break On Win32 Stack Overflow Exceptions\") @description(\"Code: 0xc00000fd\")\n  win32_stack_overflow: bool;\n  @default(0) @display_name(\"Break On Win32 Unable To Locate DLL Exceptions\") @description(\"Code: 0xc0000135\")\n  win32_unable_to_locate_dll: bool;\n  @default(0) @display_name(\"Break On Win32 Ordinal Not Found Exceptions\") @description(\"Code: 0xc0000138\")\n  win32_ordinal_not_found: bool;\n  @default(0) @display_name(\"Break On Win32 Entry Point Not Found Exceptions\") @description(\"Code: 0xc0000139\")\n  win32_entry_point_not_found: bool;\n  @default(0) @display_name(\"Break On Win32 DLL Initialization Failed Exceptions\") @description(\"Code: 0xc0000142\")\n  win32_dll_initialization_failed: bool;\n  @default(0) @display_name(\"Break On Win32 Floating Point SSE Multiple Faults Exceptions\") @description(\"Code: 0xc00002b4\")\n  win32_floating_point_sse_multiple_faults: bool;\n  @default(0) @display_name(\"Break On Win32 Floating Point SSE Multiple Traps Exceptions\") @description(\"Code: 0xc00002b5\")\n  win32_floating_point_sse_multiple_traps: bool;\n  @default(1) @display_name(\"Break On Win32 Assertion Failed Exceptions\") @description(\"Code: 0xc0000420\")\n  win32_assertion_failed: bool;\n  @default(0) @display_name(\"Break On Win32 Module Not Found Exceptions\") @description(\"Code: 0xc06d007e\")\n  win32_module_not_found: bool;\n  @default(0) @display_name(\"Break On Win32 Procedure Not Found Exceptions\") @description(\"Code: 0xc06d007f\")\n  win32_procedure_not_found: bool;\n  @default(1) @display_name(\"Break On Win32 Sanitizer Error Detected Exceptions\") @description(\"Code: 0xe073616e\")\n  win32_sanitizer_error_detected: bool;\n  @default(0) @display_name(\"Break On Win32 Sanitizer Raw Access Violation Exceptions\") @description(\"Code: 0xe0736171\")\n  win32_sanitizer_raw_access_violation: bool;\n  @default(1) @display_name(\"Break On Win32 DirectX Debug Layer Exceptions\") @description(\"Code: 0x0000087a\")\n  win32_directx_debug_layer: bool;\n}\n")},
 {str8_lit_comp("theme_color"), str8_lit_comp("@collection_commands(add_theme_color, fork_theme, save_theme, save_and_set_theme)\n@row_commands(duplicate_cfg, remove_cfg)\nx:\n{\n  @display_name('Tags') tags: string,\n  @display_name('Value') value: @color @hex u32,\n}\n")},
 {str8_lit_comp("window"), str8_lit_comp("x:\n{\n  //- rjf: text rasterization settings\n  @default(1) @display_name('Smooth UI Text') @description(\"Controls whether or not UI text is fully anti-aliased, for a smoother appearance.\")\n  'smooth_ui_text': bool,\n  @default(1) @display_name('Hint UI Text') @description(\"Controls whether or not UI text is hinted, for better text readability at small sizes.\")\n  'hint_ui_text': bool,\n  @default(0) @display_name('Smooth Code Text') @description(\"Controls whether or not code text is fully anti-aliased, for a smoother appearance.\")\n  'smooth_code_text': bool,\n  @default(1) @display_name('Hint Code Text') @description(\"Controls whether or not code text is hinted, for better text readability at small sizes.\")\n  'hint_code_text': bool,\n  @default(11) @display_name('Window Font Size') @description(\"Controls the window's default font size. Does not apply to tabs with their own font size set.\")\n  'font_size': @range[6, 72] u64,\n\n  //- rjf: size settings\n  @default(3.f) @display_name('Window Row Height') @description(\"Controls the window's default row height, in multiples of the font size. Does not apply to tabs with their own row height set.\")\n  'row_height': @range[1.75f, 5.f] f32,\n  @default(3.f) @description(\"Controls the height of tabs, in multiples of the font size.\")\n  'tab_height': @range[1.75f, 5.f] f32,\n\n  //- rjf: theme settings\n  @default(1) @display_name('Use Project Theme') @description(\"Prefer using the project theme for this window, if any. If off, only the user's theme settings will be used.\")\n  'use_project_theme': bool,\n}\n")},
 {str8_lit_comp("tab"), str8_lit_comp("@row_commands(@file copy_tab_full_path, @file show_file_in_explorer, duplicate_tab, close_tab)\nx:\n{\n  @override @display_name('Tab Font Size') @description(\"Controls the tab's font size.\") @no_callee_helper\n  'font_size': @range[6, 72] u64,\n}\n")},
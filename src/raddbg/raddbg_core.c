@@ -1997,6 +1997,59 @@ rd_eval_space_read(void *u, E_Space space, void *out, Rng1U64 range)
   return result;
 }
 
+internal B32
+rd_eval_space_read_async(void *u, E_Space space, void *out, Rng1U64 range)
+{
+  // NOTE: callable from any thread (e.g. background filter jobs) - so, only
+  // supports spaces which do not require the entity store, config, or the
+  // selected evaluation contexts
+  Temp scratch = scratch_begin(0, 0);
+  B32 result = 0;
+  switch(space.kind)
+  {
+    default:{}break;
+    
+    //- reads from hash store key
+    case E_SpaceKind_HashStoreKey:
+    {
+      C_Root root = {space.u64_0};
+      C_ID id = {space.u128};
+      C_Key key = c_key_make(root, id);
+      U128 hash = c_hash_from_key(key, 0);
+      Access *access = access_open();
+      {
+        String8 data = c_data_from_hash(access, hash);
+        Rng1U64 legal_range = r1u64(0, data.size);
+        Rng1U64 read_range = intersect_1u64(range, legal_range);
+        if(read_range.min < read_range.max)
+        {
+          result = 1;
+          MemoryCopy(out, data.str + read_range.min, dim_1u64(read_range));
+        }
+      }
+      access_close(access);
+    }break;
+    
+    //- process memory reads (thread register blocks are not supported; those
+    // reads fail, since no memory is cached for a thread handle)
+    case RD_EvalSpaceKind_CtrlEntity:
+    {
+      CTRL_Handle handle = {0};
+      handle.machine_id = space.u64s[0];
+      handle.dmn_handle.u64[0] = space.u64s[1];
+      CTRL_ProcessMemorySlice slice = ctrl_process_memory_slice_from_vaddr_range(scratch.arena, handle, range, os_now_microseconds()+50000);
+      String8 data = slice.data;
+      if(data.size == dim_1u64(range))
+      {
+        result = 1;
+        MemoryCopy(out, data.str, data.size);
+      }
+    }break;
+  }
+  scratch_end(scratch);
+  return result;
+}
+
 internal B32
 rd_eval_space_write(void *u, E_Space space, void *in, Rng1U64 range)
 {
@@ -3066,6 +3119,11 @@ rd_view_ui(Rng2F32 rect)
               }
               block_tree   = ev_block_tree_from_eval(scratch.arena, eval_view, filter, eval);
               block_ranges = ev_block_range_list_from_tree(scratch.arena, &block_tree);
+              if(block_tree.filter_is_pending)
+              {
+                rd_store_view_loading_info(1, block_tree.filter_scanned_count, block_tree.filter_total_count);
+                rd_request_frame();
+              }
               if(implicit_root && block_ranges.first != 0)
               {
                 block_ranges.count -= 1;
@@ -11887,6 +11945,7 @@ rd_frame(void)
     CTRL_EntityArray all_modules = ctrl_entity_array_from_kind(&d_state->ctrl_entity_store->ctx, CTRL_EntityKind_Module);
     U64 eval_modules_count = Max(1, all_modules.count);
     E_Module *eval_modules = push_array(scratch.arena, E_Module, eval_modules_count);
+    DI_Key *eval_modules_dbgi_keys = push_array(scratch.arena, DI_Key, eval_modules_count);
     E_Module *eval_modules_primary = &eval_modules[0];
     eval_modules_primary->rdi = &rdi_parsed_nil;
     eval_modules_primary->vaddr_range = r1u64(0, max_U64);
@@ -11897,6 +11956,7 @@ rd_frame(void)
       {
         CTRL_Entity *m = all_modules.v[eval_module_idx];
         DI_Key dbgi_key = ctrl_dbgi_key_from_module(m);
+        eval_modules_dbgi_keys[eval_module_idx]   = dbgi_key;
         eval_modules[eval_module_idx].arch        = m->arch;
         eval_modules[eval_module_idx].rdi         = di_rdi_from_key(rd_state->frame_di_scope, &dbgi_key, 1, 0);
         eval_modules[eval_module_idx].vaddr_range = m->vaddr_range;
@@ -12594,6 +12654,16 @@ rd_frame(void)
     }
     ev_select_expand_rule_table(expand_rule_table);
     
+    ////////////////////////////
+    //- build environment for background filter jobs
+    //
+    EV_FilterJobEnv *filter_job_env = push_array(scratch.arena, EV_FilterJobEnv, 1);
+    {
+      filter_job_env->modules_dbgi_keys = eval_modules_dbgi_keys;
+      filter_job_env->space_read        = rd_eval_space_read_async;
+    }
+    ev_select_filter_job_env(filter_job_env);
+    
     ////////////////////////////
     //- rjf: gather config from loaded modules
     //
@@ -16981,11 +17051,20 @@ rd_frame(void)
       }
     }
     
+    ////////////////////////////
+    //- gather run flags which come from settings
+    //
+    CTRL_RunFlags run_flags = 0;
+    if(rd_setting_b32_from_name(str8_lit("in_target_breakpoint_conditions")))
+    {
+      run_flags |= CTRL_RunFlag_InTargetConditions;
+    }
+    
     ////////////////////////////
     //- rjf: tick debug engine
     //
     U64 cmd_count_pre_tick = rd_state->cmds[0].count;
-    D_EventList engine_events = d_tick(scratch.arena, &targets, &breakpoints, &path_maps, exception_code_filters);
+    D_EventList engine_events = d_tick(scratch.arena, &targets, &breakpoints, &path_maps, exception_code_filters, run_flags);
     
     ////////////////////////////
     //- rjf: process debug engine events
@@ -17266,6 +17345,14 @@ rd_frame(void)
     }
   }
   
+  //////////////////////////////
+  //- glyph rasterizations still in flight -> keep producing frames
+  //
+  if(fnt_pending_raster_count() != 0)
+  {
+    rd_request_frame();
+  }
+  
   //////////////////////////////
   //- rjf: garbage collect untouched window states
   //
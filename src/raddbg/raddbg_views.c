@@ -363,7 +363,7 @@ rd_code_view_build(Arena *arena, RD_CodeViewState *cv, RD_CodeViewBuildFlags fla
         if(ctrl_entity_ancestor_from_kind(thread, CTRL_EntityKind_Process) == process && contains_1u64(dasm_vaddr_range, rip_vaddr))
         {
           U64 rip_off = rip_vaddr - dasm_vaddr_range.min;
-          S64 line_num = dasm_line_array_idx_from_code_off__linear_scan(dasm_lines, rip_off)+1;
+          S64 line_num = dasm_line_array_idx_from_code_off(dasm_lines, rip_off)+1;
           if(contains_1s64(visible_line_num_range, line_num))
           {
             U64 slice_line_idx = (line_num-visible_line_num_range.min);
@@ -385,7 +385,7 @@ rd_code_view_build(Arena *arena, RD_CodeViewState *cv, RD_CodeViewBuildFlags fla
         if(contains_1u64(dasm_vaddr_range, loc_value.u64))
         {
           U64 off = loc_value.u64 - dasm_vaddr_range.min;
-          U64 idx = dasm_line_array_idx_from_code_off__linear_scan(dasm_lines, off);
+          U64 idx = dasm_line_array_idx_from_code_off(dasm_lines, off);
           S64 line_num = (S64)idx+1;
           if(contains_1s64(visible_line_num_range, line_num))
           {
@@ -408,7 +408,7 @@ rd_code_view_build(Arena *arena, RD_CodeViewState *cv, RD_CodeViewBuildFlags fla
         if(contains_1u64(dasm_vaddr_range, loc_value.u64))
         {
           U64 off = loc_value.u64 - dasm_vaddr_range.min;
-          U64 idx = dasm_line_array_idx_from_code_off__linear_scan(dasm_lines, off);
+          U64 idx = dasm_line_array_idx_from_code_off(dasm_lines, off);
           S64 line_num = (S64)idx+1;
           if(contains_1s64(visible_line_num_range, line_num))
           {
@@ -2266,6 +2266,8 @@ struct RD_DisasmViewState
   U64 temp_look_vaddr;
   U64 temp_look_run_gen;
   U64 goto_vaddr;
+  U64 window_vaddr;
+  Rng1U64 window_range;
   RD_CodeViewState cv;
 };
 
@@ -2355,6 +2357,41 @@ RD_VIEW_UI_FUNCTION_DEF(disasm)
   }
   Rng1U64 range = rd_space_range_from_eval(eval);
   Arch arch = rd_arch_from_eval(eval);
+  
+  //////////////////////////////
+  //- large ranges -> only decode a window of chunks around the address being
+  // looked at, rather than the whole range
+  //
+  Rng1U64 full_range = range;
+  U64 lead_in_size = 0;
+  B32 is_windowed = (dim_1u64(full_range) > DASM_WINDOW_SIZE);
+  if(is_windowed)
+  {
+    if(dv->goto_vaddr != 0 && contains_1u64(full_range, dv->goto_vaddr) && !contains_1u64(dv->window_range, dv->goto_vaddr))
+    {
+      dv->window_vaddr = dv->goto_vaddr;
+    }
+    if(!contains_1u64(full_range, dv->window_vaddr))
+    {
+      dv->window_vaddr = full_range.min;
+    }
+    U64 full_size = dim_1u64(full_range);
+    U64 window_off = AlignDownPow2(dv->window_vaddr - full_range.min, DASM_CHUNK_SIZE);
+    window_off = ClampBot(window_off, DASM_WINDOW_SIZE/2) - DASM_WINDOW_SIZE/2;
+    window_off = Min(window_off, AlignDownPow2(full_size - DASM_WINDOW_SIZE, DASM_CHUNK_SIZE));
+    U64 window_opl = window_off + DASM_WINDOW_SIZE;
+    if(full_size - window_opl < DASM_CHUNK_SIZE)
+    {
+      window_opl = full_size;
+    }
+    dv->window_range = r1u64(full_range.min + window_off, full_range.min + window_opl);
+    
+    // windows inside of the range may start mid-instruction - decode the
+    // chunk before the window as a lead-in, to find an instruction boundary
+    lead_in_size = (window_off != 0 ? DASM_CHUNK_SIZE : 0);
+    range = r1u64(dv->window_range.min - lead_in_size, dv->window_range.max);
+  }
+  
   CTRL_Entity *space_entity = rd_ctrl_entity_from_eval_space(space);
   CTRL_Entity *dasm_module = &ctrl_entity_nil;
   DI_Key dbgi_key = {0};
@@ -2399,12 +2436,13 @@ RD_VIEW_UI_FUNCTION_DEF(disasm)
   U128 dasm_data_hash = {0};
   DASM_Params dasm_params = {0};
   {
-    dasm_params.vaddr       = range.min;
-    dasm_params.arch        = arch;
-    dasm_params.style_flags = style_flags;
-    dasm_params.syntax      = syntax;
-    dasm_params.base_vaddr  = base_vaddr;
-    dasm_params.dbgi_key    = dbgi_key;
+    dasm_params.vaddr        = range.min;
+    dasm_params.arch         = arch;
+    dasm_params.style_flags  = style_flags;
+    dasm_params.syntax       = syntax;
+    dasm_params.base_vaddr   = base_vaddr;
+    dasm_params.dbgi_key     = dbgi_key;
+    dasm_params.lead_in_size = lead_in_size;
   }
   DASM_Info dasm_info = dasm_info_from_key_params(access, dasm_key, &dasm_params, &dasm_data_hash);
   rd_regs()->text_key = dasm_info.text_key;
@@ -2429,7 +2467,7 @@ RD_VIEW_UI_FUNCTION_DEF(disasm)
   if(!is_loading && has_disasm && dv->goto_vaddr != 0 && contains_1u64(range, dv->goto_vaddr))
   {
     U64 vaddr = dv->goto_vaddr;
-    U64 line_idx = dasm_line_array_idx_from_code_off__linear_scan(&dasm_info.lines, vaddr-range.min);
+    U64 line_idx = dasm_line_array_idx_from_code_off(&dasm_info.lines, vaddr-range.min);
     if(line_idx < dasm_info.lines.count)
     {
       S64 line_num = (S64)(line_idx+1);
@@ -2459,6 +2497,22 @@ RD_VIEW_UI_FUNCTION_DEF(disasm)
     rd_regs()->lines = d_lines_from_dbgi_key_voff(rd_frame_arena(), &dbgi_key, rd_regs()->voff_range.min);
   }
   
+  //////////////////////////////
+  //- cursor near an inner edge of the decoded window -> re-center the window
+  // on the cursor, & go back to the cursor's address once it is decoded
+  //
+  if(!is_loading && has_disasm && is_windowed)
+  {
+    U64 cursor_vaddr = rd_regs()->vaddr;
+    B32 near_min = (dv->window_range.min != full_range.min && cursor_vaddr < dv->window_range.min + DASM_CHUNK_SIZE);
+    B32 near_max = (dv->window_range.max != full_range.max && cursor_vaddr + DASM_CHUNK_SIZE >= dv->window_range.max);
+    if(near_min || near_max)
+    {
+      dv->window_vaddr = cursor_vaddr;
+      dv->goto_vaddr = cursor_vaddr;
+    }
+  }
+  
   //////////////////////////////
   //- rjf: build bottom bar
   //
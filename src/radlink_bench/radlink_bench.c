@@ -0,0 +1,612 @@
+// Copyright (c) Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+// Build Options
+
+#define BUILD_CONSOLE_INTERFACE 1
+#define BUILD_TITLE "RADLINK_BENCH"
+
+////////////////////////////////
+
+#include "third_party/xxHash/xxhash.c"
+#include "third_party/xxHash/xxhash.h"
+#include "third_party/radsort/radsort.h"
+
+////////////////////////////////
+
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "coff/coff.h"
+#include "coff/coff_parse.h"
+#include "coff/coff_obj_writer.h"
+#include "coff/coff_lib_writer.h"
+#include "pe/pe.h"
+#include "pe/pe_section_flags.h"
+#include "codeview/codeview.h"
+#include "linker/base_ext/base_core.h"
+#include "linker/base_ext/base_arena.h"
+#include "linker/base_ext/base_arrays.h"
+#include "linker/hash_table.h"
+
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "coff/coff.c"
+#include "coff/coff_parse.c"
+#include "coff/coff_obj_writer.c"
+#include "coff/coff_lib_writer.c"
+#include "pe/pe.c"
+#include "codeview/codeview.c"
+#include "linker/hash_table.c"
+#include "linker/base_ext/base_core.c"
+#include "linker/base_ext/base_arena.c"
+#include "linker/base_ext/base_arrays.c"
+
+////////////////////////////////
+
+// Synthesizes a PE/COFF workload with the object writer, links it a number of times
+// and prints per-phase times and peak memory of every run as key=value lines.
+//
+// Workload shape:
+//  - every object defines `comdats` COMDAT functions and `types` LF_STRUCTURE/LF_POINTER pairs in .debug$T;
+//    `dup` percent of them use names shared across all objects, which is what the linker has to fold
+//  - every library holds `lib_members` objects of the same shape
+//  - entry object references an anchor function in each object and library member, so everything is pulled in
+
+typedef struct B_Workload
+{
+  U64 obj_count;
+  U64 comdat_count;
+  U64 type_count;
+  U64 dup_percent;
+  U64 lib_count;
+  U64 lib_member_count;
+} B_Workload;
+
+typedef struct B_Metric
+{
+  struct B_Metric *next;
+  String8          key;
+  U64             *values;
+} B_Metric;
+
+typedef struct B_MetricList
+{
+  U64       count;
+  B_Metric *first;
+  B_Metric *last;
+} B_MetricList;
+
+global String8 g_stdout_file_name = str8_lit_comp("radlink_bench.out");
+global String8 g_report_file_name = str8_lit_comp("radlink_bench.report");
+global String8 g_linker;
+global String8 g_out = str8_lit_comp("radlink_bench");
+global B32     g_redirect_stdout = 1;
+
+internal String8
+b_make_file_path(Arena *arena, String8 name)
+{
+  return push_str8f(arena, "%S/%S", g_out, name);
+}
+
+internal B32
+b_write_file(String8 name, String8 data)
+{
+  Temp scratch = scratch_begin(0,0);
+  String8 path = b_make_file_path(scratch.arena, name);
+  B32 is_written = os_write_data_to_file_path(path, data);
+  if (!is_written) {
+    fprintf(stderr, "ERROR: unable to write \"%.*s\"\n", str8_varg(path));
+  }
+  scratch_end(scratch);
+  return is_written;
+}
+
+////////////////////////////////
+
+internal String8
+b_func_name(Arena *arena, B_Workload *w, String8 unit_name, U64 func_idx)
+{
+  U64 shared_count = (w->comdat_count * w->dup_percent) / 100;
+  if (func_idx < shared_count) {
+    return push_str8f(arena, "bench_shared_func_%llu", func_idx);
+  }
+  return push_str8f(arena, "bench_%S_func_%llu", unit_name, func_idx);
+}
+
+internal String8
+b_type_name(Arena *arena, B_Workload *w, String8 unit_name, U64 type_idx)
+{
+  U64 shared_count = (w->type_count * w->dup_percent) / 100;
+  if (type_idx < shared_count) {
+    return push_str8f(arena, "bench_shared_type_%llu", type_idx);
+  }
+  return push_str8f(arena, "bench_%S_type_%llu", unit_name, type_idx);
+}
+
+internal void
+b_push_leaf(Arena *arena, String8List *list, CV_LeafKind kind, String8 data)
+{
+  // record size excludes the size field and records are padded to 4 bytes with LF_PAD bytes
+  U64 payload_size = sizeof(CV_LeafKind) + data.size;
+  U64 pad_size     = AlignPadPow2(sizeof(U16) + payload_size, 4);
+
+  U8 *buffer = push_array_no_zero(arena, U8, sizeof(U16) + payload_size + pad_size);
+  U8 *ptr    = buffer;
+
+  U16 record_size = safe_cast_u16x(payload_size + pad_size);
+  MemoryCopy(ptr, &record_size, sizeof(record_size)); ptr += sizeof(record_size);
+  U16 leaf_kind = kind;
+  MemoryCopy(ptr, &leaf_kind, sizeof(leaf_kind));     ptr += sizeof(leaf_kind);
+  MemoryCopy(ptr, data.str, data.size);               ptr += data.size;
+  for (U64 i = pad_size; i > 0; i -= 1) {
+    *ptr++ = (U8)(0xF0 + i);
+  }
+
+  str8_list_push(arena, list, str8(buffer, (U64)(ptr - buffer)));
+}
+
+internal String8
+b_make_debug_t(Arena *arena, B_Workload *w, String8 unit_name)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  String8List debug_t = {0};
+  str8_list_push(scratch.arena, &debug_t, str8_struct(&(CV_Signature){CV_Signature_C13}));
+
+  for (U64 type_idx = 0; type_idx < w->type_count; type_idx += 1) {
+    CV_TypeId struct_itype = CV_MinComplexTypeIndex + type_idx*2;
+
+    // forward declared structure: header, numeric size (values below LF_NUMERIC are stored inline), name
+    {
+      String8 name = b_type_name(scratch.arena, w, unit_name, type_idx);
+
+      CV_LeafStruct lf    = {0};
+      lf.props            = CV_TypeProp_FwdRef;
+      U16           size  = 0;
+
+      String8List data = {0};
+      str8_list_push(scratch.arena, &data, str8_struct(&lf));
+      str8_list_push(scratch.arena, &data, str8_struct(&size));
+      str8_list_push(scratch.arena, &data, str8(name.str, name.size + 1));
+      b_push_leaf(scratch.arena, &debug_t, CV_LeafKind_STRUCTURE, str8_list_join(scratch.arena, &data, 0));
+    }
+
+    // pointer to the structure gives the linker a type index to remap
+    {
+      CV_LeafPointer lf = {0};
+      lf.itype          = struct_itype;
+      lf.attribs        = CV_PointerKind_64 | (sizeof(U64) << 13);
+      b_push_leaf(scratch.arena, &debug_t, CV_LeafKind_POINTER, str8_struct(&lf));
+    }
+  }
+
+  String8 result = str8_list_join(arena, &debug_t, 0);
+  scratch_end(scratch);
+  return result;
+}
+
+internal String8
+b_make_obj(Arena *arena, B_Workload *w, String8 unit_name, String8 anchor_name)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+
+  //
+  // COMDAT functions
+  //
+  COFF_ObjSymbol **funcs = push_array(scratch.arena, COFF_ObjSymbol *, w->comdat_count);
+  for (U64 func_idx = 0; func_idx < w->comdat_count; func_idx += 1) {
+    String8 name = b_func_name(scratch.arena, w, unit_name, func_idx);
+
+    // mov eax, imm32; ret; int3 padding -- duplicates get identical bodies
+    U32 imm  = (U32)XXH3_64bits(name.str, name.size);
+    U8 *text = push_array(scratch.arena, U8, 16);
+    MemorySet(text, 0xCC, 16);
+    text[0] = 0xB8;
+    MemoryCopy(&text[1], &imm, sizeof(imm));
+    text[5] = 0xC3;
+
+    COFF_ObjSection *sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$mn"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align16Bytes, str8(text, 16));
+    coff_obj_writer_push_symbol_secdef(obj_writer, sect, COFF_ComdatSelect_Any);
+    funcs[func_idx] = coff_obj_writer_push_symbol_extern_func(obj_writer, name, 0, sect);
+  }
+
+  //
+  // Anchor: ret followed by a table of addresses that keeps every COMDAT referenced
+  //
+  {
+    U64 anchor_size = 1 + w->comdat_count*sizeof(U64);
+    U8 *anchor_text = push_array(scratch.arena, U8, anchor_size);
+    anchor_text[0]  = 0xC3;
+    COFF_ObjSection *sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$mn"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_Align16Bytes, str8(anchor_text, anchor_size));
+    coff_obj_writer_push_symbol_extern_func(obj_writer, anchor_name, 0, sect);
+    for (U64 func_idx = 0; func_idx < w->comdat_count; func_idx += 1) {
+      coff_obj_writer_section_push_reloc_addr(obj_writer, sect, 1 + func_idx*sizeof(U64), funcs[func_idx]);
+    }
+  }
+
+  //
+  // Types
+  //
+  if (w->type_count) {
+    String8 debug_t = b_make_debug_t(scratch.arena, w, unit_name);
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$T"), COFF_SectionFlag_CntInitializedData|COFF_SectionFlag_MemDiscardable|COFF_SectionFlag_MemRead|COFF_SectionFlag_Align1Bytes, debug_t);
+  }
+
+  String8 obj = coff_obj_writer_serialize(arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+
+  scratch_end(scratch);
+  return obj;
+}
+
+internal String8
+b_make_entry_obj(Arena *arena, String8List anchors)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+
+  COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+
+  U64 entry_size = 1 + anchors.node_count*sizeof(U64);
+  U8 *entry_text = push_array(scratch.arena, U8, entry_size);
+  entry_text[0]  = 0xC3;
+  COFF_ObjSection *sect = coff_obj_writer_push_section(obj_writer, str8_lit(".text$mn"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_Align16Bytes, str8(entry_text, entry_size));
+  coff_obj_writer_push_symbol_extern_func(obj_writer, str8_lit("bench_entry"), 0, sect);
+
+  U64 anchor_idx = 0;
+  for (String8Node *anchor_n = anchors.first; anchor_n != 0; anchor_n = anchor_n->next, anchor_idx += 1) {
+    COFF_ObjSymbol *anchor = coff_obj_writer_push_symbol_undef(obj_writer, anchor_n->string);
+    coff_obj_writer_section_push_reloc_addr(obj_writer, sect, 1 + anchor_idx*sizeof(U64), anchor);
+  }
+
+  String8 obj = coff_obj_writer_serialize(arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+
+  scratch_end(scratch);
+  return obj;
+}
+
+internal B32
+b_generate_workload(Arena *arena, B_Workload *w, String8List *inputs_out)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  B32 is_generated = 0;
+
+  String8List anchors = {0};
+
+  for (U64 obj_idx = 0; obj_idx < w->obj_count; obj_idx += 1) {
+    Temp temp = temp_begin(scratch.arena);
+    String8 unit_name   = push_str8f(temp.arena, "obj%llu", obj_idx);
+    String8 anchor_name = push_str8f(arena, "bench_%S_anchor", unit_name);
+    String8 obj         = b_make_obj(temp.arena, w, unit_name, anchor_name);
+    String8 obj_name    = push_str8f(arena, "%S.obj", unit_name);
+    if (!b_write_file(obj_name, obj)) {
+      goto exit;
+    }
+    temp_end(temp);
+    str8_list_push(arena, &anchors, anchor_name);
+    str8_list_push(arena, inputs_out, obj_name);
+  }
+
+  for (U64 lib_idx = 0; lib_idx < w->lib_count; lib_idx += 1) {
+    Temp temp = temp_begin(scratch.arena);
+    COFF_LibWriter *lib_writer = coff_lib_writer_alloc();
+    for (U64 member_idx = 0; member_idx < w->lib_member_count; member_idx += 1) {
+      String8 unit_name   = push_str8f(temp.arena, "lib%llu_member%llu", lib_idx, member_idx);
+      String8 anchor_name = push_str8f(arena, "bench_%S_anchor", unit_name);
+      String8 obj         = b_make_obj(temp.arena, w, unit_name, anchor_name);
+      coff_lib_writer_push_obj(lib_writer, push_str8f(temp.arena, "%S.obj", unit_name), obj);
+      str8_list_push(arena, &anchors, anchor_name);
+    }
+    String8 lib = coff_lib_writer_serialize(temp.arena, lib_writer, 0, 0, 1);
+    coff_lib_writer_release(&lib_writer);
+    String8 lib_name = push_str8f(arena, "lib%llu.lib", lib_idx);
+    if (!b_write_file(lib_name, lib)) {
+      goto exit;
+    }
+    temp_end(temp);
+    str8_list_push(arena, inputs_out, lib_name);
+  }
+
+  {
+    String8 entry_obj = b_make_entry_obj(scratch.arena, anchors);
+    if (!b_write_file(str8_lit("entry.obj"), entry_obj)) {
+      goto exit;
+    }
+    str8_list_push_front(arena, inputs_out, str8_lit("entry.obj"));
+  }
+
+  is_generated = 1;
+  exit:;
+  scratch_end(scratch);
+  return is_generated;
+}
+
+////////////////////////////////
+
+internal int
+b_invoke_linker(String8 wdir, String8List args)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  OS_Handle output_redirect = {0};
+  if (g_redirect_stdout) {
+    String8 stdout_path = b_make_file_path(scratch.arena, g_stdout_file_name);
+    output_redirect = os_file_open(OS_AccessFlag_Append|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite|OS_AccessFlag_Inherited, stdout_path);
+  }
+
+  OS_ProcessLaunchParams launch_opts = {0};
+  launch_opts.path                   = wdir;
+  launch_opts.inherit_env            = 1;
+  launch_opts.stdout_file            = output_redirect;
+  launch_opts.stderr_file            = output_redirect;
+  str8_list_push(scratch.arena, &launch_opts.cmd_line, g_linker);
+  str8_list_concat_in_place(&launch_opts.cmd_line, &args);
+
+  int exit_code = -1;
+  OS_Handle linker_handle = os_process_launch(&launch_opts);
+  if (os_handle_match(linker_handle, os_handle_zero())) {
+    fprintf(stderr, "ERROR: unable to start process: %.*s\n", str8_varg(g_linker));
+  } else {
+    os_process_join_exit_code(linker_handle, max_U64, &exit_code);
+    os_process_detach(linker_handle);
+  }
+
+  if (g_redirect_stdout) {
+    os_file_close(output_redirect);
+  }
+
+  scratch_end(scratch);
+  return exit_code;
+}
+
+internal B_Metric *
+b_metric_from_key(Arena *arena, B_MetricList *metrics, String8 key, U64 run_count)
+{
+  for (B_Metric *m = metrics->first; m != 0; m = m->next) {
+    if (str8_match(m->key, key, 0)) {
+      return m;
+    }
+  }
+  B_Metric *m = push_array(arena, B_Metric, 1);
+  m->key      = push_str8_copy(arena, key);
+  m->values   = push_array(arena, U64, run_count);
+  SLLQueuePush(metrics->first, metrics->last, m);
+  metrics->count += 1;
+  return m;
+}
+
+internal void
+b_parse_report(Arena *arena, B_MetricList *metrics, String8 report, U64 run_idx, U64 run_count)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  String8List lines = str8_split(scratch.arena, report, (U8 *)"\r\n", 2, 0);
+  for (String8Node *line_n = lines.first; line_n != 0; line_n = line_n->next) {
+    U64 eq_pos = str8_find_needle(line_n->string, 0, str8_lit("="), 0);
+    if (eq_pos < line_n->string.size) {
+      String8   key   = str8_prefix(line_n->string, eq_pos);
+      String8   value = str8_skip(line_n->string, eq_pos + 1);
+      B_Metric *m     = b_metric_from_key(arena, metrics, key, run_count);
+      m->values[run_idx] = u64_from_str8(value, 10);
+    }
+  }
+  scratch_end(scratch);
+}
+
+internal int
+b_u64_is_before(void *raw_a, void *raw_b)
+{
+  U64 *a = raw_a;
+  U64 *b = raw_b;
+  return *a < *b;
+}
+
+internal void
+b_print_metrics(String8 prefix, B_MetricList *metrics, U64 idx)
+{
+  fprintf(stdout, "%.*s", str8_varg(prefix));
+  for (B_Metric *m = metrics->first; m != 0; m = m->next) {
+    fprintf(stdout, " %.*s=%llu", str8_varg(m->key), (unsigned long long)m->values[idx]);
+  }
+  fprintf(stdout, "\n");
+}
+
+////////////////////////////////
+
+internal U64
+b_u64_opt(CmdLine *cmdline, char *name, U64 default_value)
+{
+  U64 value = default_value;
+  CmdLineOpt *opt = cmd_line_opt_from_string(cmdline, str8_cstring(name));
+  if (opt) {
+    if (opt->value_strings.node_count == 1 && try_u64_from_str8_c_rules(opt->value_string, &value)) {
+      // parsed
+    } else {
+      fprintf(stderr, "ERROR: -%s expects a single integer argument\n", name);
+      os_abort(1);
+    }
+  }
+  return value;
+}
+
+internal void
+entry_point(CmdLine *cmdline)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  B_Workload w       = {0};
+  w.obj_count        = 256;
+  w.comdat_count     = 64;
+  w.type_count       = 64;
+  w.dup_percent      = 50;
+  w.lib_count        = 4;
+  w.lib_member_count = 64;
+  U64 run_count      = 5;
+
+  //
+  // Handle -help
+  //
+  {
+    B32 print_help = cmd_line_has_flag(cmdline, str8_lit("help")) ||
+                     cmd_line_has_flag(cmdline, str8_lit("h"));
+    if (print_help) {
+      fprintf(stderr, "--- Help -----------------------------------------------------------------------\n");
+      fprintf(stderr, " %s\n\n", BUILD_TITLE_STRING_LITERAL);
+      fprintf(stderr, " Usage: radlink_bench [Options] [-- Linker Options]\n\n");
+      fprintf(stderr, " Options:\n");
+      fprintf(stderr, "   -linker:{path}      Path to radlink (default \"radlink\")\n");
+      fprintf(stderr, "   -out:{path}         Directory for the workload and link outputs (default \"%.*s\")\n", str8_varg(g_out));
+      fprintf(stderr, "   -objs:{#}           Number of objects on the command line (default %llu)\n", (unsigned long long)w.obj_count);
+      fprintf(stderr, "   -comdats:{#}        COMDAT functions per object (default %llu)\n", (unsigned long long)w.comdat_count);
+      fprintf(stderr, "   -types:{#}          Structure/pointer type pairs per object (default %llu)\n", (unsigned long long)w.type_count);
+      fprintf(stderr, "   -dup:{#}            Percent of COMDATs and types shared across objects (default %llu)\n", (unsigned long long)w.dup_percent);
+      fprintf(stderr, "   -libs:{#}           Number of libraries (default %llu)\n", (unsigned long long)w.lib_count);
+      fprintf(stderr, "   -lib_members:{#}    Objects per library (default %llu)\n", (unsigned long long)w.lib_member_count);
+      fprintf(stderr, "   -runs:{#}           Number of timed links (default %llu)\n", (unsigned long long)run_count);
+      fprintf(stderr, "   -skip_gen           Reuse workload from a previous run\n");
+      fprintf(stderr, "   -print_stdout       Print to console stdout and stderr of the linker\n");
+      fprintf(stderr, "   -help               Print help menu and exit\n\n");
+      fprintf(stderr, " Output: one line per run and min/median/max lines, each a list of key=value pairs.\n");
+      fprintf(stderr, " Times are in microseconds and memory is in bytes.\n");
+      os_abort(0);
+    }
+  }
+
+  //
+  // Handle options
+  //
+  {
+    CmdLineOpt *linker_opt = cmd_line_opt_from_string(cmdline, str8_lit("linker"));
+    if (linker_opt) {
+      if (linker_opt->value_strings.node_count == 1) {
+        g_linker = linker_opt->value_string;
+      } else {
+        fprintf(stderr, "ERROR: -linker has invalid number of arguments\n");
+        os_abort(1);
+      }
+    } else {
+      g_linker = str8_lit("radlink");
+    }
+
+    CmdLineOpt *out_opt = cmd_line_opt_from_string(cmdline, str8_lit("out"));
+    if (out_opt) {
+      if (out_opt->value_strings.node_count == 1) {
+        g_out = out_opt->value_string;
+      } else {
+        fprintf(stderr, "ERROR: -out has invalid number of arguments\n");
+        os_abort(1);
+      }
+    }
+
+    w.obj_count        = b_u64_opt(cmdline, "objs",        w.obj_count);
+    w.comdat_count     = b_u64_opt(cmdline, "comdats",     w.comdat_count);
+    w.type_count       = b_u64_opt(cmdline, "types",       w.type_count);
+    w.dup_percent      = Min(b_u64_opt(cmdline, "dup", w.dup_percent), 100);
+    w.lib_count        = b_u64_opt(cmdline, "libs",        w.lib_count);
+    w.lib_member_count = b_u64_opt(cmdline, "lib_members", w.lib_member_count);
+    run_count          = Max(b_u64_opt(cmdline, "runs", run_count), 1);
+    g_redirect_stdout  = !cmd_line_has_flag(cmdline, str8_lit("print_stdout"));
+  }
+
+  //
+  // Make Output Directory
+  //
+  os_make_directory(g_out);
+  if (!os_folder_path_exists(g_out)) {
+    fprintf(stderr, "ERROR: unable to create output directory \"%.*s\"\n", str8_varg(g_out));
+    os_abort(1);
+  }
+  String8 wdir = os_full_path_from_path(scratch.arena, g_out);
+  os_delete_file_at_path(b_make_file_path(scratch.arena, g_stdout_file_name));
+
+  //
+  // Generate Workload
+  //
+  String8 rsp_name = str8_lit("radlink_bench.rsp");
+  if (!cmd_line_has_flag(cmdline, str8_lit("skip_gen"))) {
+    U64 gen_begin = os_now_microseconds();
+
+    String8List inputs = {0};
+    if (!b_generate_workload(scratch.arena, &w, &inputs)) {
+      os_abort(1);
+    }
+
+    // inputs go through a response file to stay under the command line length limit
+    StringJoin rsp_join = { .sep = str8_lit_comp("\n"), .post = str8_lit_comp("\n") };
+    if (!b_write_file(rsp_name, str8_list_join(scratch.arena, &inputs, &rsp_join))) {
+      os_abort(1);
+    }
+
+    fprintf(stdout, "workload objs=%llu comdats=%llu types=%llu dup=%llu libs=%llu lib_members=%llu gen_us=%llu\n",
+            (unsigned long long)w.obj_count, (unsigned long long)w.comdat_count, (unsigned long long)w.type_count, (unsigned long long)w.dup_percent,
+            (unsigned long long)w.lib_count, (unsigned long long)w.lib_member_count, (unsigned long long)(os_now_microseconds() - gen_begin));
+  }
+
+  //
+  // Link Command Line
+  //
+  String8List args = {0};
+  str8_list_pushf(scratch.arena, &args, "/nologo");
+  str8_list_pushf(scratch.arena, &args, "/MACHINE:X64");
+  str8_list_pushf(scratch.arena, &args, "/SUBSYSTEM:CONSOLE");
+  str8_list_pushf(scratch.arena, &args, "/ENTRY:bench_entry");
+  str8_list_pushf(scratch.arena, &args, "/NODEFAULTLIB");
+  str8_list_pushf(scratch.arena, &args, "/DEBUG:FULL");
+  str8_list_pushf(scratch.arena, &args, "/OUT:radlink_bench.exe");
+  str8_list_pushf(scratch.arena, &args, "/RAD_BENCH_REPORT:%S", g_report_file_name);
+  str8_list_pushf(scratch.arena, &args, "@%S", rsp_name);
+  for (String8Node *input_n = cmdline->inputs.first; input_n != 0; input_n = input_n->next) {
+    str8_list_push(scratch.arena, &args, input_n->string);
+  }
+
+  //
+  // Timed Runs
+  //
+  B_MetricList metrics = {0};
+  for (U64 run_idx = 0; run_idx < run_count; run_idx += 1) {
+    Temp temp = scratch_begin(&scratch.arena, 1);
+
+    String8 report_path = b_make_file_path(temp.arena, g_report_file_name);
+    os_delete_file_at_path(report_path);
+
+    String8List run_args = str8_list_copy(temp.arena, &args);
+    U64 run_begin = os_now_microseconds();
+    int exit_code = b_invoke_linker(wdir, run_args);
+    U64 run_end   = os_now_microseconds();
+
+    if (exit_code != 0) {
+      fprintf(stderr, "ERROR: linker exited with code %d, see \"%.*s\"\n", exit_code, str8_varg(b_make_file_path(temp.arena, g_stdout_file_name)));
+      os_abort(1);
+    }
+
+    B_Metric *wall = b_metric_from_key(scratch.arena, &metrics, str8_lit("wall_us"), run_count);
+    wall->values[run_idx] = run_end - run_begin;
+
+    String8 report = os_data_from_file_path(temp.arena, report_path);
+    if (report.size == 0) {
+      fprintf(stderr, "ERROR: linker did not write \"%.*s\", does it support /RAD_BENCH_REPORT?\n", str8_varg(report_path));
+      os_abort(1);
+    }
+    b_parse_report(scratch.arena, &metrics, report, run_idx, run_count);
+
+    b_print_metrics(push_str8f(temp.arena, "run=%llu", run_idx), &metrics, run_idx);
+    fflush(stdout);
+
+    scratch_end(temp);
+  }
+
+  //
+  // Summary
+  //
+  for (B_Metric *m = metrics.first; m != 0; m = m->next) {
+    radsort(m->values, run_count, b_u64_is_before);
+  }
+  String8 runs = push_str8f(scratch.arena, "runs=%llu", run_count);
+  b_print_metrics(push_str8f(scratch.arena, "stat=min %S",    runs), &metrics, 0);
+  b_print_metrics(push_str8f(scratch.arena, "stat=median %S", runs), &metrics, run_count / 2);
+  b_print_metrics(push_str8f(scratch.arena, "stat=max %S",    runs), &metrics, run_count - 1);
+
+  scratch_end(scratch);
+}
@@ -509,40 +509,115 @@ rdi_strings_from_locations(Arena *arena, RDI_Parsed *rdi, RDI_Arch arch, Rng1U64
 ////////////////////////////////
 //~ rjf: RDI Dumping
 
+//- dump chunk helpers
+
+internal Rng1U64
+rdi_dump_lane_range_from_chunk(U64 chunk_min, U64 count)
+{
+  U64 chunk_opl = Min(count, chunk_min + RDI_DUMP_LANE_CHUNK_SIZE*lane_count());
+  Rng1U64 range = lane_range(chunk_opl - chunk_min);
+  range.min += chunk_min;
+  range.max += chunk_min;
+  return range;
+}
+
+internal void
+rdi_dump_flush(RDI_DumpShared *shared, Arena *lane_arena, String8List *lane_strings)
+{
+  shared->lane_strings[lane_idx()] = str8_list_join(lane_arena, lane_strings, 0);
+  lane_sync();
+  if(lane_idx() == 0)
+  {
+    for EachIndex(idx, lane_count())
+    {
+      if(shared->lane_strings[idx].size == 0)
+      {
+        continue;
+      }
+      if(!shared->subset_is_open)
+      {
+        shared->subset_is_open = 1;
+        shared->output(shared->output_user_data, push_str8f(lane_arena, "////////////////////////////////\n//~ %S\n\n%S:\n{", rdi_name_title_from_dump_subset_table[shared->subset], rdi_name_lowercase_from_dump_subset_table[shared->subset]));
+      }
+      shared->output(shared->output_user_data, shared->lane_strings[idx]);
+    }
+  }
+  lane_sync();
+  arena_clear(lane_arena);
+  MemoryZeroStruct(lane_strings);
+}
+
+internal void
+rdi_dump_subset_end(RDI_DumpShared *shared, Arena *lane_arena, String8List *lane_strings)
+{
+  rdi_dump_flush(shared, lane_arena, lane_strings);
+  if(lane_idx() == 0 && shared->subset_is_open)
+  {
+    shared->subset_is_open = 0;
+    shared->output(shared->output_user_data, str8_lit("}\n\n"));
+  }
+}
+
+//- list output
+
+internal void
+rdi_dump_output_to_list(void *user_data, String8 string)
+{
+  RDI_DumpListOutput *output = (RDI_DumpListOutput *)user_data;
+  str8_list_push(output->arena, &output->strings, push_str8_copy(output->arena, string));
+}
+
+//- top-level dumping
+
 internal String8List
 rdi_dump_list_from_parsed(Arena *arena, RDI_Parsed *rdi, RDI_DumpSubsetFlags flags)
+{
+  RDI_DumpListOutput output = {arena};
+  rdi_dump_parsed(rdi, flags, rdi_dump_output_to_list, &output);
+  RDI_DumpListOutput *lane0_output = &output;
+  lane_sync_u64(&lane0_output, 0);
+  String8List result = lane0_output->strings;
+  lane_sync();
+  return result;
+}
+
+internal void
+rdi_dump_parsed(RDI_Parsed *rdi, RDI_DumpSubsetFlags flags, RDI_DumpOutputFunction *output, void *output_user_data)
 {
   ProfBeginFunction();
-  Temp scratch = scratch_begin(&arena, 1);
   String8 indent = str8_lit("                                                                                                                                ");
   
   //////////////////////////////
   //- rjf: set up
   //
-  typedef struct DumpSubsetOutputNode DumpSubsetOutputNode;
-  struct DumpSubsetOutputNode
+  // NOTE: each lane dumps its slice of every chunk of elements into its
+  // own arena. at the end of each chunk, lane 0 passes the lanes' output to
+  // `output` in lane order, and the arenas are cleared - so memory use is
+  // bounded by the chunk size, not by the size of the RDI.
+  //
+  local_persist RDI_DumpShared *shared = 0;
+  if(lane_idx() == 0)
   {
-    DumpSubsetOutputNode *next;
-    RDI_DumpSubset subset;
-    String8List *lane_strings;
-  };
-  local_persist DumpSubsetOutputNode *first_output_node = 0;
-  local_persist DumpSubsetOutputNode *last_output_node = 0;
-  local_persist String8List result_strings = {0};
-  String8List *strings = 0;
-#define dump(str)  str8_list_push(arena, strings, (str))
-#define dumpf(...) str8_list_pushf(arena, strings, __VA_ARGS__)
+    Arena *shared_arena = arena_alloc();
+    shared = push_array(shared_arena, RDI_DumpShared, 1);
+    shared->arena            = shared_arena;
+    shared->lane_strings     = push_array(shared->arena, String8, lane_count());
+    shared->output           = output;
+    shared->output_user_data = output_user_data;
+  }
+  lane_sync();
+  Arena *arena = arena_alloc();
+  String8List strings = {0};
+#define dump(str)  str8_list_push(arena, &strings, (str))
+#define dumpf(...) str8_list_pushf(arena, &strings, __VA_ARGS__)
 #define DumpSubset(name) \
-if(lane_idx() == 0)\
-{\
-DumpSubsetOutputNode *n = push_array(scratch.arena, DumpSubsetOutputNode, 1);\
-SLLQueuePush(first_output_node, last_output_node, n);\
-n->subset = RDI_DumpSubset_##name;\
-n->lane_strings = push_array(scratch.arena, String8List, lane_count());\
-}\
-lane_sync();\
-strings = &last_output_node->lane_strings[lane_idx()];\
-lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
+rdi_dump_subset_end(shared, arena, &strings);\
+if(lane_idx() == 0) { shared->subset = RDI_DumpSubset_##name; }\
+if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
+#define DumpEachIndex(idx, count) \
+(U64 chunk_min__ = 0, chunk_count__ = (count); chunk_min__ < chunk_count__; chunk_min__ += RDI_DUMP_LANE_CHUNK_SIZE*lane_count(), rdi_dump_flush(shared, arena, &strings))\
+for(Rng1U64 chunk_lane_range__ = rdi_dump_lane_range_from_chunk(chunk_min__, chunk_count__); chunk_lane_range__.min < chunk_lane_range__.max; chunk_lane_range__.min = chunk_lane_range__.max)\
+for EachInRange(idx, chunk_lane_range__)
   
   //////////////////////////////
   //- rjf: dump data sections
@@ -550,8 +625,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   DumpSubset(DataSections)
   {
     if(lane_idx() == 0) { dumpf("\n"); }
-    Rng1U64 range = lane_range(rdi->sections_count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, rdi->sections_count)
     {
       Temp scratch = scratch_begin(&arena, 1);
       RDI_SectionKind  kind     = (RDI_SectionKind)idx;
@@ -591,8 +665,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     }
     U64 count = 0;
     RDI_BinarySection *v = rdi_table_from_name(rdi, BinarySections, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       Temp scratch = scratch_begin(&arena, 1);
       RDI_BinarySection *bin_section = &v[idx];
@@ -619,8 +692,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     U64 count = 0;
     RDI_FilePathNode *v = rdi_table_from_name(rdi, FilePathNodes, &count);
     RDI_FilePathNode *nil = &v[0];
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_FilePathNode *root = &v[idx];
       if(root->parent_path_node != 0) { continue; }
@@ -671,8 +743,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_SourceFile *v = rdi_table_from_name(rdi, SourceFiles, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_SourceFile *source_file = &v[idx];
       dumpf("\n  { file_path_node_idx: %4u, source_line_map: %4u, path: %-192S } // source_file[%I64u]",
@@ -691,8 +762,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_Unit *v = rdi_table_from_name(rdi, Units, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_Unit *unit = &v[idx];
       Temp scratch = scratch_begin(&arena, 1);
@@ -718,8 +788,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     if(lane_idx() == 0) { dumpf("\n"); }
     U64 count = 0;
     RDI_VMapEntry *v = rdi_table_from_name(rdi, UnitVMap, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       dumpf("  {0x%I64x => %I64u}\n", v[idx].voff, v[idx].idx);
     }
@@ -732,8 +801,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_LineTable *v = rdi_table_from_name(rdi, LineTables, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_LineTable *line_table = &v[idx];
       RDI_ParsedLineTable parsed_line_table = {0};
@@ -769,8 +837,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_SourceLineMap *v = rdi_table_from_name(rdi, SourceLineMaps, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       Temp scratch = scratch_begin(&arena, 1);
       RDI_ParsedSourceLineMap line_map = {0};
@@ -802,8 +869,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_TypeNode *v = rdi_table_from_name(rdi, TypeNodes, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       Temp scratch = scratch_begin(&arena, 1);
       RDI_TypeNode *type = &v[idx];
@@ -894,8 +960,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     RDI_Member *all_members = rdi_table_from_name(rdi, Members, &all_members_count);
     U64 all_enum_members_count = 0;
     RDI_EnumMember *all_enum_members = rdi_table_from_name(rdi, EnumMembers, &all_enum_members_count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_UDT *udt = &v[idx];
       Temp scratch = scratch_begin(&arena, 1);
@@ -952,8 +1017,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_GlobalVariable *v = rdi_table_from_name(rdi, GlobalVariables, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_GlobalVariable *gvar = &v[idx];
       Temp scratch = scratch_begin(&arena, 1);
@@ -975,8 +1039,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     if(lane_idx() == 0) { dumpf("\n"); }
     U64 count = 0;
     RDI_VMapEntry *v = rdi_table_from_name(rdi, GlobalVMap, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       dumpf("  {0x%I64x => %I64u}\n", v[idx].voff, v[idx].idx);
     }
@@ -989,8 +1052,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_ThreadVariable *v = rdi_table_from_name(rdi, ThreadVariables, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_ThreadVariable *tvar = &v[idx];
       Temp scratch = scratch_begin(&arena, 1);
@@ -1011,8 +1073,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_Constant *v = rdi_table_from_name(rdi, Constants, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_Constant *cnst = &v[idx];
       dumpf("\n  '%S': // constant[%I64u]\n  {\n", str8_from_rdi_string_idx(rdi, cnst->name_string_idx), idx);
@@ -1029,8 +1090,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     RDI_TopLevelInfo *tli = rdi_element_from_name_idx(rdi, TopLevelInfo, 0);
     U64 count = 0;
     RDI_Procedure *v = rdi_table_from_name(rdi, Procedures, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_Procedure *proc = &v[idx];
       Temp scratch = scratch_begin(&arena, 1);
@@ -1070,8 +1130,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     U64 count = 0;
     RDI_Scope *v = rdi_table_from_name(rdi, Scopes, &count);
     RDI_Scope *nil = &v[0];
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       if(v[idx].parent_scope_idx != 0) { continue; }
       RDI_Scope *root = &v[idx];
@@ -1183,8 +1242,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     if(lane_idx() == 0) { dumpf("\n"); }
     U64 count = 0;
     RDI_VMapEntry *v = rdi_table_from_name(rdi, ScopeVMap, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       dumpf("  {0x%I64x => %I64u}\n", v[idx].voff, v[idx].idx);
     }
@@ -1197,8 +1255,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     RDI_InlineSite *v = rdi_table_from_name(rdi, InlineSites, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_InlineSite *inline_site = &v[idx];
       Temp scratch = scratch_begin(&arena, 1);
@@ -1226,8 +1283,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
     Temp scratch = scratch_begin(&arena, 1);
     U64 count = 0;
     RDI_NameMap *v = rdi_table_from_name(rdi, NameMaps, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       RDI_ParsedNameMap name_map = {0};
       rdi_parsed_from_name_map(rdi, &v[idx], &name_map);
@@ -1277,8 +1333,7 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   {
     U64 count = 0;
     U32 *v = rdi_table_from_name(rdi, StringTable, &count);
-    Rng1U64 range = lane_range(count);
-    for EachInRange(idx, range)
+    for DumpEachIndex(idx, count)
     {
       dumpf("\n  \"%S\" // string[%I64u]", str8_from_rdi_string_idx(rdi, idx), idx);
     }
@@ -1286,32 +1341,19 @@ lane_sync(); if(flags & RDI_DumpSubsetFlag_##name) ProfScope(#name)
   }
   
   //////////////////////////////
-  //- rjf: join results
+  //- flush last subset, release
   //
+  rdi_dump_subset_end(shared, arena, &strings);
+  arena_release(arena);
   lane_sync();
   if(lane_idx() == 0)
   {
-    for EachNode(n, DumpSubsetOutputNode, first_output_node)
-    {
-      String8List subset_strings = {0};
-      for EachIndex(idx, lane_count())
-      {
-        str8_list_concat_in_place(&subset_strings, &n->lane_strings[idx]);
-      }
-      if(subset_strings.total_size != 0)
-      {
-        str8_list_pushf(arena, &result_strings, "////////////////////////////////\n//~ %S\n\n%S:\n{", rdi_name_title_from_dump_subset_table[n->subset], rdi_name_lowercase_from_dump_subset_table[n->subset]);
-        str8_list_concat_in_place(&result_strings, &subset_strings);
-        str8_list_pushf(arena, &result_strings, "}\n\n");
-      }
-    }
+    arena_release(shared->arena);
   }
-  lane_sync();
   
+#undef DumpEachIndex
 #undef DumpSubset
 #undef dumpf
 #undef dump
-  scratch_end(scratch);
   ProfEnd();
-  return result_strings;
 }
@@ -64,6 +64,31 @@ read_only global String8 rdi_name_title_from_dump_subset_table[] =
 #undef X
 };
 
+////////////////////////////////
+//~ RDI Dumping Types
+
+#define RDI_DUMP_LANE_CHUNK_SIZE 4096
+
+typedef void RDI_DumpOutputFunction(void *user_data, String8 string);
+
+typedef struct RDI_DumpShared RDI_DumpShared;
+struct RDI_DumpShared
+{
+  Arena *arena;
+  String8 *lane_strings;
+  RDI_DumpOutputFunction *output;
+  void *output_user_data;
+  RDI_DumpSubset subset;
+  B32 subset_is_open;
+};
+
+typedef struct RDI_DumpListOutput RDI_DumpListOutput;
+struct RDI_DumpListOutput
+{
+  Arena *arena;
+  String8List strings;
+};
+
 ////////////////////////////////
 //~ rjf: Lookup Helpers
 
@@ -92,6 +117,17 @@ internal String8List rdi_strings_from_locations(Arena *arena, RDI_Parsed *rdi, R
 ////////////////////////////////
 //~ rjf: RDI Dumping
 
+//- dump chunk helpers
+internal Rng1U64 rdi_dump_lane_range_from_chunk(U64 chunk_min, U64 count);
+internal void rdi_dump_flush(RDI_DumpShared *shared, Arena *lane_arena, String8List *lane_strings);
+internal void rdi_dump_subset_end(RDI_DumpShared *shared, Arena *lane_arena, String8List *lane_strings);
+
+//- list output
+internal void rdi_dump_output_to_list(void *user_data, String8 string);
+
+//- top-level dumping; must be called on all lanes. `output` is called on
+// lane 0 only, in order, as each chunk of the dump completes.
 internal String8List rdi_dump_list_from_parsed(Arena *arena, RDI_Parsed *rdi, RDI_DumpSubsetFlags flags);
+internal void rdi_dump_parsed(RDI_Parsed *rdi, RDI_DumpSubsetFlags flags, RDI_DumpOutputFunction *output, void *output_user_data);
 
 #endif // RDI_FORMAT_LOCAL_H
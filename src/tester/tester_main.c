@@ -14,21 +14,143 @@
 //- rjf: [h]
 #include "base/base_inc.h"
 #include "os/os_inc.h"
+#include "async/async.h"
+#include "artifact_cache/artifact_cache.h"
+#include "rdi/rdi_local.h"
 #include "content/content.h"
-#include "rdi_format/rdi_format_local.h"
 #include "regs/regs.h"
 #include "regs/rdi/regs_rdi.h"
+#include "dbg_info/dbg_info.h"
 #include "eval/eval_inc.h"
 
 //- rjf: [c]
 #include "base/base_inc.c"
 #include "os/os_inc.c"
+#include "async/async.c"
+#include "artifact_cache/artifact_cache.c"
+#include "rdi/rdi_local.c"
 #include "content/content.c"
-#include "rdi_format/rdi_format_local.c"
 #include "regs/regs.c"
 #include "regs/rdi/regs_rdi.c"
+#include "dbg_info/dbg_info.c"
 #include "eval/eval_inc.c"
 
+////////////////////////////////
+//~ Eval JIT Differential Testing Helpers
+
+typedef struct T_EvalSpaces T_EvalSpaces;
+struct T_EvalSpaces
+{
+  U8 memory[256];
+  U64 memory_base;
+  U8 *regs;
+  U64 regs_size;
+};
+
+internal B32
+t_eval_space_read(void *user_data, E_Space space, void *out, Rng1U64 range)
+{
+  T_EvalSpaces *spaces = (T_EvalSpaces *)user_data;
+  B32 result = 0;
+  Rng1U64 legal_range = {0};
+  U8 *base = 0;
+  switch(space.kind)
+  {
+    default:{}break;
+    case E_SpaceKind_FirstUserDefined+0:{base = spaces->memory; legal_range = r1u64(spaces->memory_base, spaces->memory_base + sizeof(spaces->memory));}break;
+    case E_SpaceKind_FirstUserDefined+1:{base = spaces->regs;   legal_range = r1u64(0, spaces->regs_size);}break;
+  }
+  if(base != 0 && legal_range.min <= range.min && range.min <= range.max && range.max <= legal_range.max)
+  {
+    MemoryCopy(out, base + (range.min - legal_range.min), range.max - range.min);
+    result = 1;
+  }
+  return result;
+}
+
+internal E_IRNode *
+t_eval_batch_tree(Arena *arena, E_IRNode *input, B32 conditional)
+{
+  // `x->b*3 + x->a`, or `x->a ? x->b : 7` - for `struct {U16 a; U16 pad; U32 b;} *x`
+  E_IRNode *a = e_push_irnode(arena, RDI_EvalOp_MemRead);
+  a->value.u64 = 2;
+  e_irnode_push_child(a, e_irnode_copy(arena, input));
+  E_IRNode *b = e_push_irnode(arena, RDI_EvalOp_MemRead);
+  b->value.u64 = 4;
+  e_irnode_push_child(b, e_irtree_binary_op_u(arena, RDI_EvalOp_Add, e_irnode_copy(arena, input), e_irtree_const_u(arena, 4)));
+  E_IRNode *result = 0;
+  if(conditional)
+  {
+    result = e_irtree_conditional(arena, a, b, e_irtree_const_u(arena, 7));
+  }
+  else
+  {
+    result = e_irtree_binary_op_u(arena, RDI_EvalOp_Add, e_irtree_binary_op_u(arena, RDI_EvalOp_Mul, b, e_irtree_const_u(arena, 3)), a);
+  }
+  return result;
+}
+
+internal U64
+t_rand_u64(U64 *state)
+{
+  U64 x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+internal void
+t_bytecode_push_op(Arena *arena, String8List *out, RDI_EvalOp op, U64 imm)
+{
+  U64 decode_size = RDI_DECODEN_FROM_CTRLBITS(rdi_eval_op_ctrlbits_table[op]);
+  U8 *bytes = push_array(arena, U8, 1 + decode_size);
+  bytes[0] = (U8)op;
+  MemoryCopy(bytes + 1, &imm, Min(decode_size, sizeof(imm)));
+  str8_list_push(arena, out, str8(bytes, 1 + decode_size));
+}
+
+typedef struct T_EvalReentrantSpaces T_EvalReentrantSpaces;
+struct T_EvalReentrantSpaces
+{
+  T_EvalSpaces spaces;
+  U64 nested_program_count;
+  U64 nested_bad_count;
+};
+
+internal B32
+t_eval_space_read_reentrant(void *user_data, E_Space space, void *out, Rng1U64 range)
+{
+  T_EvalReentrantSpaces *reentrant = (T_EvalReentrantSpaces *)user_data;
+  
+  //- evaluate more hot programs than the JIT cache holds from inside the read,
+  // like a space read hook that evaluates expressions - the generated code which
+  // called this read must survive it
+  U64 nested_program_count = reentrant->nested_program_count;
+  reentrant->nested_program_count = 0;
+  for EachIndex(program_idx, nested_program_count)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    String8List ops = {0};
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_ConstU64, program_idx);
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_ConstU64, 7);
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_Mul, RDI_EvalTypeGroup_U);
+    String8 bytecode = str8_list_join(scratch.arena, &ops, 0);
+    for EachIndex(hit_idx, E_JIT_HOT_HIT_COUNT+1)
+    {
+      E_Interpretation nested = e_interpret(bytecode);
+      if(nested.code != E_InterpretationCode_Good || nested.value.u64 != program_idx*7)
+      {
+        reentrant->nested_bad_count += 1;
+      }
+    }
+    scratch_end(scratch);
+  }
+  
+  return t_eval_space_read(&reentrant->spaces, space, out, range);
+}
+
 ////////////////////////////////
 //~ rjf: Entry Points
 
@@ -232,6 +354,433 @@ for(Test *test = test_##name_identifier; test != 0; test = 0)
     test->good = str8_match(correct_file_data, current_file_data, 0);
   }
   
+  //////////////////////////////
+  //- eval JIT <-> interpreter differential
+  //
+  Test(eval_jit_differential)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    U64 rng_state = 0x9E3779B97F4A7C15ull;
+    
+    //- set up fake memory & register spaces
+    T_EvalSpaces spaces = {0};
+    spaces.memory_base = 0x1000;
+    spaces.regs_size = regs_block_size_from_arch(Arch_x64);
+    spaces.regs = push_array(scratch.arena, U8, spaces.regs_size);
+    for EachElement(idx, spaces.memory)  {spaces.memory[idx] = (U8)t_rand_u64(&rng_state);}
+    for EachIndex(idx, spaces.regs_size) {spaces.regs[idx] = (U8)t_rand_u64(&rng_state);}
+    U64 module_base = 0x1000;
+    U64 frame_base = 0x1080;
+    E_InterpretCtx *interpret_ctx_restore = e_interpret_ctx;
+    E_InterpretCtx test_interpret_ctx = {0};
+    test_interpret_ctx.space_rw_user_data = &spaces;
+    test_interpret_ctx.space_read         = t_eval_space_read;
+    test_interpret_ctx.primary_space.kind = E_SpaceKind_FirstUserDefined+0;
+    test_interpret_ctx.reg_space.kind     = E_SpaceKind_FirstUserDefined+1;
+    test_interpret_ctx.reg_arch           = Arch_x64;
+    test_interpret_ctx.module_base        = &module_base;
+    test_interpret_ctx.frame_base         = &frame_base;
+    e_select_interpret_ctx(&test_interpret_ctx, 0, 0);
+    
+    //- generate random programs; compare every one the JIT accepts
+    U64 program_count = 20000;
+    U64 compiled_count = 0;
+    RDI_EvalTypeGroup type_groups[] = {RDI_EvalTypeGroup_U, RDI_EvalTypeGroup_S, RDI_EvalTypeGroup_Other, RDI_EvalTypeGroup_F64};
+    for EachIndex(program_idx, program_count)
+    {
+      Temp temp = temp_begin(scratch.arena);
+      String8List ops = {0};
+      U64 depth = 0;
+      U64 op_count = 1 + t_rand_u64(&rng_state)%16;
+      for EachIndex(op_idx, op_count)
+      {
+        U64 r = t_rand_u64(&rng_state);
+        RDI_EvalTypeGroup type_group = type_groups[(r>>32)%ArrayCount(type_groups)];
+        if(depth < 2 || r%3 == 0)
+        {
+          switch((r>>8)%6)
+          {
+            default:{t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_ConstU32, (r>>16)%300);}break;
+            case 1: {t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_ConstU64, spaces.memory_base + (r>>16)%(sizeof(spaces.memory)+8));}break;
+            case 2: {t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_FrameOff + (r>>16)%3, (r>>24)%32);}break;
+            case 3: {t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_RegRead, RDI_EncodeRegReadParam(RDI_RegCodeX64_rax + (r>>16)%16, 1 + (r>>24)%8, 0));}break;
+          }
+          depth += 1;
+        }
+        else switch((r>>8)%8)
+        {
+          default:
+          {
+            RDI_EvalOp op = (RDI_EvalOp)(RDI_EvalOp_Add + (r>>16)%(RDI_EvalOp_Grtr - RDI_EvalOp_Add + 1));
+            if(op == RDI_EvalOp_LShift || op == RDI_EvalOp_RShift) {op = RDI_EvalOp_BitXor;}
+            t_bytecode_push_op(temp.arena, &ops, op, type_group);
+            depth -= (op != RDI_EvalOp_BitNot && op != RDI_EvalOp_LogNot);
+          }break;
+          case 1:{t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_MemRead, 1 + (r>>16)%8);}break;
+          case 2:{t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_Trunc + (r>>16)%2, (r>>24)%40);}break;
+          case 3:{t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_Pick, (r>>16)%depth); depth += 1;}break;
+          case 4:{t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_Cond, (r>>16)%16); depth -= 1;}break;
+        }
+      }
+      String8 bytecode = str8_list_join(temp.arena, &ops, 0);
+      E_JITFunction *jit_function = e_jit_function_from_bytecode(bytecode, 0);
+      if(jit_function != 0)
+      {
+        compiled_count += 1;
+        E_Interpretation interpreted = e_interpret__switch(bytecode);
+        E_Interpretation jitted = e_jit_interpret(jit_function);
+        if(interpreted.code != jitted.code ||
+           !MemoryMatchStruct(&interpreted.value, &jitted.value) ||
+           !MemoryMatchStruct(&interpreted.space, &jitted.space))
+        {
+          test->good = 0;
+          str8_list_pushf(arena, &test->out, "program %I64u: interpreter (code %i, value 0x%I64x) != jit (code %i, value 0x%I64x)\n",
+                          program_idx, interpreted.code, interpreted.value.u64, jitted.code, jitted.value.u64);
+        }
+      }
+      temp_end(temp);
+    }
+    
+    //- on x64 hosts, the JIT should accept a decent share of programs
+#if ARCH_X64
+    if(compiled_count == 0)
+    {
+      test->good = 0;
+      str8_list_pushf(arena, &test->out, "no programs were JIT compiled\n");
+    }
+#endif
+    
+    e_select_interpret_ctx(interpret_ctx_restore, 0, 0);
+    scratch_end(scratch);
+  }
+  
+  //////////////////////////////
+  //- eval JIT cache - compiling more programs than the cache holds flushes
+  // it, and programs compiled after the flush must still run correctly
+  //
+  Test(eval_jit_cache_flush)
+  {
+#if ARCH_X64
+    Temp scratch = scratch_begin(0, 0);
+    E_InterpretCtx *interpret_ctx_restore = e_interpret_ctx;
+    E_InterpretCtx test_interpret_ctx = {0};
+    e_select_interpret_ctx(&test_interpret_ctx, 0, 0);
+    U64 flush_count_start = (e_jit_cache ? e_jit_cache->flush_count : 0);
+    U64 program_count = E_JIT_MAX_NODE_COUNT + 64;
+    for EachIndex(program_idx, program_count)
+    {
+      Temp temp = temp_begin(scratch.arena);
+      String8List ops = {0};
+      t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_ConstU64, program_idx);
+      t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_ConstU64, 7);
+      t_bytecode_push_op(temp.arena, &ops, RDI_EvalOp_Mul, RDI_EvalTypeGroup_U);
+      String8 bytecode = str8_list_join(temp.arena, &ops, 0);
+      E_JITFunction *jit_function = e_jit_function_from_bytecode(bytecode, 0);
+      if(jit_function != 0)
+      {
+        E_Interpretation jitted = e_jit_interpret(jit_function);
+        if(jitted.code != E_InterpretationCode_Good || jitted.value.u64 != program_idx*7)
+        {
+          test->good = 0;
+          str8_list_pushf(arena, &test->out, "program %I64u: jit (code %i, value 0x%I64x) != 0x%I64x\n", program_idx, jitted.code, jitted.value.u64, program_idx*7);
+          temp_end(temp);
+          break;
+        }
+      }
+      temp_end(temp);
+    }
+    if(e_jit_cache != 0 && !e_jit_cache->code_is_broken && e_jit_cache->flush_count == flush_count_start)
+    {
+      test->good = 0;
+      str8_list_pushf(arena, &test->out, "cache was not flushed after %I64u programs\n", program_count);
+    }
+    e_select_interpret_ctx(interpret_ctx_restore, 0, 0);
+    scratch_end(scratch);
+#endif
+  }
+  
+  //////////////////////////////
+  //- eval JIT reentrancy - a memory read from generated code evaluates other
+  // expressions, enough to overflow the cache; the outer program must still
+  // match the interpreter
+  //
+  Test(eval_jit_reentrant_space_read)
+  {
+#if ARCH_X64
+    Temp scratch = scratch_begin(0, 0);
+    U64 rng_state = 0xD1B54A32D192ED03ull;
+    T_EvalReentrantSpaces reentrant = {0};
+    reentrant.spaces.memory_base = 0x1000;
+    for EachElement(idx, reentrant.spaces.memory) {reentrant.spaces.memory[idx] = (U8)t_rand_u64(&rng_state);}
+    E_InterpretCtx *interpret_ctx_restore = e_interpret_ctx;
+    E_InterpretCtx test_interpret_ctx = {0};
+    test_interpret_ctx.space_rw_user_data = &reentrant;
+    test_interpret_ctx.space_read         = t_eval_space_read_reentrant;
+    test_interpret_ctx.primary_space.kind = E_SpaceKind_FirstUserDefined+0;
+    e_select_interpret_ctx(&test_interpret_ctx, 0, 0);
+    
+    //- `*(U32 *)(base+8) + 3 ^ *(U64 *)(base+16)` - work on both sides of the
+    // reentrant read, so clobbered code shows up as a wrong value or a crash
+    String8List ops = {0};
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_ConstU64, reentrant.spaces.memory_base + 8);
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_MemRead, 4);
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_ConstU32, 3);
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_Add, RDI_EvalTypeGroup_U);
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_ConstU64, reentrant.spaces.memory_base + 16);
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_MemRead, 8);
+    t_bytecode_push_op(scratch.arena, &ops, RDI_EvalOp_BitXor, RDI_EvalTypeGroup_U);
+    String8 bytecode = str8_list_join(scratch.arena, &ops, 0);
+    
+    E_JITFunction *jit_function = e_jit_function_from_bytecode(bytecode, 0);
+    if(jit_function != 0)
+    {
+      reentrant.nested_program_count = E_JIT_MAX_NODE_COUNT + 64;
+      E_Interpretation jitted = e_jit_interpret(jit_function);
+      E_Interpretation interpreted = e_interpret__switch(bytecode);
+      if(interpreted.code != jitted.code ||
+         !MemoryMatchStruct(&interpreted.value, &jitted.value) ||
+         !MemoryMatchStruct(&interpreted.space, &jitted.space))
+      {
+        test->good = 0;
+        str8_list_pushf(arena, &test->out, "interpreter (code %i, value 0x%I64x) != jit (code %i, value 0x%I64x)\n",
+                        interpreted.code, interpreted.value.u64, jitted.code, jitted.value.u64);
+      }
+      if(reentrant.nested_bad_count != 0)
+      {
+        test->good = 0;
+        str8_list_pushf(arena, &test->out, "%I64u nested evaluations were wrong\n", reentrant.nested_bad_count);
+      }
+      if(e_jit_run_depth != 0)
+      {
+        test->good = 0;
+        str8_list_pushf(arena, &test->out, "jit run depth is %I64u after returning\n", e_jit_run_depth);
+      }
+    }
+    else if(e_jit_cache != 0 && !e_jit_cache->code_is_broken)
+    {
+      test->good = 0;
+      str8_list_pushf(arena, &test->out, "program was not JIT compiled\n");
+    }
+    
+    e_select_interpret_ctx(interpret_ctx_restore, 0, 0);
+    scratch_end(scratch);
+#endif
+  }
+  
+  //////////////////////////////
+  //- eval IR optimizer - coalesced member reads
+  //
+  Test(eval_ir_optimize_mem_reads)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    
+    //- set up fake memory space
+    T_EvalSpaces spaces = {0};
+    spaces.memory_base = 0x1000;
+    for EachElement(idx, spaces.memory) {spaces.memory[idx] = (U8)(idx*37 + 11);}
+    E_InterpretCtx *interpret_ctx_restore = e_interpret_ctx;
+    E_InterpretCtx test_interpret_ctx = {0};
+    test_interpret_ctx.space_rw_user_data = &spaces;
+    test_interpret_ctx.space_read         = t_eval_space_read;
+    test_interpret_ctx.primary_space.kind = E_SpaceKind_FirstUserDefined+0;
+    test_interpret_ctx.reg_space.kind     = E_SpaceKind_FirstUserDefined+1;
+    e_select_interpret_ctx(&test_interpret_ctx, 0, 0);
+    
+    //- build `p->x + p->y + p->z + (p->w == 3)`, where `p` lives at the start
+    // of memory, and all members (U16 x, U8 y, U32 z, U8 w) fit in 8 bytes
+    U64 p = spaces.memory_base + 0x40;
+    MemoryCopy(spaces.memory, &p, sizeof(p));
+    E_IRNode *member_reads[4] = {0};
+    U64 member_offs[4]  = {0, 2, 3, 7};
+    U64 member_sizes[4] = {2, 1, 4, 1};
+    for EachElement(idx, member_reads)
+    {
+      E_IRNode *ptr = e_push_irnode(scratch.arena, RDI_EvalOp_MemRead);
+      ptr->value.u64 = 8;
+      e_irnode_push_child(ptr, e_irtree_const_u(scratch.arena, spaces.memory_base));
+      E_IRNode *addr = e_irtree_binary_op_u(scratch.arena, RDI_EvalOp_Add, ptr, e_irtree_const_u(scratch.arena, member_offs[idx]));
+      member_reads[idx] = e_push_irnode(scratch.arena, RDI_EvalOp_MemRead);
+      member_reads[idx]->value.u64 = member_sizes[idx];
+      e_irnode_push_child(member_reads[idx], addr);
+    }
+    E_IRNode *root = e_irtree_binary_op_u(scratch.arena, RDI_EvalOp_Add, member_reads[0], member_reads[1]);
+    root = e_irtree_binary_op_u(scratch.arena, RDI_EvalOp_Add, root, member_reads[2]);
+    root = e_irtree_binary_op_u(scratch.arena, RDI_EvalOp_Add, root, e_irtree_binary_op_u(scratch.arena, RDI_EvalOp_EqEq, member_reads[3], e_irtree_const_u(scratch.arena, 3)));
+    
+    //- compare unoptimized & optimized bytecode
+    E_OpList unoptimized_ops = {0};
+    E_Space space = test_interpret_ctx.primary_space;
+    e_append_oplist_from_irtree(scratch.arena, root, &space, &unoptimized_ops);
+    String8 unoptimized_bytecode = e_bytecode_from_oplist(scratch.arena, &unoptimized_ops);
+    E_IROptStats stats_before = e_ir_opt_stats_snapshot();
+    E_OpList optimized_ops = e_oplist_from_irtree(scratch.arena, root);
+    E_IROptStats stats_after = e_ir_opt_stats_snapshot();
+    String8 optimized_bytecode = e_bytecode_from_oplist(scratch.arena, &optimized_ops);
+    E_Interpretation unoptimized = e_interpret__switch(unoptimized_bytecode);
+    E_Interpretation optimized = e_interpret__switch(optimized_bytecode);
+    U64 reads_in  = stats_after.mem_read_count_in  - stats_before.mem_read_count_in;
+    U64 reads_out = stats_after.mem_read_count_out - stats_before.mem_read_count_out;
+    if(unoptimized.code != E_InterpretationCode_Good ||
+       optimized.code != E_InterpretationCode_Good ||
+       unoptimized.value.u64 != optimized.value.u64)
+    {
+      test->good = 0;
+      str8_list_pushf(arena, &test->out, "unoptimized (code %i, value 0x%I64x) != optimized (code %i, value 0x%I64x)\n",
+                      unoptimized.code, unoptimized.value.u64, optimized.code, optimized.value.u64);
+    }
+    if(reads_in != 8 || reads_out != 2)
+    {
+      test->good = 0;
+      str8_list_pushf(arena, &test->out, "expected 8 -> 2 reads, got %I64u -> %I64u\n", reads_in, reads_out);
+    }
+    
+    e_select_interpret_ctx(interpret_ctx_restore, 0, 0);
+    scratch_end(scratch);
+  }
+  
+  //////////////////////////////
+  //- eval batch interpretation - lockstep & per-lane paths
+  //
+  Test(eval_interpret_batch)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    
+    //- set up fake memory space
+    T_EvalSpaces spaces = {0};
+    spaces.memory_base = 0x1000;
+    for EachElement(idx, spaces.memory) {spaces.memory[idx] = (U8)(idx*37 + 11);}
+    E_InterpretCtx *interpret_ctx_restore = e_interpret_ctx;
+    E_InterpretCtx test_interpret_ctx = {0};
+    test_interpret_ctx.space_rw_user_data = &spaces;
+    test_interpret_ctx.space_read         = t_eval_space_read;
+    test_interpret_ctx.primary_space.kind = E_SpaceKind_FirstUserDefined+0;
+    test_interpret_ctx.reg_space.kind     = E_SpaceKind_FirstUserDefined+1;
+    e_select_interpret_ctx(&test_interpret_ctx, 0, 0);
+    
+    //- inputs - an array of 8-byte elements, a misaligned element, and
+    // elements which are out of bounds
+    U64 inputs[36] = {0};
+    for EachIndex(idx, 32) {inputs[idx] = spaces.memory_base + idx*8;}
+    inputs[32] = spaces.memory_base + 0x13;
+    inputs[33] = spaces.memory_base + sizeof(spaces.memory) - 1;
+    inputs[34] = 0;
+    inputs[35] = max_U64 - 2;
+    
+    //- evaluate straight-line (lockstep) & conditional (per-lane) trees
+    for EachIndex(conditional, 2)
+    {
+      E_OpList batch_ops = e_oplist_from_irtree(scratch.arena, t_eval_batch_tree(scratch.arena, e_irtree_batch_input(scratch.arena), (B32)conditional));
+      String8 batch_bytecode = e_bytecode_from_oplist(scratch.arena, &batch_ops);
+      E_Interpretation batch_results[ArrayCount(inputs)] = {0};
+      e_interpret_batch(batch_bytecode, ArrayCount(inputs), inputs, batch_results);
+      for EachElement(idx, inputs)
+      {
+        E_Interpretation expected = {0};
+        expected.code = E_InterpretationCode_BadMemRead;
+        if(spaces.memory_base <= inputs[idx] && inputs[idx] + 8 <= spaces.memory_base + sizeof(spaces.memory))
+        {
+          U16 a = 0;
+          U32 b = 0;
+          MemoryCopy(&a, spaces.memory + (inputs[idx] - spaces.memory_base) + 0, sizeof(a));
+          MemoryCopy(&b, spaces.memory + (inputs[idx] - spaces.memory_base) + 4, sizeof(b));
+          expected.code = E_InterpretationCode_Good;
+          expected.value.u64 = conditional ? (a ? b : 7) : ((U64)b*3 + a);
+        }
+        if(batch_results[idx].code != expected.code ||
+           (expected.code == E_InterpretationCode_Good && batch_results[idx].value.u64 != expected.value.u64))
+        {
+          test->good = 0;
+          str8_list_pushf(arena, &test->out, "%s, input 0x%I64x: got (code %i, value 0x%I64x), expected (code %i, value 0x%I64x)\n",
+                          conditional ? "conditional" : "straight-line", inputs[idx],
+                          batch_results[idx].code, batch_results[idx].value.u64, expected.code, expected.value.u64);
+        }
+      }
+    }
+    
+    e_select_interpret_ctx(interpret_ctx_restore, 0, 0);
+    scratch_end(scratch);
+  }
+  
+  //////////////////////////////
+  //- radbin symbolication (correctness, & determinism across lane counts)
+  //
+  Test(radbin_symbolicate_lane_determinism)
+  {
+    String8 pdb_path = path_normalized_from_string(arena, push_str8f(arena, "%S/mule_main/mule_main.pdb", test_data_folder_path));
+    String8 folder = push_str8f(arena, "%S/%S", artifacts_path, test->name);
+    os_make_directory(folder);
+    String8 rdi_path = push_str8f(arena, "%S/mule_main.rdi", folder);
+    String8 records_path = push_str8f(arena, "%S/records.txt", folder);
+    os_process_join(os_cmd_line_launchf("radbin --deterministic %S --out:%S", pdb_path, rdi_path), max_U64);
+    if(os_properties_from_file_path(rdi_path).size == 0)
+    {
+      test->good = 0;
+      str8_list_pushf(arena, &test->out, "  \"%S\" was not produced\n", rdi_path);
+    }
+    
+    // write records - dense sweeps of voffs, with malformed lines & a missing
+    // module mixed in. repeated enough to span several RB_SYM_BLOCK_SIZE blocks,
+    // so that lines split across block boundaries are covered too.
+    U64 sweeps_count = 24;
+    U64 records_count = 0;
+    U64 unresolvable_records_count = 0;
+    String8List records = {0};
+    for EachIndex(sweep_idx, sweeps_count)
+    {
+      for(U64 voff = 0x1000; voff < 0x41000; voff += 0x10)
+      {
+        str8_list_pushf(arena, &records, "%S 0x%I64x\n", rdi_path, voff);
+        records_count += 1;
+        if(voff % 0x10000 == 0)
+        {
+          str8_list_pushf(arena, &records, "%S/missing.rdi 0x%I64x\n", folder, voff);
+          str8_list_pushf(arena, &records, "not a record\n");
+          records_count += 2;
+          unresolvable_records_count += 2;
+        }
+      }
+    }
+    os_write_data_list_to_file_path(records_path, records);
+    
+    // symbolicate with various lane counts, and check & compare outputs
+    U64 thread_counts[] = {1, 3, 8};
+    U128 hashes[ArrayCount(thread_counts)] = {0};
+    String8 out_paths[ArrayCount(thread_counts)] = {0};
+    for EachElement(idx, thread_counts)
+    {
+      out_paths[idx] = push_str8f(arena, "%S/symbols_%I64u.txt", folder, thread_counts[idx]);
+      os_process_join(os_cmd_line_launchf("radbin --symbolicate --thread_count:%I64u %S --out:%S", thread_counts[idx], records_path, out_paths[idx]), max_U64);
+      Temp scratch = scratch_begin(0, 0);
+      String8 data = os_data_from_file_path(scratch.arena, out_paths[idx]);
+      hashes[idx] = c_hash_from_data(data);
+      String8List lines = str8_split(scratch.arena, data, (U8 *)"\n", 1, 0);
+      U64 unresolved_count = 0;
+      for(String8Node *n = lines.first; n != 0; n = n->next)
+      {
+        unresolved_count += str8_ends_with(n->string, str8_lit(" ??"), 0);
+      }
+      if(lines.node_count != records_count)
+      {
+        test->good = 0;
+        str8_list_pushf(arena, &test->out, "  \"%S\" has %I64u lines, expected %I64u\n", out_paths[idx], lines.node_count, records_count);
+      }
+      if(unresolved_count < unresolvable_records_count || unresolved_count >= lines.node_count)
+      {
+        test->good = 0;
+        str8_list_pushf(arena, &test->out, "  \"%S\" has %I64u unresolved lines, of %I64u\n", out_paths[idx], unresolved_count, lines.node_count);
+      }
+      scratch_end(scratch);
+    }
+    for EachElement(idx, thread_counts)
+    {
+      if(!u128_match(hashes[idx], hashes[0]))
+      {
+        test->good = 0;
+        str8_list_pushf(arena, &test->out, "  \"%S\" does not match \"%S\"\n", out_paths[idx], out_paths[0]);
+      }
+    }
+  }
+  
   //////////////////////////////
   //- rjf: dump results
   //
@@ -23,6 +23,13 @@
 #include "coff/coff_lib_writer.h"
 #include "pe/pe.h"
 #include "pe/pe_section_flags.h"
+#include "codeview/codeview.h"
+#include "codeview/codeview_parse.h"
+#include "msf/msf.h"
+#include "msf/msf_parse.h"
+#include "pdb/pdb.h"
+#include "pdb/pdb_parse.h"
+#include "rdi/rdi_local.h"
 #include "linker/base_ext/base_core.h"
 #include "linker/base_ext/base_arena.h"
 #include "linker/base_ext/base_arrays.h"
@@ -35,6 +42,13 @@
 #include "coff/coff_obj_writer.c"
 #include "coff/coff_lib_writer.c"
 #include "pe/pe.c"
+#include "codeview/codeview.c"
+#include "codeview/codeview_parse.c"
+#include "msf/msf.c"
+#include "msf/msf_parse.c"
+#include "pdb/pdb.c"
+#include "pdb/pdb_parse.c"
+#include "rdi/rdi_local.c"
 #include "linker/hash_table.c"
 #include "linker/base_ext/base_core.c"
 #include "linker/base_ext/base_arena.c"
@@ -4940,6 +4954,883 @@ exit:;
   return result;
 }
 
+internal T_Result
+t_order(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  char *func_names[] = { "f_a", "f_b", "f_c", "f_d" };
+  U64   func_size    = 16;
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+
+    U8 xdata_payload[] = { 0x01, 0x00, 0x00, 0x00 };
+    COFF_ObjSection *xdata       = coff_obj_writer_push_section(obj_writer, str8_lit(".xdata"), PE_RDATA_SECTION_FLAGS|COFF_SectionFlag_Align4Bytes, str8_array_fixed(xdata_payload));
+    COFF_ObjSymbol  *unwind_info = coff_obj_writer_push_symbol_static(obj_writer, str8_lit("$unwind"), 0, xdata);
+
+    for EachElement(func_idx, func_names) {
+      // tag each function with its index so the test can find it in the image
+      U8 *code = push_array(scratch.arena, U8, func_size);
+      MemorySet(code, 0xCC, func_size);
+      code[0] = 0xC3;
+      code[1] = (U8)func_idx;
+
+      COFF_ObjSection *func        = coff_obj_writer_push_section(obj_writer, str8_lit(".text$mn"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align16Bytes, str8(code, func_size));
+      coff_obj_writer_push_symbol_secdef(obj_writer, func, COFF_ComdatSelect_NoDuplicates);
+      COFF_ObjSymbol  *func_symbol = coff_obj_writer_push_symbol_extern_func(obj_writer, str8_cstring(func_names[func_idx]), 0, func);
+
+      // in-place addend puts one-past-last at the end of the function
+      PE_IntelPdata *pdata_payload = push_array(scratch.arena, PE_IntelPdata, 1);
+      pdata_payload->voff_one_past_last = func_size;
+
+      COFF_ObjSection *pdata = coff_obj_writer_push_section(obj_writer, str8_lit(".pdata"), PE_RDATA_SECTION_FLAGS|COFF_SectionFlag_LnkCOMDAT|COFF_SectionFlag_Align4Bytes, str8_struct(pdata_payload));
+      coff_obj_writer_push_symbol_associative(obj_writer, pdata, func);
+      coff_obj_writer_section_push_reloc(obj_writer, pdata, OffsetOf(PE_IntelPdata, voff_first),         func_symbol, COFF_Reloc_X64_Addr32Nb);
+      coff_obj_writer_section_push_reloc(obj_writer, pdata, OffsetOf(PE_IntelPdata, voff_one_past_last), func_symbol, COFF_Reloc_X64_Addr32Nb);
+      coff_obj_writer_section_push_reloc(obj_writer, pdata, OffsetOf(PE_IntelPdata, voff_unwind_info),   unwind_info, COFF_Reloc_X64_Addr32Nb);
+    }
+
+    String8 funcs_obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("funcs.obj"), funcs_obj)) { goto exit; }
+  }
+
+  {
+    // reference every function from the entry so none of them is discarded
+    U8 entry_text[ArrayCount(func_names)*7 + 1];
+    for EachElement(func_idx, func_names) {
+      U8 *mov = &entry_text[func_idx*7];
+      mov[0] = 0x48; mov[1] = 0xC7; mov[2] = 0xC0; // mov rax, imm32
+      MemoryZero(&mov[3], 4);
+    }
+    entry_text[ArrayCount(entry_text)-1] = 0xC3;
+
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *text       = t_push_text_section(obj_writer, str8_array_fixed(entry_text));
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text);
+    for EachElement(func_idx, func_names) {
+      COFF_ObjSymbol *func_symbol = coff_obj_writer_push_symbol_undef_func(obj_writer, str8_cstring(func_names[func_idx]));
+      coff_obj_writer_section_push_reloc(obj_writer, text, func_idx*7 + 3, func_symbol, COFF_Reloc_X64_Addr32Nb);
+    }
+    String8 entry_obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("entry.obj"), entry_obj)) { goto exit; }
+  }
+
+  // f_c and f_a are ordered explicitly, f_d is hot, f_b is cold, and the missing symbol is skipped
+  if (!t_write_file(str8_lit("order.txt"), str8_lit("f_c\r\nf_a\r\n")))                 { goto exit; }
+  if (!t_write_file(str8_lit("profile.txt"), str8_lit("f_b 0\nf_d 100\nmissing 5\n"))) { goto exit; }
+
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /order:@order.txt /rad_order_profile:profile.txt entry.obj funcs.obj");
+  if (linker_exit_code != 0) { goto exit; }
+
+  String8    exe = t_read_file(scratch.arena, str8_lit("a.exe"));
+  PE_BinInfo pe  = pe_bin_info_from_data(scratch.arena, exe);
+
+  U64            expected_order[] = { 2, 0, 3, 1 };
+  String8        pdata            = str8_substr(exe, pe.data_dir_franges[PE_DataDirectoryIndex_EXCEPTIONS]);
+  PE_IntelPdata *pdata_entries    = (PE_IntelPdata *)pdata.str;
+  U64            pdata_count      = pdata.size / sizeof(PE_IntelPdata);
+  if (pdata_count != ArrayCount(expected_order)) { goto exit; }
+
+  for EachIndex(pdata_idx, pdata_count) {
+    PE_IntelPdata *p = &pdata_entries[pdata_idx];
+
+    // .pdata must stay sorted after functions were moved around
+    if (pdata_idx > 0 && pdata_entries[pdata_idx-1].voff_first >= p->voff_first) { goto exit; }
+    if (p->voff_one_past_last - p->voff_first != func_size)                       { goto exit; }
+
+    U64     func_foff = pe_foff_from_voff(exe, &pe, p->voff_first);
+    String8 func_code = str8_substr(exe, r1u64(func_foff, func_foff + func_size));
+    if (func_code.size != func_size)                     { goto exit; }
+    if (func_code.str[0] != 0xC3)                        { goto exit; }
+    if (func_code.str[1] != expected_order[pdata_idx])   { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_parallel_write(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  // sizes are picked so section data straddles write block boundaries at odd offsets
+  U64 data_sizes[] = { MB(13) + 1, MB(17) + 3, MB(9) + 5 };
+
+  U64 total_data_size = 0;
+  for EachElement(i, data_sizes) { total_data_size += data_sizes[i]; }
+
+  U8 *expected_data = push_array_no_zero(scratch.arena, U8, total_data_size);
+  for EachIndex(i, total_data_size) {
+    expected_data[i] = (U8)(i*7 + (i >> 16));
+  }
+
+  {
+    COFF_ObjWriter *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    for (U64 i = 0, data_off = 0; i < ArrayCount(data_sizes); data_off += data_sizes[i], i += 1) {
+      String8 name = push_str8f(scratch.arena, ".data$%c", (char)('a' + i));
+      coff_obj_writer_push_section(obj_writer, name, PE_DATA_SECTION_FLAGS|COFF_SectionFlag_Align1Bytes, str8(expected_data + data_off, data_sizes[i]));
+    }
+    String8 data_obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("data.obj"), data_obj)) { goto exit; }
+  }
+
+  t_write_entry_obj();
+
+  // second link replaces the image produced by the first one
+  for EachIndex(link_idx, 2) {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe entry.obj data.obj");
+    if (linker_exit_code != 0) { goto exit; }
+
+    String8             exe           = t_read_file(scratch.arena, str8_lit("a.exe"));
+    PE_BinInfo          pe            = pe_bin_info_from_data(scratch.arena, exe);
+    COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(exe, pe.section_table_range).str;
+    String8             string_table  = str8_substr(exe, pe.string_table_range);
+    COFF_SectionHeader *data_section  = t_coff_section_header_from_name(string_table, section_table, pe.section_count, str8_lit(".data"));
+    if (!data_section) { goto exit; }
+
+    String8 data = str8_substr(exe, rng_1u64(data_section->foff, data_section->foff + data_section->vsize));
+    if (!str8_match(data, str8(expected_data, total_data_size), 0)) { goto exit; }
+
+    // image must end where the last section ends, a stale tail means the file was not sized correctly
+    U64 image_end = 0;
+    for EachIndex(sect_idx, pe.section_count) {
+      image_end = Max(image_end, section_table[sect_idx].foff + section_table[sect_idx].fsize);
+    }
+    if (exe.size != image_end) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_rdi_unit_vmap(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  // each unit pushes interleaved .text and .data ranges, so the unit vmap builder gets
+  // unsorted input that spans every voff digit of the radix sort
+  U64          obj_count   = 512;
+  String8List  obj_names   = {0};
+  U64         *text_voffs  = push_array(scratch.arena, U64, obj_count);
+  U64         *data_voffs  = push_array(scratch.arena, U64, obj_count);
+  for EachIndex(obj_idx, obj_count) {
+    U8 *text = push_array(scratch.arena, U8, 16);
+    MemorySet(text, 0xCC, 16);
+    text[0] = 0xC3;
+    text[1] = (U8)obj_idx;
+    text[2] = (U8)(obj_idx >> 8);
+
+    U64 data_size = (((obj_idx * 37) % 64) + 1) * 16;
+    U8 *data      = push_array(scratch.arena, U8, data_size);
+    data[0] = 0xDD;
+    data[1] = 0xDD;
+    data[2] = (U8)obj_idx;
+    data[3] = (U8)(obj_idx >> 8);
+
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *text_sect  = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_Align16Bytes, str8(text, 16));
+    coff_obj_writer_push_section(obj_writer, str8_lit(".data"), PE_DATA_SECTION_FLAGS|COFF_SectionFlag_Align16Bytes, str8(data, data_size));
+    if (obj_idx == 0) {
+      coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+    }
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+
+    String8 obj_name = push_str8f(scratch.arena, "u%03llu.obj", obj_idx);
+    if (!t_write_file(obj_name, obj)) { goto exit; }
+    str8_list_push(scratch.arena, &obj_names, obj_name);
+  }
+
+  String8 obj_list        = str8_list_join(scratch.arena, &obj_names, &(StringJoin){ .sep = str8_lit(" ") });
+  int     linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /debug /rad_debug /rad_debug_name:a.rdi %S", obj_list);
+  if (linker_exit_code != 0) { goto exit; }
+
+  //
+  // find where each unit's sections ended up in the image
+  //
+  String8             exe           = t_read_file(scratch.arena, str8_lit("a.exe"));
+  PE_BinInfo          pe            = pe_bin_info_from_data(scratch.arena, exe);
+  COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(exe, pe.section_table_range).str;
+  String8             string_table  = str8_substr(exe, pe.string_table_range);
+  COFF_SectionHeader *text_section  = t_coff_section_header_from_name(string_table, section_table, pe.section_count, str8_lit(".text"));
+  COFF_SectionHeader *data_section  = t_coff_section_header_from_name(string_table, section_table, pe.section_count, str8_lit(".data"));
+  if (!text_section || !data_section) { goto exit; }
+
+  String8 text = str8_substr(exe, rng_1u64(text_section->foff, text_section->foff + text_section->fsize));
+  String8 data = str8_substr(exe, rng_1u64(data_section->foff, data_section->foff + data_section->fsize));
+  for (U64 off = 0; off + 16 <= text.size; off += 16) {
+    if (text.str[off] == 0xC3) {
+      U64 obj_idx = text.str[off+1] | ((U64)text.str[off+2] << 8);
+      if (obj_idx >= obj_count) { goto exit; }
+      text_voffs[obj_idx] = text_section->voff + off;
+    }
+  }
+  for (U64 off = 0; off + 16 <= data.size; off += 16) {
+    if (data.str[off] == 0xDD && data.str[off+1] == 0xDD) {
+      U64 obj_idx = data.str[off+2] | ((U64)data.str[off+3] << 8);
+      if (obj_idx >= obj_count) { goto exit; }
+      data_voffs[obj_idx] = data_section->voff + off;
+    }
+  }
+
+  //
+  // check unit vmap
+  //
+  String8    rdi_data = t_read_file(scratch.arena, str8_lit("a.rdi"));
+  RDI_Parsed rdi      = {0};
+  if (rdi_parse(rdi_data.str, rdi_data.size, &rdi) != RDI_ParseStatus_Good) { goto exit; }
+
+  RDI_U64        vmap_count = 0;
+  RDI_VMapEntry *vmap       = rdi_table_from_name(&rdi, UnitVMap, &vmap_count);
+  if (vmap_count == 0) { goto exit; }
+  for (U64 vmap_idx = 1; vmap_idx < vmap_count; vmap_idx += 1) {
+    if (vmap[vmap_idx-1].voff > vmap[vmap_idx].voff) { goto exit; }
+  }
+
+  for EachIndex(obj_idx, obj_count) {
+    if (text_voffs[obj_idx] == 0 || data_voffs[obj_idx] == 0) { goto exit; }
+
+    String8 expected_name = push_str8f(scratch.arena, "u%03llu.obj", obj_idx);
+    U64     voffs[]       = { text_voffs[obj_idx], text_voffs[obj_idx] + 15, data_voffs[obj_idx] };
+    for EachElement(voff_idx, voffs) {
+      RDI_Unit *unit      = rdi_unit_from_voff(&rdi, voffs[voff_idx]);
+      RDI_U64   name_size = 0;
+      RDI_U8   *name      = rdi_string_from_idx(&rdi, unit->unit_name_string_idx, &name_size);
+      if (!str8_match(str8(name, name_size), expected_name, 0)) { goto exit; }
+    }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_pdb_names(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  // strings go through one obj so they reach /names in the same order regardless of worker count
+  U64      string_count = 4000;
+  String8 *strings      = push_array(scratch.arena, String8, string_count);
+  {
+    String8     null_char    = str8((U8 *)"", 1);
+    String8List string_table = {0};
+    str8_list_push(scratch.arena, &string_table, null_char);
+    for EachIndex(string_idx, string_count) {
+      strings[string_idx] = push_str8f(scratch.arena, "c:\\src\\%.*s\\file_%llu.c", (int)(string_idx % 13), "dddddddddddd", string_idx);
+      str8_list_push(scratch.arena, &string_table, strings[string_idx]);
+      str8_list_push(scratch.arena, &string_table, null_char);
+    }
+
+    CV_C13SubSectionHeader header = {0};
+    header.kind = CV_C13SubSectionKind_StringTable;
+    header.size = string_table.total_size;
+
+    String8List debug_s = {0};
+    CV_Signature signature = CV_Signature_C13;
+    str8_list_push(scratch.arena, &debug_s, push_str8_copy(scratch.arena, str8_struct(&signature)));
+    str8_list_push(scratch.arena, &debug_s, push_str8_copy(scratch.arena, str8_struct(&header)));
+    str8_list_concat_in_place(&debug_s, &string_table);
+    str8_list_push_aligner(scratch.arena, &debug_s, 0, CV_C13SubSectionAlign);
+
+    U8 text[] = { 0xC3 };
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *text_sect  = t_push_text_section(obj_writer, str8_array_fixed(text));
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$S"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align1Bytes, str8_list_join(scratch.arena, &debug_s, 0));
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+    if (!t_write_file(str8_lit("names.obj"), obj)) { goto exit; }
+  }
+
+  // bucket parts are cut per worker, so the table must not change with the worker count
+  U64     worker_counts[] = { 1, 3, 8 };
+  String8 names_streams[ArrayCount(worker_counts)];
+  for EachElement(worker_idx, worker_counts) {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /debug:full /pdb:a.pdb /rad_workers:%llu names.obj", worker_counts[worker_idx]);
+    if (linker_exit_code != 0) { goto exit; }
+
+    String8               pdb_data      = t_read_file(scratch.arena, str8_lit("a.pdb"));
+    MSF_Parsed           *msf           = msf_parsed_from_data(scratch.arena, pdb_data);
+    if (!msf) { goto exit; }
+    PDB_Info             *info          = pdb_info_from_data(scratch.arena, msf_data_from_stream(msf, PDB_FixedStream_Info));
+    if (!info) { goto exit; }
+    PDB_NamedStreamTable *named_streams = pdb_named_stream_table_from_info(scratch.arena, info);
+    if (!named_streams) { goto exit; }
+
+    names_streams[worker_idx] = msf_data_from_stream(msf, named_streams->sn[PDB_NamedStream_StringTable]);
+    if (!str8_match(names_streams[worker_idx], names_streams[0], 0)) { goto exit; }
+  }
+
+  // every string must be reachable by probing from its home bucket
+  PDB_Strtbl *strtbl = pdb_strtbl_from_data(scratch.arena, names_streams[0]);
+  if (strtbl->bucket_count == 0) { goto exit; }
+  U32 *buckets     = (U32 *)(strtbl->data.str + strtbl->buckets_min);
+  U32  null_bucket = pdb_hash_v1(str8_zero()) % strtbl->bucket_count;
+  for EachIndex(string_idx, string_count) {
+    B32 is_found   = 0;
+    U32 home       = pdb_hash_v1(strings[string_idx]) % strtbl->bucket_count;
+    U32 bucket_idx = home;
+    do {
+      if (buckets[bucket_idx] == 0 && bucket_idx != null_bucket) {
+        break;
+      }
+      if (str8_match(pdb_strtbl_string_from_off(strtbl, buckets[bucket_idx]), strings[string_idx], 0)) {
+        is_found = 1;
+        break;
+      }
+      bucket_idx = (bucket_idx + 1) % strtbl->bucket_count;
+    } while (bucket_idx != home);
+    if (!is_found) { goto exit; }
+  }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_pdb_page_reuse(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  // many modules with string tables grow the stream table, root directory and /names,
+  // so pages are freed and handed out again while the PDB is built
+  U64         obj_count = 64;
+  String8List obj_names = {0};
+  for EachIndex(obj_idx, obj_count) {
+    String8     null_char    = str8((U8 *)"", 1);
+    String8List string_table = {0};
+    str8_list_push(scratch.arena, &string_table, null_char);
+    for EachIndex(string_idx, 500) {
+      str8_list_push(scratch.arena, &string_table, push_str8f(scratch.arena, "c:\\src\\obj_%llu\\file_%llu.c", obj_idx, string_idx));
+      str8_list_push(scratch.arena, &string_table, null_char);
+    }
+
+    CV_C13SubSectionHeader header = {0};
+    header.kind = CV_C13SubSectionKind_StringTable;
+    header.size = string_table.total_size;
+
+    String8List debug_s = {0};
+    CV_Signature signature = CV_Signature_C13;
+    str8_list_push(scratch.arena, &debug_s, push_str8_copy(scratch.arena, str8_struct(&signature)));
+    str8_list_push(scratch.arena, &debug_s, push_str8_copy(scratch.arena, str8_struct(&header)));
+    str8_list_concat_in_place(&debug_s, &string_table);
+    str8_list_push_aligner(scratch.arena, &debug_s, 0, CV_C13SubSectionAlign);
+
+    U8 text[] = { 0xC3 };
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *text_sect  = t_push_text_section(obj_writer, str8_array_fixed(text));
+    coff_obj_writer_push_section(obj_writer, str8_lit(".debug$S"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align1Bytes, str8_list_join(scratch.arena, &debug_s, 0));
+    if (obj_idx == 0) {
+      coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+    }
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+
+    String8 obj_name = push_str8f(scratch.arena, "m%02llu.obj", obj_idx);
+    if (!t_write_file(obj_name, obj)) { goto exit; }
+    str8_list_push(scratch.arena, &obj_names, obj_name);
+  }
+
+  String8 obj_list         = str8_list_join(scratch.arena, &obj_names, &(StringJoin){ .sep = str8_lit(" ") });
+  int     linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /debug:full /pdb:a.pdb %S", obj_list);
+  if (linker_exit_code != 0) { goto exit; }
+
+  String8 pdb_data = t_read_file(scratch.arena, str8_lit("a.pdb"));
+  if (pdb_data.size < sizeof(MSF_Header70) || !msf_check_magic_70(pdb_data)) { goto exit; }
+
+  MSF_Header70 *header    = (MSF_Header70 *)pdb_data.str;
+  U64           page_size = header->page_size;
+  if (page_size == 0 || header->page_count * page_size != pdb_data.size) { goto exit; }
+
+  // count references to each page, header and FPM pages are reserved by the format
+  U8 *page_refs = push_array(scratch.arena, U8, header->page_count);
+  for (U64 pn = 0; pn < header->page_count; pn += 1) {
+    U64 pn_in_interval = pn % page_size;
+    if (pn == 0 || pn_in_interval == 1 || pn_in_interval == 2) {
+      page_refs[pn] = 1;
+    }
+  }
+
+  {
+    U64  dir_page_count  = CeilIntegerDiv(header->stream_table_size, page_size);
+    U64  root_page_count = CeilIntegerDiv(dir_page_count * sizeof(U32), page_size);
+    U32 *root_pns        = (U32 *)(pdb_data.str + OffsetOf(MSF_Header70, root_pn));
+    for EachIndex(root_idx, root_page_count) {
+      if (root_pns[root_idx] >= header->page_count) { goto exit; }
+      page_refs[root_pns[root_idx]] += 1;
+
+      U32 *dir_pns      = (U32 *)(pdb_data.str + root_pns[root_idx] * page_size);
+      U64  dir_pn_count = Min(dir_page_count - root_idx * (page_size / sizeof(U32)), page_size / sizeof(U32));
+      for EachIndex(dir_idx, dir_pn_count) {
+        if (dir_pns[dir_idx] >= header->page_count) { goto exit; }
+        page_refs[dir_pns[dir_idx]] += 1;
+      }
+    }
+  }
+
+  MSF_RawStreamTable *st = msf_raw_stream_table_from_data(scratch.arena, pdb_data);
+  if (!st || st->stream_count == 0) { goto exit; }
+  for EachIndex(sn, st->stream_count) {
+    MSF_RawStream *stream = &st->streams[sn];
+    for EachIndex(page_idx, stream->page_count) {
+      U32 pn = stream->u.page_indices_u32[page_idx];
+      if (pn >= header->page_count) { goto exit; }
+      page_refs[pn] += 1;
+    }
+  }
+
+  // a reused page must not be shared and has to stay allocated in the FPM
+  for (U64 pn = 0; pn < header->page_count; pn += 1) {
+    if (page_refs[pn] > 1) { goto exit; }
+    if (page_refs[pn] == 1) {
+      U64 fpm_interval = page_size * 8;
+      U64 fpm_pn       = header->active_fpm + (pn / fpm_interval) * page_size;
+      U64 bit_idx      = pn % fpm_interval;
+      U8  fpm_byte     = pdb_data.str[fpm_pn * page_size + bit_idx / 8];
+      B32 is_free      = (fpm_byte >> (bit_idx % 8)) & 1;
+      if (is_free) { goto exit; }
+    }
+  }
+
+  // data written into reused pages must read back intact
+  MSF_Parsed           *msf           = msf_parsed_from_data(scratch.arena, pdb_data);
+  if (!msf) { goto exit; }
+  PDB_Info             *info          = pdb_info_from_data(scratch.arena, msf_data_from_stream(msf, PDB_FixedStream_Info));
+  if (!info) { goto exit; }
+  PDB_NamedStreamTable *named_streams = pdb_named_stream_table_from_info(scratch.arena, info);
+  if (!named_streams) { goto exit; }
+  PDB_Strtbl           *strtbl        = pdb_strtbl_from_data(scratch.arena, msf_data_from_stream(msf, named_streams->sn[PDB_NamedStream_StringTable]));
+  U32                   string_count  = 0;
+  if (strtbl->buckets_max + sizeof(U32) > strtbl->data.size) { goto exit; }
+  MemoryCopy(&string_count, strtbl->data.str + strtbl->buckets_max, sizeof(string_count));
+  if (string_count < obj_count * 500) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+// mirrors LNK_TypeHashCacheHeader
+typedef struct
+{
+  U64 magic;
+  U32 version;
+  U32 pad;
+  U64 build_stamp;
+  U64 entry_count;
+  U64 entries_off;
+  U64 hashes_off;
+  U64 hashes_count;
+} T_TypeHashCacheHeader;
+
+internal B32
+t_write_obj_with_proc_type(String8 name, CV_TypeId arg_itype, B32 has_entry)
+{
+  Temp scratch = scratch_begin(0,0);
+
+  // .debug$T with an arg list and a procedure type that refers to it
+  String8List debug_t = {0};
+  {
+    CV_Signature signature = CV_Signature_C13;
+    str8_list_push(scratch.arena, &debug_t, push_str8_copy(scratch.arena, str8_struct(&signature)));
+
+    struct { CV_LeafSize size; CV_LeafKind kind; CV_LeafArgList arg_list; CV_TypeId arg; } arg_list_leaf = {0};
+    arg_list_leaf.size           = sizeof(arg_list_leaf) - sizeof(arg_list_leaf.size);
+    arg_list_leaf.kind           = CV_LeafKind_ARGLIST;
+    arg_list_leaf.arg_list.count = 1;
+    arg_list_leaf.arg            = arg_itype;
+    str8_list_push(scratch.arena, &debug_t, push_str8_copy(scratch.arena, str8_struct(&arg_list_leaf)));
+
+    struct { CV_LeafSize size; CV_LeafKind kind; CV_LeafProcedure proc; } proc_leaf = {0};
+    proc_leaf.size           = sizeof(proc_leaf) - sizeof(proc_leaf.size);
+    proc_leaf.kind           = CV_LeafKind_PROCEDURE;
+    proc_leaf.proc.ret_itype = arg_itype;
+    proc_leaf.proc.arg_count = 1;
+    proc_leaf.proc.arg_itype = CV_MinComplexTypeIndex;
+    str8_list_push(scratch.arena, &debug_t, push_str8_copy(scratch.arena, str8_struct(&proc_leaf)));
+  }
+
+  U8 text[] = { 0xC3 };
+  COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+  COFF_ObjSection *text_sect  = t_push_text_section(obj_writer, str8_array_fixed(text));
+  coff_obj_writer_push_section(obj_writer, str8_lit(".debug$T"), PE_DEBUG_SECTION_FLAGS|COFF_SectionFlag_Align1Bytes, str8_list_join(scratch.arena, &debug_t, 0));
+  if (has_entry) {
+    coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+  }
+  String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+
+  B32 is_written = t_write_file(name, obj);
+  scratch_end(scratch);
+  return is_written;
+}
+
+internal String8
+t_pdb_stream_from_file(Arena *arena, String8 pdb_name, MSF_StreamNumber sn)
+{
+  String8     pdb_data = t_read_file(arena, pdb_name);
+  MSF_Parsed *msf      = msf_parsed_from_data(arena, pdb_data);
+  String8     result   = {0};
+  if (msf) {
+    result = msf_data_from_stream(msf, sn);
+  }
+  return result;
+}
+
+internal T_Result
+t_type_hash_cache(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  String8 cache_name = str8_lit("types.cache");
+
+  if (!t_write_obj_with_proc_type(str8_lit("a.obj"), CV_BasicType_INT32, 1))   { goto exit; }
+  if (!t_write_obj_with_proc_type(str8_lit("b.obj"), CV_BasicType_FLOAT32, 0)) { goto exit; }
+
+  //
+  // first link creates the cache
+  //
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /debug:full /pdb:a.pdb /rad_type_hash_cache:%S a.obj b.obj", cache_name);
+  if (linker_exit_code != 0) { goto exit; }
+
+  String8 cache = t_read_file(scratch.arena, cache_name);
+  if (cache.size < sizeof(T_TypeHashCacheHeader)) { goto exit; }
+  T_TypeHashCacheHeader *header = (T_TypeHashCacheHeader *)cache.str;
+  if (header->entry_count != 2)  { goto exit; }
+  if (header->hashes_count != 4) { goto exit; }
+  String8 tpi_no_hits = t_pdb_stream_from_file(scratch.arena, str8_lit("a.pdb"), PDB_FixedStream_Tpi);
+  if (tpi_no_hits.size == 0) { goto exit; }
+
+  //
+  // second link takes all hashes from the cache, tag the header to see whether the file is rewritten
+  //
+  header->pad = 0xC0FFEE;
+  if (!t_write_file(cache_name, cache)) { goto exit; }
+
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /debug:full /pdb:a.pdb /rad_type_hash_cache:%S a.obj b.obj", cache_name);
+  if (linker_exit_code != 0) { goto exit; }
+
+  cache  = t_read_file(scratch.arena, cache_name);
+  header = (T_TypeHashCacheHeader *)cache.str;
+  if (cache.size < sizeof(T_TypeHashCacheHeader) || header->pad != 0xC0FFEE) { goto exit; }
+
+  String8 tpi_hits = t_pdb_stream_from_file(scratch.arena, str8_lit("a.pdb"), PDB_FixedStream_Tpi);
+  if (!str8_match(tpi_hits, tpi_no_hits, 0)) { goto exit; }
+
+  //
+  // changed object replaces the existing cache file and drops the stale entry
+  //
+  if (!t_write_obj_with_proc_type(str8_lit("b.obj"), CV_BasicType_FLOAT64, 0)) { goto exit; }
+
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /debug:full /pdb:a.pdb /rad_type_hash_cache:%S a.obj b.obj", cache_name);
+  if (linker_exit_code != 0) { goto exit; }
+
+  cache  = t_read_file(scratch.arena, cache_name);
+  header = (T_TypeHashCacheHeader *)cache.str;
+  if (cache.size < sizeof(T_TypeHashCacheHeader)) { goto exit; }
+  if (header->pad == 0xC0FFEE)  { goto exit; }
+  if (header->entry_count != 2) { goto exit; }
+
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:b.exe /debug:full /pdb:b.pdb a.obj b.obj");
+  if (linker_exit_code != 0) { goto exit; }
+
+  tpi_hits              = t_pdb_stream_from_file(scratch.arena, str8_lit("a.pdb"), PDB_FixedStream_Tpi);
+  String8 tpi_reference = t_pdb_stream_from_file(scratch.arena, str8_lit("b.pdb"), PDB_FixedStream_Tpi);
+  if (!str8_match(tpi_hits, tpi_reference, 0)) { goto exit; }
+
+  //
+  // offsets past the end of the file must be rejected, not wrapped around
+  //
+  header->entries_off = max_U64 - 8;
+  header->hashes_off  = max_U64 - 8;
+  if (!t_write_file(cache_name, cache)) { goto exit; }
+
+  linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /debug:full /pdb:a.pdb /rad_type_hash_cache:%S a.obj b.obj", cache_name);
+  if (linker_exit_code != 0) { goto exit; }
+
+  cache  = t_read_file(scratch.arena, cache_name);
+  header = (T_TypeHashCacheHeader *)cache.str;
+  if (cache.size < sizeof(T_TypeHashCacheHeader))  { goto exit; }
+  if (header->entries_off != sizeof(*header))      { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal String8
+t_make_data_obj(Arena *arena, String8 symbol_name, String8 payload)
+{
+  COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+  COFF_ObjSection *data_sect  = coff_obj_writer_push_section(obj_writer, str8_lit(".data"), PE_DATA_SECTION_FLAGS|COFF_SectionFlag_Align1Bytes, payload);
+  coff_obj_writer_push_symbol_extern(obj_writer, symbol_name, 0, data_sect);
+  String8 obj = coff_obj_writer_serialize(arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+  return obj;
+}
+
+internal String8
+t_make_entry_obj_with_refs(Arena *arena, String8Array symbol_names)
+{
+  // mov rax, imm32 for each reference
+  U64 text_size = symbol_names.count*7 + 1;
+  U8 *text      = push_array(arena, U8, text_size);
+  for EachIndex(i, symbol_names.count) {
+    text[i*7 + 0] = 0x48;
+    text[i*7 + 1] = 0xC7;
+    text[i*7 + 2] = 0xC0;
+  }
+  text[text_size-1] = 0xC3;
+
+  COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+  COFF_ObjSection *text_sect  = t_push_text_section(obj_writer, str8(text, text_size));
+  coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+  for EachIndex(i, symbol_names.count) {
+    COFF_ObjSymbol *symbol = coff_obj_writer_push_symbol_undef(obj_writer, symbol_names.v[i]);
+    coff_obj_writer_section_push_reloc(obj_writer, text_sect, i*7 + 3, symbol, COFF_Reloc_X64_Addr32Nb);
+  }
+  String8 obj = coff_obj_writer_serialize(arena, obj_writer);
+  coff_obj_writer_release(&obj_writer);
+  return obj;
+}
+
+internal String8
+t_read_member_set(Arena *arena, String8 cache_dir_name)
+{
+  Temp         scratch   = scratch_begin(&arena, 1);
+  String8      result    = {0};
+  OS_FileIter *iter      = os_file_iter_begin(scratch.arena, t_make_file_path(scratch.arena, cache_dir_name), OS_FileIterFlag_SkipFolders);
+  for (OS_FileInfo info; os_file_iter_next(scratch.arena, iter, &info); ) {
+    if (str8_ends_with(info.name, str8_lit(".members"), 0)) {
+      result = t_read_file(arena, push_str8f(scratch.arena, "%S\\%S", cache_dir_name, info.name));
+      break;
+    }
+  }
+  os_file_iter_end(iter);
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_lib_member_prefetch(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  // mirrors leading fields of LNK_MemberSetHeader
+  typedef struct { U64 magic; U32 version; U32 lib_count; U64 member_offset_count; U64 path_blob_size; } T_MemberSetHeader;
+
+  String8 a_obj = t_make_data_obj(scratch.arena, str8_lit("A"), str8_lit("AAAA"));
+  String8 b_obj = t_make_data_obj(scratch.arena, str8_lit("B"), str8_lit("BBBB"));
+  String8 c_obj = t_make_data_obj(scratch.arena, str8_lit("C"), str8_lit("CCCC"));
+
+  {
+    COFF_LibWriter *lib_writer = coff_lib_writer_alloc();
+    coff_lib_writer_push_obj(lib_writer, str8_lit("a.obj"), a_obj);
+    coff_lib_writer_push_obj(lib_writer, str8_lit("b.obj"), b_obj);
+    coff_lib_writer_push_obj(lib_writer, str8_lit("c.obj"), c_obj);
+    String8 lib = coff_lib_writer_serialize(scratch.arena, lib_writer, 0, 0, 1);
+    coff_lib_writer_release(&lib_writer);
+    if (!t_write_file(str8_lit("abc.lib"), lib)) { goto exit; }
+  }
+  {
+    String8 refs[] = { str8_lit("A"), str8_lit("B") };
+    String8 entry_obj = t_make_entry_obj_with_refs(scratch.arena, (String8Array){ .v = refs, .count = ArrayCount(refs) });
+    if (!t_write_file(str8_lit("entry.obj"), entry_obj)) { goto exit; }
+  }
+
+  //
+  // first link records the members pulled from the lib, second link prefetches them
+  //
+  for EachIndex(link_idx, 2) {
+    int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /rad_lib_cache:lib_cache entry.obj abc.lib");
+    if (linker_exit_code != 0) { goto exit; }
+
+    String8             exe           = t_read_file(scratch.arena, str8_lit("a.exe"));
+    PE_BinInfo          pe            = pe_bin_info_from_data(scratch.arena, exe);
+    COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(exe, pe.section_table_range).str;
+    String8             string_table  = str8_substr(exe, pe.string_table_range);
+    COFF_SectionHeader *data_section  = t_coff_section_header_from_name(string_table, section_table, pe.section_count, str8_lit(".data"));
+    if (!data_section) { goto exit; }
+
+    String8 data = str8_substr(exe, rng_1u64(data_section->foff, data_section->foff + data_section->vsize));
+    if (!str8_match(data, str8_lit("AAAABBBB"), 0)) { goto exit; }
+
+    String8            member_set = t_read_member_set(scratch.arena, str8_lit("lib_cache"));
+    T_MemberSetHeader *header     = (T_MemberSetHeader *)member_set.str;
+    if (member_set.size < sizeof(*header))  { goto exit; }
+    if (header->magic != 0x5445534d424d4c52) { goto exit; }
+    if (header->version != 1)               { goto exit; }
+    if (header->lib_count != 1)             { goto exit; }
+    if (header->member_offset_count != 2)   { goto exit; }
+  }
+
+  //
+  // prediction goes stale when the lib is reordered and fewer symbols are referenced,
+  // link must still pick members by search alone and replace the recorded set
+  //
+  {
+    COFF_LibWriter *lib_writer = coff_lib_writer_alloc();
+    coff_lib_writer_push_obj(lib_writer, str8_lit("c.obj"), c_obj);
+    coff_lib_writer_push_obj(lib_writer, str8_lit("b.obj"), b_obj);
+    coff_lib_writer_push_obj(lib_writer, str8_lit("a.obj"), a_obj);
+    String8 lib = coff_lib_writer_serialize(scratch.arena, lib_writer, 0, 0, 1);
+    coff_lib_writer_release(&lib_writer);
+    if (!t_write_file(str8_lit("abc.lib"), lib)) { goto exit; }
+  }
+  {
+    String8 refs[] = { str8_lit("A") };
+    String8 entry_obj = t_make_entry_obj_with_refs(scratch.arena, (String8Array){ .v = refs, .count = ArrayCount(refs) });
+    if (!t_write_file(str8_lit("entry.obj"), entry_obj)) { goto exit; }
+  }
+
+  int linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /rad_lib_cache:lib_cache entry.obj abc.lib");
+  if (linker_exit_code != 0) { goto exit; }
+
+  String8             exe           = t_read_file(scratch.arena, str8_lit("a.exe"));
+  PE_BinInfo          pe            = pe_bin_info_from_data(scratch.arena, exe);
+  COFF_SectionHeader *section_table = (COFF_SectionHeader *)str8_substr(exe, pe.section_table_range).str;
+  String8             string_table  = str8_substr(exe, pe.string_table_range);
+  COFF_SectionHeader *data_section  = t_coff_section_header_from_name(string_table, section_table, pe.section_count, str8_lit(".data"));
+  if (!data_section) { goto exit; }
+
+  String8 data = str8_substr(exe, rng_1u64(data_section->foff, data_section->foff + data_section->vsize));
+  if (!str8_match(data, str8_lit("AAAA"), 0)) { goto exit; }
+
+  String8            member_set = t_read_member_set(scratch.arena, str8_lit("lib_cache"));
+  T_MemberSetHeader *header     = (T_MemberSetHeader *)member_set.str;
+  if (member_set.size < sizeof(*header))  { goto exit; }
+  if (header->member_offset_count != 1)   { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
+internal T_Result
+t_rdi_stream_layout(void)
+{
+  Temp scratch = scratch_begin(0,0);
+  T_Result result = T_Result_Fail;
+
+  // enough units to make serialization passes write in parallel blocks
+  U64         obj_count = 256;
+  String8List obj_names = {0};
+  for EachIndex(obj_idx, obj_count) {
+    U8 text[16];
+    MemorySet(text, 0xCC, sizeof(text));
+    text[0] = 0xC3;
+    text[1] = (U8)obj_idx;
+
+    COFF_ObjWriter  *obj_writer = coff_obj_writer_alloc(0, COFF_MachineType_X64);
+    COFF_ObjSection *text_sect  = coff_obj_writer_push_section(obj_writer, str8_lit(".text"), PE_TEXT_SECTION_FLAGS|COFF_SectionFlag_Align16Bytes, str8_array_fixed(text));
+    coff_obj_writer_push_section(obj_writer, str8_lit(".data"), PE_DATA_SECTION_FLAGS|COFF_SectionFlag_Align16Bytes, str8_array_fixed(text));
+    if (obj_idx == 0) {
+      coff_obj_writer_push_symbol_extern(obj_writer, str8_lit("entry"), 0, text_sect);
+    }
+    String8 obj = coff_obj_writer_serialize(scratch.arena, obj_writer);
+    coff_obj_writer_release(&obj_writer);
+
+    String8 obj_name = push_str8f(scratch.arena, "s%03llu.obj", obj_idx);
+    if (!t_write_file(obj_name, obj)) { goto exit; }
+    str8_list_push(scratch.arena, &obj_names, obj_name);
+  }
+
+  String8 obj_list         = str8_list_join(scratch.arena, &obj_names, &(StringJoin){ .sep = str8_lit(" ") });
+  int     linker_exit_code = t_invoke_linkerf("/subsystem:console /entry:entry /out:a.exe /debug /rad_debug /rad_debug_name:a.rdi /rad_workers:8 %S", obj_list);
+  if (linker_exit_code != 0) { goto exit; }
+
+  String8    rdi_data = t_read_file(scratch.arena, str8_lit("a.rdi"));
+  RDI_Parsed rdi      = {0};
+  if (rdi_parse(rdi_data.str, rdi_data.size, &rdi) != RDI_ParseStatus_Good) { goto exit; }
+  if (rdi.sections_count != RDI_SectionKind_COUNT) { goto exit; }
+
+  //
+  // sections written at stream offsets must land where a contiguous in-memory
+  // build would put them: header, section table, then 8-byte aligned sections
+  // back to back with zeroed alignment gaps
+  //
+  RDI_Header *header = (RDI_Header *)rdi_data.str;
+  if (header->data_section_off != sizeof(RDI_Header)) { goto exit; }
+
+  U64 *sorted_sects = push_array(scratch.arena, U64, rdi.sections_count);
+  U64  sorted_count = 0;
+  for EachIndex(sect_idx, rdi.sections_count) {
+    RDI_Section *sect = &rdi.sections[sect_idx];
+    if (sect->encoding != RDI_SectionEncoding_Unpacked)  { goto exit; }
+    if (sect->encoded_size != sect->unpacked_size)       { goto exit; }
+    if (sect->encoded_size == 0) {
+      continue;
+    }
+    U64 insert_idx = sorted_count;
+    for (; insert_idx > 0 && rdi.sections[sorted_sects[insert_idx-1]].off > sect->off; insert_idx -= 1) {
+      sorted_sects[insert_idx] = sorted_sects[insert_idx-1];
+    }
+    sorted_sects[insert_idx] = sect_idx;
+    sorted_count += 1;
+  }
+  if (sorted_count == 0) { goto exit; }
+
+  U64 expected_off = AlignPow2(sizeof(RDI_Header) + sizeof(RDI_Section) * RDI_SectionKind_COUNT, 8);
+  for EachIndex(i, sorted_count) {
+    RDI_Section *sect = &rdi.sections[sorted_sects[i]];
+    if (sect->off != expected_off) { goto exit; }
+
+    U64 sect_opl = sect->off + sect->encoded_size;
+    U64 next_off = AlignPow2(sect_opl, 8);
+    if (next_off > rdi_data.size) { goto exit; }
+    for (U64 pad_off = sect_opl; pad_off < next_off; pad_off += 1) {
+      if (rdi_data.str[pad_off] != 0) { goto exit; }
+    }
+    expected_off = next_off;
+  }
+  if (expected_off != rdi_data.size) { goto exit; }
+
+  //
+  // tables read through the section table must hold every unit
+  //
+  RDI_U64   unit_count = 0;
+  RDI_Unit *units      = rdi_table_from_name(&rdi, Units, &unit_count);
+  U64       found_count = 0;
+  for EachIndex(unit_idx, unit_count) {
+    RDI_U64 name_size = 0;
+    RDI_U8 *name      = rdi_string_from_idx(&rdi, units[unit_idx].unit_name_string_idx, &name_size);
+    if (str8_match(str8_prefix(str8(name, name_size), 1), str8_lit("s"), 0) && str8_ends_with(str8(name, name_size), str8_lit(".obj"), 0)) {
+      found_count += 1;
+    }
+  }
+  if (found_count != obj_count) { goto exit; }
+
+  result = T_Result_Pass;
+exit:;
+  scratch_end(scratch);
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////
 
 internal void
@@ -5019,6 +5910,14 @@ entry_point(CmdLine *cmdline)
     { "function_pad_min",                  t_function_pad_min                  },
     { "first_member_header",               t_first_member_header               },
     { "second_member_header",              t_second_member_header              },
+    { "order",                             t_order                             },
+    { "parallel_write",                    t_parallel_write                    },
+    { "rdi_unit_vmap",                     t_rdi_unit_vmap                     },
+    { "pdb_names",                         t_pdb_names                         },
+    { "pdb_page_reuse",                    t_pdb_page_reuse                    },
+    { "type_hash_cache",                   t_type_hash_cache                   },
+    { "lib_member_prefetch",               t_lib_member_prefetch               },
+    { "rdi_stream_layout",                 t_rdi_stream_layout                 },
   };
 
   //